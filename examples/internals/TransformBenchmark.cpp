@@ -0,0 +1,125 @@
+/** @file
+    @brief Implementation of a micro-benchmark comparing the per-report cost of
+    applying a tracker route transform the original way (combining it with the
+    room-to-world transform and using 4x4 matrices on every report) and with a
+    CompiledTransform.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/CompiledTransform.h>
+#include <osvr/Common/Transform.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <iostream>
+
+using osvr::common::CompiledTransform;
+using osvr::common::Transform;
+
+static const std::size_t REPORTS = 1000000;
+
+/// @brief One simulated tracker report: pose plus linear and angular velocity.
+struct Report {
+    Eigen::Quaterniond rotation;
+    Eigen::Vector3d translation;
+    Eigen::Vector3d linearVelocity;
+    Eigen::Quaterniond angularVelocity;
+};
+
+static Report makeReport(std::size_t i) {
+    Report ret;
+    ret.rotation = Eigen::Quaterniond(
+        Eigen::AngleAxisd(0.001 * i, Eigen::Vector3d(1, 2, 3).normalized()));
+    ret.translation = Eigen::Vector3d(0.001 * i, 1, -0.5);
+    ret.linearVelocity = Eigen::Vector3d(0.1, 0.2, 0.3);
+    ret.angularVelocity = Eigen::Quaterniond(
+        Eigen::AngleAxisd(0.01, Eigen::Vector3d::UnitY()));
+    return ret;
+}
+
+/// @brief Sum of the outputs, so the work can't be optimized away.
+static double checksum(Report const &r) {
+    return r.rotation.coeffs().sum() + r.translation.sum() +
+           r.linearVelocity.sum() + r.angularVelocity.coeffs().sum();
+}
+
+template <typename F> static double timePerReport(const char *name, F &&f) {
+    double sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < REPORTS; ++i) {
+        auto r = makeReport(i);
+        f(r);
+        sum += checksum(r);
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto ns =
+        std::chrono::duration<double, std::nano>(end - start).count() / REPORTS;
+    std::cout << name << ": " << ns << " ns/report (checksum " << sum << ")"
+              << std::endl;
+    return ns;
+}
+
+int main() {
+    Transform route;
+    Eigen::Isometry3d post(Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitY()));
+    post.translation() = Eigen::Vector3d(0.1, 1.5, -0.2);
+    route.concatPost(post.matrix());
+    Eigen::Isometry3d pre(Eigen::AngleAxisd(-1.1, Eigen::Vector3d::UnitX()));
+    route.concatPre(pre.matrix());
+    Transform room;
+    room.concatPost(Eigen::Isometry3d(Eigen::Translation3d(0, 0, 5)).matrix());
+
+    /// Time just generating the reports, to subtract it out.
+    auto baseline = timePerReport("baseline (no transform)", [](Report &) {});
+
+    auto original = timePerReport("Transform", [&](Report &r) {
+        auto xform = route;
+        xform.transform(room);
+        Eigen::Isometry3d pose(r.rotation);
+        pose.translation() = r.translation;
+        Eigen::Matrix4d result = xform.transform(pose.matrix());
+        r.rotation =
+            Eigen::Quaterniond(Eigen::Matrix3d(result.topLeftCorner<3, 3>()));
+        r.translation = result.topRightCorner<3, 1>();
+        r.linearVelocity = xform.transformDerivative(r.linearVelocity);
+        r.angularVelocity = xform.transformDerivative(r.angularVelocity);
+    });
+
+    auto combined = route;
+    combined.transform(room);
+    CompiledTransform compiledXform(combined);
+    auto compiled = timePerReport("CompiledTransform", [&](Report &r) {
+        compiledXform.transformPose(r.rotation, r.translation);
+        r.linearVelocity = compiledXform.transformDerivative(r.linearVelocity);
+        r.angularVelocity =
+            compiledXform.transformDerivative(r.angularVelocity);
+    });
+
+    std::cout << "Speedup (excluding baseline): "
+              << (original - baseline) / (compiled - baseline) << "x"
+              << std::endl;
+    return 0;
+}
@@ -35,10 +35,11 @@
 #include <osvr/Client/InterfaceTree.h>
 
 // Library/third-party includes
-// - none
+#include <json/value.h>
 
 // Standard includes
 #include <string>
+#include <unordered_map>
 
 namespace osvr {
 namespace common {
@@ -95,6 +96,17 @@ namespace client {
         /// or more interface objects but no remote handler.
         void m_connectNeededCallbacks();
 
+        /// @brief Summarizes what a path currently resolves to, so we can
+        /// tell whether its handler needs rebuilding after a tree patch.
+        Json::Value m_getSourceSignature(std::string const &path);
+
+        /// @brief Records the source signature of every path with a handler.
+        void m_snapshotHandledSources();
+
+        /// @brief Rebuilds handlers only for paths whose source changed since
+        /// m_snapshotHandledSources(), then tries to connect any others.
+        void m_reconnectChangedSources();
+
         /// @brief Access the client context's logger.
         util::log::LoggerPtr const &logger() const;
 
@@ -110,6 +122,9 @@ namespace client {
         /// common::PathTreeOwner events.
         common::PathTreeObserverPtr m_treeObserver;
 
+        /// @brief Source signatures of handled paths, taken before a patch.
+        std::unordered_map<std::string, Json::Value> m_handledSources;
+
         /// @brief Factory for producing remote handlers
         RemoteHandlerFactory &m_factory;
 
@@ -40,9 +40,25 @@ class vrpn_ConnectionPtr;
 namespace osvr {
 namespace client {
 
+    /// @brief Options for createContext()
+    struct ContextOptions {
+        /// @brief Whether to wait (briefly) for the server connection and
+        /// path tree before returning: otherwise, they're received on
+        /// subsequent updates.
+        bool waitForConnection = true;
+        /// @brief Whether to start out with the last path tree received from
+        /// this server, cached on disk, so interfaces can be resolved before
+        /// the server sends its tree.
+        bool usePathTreeCache = false;
+    };
+
     OSVR_CLIENT_EXPORT common::ClientContext *
     createContext(const char appId[], const char host[] = "localhost");
 
+    OSVR_CLIENT_EXPORT common::ClientContext *
+    createContext(const char appId[], const char host[],
+                  ContextOptions const &options);
+
     OSVR_CLIENT_EXPORT common::ClientContext *
     createAnalysisClientContext(const char appId[], const char host[],
                                 vrpn_ConnectionPtr const& conn);
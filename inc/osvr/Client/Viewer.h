@@ -58,6 +58,9 @@ namespace client {
         }
 
         OSVR_CLIENT_EXPORT OSVR_Pose3 getPose() const;
+        /// @brief Gets the pose predicted for the given time.
+        OSVR_CLIENT_EXPORT OSVR_Pose3
+        getPose(util::time::TimeValue const &when) const;
         OSVR_CLIENT_EXPORT bool hasPose() const;
 
       private:
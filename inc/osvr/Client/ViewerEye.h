@@ -36,6 +36,7 @@
 #include <osvr/Util/MatrixConventionsC.h>
 #include <osvr/Util/RadialDistortionParametersC.h>
 #include <osvr/Util/Angles.h>
+#include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
 #include <boost/optional.hpp>
@@ -85,9 +86,16 @@ namespace client {
         }
 #endif
         OSVR_CLIENT_EXPORT OSVR_Pose3 getPose() const;
+        /// @brief Gets the pose predicted for the given time.
+        OSVR_CLIENT_EXPORT OSVR_Pose3
+        getPose(util::time::TimeValue const &when) const;
         OSVR_CLIENT_EXPORT bool hasPose() const;
 
         OSVR_CLIENT_EXPORT Eigen::Matrix4d getView() const;
+        /// @brief Gets the view matrix for the pose predicted for the given
+        /// time.
+        OSVR_CLIENT_EXPORT Eigen::Matrix4d
+        getView(util::time::TimeValue const &when) const;
 
         bool wantDistortion() const {
             return m_radDistortParams.is_initialized();
@@ -132,6 +140,9 @@ namespace client {
             util::Angle opticalAxisOffsetY = 0. * util::radians);
         util::Rectd m_getRect(double near, double far) const;
         Eigen::Isometry3d getPoseIsometry() const;
+        Eigen::Isometry3d
+        getPoseIsometry(util::time::TimeValue const &when) const;
+        Eigen::Isometry3d m_applyEyeOffset(OSVR_Pose3 const &pose) const;
         InternalInterfaceOwner m_pose;
         Eigen::Vector3d m_offset;
 #if 0
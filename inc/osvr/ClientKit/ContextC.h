@@ -52,18 +52,48 @@ OSVR_EXTERN_C_BEGIN
     @{
 */
 
+/** @brief Flag for osvrClientInit(): service the server connection on an
+    internal thread instead of in osvrClientUpdate() (which then does nothing).
+
+    State (e.g. osvrGetPoseState()) may then be read from any thread without
+    locking, and always reflects a single report: a read that overlaps an
+    update of that state briefly yields and retries. Callbacks are called on
+    the internal thread.
+*/
+#define OSVR_CLIENT_INIT_BACKGROUND_UPDATE (1u << 0)
+
+/** @brief Flag for osvrClientInit(): return immediately, instead of waiting
+    (up to about a second) for the server connection and path tree, which are
+    then received during subsequent updates. Use osvrClientCheckStatus() to
+    find out when startup is complete.
+*/
+#define OSVR_CLIENT_INIT_NONBLOCKING (1u << 1)
+
+/** @brief Flag for osvrClientInit(): start out with the last path tree
+    received from the server (cached on disk), so interfaces begin receiving
+    reports as soon as the devices are reachable, without waiting for the
+    server to send its path tree. The cached tree is checked against the
+    server's once that arrives.
+
+    Most useful along with OSVR_CLIENT_INIT_NONBLOCKING.
+*/
+#define OSVR_CLIENT_INIT_CACHED_PATH_TREE (1u << 2)
+
 /** @brief Initialize the library.
 
     @param applicationIdentifier A null terminated string identifying your
    application. Reverse DNS format strongly suggested.
-    @param flags initialization options (reserved) - pass 0 for now.
+    @param flags initialization options: 0 or a bitwise-or of
+    OSVR_CLIENT_INIT_BACKGROUND_UPDATE, OSVR_CLIENT_INIT_NONBLOCKING, and
+    OSVR_CLIENT_INIT_CACHED_PATH_TREE.
 
     @returns Client context - will be needed for subsequent calls
 */
 OSVR_CLIENTKIT_EXPORT OSVR_ClientContext osvrClientInit(
     const char applicationIdentifier[], uint32_t flags OSVR_CPP_ONLY(= 0));
 
-/** @brief Updates the state of the context - call regularly in your mainloop.
+/** @brief Updates the state of the context - call regularly in your mainloop,
+    unless the context was created with OSVR_CLIENT_INIT_BACKGROUND_UPDATE.
 
     @param ctx Client context
 */
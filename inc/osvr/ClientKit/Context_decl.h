@@ -59,7 +59,7 @@ namespace clientkit {
         /// @brief Initialize the library.
         /// @param applicationIdentifier A string identifying your application.
         /// Reverse DNS format strongly suggested.
-        /// @param flags initialization options (reserved, optional)
+        /// @param flags initialization options (optional): see osvrClientInit()
         ClientContext(const char applicationIdentifier[], uint32_t flags = 0u);
 
         /// @brief Initialize the context with an existing context.
@@ -39,6 +39,7 @@
 #include <osvr/Util/Pose3C.h>
 #include <osvr/Util/BoolC.h>
 #include <osvr/Util/RadialDistortionParametersC.h>
+#include <osvr/Util/TimeValueC.h>
 
 /* Library/third-party includes */
 /* none */
@@ -194,6 +195,16 @@ osvrClientGetNumViewers(OSVR_DisplayConfig disp, OSVR_ViewerCount *viewers);
 OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetViewerPose(
     OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_Pose3 *pose);
 
+/** @brief Like osvrClientGetViewerPose(), but predicts the pose for a given
+    time (typically when the frame being rendered will be scanned out) from
+    the tracker's velocity and acceleration reports.
+
+    @sa osvrGetPoseStateAtTime()
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetViewerPoseAtTime(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer,
+    OSVR_IN_PTR struct OSVR_TimeValue const *when, OSVR_Pose3 *pose);
+
 /** @brief Each viewer in a display config can have one or more "eyes" which
     have a substantially similar pose: get the count.
 
@@ -228,6 +239,15 @@ OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
 osvrClientGetViewerEyePose(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer,
                            OSVR_EyeCount eye, OSVR_Pose3 *pose);
 
+/** @brief Like osvrClientGetViewerEyePose(), but predicts the pose for a
+    given time (typically when the frame being rendered will be scanned out).
+
+    @sa osvrGetPoseStateAtTime()
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetViewerEyePoseAtTime(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_IN_PTR struct OSVR_TimeValue const *when, OSVR_Pose3 *pose);
+
 /** @brief Get the view matrix (inverse of pose) for the given eye of a
     viewer in a display config - matrix of **doubles**.
 
@@ -266,6 +286,24 @@ OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetViewerEyeViewMatrixf(
     OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
     OSVR_MatrixConventions flags, float *mat);
 
+/** @brief Like osvrClientGetViewerEyeViewMatrixd(), but for the pose
+    predicted for a given time (typically when the frame being rendered will be
+    scanned out).
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetViewerEyeViewMatrixdAtTime(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_IN_PTR struct OSVR_TimeValue const *when,
+    OSVR_MatrixConventions flags, double *mat);
+
+/** @brief Like osvrClientGetViewerEyeViewMatrixf(), but for the pose
+    predicted for a given time (typically when the frame being rendered will be
+    scanned out).
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientGetViewerEyeViewMatrixfAtTime(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_IN_PTR struct OSVR_TimeValue const *when,
+    OSVR_MatrixConventions flags, float *mat);
+
 /** @brief Each eye of each viewer in a display config has one or more surfaces
     (aka "screens") on which content should be rendered.
 
@@ -61,6 +61,7 @@ OSVR_INTERFACE_CALLBACK_METHOD(LinearAcceleration)
 OSVR_INTERFACE_CALLBACK_METHOD(AngularAcceleration)
 OSVR_INTERFACE_CALLBACK_METHOD(Button)
 OSVR_INTERFACE_CALLBACK_METHOD(Analog)
+OSVR_INTERFACE_CALLBACK_METHOD(AnalogArray)
 OSVR_INTERFACE_CALLBACK_METHOD(Imaging)
 OSVR_INTERFACE_CALLBACK_METHOD(Location2D)
 OSVR_INTERFACE_CALLBACK_METHOD(Direction)
@@ -74,6 +74,88 @@ OSVR_CALLBACK_METHODS(NaviPosition)
 
 #undef OSVR_CALLBACK_METHODS
 
+/** @brief Set the number of past states to keep for each report type on an
+    interface, discarding any already kept. Defaults to 0, keeping none (and
+    allocating nothing for them).
+
+    History is what the osvrGet...StateNearest(), osvrGet...StateRange(),
+    and osvrGet...StateInterpolated() functions search.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrSetStateHistoryCapacity(OSVR_ClientInterface iface, uint32_t capacity);
+
+#define OSVR_HISTORY_METHODS(TYPE)                                             \
+    /** @brief Get the TYPE state from an interface's history with the         \
+     * timestamp closest to the given time, returning failure if none          \
+     * exists */                                                               \
+    OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrGet##TYPE##StateNearest(         \
+        OSVR_ClientInterface iface, struct OSVR_TimeValue const *when,         \
+        struct OSVR_TimeValue *timestamp, OSVR_##TYPE##State *state);          \
+    /** @brief Get the TYPE states from an interface's history with            \
+     * timestamps in [begin, end], oldest first, up to maxStates of them. The  \
+     * number written is returned in numStates. */                             \
+    OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrGet##TYPE##StateRange(           \
+        OSVR_ClientInterface iface, struct OSVR_TimeValue const *begin,        \
+        struct OSVR_TimeValue const *end, struct OSVR_TimeValue *timestamps,   \
+        OSVR_##TYPE##State *states, uint32_t maxStates, uint32_t *numStates);
+
+OSVR_HISTORY_METHODS(Pose)
+OSVR_HISTORY_METHODS(Position)
+OSVR_HISTORY_METHODS(Orientation)
+OSVR_HISTORY_METHODS(Velocity)
+OSVR_HISTORY_METHODS(LinearVelocity)
+OSVR_HISTORY_METHODS(AngularVelocity)
+OSVR_HISTORY_METHODS(Acceleration)
+OSVR_HISTORY_METHODS(LinearAcceleration)
+OSVR_HISTORY_METHODS(AngularAcceleration)
+OSVR_HISTORY_METHODS(Button)
+OSVR_HISTORY_METHODS(Analog)
+OSVR_HISTORY_METHODS(Location2D)
+OSVR_HISTORY_METHODS(Direction)
+OSVR_HISTORY_METHODS(EyeTracker2D)
+OSVR_HISTORY_METHODS(EyeTracker3D)
+OSVR_HISTORY_METHODS(EyeTrackerBlink)
+OSVR_HISTORY_METHODS(NaviVelocity)
+OSVR_HISTORY_METHODS(NaviPosition)
+
+#undef OSVR_HISTORY_METHODS
+
+#define OSVR_INTERPOLATED_METHODS(TYPE)                                        \
+    /** @brief Get the TYPE state from an interface's history, interpolated    \
+     * to the given time, returning failure if the time is outside the span    \
+     * recorded. */                                                            \
+    OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrGet##TYPE##StateInterpolated(    \
+        OSVR_ClientInterface iface, struct OSVR_TimeValue const *when,         \
+        OSVR_##TYPE##State *state);
+
+OSVR_INTERPOLATED_METHODS(Pose)
+OSVR_INTERPOLATED_METHODS(Position)
+OSVR_INTERPOLATED_METHODS(Orientation)
+
+#undef OSVR_INTERPOLATED_METHODS
+
+/** @brief Get pose state from an interface, extrapolated to a target time
+    (such as the expected scan-out time of a frame) using the velocity and
+    acceleration state of the same interface, if any.
+
+    Prediction is limited to a short interval past the latest pose report; a
+    target time at or before that report gets the unmodified pose.
+
+    @param iface Interface
+    @param targetTime Time to predict the pose for.
+    @param[out] timestamp Timestamp of the pose report the prediction started
+    from.
+    @param[out] state Predicted pose state.
+
+    @return OSVR_RETURN_FAILURE if invalid parameters were passed or no pose
+    state exists, in which case the output arguments are unmodified.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrGetPoseStateAtTime(OSVR_ClientInterface iface,
+                       OSVR_IN_PTR struct OSVR_TimeValue const *targetTime,
+                       OSVR_OUT_PTR struct OSVR_TimeValue *timestamp,
+                       OSVR_OUT_PTR OSVR_PoseState *state);
+
 OSVR_EXTERN_C_END
 
 #endif
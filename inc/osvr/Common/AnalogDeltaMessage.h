@@ -0,0 +1,153 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AnalogDeltaMessage_h_GUID_8B2D6F41_C37A_4E15_9D08_5A1E7C94B2F3
+#define INCLUDED_AnalogDeltaMessage_h_GUID_8B2D6F41_C37A_4E15_9D08_5A1E7C94B2F3
+
+// Internal Includes
+#include <osvr/Common/SerializationTraits.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    namespace messages {
+        /// @brief A channel value carried by an AnalogDelta message.
+        struct AnalogDeltaEntry {
+            uint16_t channel;
+            double value;
+        };
+
+        /// @brief Analog message carrying only the channels that changed
+        /// since the last one (or all of them, in a "full" message), sent
+        /// from the same sender as the standard vrpn_Analog messages in place
+        /// of them.
+        ///
+        /// If the quantum is non-zero, values are sent as 32-bit integer
+        /// multiples of it.
+        class AnalogDelta {
+          public:
+            static const char *identifier() { return "com.osvr.analog.delta"; }
+
+            /// @brief The integer sent for a value with a non-zero quantum.
+            static int32_t quantize(double value, double quantum) {
+                auto q = std::round(value / quantum);
+                typedef std::numeric_limits<int32_t> limits;
+                if (!(q > limits::min())) {
+                    return limits::min();
+                }
+                if (!(q < limits::max())) {
+                    return limits::max();
+                }
+                return static_cast<int32_t>(q);
+            }
+
+            class MessageSerialization {
+              public:
+                /// @brief Constructor for sending: the entries are not copied.
+                MessageSerialization(bool full, uint16_t numChannels,
+                                     double quantum,
+                                     AnalogDeltaEntry const *entries,
+                                     std::size_t count)
+                    : m_full(full), m_numChannels(numChannels),
+                      m_quantum(quantum), m_entries(entries), m_count(count) {}
+
+                /// @brief Constructor for receiving, into a vector whose
+                /// storage may be reused from message to message.
+                explicit MessageSerialization(
+                    std::vector<AnalogDeltaEntry> &dest)
+                    : m_dest(&dest) {}
+
+                template <typename T> void processMessage(T &p) {
+                    p(m_full);
+                    p(m_numChannels);
+                    p(m_quantum);
+                    m_process(p, p.isDeserialize());
+                }
+
+                /// @brief Whether the message carries every channel.
+                bool isFull() const { return m_full; }
+
+                /// @brief Total number of channels on the device.
+                uint16_t getNumChannels() const { return m_numChannels; }
+
+              private:
+                template <typename T>
+                void m_process(T &p, std::false_type /* isDeserialize */) {
+                    auto count = static_cast<uint16_t>(m_count);
+                    p(count);
+                    for (std::size_t i = 0; i < m_count; ++i) {
+                        auto channel = m_entries[i].channel;
+                        p(channel);
+                        if (m_quantum > 0) {
+                            auto q = quantize(m_entries[i].value, m_quantum);
+                            p(q);
+                        } else {
+                            auto value = m_entries[i].value;
+                            p(value);
+                        }
+                    }
+                }
+                template <typename T>
+                void m_process(T &p, std::true_type /* isDeserialize */) {
+                    uint16_t count;
+                    p(count);
+                    /// Entry by entry, so a bogus count runs out of buffer
+                    /// rather than allocating.
+                    m_dest->clear();
+                    for (uint16_t i = 0; i < count; ++i) {
+                        AnalogDeltaEntry entry;
+                        p(entry.channel);
+                        if (m_quantum > 0) {
+                            int32_t q;
+                            p(q);
+                            entry.value = q * m_quantum;
+                        } else {
+                            p(entry.value);
+                        }
+                        m_dest->push_back(entry);
+                    }
+                }
+                bool m_full = false;
+                uint16_t m_numChannels = 0;
+                double m_quantum = 0;
+                AnalogDeltaEntry const *m_entries = nullptr;
+                std::size_t m_count = 0;
+                std::vector<AnalogDeltaEntry> *m_dest = nullptr;
+            };
+        };
+    } // namespace messages
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_AnalogDeltaMessage_h_GUID_8B2D6F41_C37A_4E15_9D08_5A1E7C94B2F3
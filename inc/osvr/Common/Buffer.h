@@ -281,6 +281,13 @@ namespace common {
         /// @brief Gets the current size, in bytes.
         size_t size() const { return m_buf.size(); }
 
+        /// @brief Ensures the buffer can hold the given total number of bytes
+        /// without reallocating.
+        void reserve(size_t const bytes) { m_buf.reserve(bytes); }
+
+        /// @brief Empties the buffer, keeping its storage for reuse.
+        void clear() { m_buf.clear(); }
+
         /// @brief Provides access to the underlying container.
         ContainerType &getContents() { return m_buf; }
 
@@ -46,6 +46,11 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
 
 struct OSVR_ClientContextObject : boost::noncopyable {
   public:
@@ -53,9 +58,35 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     /// @brief Destructor
     OSVR_COMMON_EXPORT virtual ~OSVR_ClientContextObject();
 
-    /// @brief System-wide update method.
+    /// @brief System-wide update method. Does nothing while updating in the
+    /// background.
     OSVR_COMMON_EXPORT void update();
 
+    /// @brief Starts servicing the connections on an internal thread, every
+    /// interval, instead of in update(). Interface state can then be read
+    /// from any thread without locking (see InterfaceState), while callbacks
+    /// are called on the internal thread.
+    ///
+    /// The other methods of this object, except the reference-returning
+    /// accessors (getInterfaces(), getPathTree() and
+    /// getRoomToWorldTransform()), remain safe to call from the thread that
+    /// created it: they are serialized with the internal thread.
+    OSVR_COMMON_EXPORT void startBackgroundUpdates(
+        std::chrono::microseconds interval = std::chrono::milliseconds(1));
+
+    /// @brief Stops updating in the background, if we were, waiting for the
+    /// internal thread to finish.
+    OSVR_COMMON_EXPORT void stopBackgroundUpdates();
+
+    /// @brief Whether we're updating on an internal thread.
+    bool isUpdatingInBackground() const { return m_updateThread.joinable(); }
+
+    /// @brief Locks out updating (in the background or not) for the lifetime
+    /// of the returned lock: hold it while touching interface data the update
+    /// uses, such as callbacks and state history.
+    OSVR_COMMON_EXPORT std::unique_lock<std::recursive_mutex>
+    lockUpdates() const;
+
     /// @brief Accessor for app ID
     std::string const &getAppId() const;
 
@@ -92,6 +123,7 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     /// @brief Pass (smart-pointer) ownership of some object to the client
     /// context.
     template <typename T> void *acquireObject(T obj) {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
         return m_ownedObjects.acquire(obj);
     }
 
@@ -109,6 +141,12 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     OSVR_COMMON_EXPORT void
     setRoomToWorldTransform(osvr::common::Transform const &xform);
 
+    /// @brief Gets a number that changes every time the transform from room
+    /// space to world space is set, so values derived from it can be cached.
+    std::uint32_t getRoomToWorldTransformGeneration() const {
+        return m_roomToWorldGeneration;
+    }
+
     /// @brief Returns the specialized deleter for this object.
     OSVR_COMMON_EXPORT osvr::common::ClientContextDeleter getDeleter() const;
 
@@ -136,6 +174,8 @@ struct OSVR_ClientContextObject : boost::noncopyable {
         osvr::common::ClientContextDeleter del);
 
   private:
+    /// @brief Body of update(), called with m_mutex held.
+    void m_updateLocked();
     virtual void m_update() = 0;
     virtual void m_sendRoute(std::string const &route) = 0;
     OSVR_COMMON_EXPORT virtual bool m_getStatus() const;
@@ -173,6 +213,13 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     osvr::util::log::LoggerPtr m_logger;
     /// Logger for the client's exclusive use
     osvr::util::log::LoggerPtr m_clientLogger;
+
+    /// @brief Serializes updating with other use of the context. Recursive
+    /// since callbacks made during update may call back into the context.
+    mutable std::recursive_mutex m_mutex;
+    std::uint32_t m_roomToWorldGeneration = 0;
+    std::atomic<bool> m_runUpdateThread{false};
+    std::thread m_updateThread;
 };
 
 namespace osvr {
@@ -45,6 +45,7 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <mutex>
 
 struct OSVR_ClientInterfaceObject : boost::noncopyable {
 
@@ -72,11 +73,7 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
     getState(osvr::util::time::TimeValue &timestamp,
              osvr::common::traits::StateFromReport_t<ReportType> &state) const {
         osvr::common::tracing::markGetState(m_path);
-        if (!m_state.hasState<ReportType>()) {
-            return false;
-        }
-        m_state.getState<ReportType>(timestamp, state);
-        return true;
+        return m_state.getState<ReportType>(timestamp, state);
     }
 
     template <typename ReportType> bool hasStateForReportType() const {
@@ -85,6 +82,23 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
 
     bool hasAnyState() const { return m_state.hasAnyState(); }
 
+    /// @brief Sets how many past states to keep for each report type: 0
+    /// (the default) keeps none.
+    void setStateHistoryCapacity(std::size_t capacity) {
+        auto lock = m_lockContext();
+        m_state.setHistoryCapacity(capacity);
+    }
+
+    /// @brief Gets the recorded history for a report type, or nullptr if
+    /// none has been recorded.
+    ///
+    /// The history is modified by the context update, so outside of it (and
+    /// its callbacks) hold ClientContext::lockUpdates() while using it.
+    template <typename ReportType>
+    osvr::common::StateHistory<ReportType> const *getStateHistory() const {
+        return m_state.getHistory<ReportType>();
+    }
+
     /// @brief Set saved state for a report type.
     template <typename ReportType>
     void setState(const OSVR_TimeValue &timestamp, ReportType const &report) {
@@ -102,6 +116,7 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
     /// @brief Register a callback for a known report type.
     template <typename CallbackType>
     void registerCallback(CallbackType cb, void *userdata) {
+        auto lock = m_lockContext();
         m_callbacks.addCallback(cb, userdata);
     }
 
@@ -116,6 +131,7 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
     /// @brief Get the number of registered callbacks for the given report type.
     template <typename ReportType>
     std::size_t getNumCallbacksFor(ReportType const &r) const {
+        auto lock = m_lockContext();
         return m_callbacks.getNumCallbacksFor(r);
     }
     /// @}
@@ -129,6 +145,11 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
     boost::any &data() { return m_data; }
 
   private:
+    /// @brief Locks out the context's update, which may be running on
+    /// another thread: see ClientContext::lockUpdates().
+    OSVR_COMMON_EXPORT std::unique_lock<std::recursive_mutex>
+    m_lockContext() const;
+
     osvr::common::ClientContext &m_ctx;
     std::string const m_path;
     osvr::common::InterfaceCallbacks m_callbacks;
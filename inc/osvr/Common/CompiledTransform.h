@@ -0,0 +1,125 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_CompiledTransform_h_GUID_7E2B9C14_3A5D_4F61_8C0E_B94D17A2F356
+#define INCLUDED_CompiledTransform_h_GUID_7E2B9C14_3A5D_4F61_8C0E_B94D17A2F356
+
+// Internal Includes
+#include <osvr/Common/Transform.h>
+
+// Library/third-party includes
+#include <osvr/Util/EigenCoreGeometry.h>
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    /// @brief A Transform reduced, once, to the form cheapest to apply to
+    /// every report: the linear part and translation of its pre and post
+    /// components, plus, when those linear parts are rotations (the usual
+    /// case), their quaternions, so poses and rotational derivatives are
+    /// transformed with quaternion products rather than 4x4 matrix products
+    /// and conversions.
+    ///
+    /// Produces the same results as the Transform methods of the same names
+    /// (up to the sign of quaternions and rounding).
+    class CompiledTransform {
+      public:
+        /// @brief Identity transform.
+        CompiledTransform() : CompiledTransform(Transform()) {}
+
+        explicit CompiledTransform(Transform const &xform)
+            : m_preLinear(xform.getPre().topLeftCorner<3, 3>()),
+              m_preTranslation(xform.getPre().topRightCorner<3, 1>()),
+              m_postLinear(xform.getPost().topLeftCorner<3, 3>()),
+              m_postTranslation(xform.getPost().topRightCorner<3, 1>()),
+              m_postIsRotation(isRotation(m_postLinear)),
+              m_rigid(m_postIsRotation && isRotation(m_preLinear)) {
+            if (m_postIsRotation) {
+                m_postRotation = Eigen::Quaterniond(m_postLinear);
+            }
+            if (m_rigid) {
+                m_preRotation = Eigen::Quaterniond(m_preLinear);
+            }
+        }
+
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        /// @brief Apply the transformation to a pose, in place.
+        void transformPose(Eigen::Quaterniond &rotation,
+                           Eigen::Vector3d &translation) const {
+            if (m_rigid) {
+                translation = m_postRotation * (rotation * m_preTranslation +
+                                                translation) +
+                              m_postTranslation;
+                rotation = m_postRotation * rotation * m_preRotation;
+                return;
+            }
+            Eigen::Matrix3d rot = rotation.toRotationMatrix();
+            translation =
+                m_postLinear * (rot * m_preTranslation + translation) +
+                m_postTranslation;
+            rotation = Eigen::Quaterniond(m_postLinear * rot * m_preLinear);
+        }
+
+        /// @brief Apply only the rotation/basis change (not the translation)
+        /// to a vector representing a velocity or acceleration
+        Eigen::Vector3d transformDerivative(
+            Eigen::Ref<Eigen::Vector3d const> const &vec) const {
+            return m_postLinear * vec;
+        }
+
+        /// @brief Transform a rotational derivative: angular velocity or
+        /// acceleration.
+        Eigen::Quaterniond
+        transformDerivative(Eigen::Quaterniond const &quat) const {
+            if (m_postIsRotation) {
+                return m_postRotation * quat * m_postRotation.conjugate();
+            }
+            return Eigen::Quaterniond(m_postLinear * quat.toRotationMatrix() *
+                                      m_postLinear.transpose());
+        }
+
+        /// @brief Whether poses take the quaternion fast path.
+        bool isRigid() const { return m_rigid; }
+
+      private:
+        static bool isRotation(Eigen::Matrix3d const &mat) {
+            return mat.isUnitary() && mat.determinant() > 0;
+        }
+        Eigen::Matrix3d m_preLinear;
+        Eigen::Vector3d m_preTranslation;
+        Eigen::Matrix3d m_postLinear;
+        Eigen::Vector3d m_postTranslation;
+        Eigen::Quaterniond m_preRotation = Eigen::Quaterniond::Identity();
+        Eigen::Quaterniond m_postRotation = Eigen::Quaterniond::Identity();
+        bool m_postIsRotation;
+        bool m_rigid;
+    };
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_CompiledTransform_h_GUID_7E2B9C14_3A5D_4F61_8C0E_B94D17A2F356
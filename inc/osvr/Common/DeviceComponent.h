@@ -26,8 +26,10 @@
 #define INCLUDED_DeviceComponent_h_GUID_FC172255_F4F1_41A2_ABA5_E5E33F8BD005
 
 // Internal Includes
+#include <osvr/Common/Export.h>
 #include <osvr/Common/DeviceComponentPtr.h>
 #include <osvr/Common/BaseDevicePtr.h>
+#include <osvr/Common/Buffer.h>
 #include <osvr/Common/MessageHandler.h>
 #include <osvr/Common/BaseMessageTraits.h>
 
@@ -69,6 +71,18 @@ namespace common {
         void m_registerHandler(vrpn_MESSAGEHANDLER handler, void *userdata,
                                RawMessageType const &msgType);
 
+        /// @brief Gets this component's buffer for serializing an outgoing
+        /// message into, emptied. Its storage is kept from message to
+        /// message, so once it has grown to fit, sending doesn't allocate.
+        ///
+        /// Contents are only valid until the next call: serialize, then
+        /// packMessage() right away. Each component has its own buffer, so
+        /// this needs no locking beyond what sending through the parent
+        /// already does: a component's sends must not overlap, since they
+        /// share the device's connection (for async devices, the access
+        /// control around sending takes care of this).
+        OSVR_COMMON_EXPORT Buffer<> &m_getMessageBuffer();
+
         /// @brief Called once when we have a parent
         virtual void m_parentSet() = 0;
 
@@ -79,6 +93,7 @@ namespace common {
       private:
         Parent *m_parent;
         MessageHandlerList<BaseDeviceMessageHandleTraits> m_messageHandlers;
+        Buffer<> m_messageBuffer;
     };
 } // namespace common
 } // namespace osvr
@@ -62,6 +62,11 @@ namespace common {
     /// segment name and signalling new data, and no guarantee that the data you
     /// were notified about won't be overwritten - just that if you're currently
     /// accessing data, we won't overwrite that.
+    ///
+    /// Alternately, a ring buffer may be created in lock-free mode (see
+    /// Options::setLockFree()), in which case the producer never waits on
+    /// readers: readers instead get a validated private copy of an entry, and
+    /// simply fail to get an entry that was torn or overwritten.
     class IPCRingBuffer : public enable_shared_from_this<IPCRingBuffer> {
       public:
         typedef uint8_t BackendType;
@@ -100,20 +105,39 @@ namespace common {
             Options &setEntrySize(entry_size_type entrySize);
             entry_size_type getEntrySize() const { return m_entrySize; }
 
+            /// @brief Sets whether the ring buffer should be created in the
+            /// lock-free, single-writer mode (which uses a different ABI
+            /// level). Only used when creating: clients detect the mode.
+            /// @return *this for chained method idiom.
+            Options &setLockFree(bool lockFree);
+            bool getLockFree() const { return m_lockFree; }
+
           private:
             std::string m_name;
             BackendType m_shmBackend;
             alignment_type m_alignment = 16;
             entry_count_type m_entries = 16;
             entry_size_type m_entrySize = 65536;
+            bool m_lockFree = false;
         };
 
         /// @brief Gets an integer representing a unique arrangement of the
         /// internal shared memory layout, such that if two processes try to
         /// communicate with different ABI levels, they will (likely) not
         /// succeed and thus should not try.
+        ///
+        /// This is the ABI level of the default (locking) layout.
         OSVR_COMMON_EXPORT static abi_level_type getABILevel();
 
+        /// @brief Gets the ABI level of the lock-free layout - see
+        /// getABILevel()
+        OSVR_COMMON_EXPORT static abi_level_type getLockFreeABILevel();
+
+        /// @brief Can this build access a ring buffer created with the given
+        /// ABI level?
+        OSVR_COMMON_EXPORT static bool
+        isABILevelSupported(abi_level_type level);
+
         /// @brief Named constructor, for use by server processes: creates a
         /// shared memory ring buffer given the options structure.
         ///
@@ -136,6 +160,13 @@ namespace common {
         /// buffer
         OSVR_COMMON_EXPORT std::string const &getName() const;
 
+        /// @brief Returns whether this ring buffer uses the lock-free mode.
+        OSVR_COMMON_EXPORT bool isLockFree() const;
+
+        /// @brief Returns the ABI level of the layout actually used by this
+        /// ring buffer, suitable for sending to clients.
+        OSVR_COMMON_EXPORT abi_level_type getInstanceABILevel() const;
+
         /// @brief Returns the size of each individual buffer entry, in bytes.
         OSVR_COMMON_EXPORT uint32_t getEntrySize() const;
 
@@ -195,6 +226,10 @@ namespace common {
         /// holding a sharable mutex lock preventing it from being overwritten
         /// while this object is in scope.
         ///
+        /// In lock-free mode, it instead holds a private copy of the entry,
+        /// validated to be neither torn nor overwritten. For entries written
+        /// with put(data, len), only those len bytes are copied.
+        ///
         /// As such, you should only access the memory pointed to by this object
         /// while you keep this object alive, and you should let it go out of
         /// scope when you no longer need the data.
@@ -0,0 +1,193 @@
+/** @file
+    @brief Header for the encoding used by the chunked network image stream.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ImageStreamCodec_h_GUID_6F1B2C8E_8D0A_4E57_B3A9_41C5D27E9A60
+#define INCLUDED_ImageStreamCodec_h_GUID_6F1B2C8E_8D0A_4E57_B3A9_41C5D27E9A60
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Util/ImagingReportTypesC.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    namespace imagestream {
+        typedef std::vector<uint8_t> ByteVector;
+        typedef uint32_t frame_id_type;
+
+        /// @brief Settings a client may request for the network image stream
+        /// of a sensor.
+        struct StreamSettings {
+            /// @brief Integer decimation factor applied in both dimensions (1
+            /// means full resolution)
+            uint8_t downscale = 1;
+            /// @brief Region of interest, in full-resolution pixels. A zero
+            /// width or height means the whole image.
+            uint32_t roiX = 0;
+            uint32_t roiY = 0;
+            uint32_t roiWidth = 0;
+            uint32_t roiHeight = 0;
+            /// @brief Whether to run-length encode zero bytes.
+            bool compress = true;
+            /// @brief Whether to encode frames relative to the previous frame
+            /// (with periodic key frames).
+            bool delta = true;
+        };
+
+        enum class Encoding : uint8_t {
+            /// @brief Plain pixel bytes
+            Raw = 0,
+            /// @brief Zero-run-length-encoded pixel bytes
+            ZeroRuns = 1,
+            /// @brief Byte-wise difference from the base frame, then
+            /// zero-run-length encoded.
+            DeltaZeroRuns = 2
+        };
+
+        /// @brief Sentinel base frame ID for frames that don't depend on any
+        /// other.
+        static const frame_id_type NO_BASE_FRAME = 0xffffffff;
+
+        /// @brief Crops the image to the region of interest and decimates it
+        /// as requested in the settings.
+        /// @return the metadata of the resulting image, placed in out.
+        OSVR_COMMON_EXPORT OSVR_ImagingMetadata extractRegion(
+            OSVR_ImagingMetadata const &metadata,
+            OSVR_ImageBufferElement const *data,
+            StreamSettings const &settings, ByteVector &out);
+
+        /// @brief Appends a run-length encoding of the zero bytes in the
+        /// input to out: a sequence of (varint literal count, literal bytes,
+        /// varint zero count) groups.
+        OSVR_COMMON_EXPORT void encodeZeroRuns(uint8_t const *data,
+                                               std::size_t len,
+                                               ByteVector &out);
+
+        /// @brief Decodes the output of encodeZeroRuns()
+        /// @return false if the input was malformed or didn't decode to
+        /// exactly outLen bytes.
+        OSVR_COMMON_EXPORT bool decodeZeroRuns(uint8_t const *data,
+                                               std::size_t len, uint8_t *out,
+                                               std::size_t outLen);
+
+        /// @brief Producer-side state for one sensor's stream.
+        class Encoder {
+          public:
+            struct EncodedFrame {
+                OSVR_ImagingMetadata metadata;
+                Encoding encoding;
+                frame_id_type frameId;
+                frame_id_type baseFrameId;
+                ByteVector payload;
+            };
+
+            /// @brief Frames between forced key frames in delta mode.
+            static const frame_id_type KEYFRAME_INTERVAL = 30;
+
+            OSVR_COMMON_EXPORT Encoder();
+
+            /// @brief Encodes a frame, reusing the internal payload buffer.
+            OSVR_COMMON_EXPORT EncodedFrame const &
+            encode(OSVR_ImagingMetadata const &metadata,
+                   OSVR_ImageBufferElement const *data,
+                   StreamSettings const &settings);
+
+            /// @brief Makes the next frame a key frame (for instance, because
+            /// a client lost track of the stream).
+            void requestKeyframe() { m_keyframeRequested = true; }
+
+          private:
+            EncodedFrame m_frame;
+            ByteVector m_region;
+            ByteVector m_prev;
+            ByteVector m_delta;
+            OSVR_ImagingMetadata m_prevMetadata;
+            bool m_havePrev = false;
+            bool m_keyframeRequested = true;
+            frame_id_type m_nextFrameId = 0;
+            frame_id_type m_prevFrameId = NO_BASE_FRAME;
+            frame_id_type m_framesSinceKey = 0;
+        };
+
+        /// @brief Consumer-side state for one sensor's stream: reassembles
+        /// chunks and undoes the encoding.
+        class Decoder {
+          public:
+            struct ChunkHeader {
+                OSVR_ImagingMetadata metadata;
+                Encoding encoding;
+                frame_id_type frameId;
+                frame_id_type baseFrameId;
+                uint32_t totalBytes;
+                uint32_t offset;
+            };
+
+            enum class Result {
+                /// @brief Chunk accepted, frame not yet complete
+                Incomplete,
+                /// @brief A frame was completed: see getFrame()
+                Complete,
+                /// @brief The frame can't be decoded (missing chunks or base
+                /// frame): the producer should be asked for a key frame.
+                NeedKeyframe
+            };
+
+            OSVR_COMMON_EXPORT Decoder();
+
+            OSVR_COMMON_EXPORT Result addChunk(ChunkHeader const &header,
+                                               uint8_t const *data,
+                                               std::size_t len);
+
+            /// @brief The most recently completed frame's metadata.
+            OSVR_ImagingMetadata const &getMetadata() const {
+                return m_frameMetadata;
+            }
+
+            /// @brief The most recently completed frame's pixels.
+            ByteVector const &getFrame() const { return m_frame; }
+
+          private:
+            Result m_finishFrame(ChunkHeader const &header);
+            ByteVector m_payload;
+            ByteVector m_delta;
+            ByteVector m_frame;
+            OSVR_ImagingMetadata m_frameMetadata;
+            bool m_haveFrame = false;
+            frame_id_type m_frameId = NO_BASE_FRAME;
+            bool m_assembling = false;
+            frame_id_type m_assemblingId = 0;
+            uint32_t m_received = 0;
+        };
+    } // namespace imagestream
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ImageStreamCodec_h_GUID_6F1B2C8E_8D0A_4E57_B3A9_41C5D27E9A60
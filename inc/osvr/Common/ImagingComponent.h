@@ -33,12 +33,15 @@
 #include <osvr/Util/ImagingReportTypesC.h>
 #include <osvr/Common/IPCRingBuffer.h>
 #include <osvr/Common/ImagingComponentConfig.h>
+#include <osvr/Common/ImageStreamCodec.h>
+#include <osvr/Util/AlignedMemoryUniquePtr.h>
+#include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
 #include <vrpn_BaseClass.h>
 
 // Standard includes
-// - none
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -69,6 +72,17 @@ namespace common {
             class MessageSerialization;
             static const char *identifier();
         };
+        class ImageChunk : public MessageRegistration<ImageChunk> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+        class ImageStreamRequest
+            : public MessageRegistration<ImageStreamRequest> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
     } // namespace messages
 
     /// @brief BaseDevice component
@@ -88,6 +102,14 @@ namespace common {
         /// shared memory ring buffer.
         messages::ImagePlacedInSharedMemory imagePlacedInSharedMemory;
 
+        /// @brief Message from server to client, containing part of an
+        /// encoded frame of the network image stream of a sensor.
+        messages::ImageChunk imageChunk;
+
+        /// @brief Message from client to server, requesting (or adjusting) the
+        /// network image stream of a sensor.
+        messages::ImageStreamRequest imageStreamRequest;
+
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
         /// @brief Message from server to client, notifying of image data in process
         /// memory (assumes joint client kit)
@@ -98,13 +120,61 @@ namespace common {
             OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
             OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp);
 
+        /// @brief Gets a writable buffer, large enough for an image with the
+        /// given metadata, that will be sent on commitImageBuffer() without
+        /// being copied again: this is the next entry of the shared memory
+        /// ring buffer, where available in lock-free mode. Otherwise (where
+        /// holding an entry would hold the ring's lock until the commit) it is
+        /// a private buffer, copied from on commit.
+        ///
+        /// Acquiring again for the same sensor before committing abandons the
+        /// previously-acquired buffer. Do not call sendImageData() for the
+        /// same sensor in between acquiring and committing.
+        ///
+        /// Like sendImageData(), must be called while holding the device's
+        /// send guard, if it has one.
+        ///
+        /// @return nullptr if a buffer could not be acquired.
+        OSVR_COMMON_EXPORT OSVR_ImageBufferElement *
+        acquireImageBuffer(OSVR_ImagingMetadata const &metadata,
+                           OSVR_ChannelCount sensor);
+
+        /// @brief Sends the image previously written into the buffer from
+        /// acquireImageBuffer() for this sensor.
+        ///
+        /// @return false if there was no buffer acquired for this sensor, or
+        /// the image could not be sent.
+        OSVR_COMMON_EXPORT bool
+        commitImageBuffer(OSVR_ChannelCount sensor,
+                          OSVR_TimeValue const &timestamp);
+
+        /// @brief Abandons the buffer acquired for this sensor, if any,
+        /// without sending it: for when it can't be committed.
+        ///
+        /// Does not need the send guard.
+        OSVR_COMMON_EXPORT void releaseImageBuffer(OSVR_ChannelCount sensor);
+
         typedef std::function<void(ImageData const &,
                                    util::time::TimeValue const &)> ImageHandler;
         OSVR_COMMON_EXPORT void registerImageHandler(ImageHandler cb);
 
+        /// @brief Client side: asks the server to send frames of the sensor
+        /// over the network as a chunked, optionally downscaled, cropped, and
+        /// delta-compressed stream. Done automatically, with default
+        /// settings, if a frame can't be accessed through shared memory.
+        ///
+        /// Each client gets its own stream with its own settings. The request
+        /// is renewed periodically during update, and the server drops
+        /// streams that stop being renewed (e.g. when the client goes away).
+        OSVR_COMMON_EXPORT void requestImageStream(
+            OSVR_ChannelCount sensor,
+            imagestream::StreamSettings const &settings =
+                imagestream::StreamSettings());
+
       private:
         ImagingComponent(OSVR_ChannelCount numChan);
         virtual void m_parentSet();
+        virtual void m_update();
 
         /// @return true if we could send it.
         bool m_sendImageDataViaSharedMemory(OSVR_ImagingMetadata metadata,
@@ -132,19 +202,103 @@ namespace common {
         static int VRPN_CALLBACK
         m_handleImagePlacedInSharedMemory(void *userdata, vrpn_HANDLERPARAM p);
 
+        static int VRPN_CALLBACK
+        m_handleImageChunk(void *userdata, vrpn_HANDLERPARAM p);
+
+        static int VRPN_CALLBACK
+        m_handleImageStreamRequest(void *userdata, vrpn_HANDLERPARAM p);
+
+        /// @return true if any client has a network image stream of the
+        /// sensor, and the frame was sent on them.
+        bool m_sendImageStream(OSVR_ImagingMetadata const &metadata,
+                               OSVR_ImageBufferElement const *imageData,
+                               OSVR_ChannelCount sensor,
+                               OSVR_TimeValue const &timestamp);
+
+        void m_sendImageStreamRequest(
+            OSVR_ChannelCount sensor,
+            imagestream::StreamSettings const &settings, bool keyframeOnly);
+
+        /// @brief Sends one encoded frame as chunks of one client's stream.
+        void
+        m_sendImageStreamFrame(imagestream::Encoder::EncodedFrame const &frame,
+                               OSVR_ChannelCount sensor, uint32_t streamId,
+                               OSVR_TimeValue const &timestamp);
+
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
         static int VRPN_CALLBACK
         m_handleImagePlacedInProcessMemory(void *userdata, vrpn_HANDLERPARAM p);
 #endif
 
+        /// @brief Creates or replaces the shared memory ring buffer for the
+        /// sensor if required for the given buffer size.
+        /// @return false if there is no usable ring buffer.
+        bool m_ensureShm(OSVR_ChannelCount sensor, uint32_t imageBufferSize);
+
+        /// @brief Sends the notification that an image has been placed in the
+        /// shared memory ring buffer.
+        void m_sendSharedMemoryMessage(OSVR_ImagingMetadata const &metadata,
+                                       IPCRingBuffer::sequence_type seq,
+                                       OSVR_ChannelCount sensor,
+                                       OSVR_TimeValue const &timestamp);
+
         void m_checkFirst(OSVR_ImagingMetadata const &metadata);
         void m_growShmVecIfRequired(OSVR_ChannelCount sensor);
 
+        /// @brief An image being written in place by a device, between
+        /// acquireImageBuffer() and commitImageBuffer()
+        struct PendingFrame {
+            OSVR_ImagingMetadata metadata;
+            /// @brief Holds the ring buffer entry, if we're using shared
+            /// memory.
+            unique_ptr<IPCRingBuffer::BufferWriteProxy> shmEntry;
+            /// @brief Holds the buffer, if we aren't using shared memory.
+            util::AlignedImageBufferPtr buffer;
+        };
+
         OSVR_ChannelCount m_numSensor;
         std::vector<ImageHandler> m_cb;
         bool m_gotOne;
         /// @brief One for each sensor
         std::vector<IPCRingBufferPtr> m_shmBuf;
+        /// @brief One for each sensor
+        std::vector<PendingFrame> m_pendingFrames;
+
+        /// @brief Server-side state of one client's network image stream of
+        /// a sensor.
+        struct StreamSendState {
+            uint32_t streamId = 0;
+            /// @brief When the client last requested (or renewed) the stream.
+            util::time::TimeValue lastRequest = {0, 0};
+            imagestream::StreamSettings settings;
+            imagestream::Encoder encoder;
+        };
+        /// @brief One list for each sensor, of one stream for each client
+        /// that has requested it: server only
+        std::vector<std::vector<StreamSendState> > m_streamSenders;
+
+        /// @brief Client-side state of a sensor's network image stream.
+        struct StreamReceiveState {
+            /// @brief Once we've gotten frames via shared memory, the stream is
+            /// redundant for us.
+            bool viaSharedMemory = false;
+            bool requested = false;
+            /// @brief Once our stream's chunks arrive, the ImageRegion
+            /// messages the server still sends for other clients are
+            /// duplicates.
+            bool receivingStream = false;
+            imagestream::StreamSettings settings;
+            /// @brief When we last sent the request, to renew it in time.
+            util::time::TimeValue lastRequestSent = {0, 0};
+            bool keyframeRequested = false;
+            imagestream::frame_id_type keyframeRequestedAt = 0;
+            imagestream::Decoder decoder;
+        };
+        /// @brief One for each sensor, client only
+        std::vector<StreamReceiveState> m_streamReceivers;
+        /// @brief Identifies our streams among those of all clients: client
+        /// only
+        uint32_t m_streamId;
     };
 } // namespace common
 } // namespace osvr
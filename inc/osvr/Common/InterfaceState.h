@@ -29,27 +29,25 @@
 #include <osvr/Common/ReportTypes.h>
 #include <osvr/Common/StateType.h>
 #include <osvr/Common/ReportState.h>
+#include <osvr/Common/StateHistory.h>
 #include <osvr/Util/TimeValue.h>
 #include <osvr/Common/Tracing.h>
 #include <osvr/TypePack/TypeKeyedTuple.h>
 #include <osvr/TypePack/Quote.h>
+#include <osvr/TypePack/ForEachType.h>
 
 // Library/third-party includes
 #include <boost/optional.hpp>
 
 // Standard includes
-// - none
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
 
 namespace osvr {
 namespace common {
-    /// @brief A templated type containing state and a timestamp for known,
-    /// specialized report types.
-    template <typename ReportType> struct StateMapContents {
-        using state_type = traits::StateFromReport_t<ReportType>;
-        state_type state;
-        util::time::TimeValue timestamp;
-    };
-
     /// @brief Alias taking a report type and returning a state map
     /// value type.
     template <typename ReportType>
@@ -61,8 +59,30 @@ namespace common {
         typepack::TypeKeyedTuple<traits::ReportTypeList,
                                  typepack::quote<StateMapValueType>>;
 
+    /// @brief Alias taking a report type and returning a (possibly null)
+    /// pointer to a history of that state type.
+    template <typename ReportType>
+    using StateHistoryPtr = std::unique_ptr<StateHistory<ReportType>>;
+
+    /// @brief Data structure mapping from a report type to its state history,
+    /// allocated only when recording history is enabled and a report of that
+    /// type arrives.
+    using StateHistoryMap =
+        typepack::TypeKeyedTuple<traits::ReportTypeList,
+                                 typepack::quote<StateHistoryPtr>>;
+
     /// @brief Class to maintain state for an interface for each report (and
     /// thus state) type explicitly enumerated.
+    ///
+    /// Optionally also keeps a fixed-size history of states per report type:
+    /// see setHistoryCapacity().
+    ///
+    /// The latest states are published through a seqlock, so getState(),
+    /// hasState() and hasAnyState() may be called from any thread while
+    /// another thread sets state. They never block the writer and never
+    /// return a torn state: a reader that catches a write in progress yields
+    /// and retries. Everything else, including the history, belongs to the
+    /// thread setting state (or must be serialized with it by the caller).
     class InterfaceState {
       public:
         template <typename ReportType>
@@ -71,31 +91,110 @@ namespace common {
             StateMapContents<ReportType> c;
             c.state = reportState(report);
             c.timestamp = timestamp;
+            auto seq = m_sequence.load(std::memory_order_relaxed);
+            m_sequence.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
             typepack::get<ReportType, StateMap>(m_states) = c;
-            m_hasState = true;
+            m_sequence.store(seq + 2, std::memory_order_release);
+            if (m_historyCapacity > 0) {
+                auto &history =
+                    typepack::get<ReportType, StateHistoryMap>(m_histories);
+                if (!history) {
+                    history.reset(
+                        new StateHistory<ReportType>(m_historyCapacity));
+                }
+                history->push(c);
+            }
+        }
+
+        /// @brief Sets the number of past states to keep for each report
+        /// type, discarding any already kept. 0 (the default) disables
+        /// history, so no memory is allocated for it.
+        void setHistoryCapacity(std::size_t capacity) {
+            m_historyCapacity = capacity;
+            typepack::for_each_type<traits::ReportTypeList>(
+                HistoryResetter{m_histories});
+        }
+
+        std::size_t getHistoryCapacity() const { return m_historyCapacity; }
+
+        /// @brief Gets the history for a report type, or nullptr if no
+        /// history has been recorded for it.
+        template <typename ReportType>
+        StateHistory<ReportType> const *getHistory() const {
+            return typepack::cget<ReportType>(m_histories).get();
         }
 
         template <typename ReportType> bool hasState() const {
-            // using typepack::get;
-            return m_hasState && bool(typepack::cget<ReportType>(m_states));
+            bool present = false;
+            m_read([&] {
+                present = bool(typepack::cget<ReportType>(m_states));
+            });
+            return present;
         }
 
-        bool hasAnyState() const { return m_hasState; }
+        /// @brief Whether any state has been set: true once the first write
+        /// has completed.
+        bool hasAnyState() const {
+            return m_sequence.load(std::memory_order_acquire) >= 2;
+        }
 
+        /// @brief Gets a consistent copy of the latest state for the report
+        /// type, if any, retrying if it was updated while being read.
+        ///
+        /// @returns false (leaving the outputs unmodified) if there is no
+        /// state for the report type.
         template <typename ReportType>
-        void getState(util::time::TimeValue &timestamp,
+        bool getState(util::time::TimeValue &timestamp,
                       traits::StateFromReport_t<ReportType> &state) const {
-            if (hasState<ReportType>()) {
-                timestamp = typepack::cget<ReportType>(m_states)->timestamp;
-                state = typepack::cget<ReportType>(m_states)->state;
+            StateMapContents<ReportType> copy;
+            bool present = false;
+            m_read([&] {
+                auto const &entry = typepack::cget<ReportType>(m_states);
+                present = bool(entry);
+                if (present) {
+                    copy = *entry;
+                }
+            });
+            if (!present) {
+                return false;
             }
-            /// @todo do we fail silently or throw exception if we are asked for
-            /// state we don't have?
+            timestamp = copy.timestamp;
+            state = copy.state;
+            return true;
         }
 
       private:
+        /// @brief Seqlock read: calls f, which copies what it needs out of
+        /// m_states, until it did so without a write starting or in progress.
+        template <typename F> void m_read(F &&f) const {
+            for (;;) {
+                auto seq = m_sequence.load(std::memory_order_acquire);
+                if (seq & 1) {
+                    /// Write in progress: let the writer finish.
+                    std::this_thread::yield();
+                    continue;
+                }
+                f();
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_sequence.load(std::memory_order_relaxed) == seq) {
+                    return;
+                }
+            }
+        }
+
+        struct HistoryResetter {
+            StateHistoryMap &histories;
+            template <typename ReportType> void operator()(ReportType const &) {
+                typepack::get<ReportType, StateHistoryMap>(histories).reset();
+            }
+        };
+        /// @brief Seqlock sequence number for m_states: odd while a write is
+        /// in progress.
+        std::atomic<std::uint32_t> m_sequence{0};
         StateMap m_states;
-        bool m_hasState = false;
+        StateHistoryMap m_histories;
+        std::size_t m_historyCapacity = 0;
     };
 
 } // namespace common
@@ -33,10 +33,58 @@
 // - none
 
 // Standard includes
+#include <cstddef>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace osvr {
 namespace common {
+    /// @brief Scheduling-related settings applied to a single thread.
+    struct ThreadLatencyOptions {
+        enum class Scheduler {
+            /// Leave the thread's scheduling policy alone.
+            Default,
+            /// SCHED_FIFO real-time scheduling.
+            Fifo,
+            /// SCHED_RR real-time scheduling.
+            RoundRobin
+        };
+        Scheduler scheduler = Scheduler::Default;
+        /// @brief Real-time priority, clamped to what the scheduler allows.
+        /// Only used with a real-time scheduler.
+        int priority = 1;
+        /// @brief CPUs to pin the thread to: empty leaves affinity alone.
+        std::vector<int> cpus;
+        /// @brief Whether to drop the thread's timer slack to the minimum, so
+        /// sleeps and timed waits wake when asked rather than up to 50us
+        /// later.
+        bool minimizeTimerSlack = false;
+    };
+
+    /// @brief Settings for a LowLatency object.
+    struct LowLatencyOptions {
+        /// @brief Applied to the thread creating the LowLatency object (the
+        /// server thread), and reverted when it's destroyed. That thread
+        /// must still be running then, and should be the one destroying it:
+        /// timer slack can only be reverted from the thread itself.
+        ThreadLatencyOptions thread;
+        /// @brief Whether to lock all current and future pages of the process
+        /// into memory (mlockall), avoiding page-fault stalls.
+        bool lockMemory = false;
+        /// @brief Number of bytes of stack and heap to touch up front so they
+        /// are resident before they are needed. Only used with lockMemory,
+        /// and only done by the first LowLatency object in the process.
+        std::size_t prefaultBytes = 0;
+    };
+
+    /// @brief Human-readable descriptions of which low-latency settings were
+    /// applied and which couldn't be (and why).
+    struct LowLatencyResult {
+        std::vector<std::string> applied;
+        std::vector<std::string> failed;
+    };
+
     /// An object that sets a system for low-latency, but potentially
     /// high-CPU-usage, high power, and even lower-performance due to scheduling
     /// (see the cautions about timeBeginPeriod).
@@ -51,18 +99,44 @@ namespace common {
     /// is VR" so when milliseconds count, it might be OK. Bruce Dawson even
     /// says so :)
     /// https://randomascii.wordpress.com/2016/03/08/power-wastage-on-an-idle-laptop/#comment-20184
+    ///
+    /// On Linux, this applies whatever LowLatencyOptions are given: real-time
+    /// scheduling, CPU affinity, and minimal timer slack for the calling
+    /// thread, and locked, prefaulted memory for the process. Most of these
+    /// need privileges (CAP_SYS_NICE, CAP_IPC_LOCK, or suitable rlimits):
+    /// anything that can't be applied is listed in getResult().
     class LowLatency {
       public:
         OSVR_COMMON_EXPORT LowLatency();
+        OSVR_COMMON_EXPORT explicit LowLatency(LowLatencyOptions const &opts);
         OSVR_COMMON_EXPORT ~LowLatency();
         LowLatency(LowLatency const &) = delete;
         LowLatency &operator=(LowLatency const &) = delete;
 
+        /// @brief What was and wasn't applied on construction.
+        OSVR_COMMON_EXPORT LowLatencyResult const &getResult() const;
+
       private:
         // private implementation, if any is needed.
         struct Impl;
         std::unique_ptr<Impl> m_impl;
     };
+
+    /// @brief Applies scheduling settings to the calling thread for the rest
+    /// of its life.
+    OSVR_COMMON_EXPORT LowLatencyResult
+    applyThreadLatencyOptions(ThreadLatencyOptions const &opts);
+
+    /// @brief Sets the options that device (tracker) threads apply to
+    /// themselves with applyDeviceThreadLatencyOptions(). Only affects
+    /// threads started afterwards.
+    OSVR_COMMON_EXPORT void
+    setDeviceThreadLatencyOptions(ThreadLatencyOptions const &opts);
+
+    /// @brief To be called by a device thread when it starts: applies the
+    /// options set by setDeviceThreadLatencyOptions(), if any, logging
+    /// anything that couldn't be applied.
+    OSVR_COMMON_EXPORT void applyDeviceThreadLatencyOptions();
 } // namespace common
 } // namespace osvr
 #endif // INCLUDED_LowLatency_h_GUID_A7B15740_3824_499E_22C3_EE2B08AFC7AC
@@ -0,0 +1,116 @@
+/** @file
+    @brief Header for parsing low-latency settings from a server config file.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_LowLatencyJSON_h_GUID_4F0B7E2A_91C3_4D6E_A85B_2E7D3C1F6A94
+#define INCLUDED_LowLatencyJSON_h_GUID_4F0B7E2A_91C3_4D6E_A85B_2E7D3C1F6A94
+
+// Internal Includes
+#include <osvr/Common/LowLatency.h>
+
+// Library/third-party includes
+#include <json/value.h>
+
+// Standard includes
+#include <stdexcept>
+
+namespace osvr {
+namespace common {
+    namespace low_latency_keys {
+        static const char SERVER_THREAD_KEY[] = "serverThread";
+        static const char DEVICE_THREADS_KEY[] = "deviceThreads";
+        static const char SCHEDULER_KEY[] = "scheduler";
+        static const char PRIORITY_KEY[] = "priority";
+        static const char CPUS_KEY[] = "cpus";
+        static const char TIMER_SLACK_KEY[] = "minimizeTimerSlack";
+        static const char LOCK_MEMORY_KEY[] = "lockMemory";
+        static const char PREFAULT_KEY[] = "prefaultBytes";
+    } // namespace low_latency_keys
+
+    /// @brief Parses a thread object ("serverThread" or "deviceThreads") of
+    /// the low-latency config: missing or mistyped members keep their
+    /// defaults.
+    ///
+    /// @throws std::invalid_argument for an unknown scheduler name.
+    inline ThreadLatencyOptions
+    parseThreadLatencyOptions(Json::Value const &jsonThread) {
+        using namespace low_latency_keys;
+        using Scheduler = ThreadLatencyOptions::Scheduler;
+        ThreadLatencyOptions ret;
+        Json::Value const &jsonScheduler = jsonThread[SCHEDULER_KEY];
+        if (jsonScheduler.isString()) {
+            auto scheduler = jsonScheduler.asString();
+            if (scheduler == "fifo") {
+                ret.scheduler = Scheduler::Fifo;
+            } else if (scheduler == "rr") {
+                ret.scheduler = Scheduler::RoundRobin;
+            } else if (scheduler != "default") {
+                throw std::invalid_argument(
+                    "Invalid scheduler value: must be \"fifo\", \"rr\", or "
+                    "\"default\"");
+            }
+        }
+        Json::Value const &jsonPriority = jsonThread[PRIORITY_KEY];
+        if (jsonPriority.isInt()) {
+            ret.priority = jsonPriority.asInt();
+        }
+        for (auto const &cpu : jsonThread[CPUS_KEY]) {
+            if (cpu.isInt()) {
+                ret.cpus.push_back(cpu.asInt());
+            }
+        }
+        Json::Value const &jsonTimerSlack = jsonThread[TIMER_SLACK_KEY];
+        if (jsonTimerSlack.isBool()) {
+            ret.minimizeTimerSlack = jsonTimerSlack.asBool();
+        }
+        return ret;
+    }
+
+    /// @brief Parses the "lowLatency" object of a server config into the
+    /// options for the server, and those for device threads (see
+    /// setDeviceThreadLatencyOptions()).
+    ///
+    /// @throws std::invalid_argument for an unknown scheduler name.
+    inline LowLatencyOptions
+    parseLowLatencyOptions(Json::Value const &jsonLowLatency,
+                           ThreadLatencyOptions &deviceThreads) {
+        using namespace low_latency_keys;
+        LowLatencyOptions ret;
+        ret.thread =
+            parseThreadLatencyOptions(jsonLowLatency[SERVER_THREAD_KEY]);
+        deviceThreads =
+            parseThreadLatencyOptions(jsonLowLatency[DEVICE_THREADS_KEY]);
+        Json::Value const &jsonLockMemory = jsonLowLatency[LOCK_MEMORY_KEY];
+        if (jsonLockMemory.isBool()) {
+            ret.lockMemory = jsonLockMemory.asBool();
+        }
+        Json::Value const &jsonPrefault = jsonLowLatency[PREFAULT_KEY];
+        if (jsonPrefault.isUInt()) {
+            ret.prefaultBytes = jsonPrefault.asUInt();
+        }
+        return ret;
+    }
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_LowLatencyJSON_h_GUID_4F0B7E2A_91C3_4D6E_A85B_2E7D3C1F6A94
@@ -40,7 +40,16 @@
 namespace osvr {
 namespace common {
     class PathTreeOwner;
-    enum class PathTreeEvents : std::size_t { AboutToUpdate, AfterUpdate };
+    enum class PathTreeEvents : std::size_t {
+        /// @brief The tree is about to be entirely replaced.
+        AboutToUpdate,
+        /// @brief The tree has been entirely replaced.
+        AfterUpdate,
+        /// @brief Some nodes of the tree are about to be changed in place.
+        AboutToPatch,
+        /// @brief Some nodes of the tree have been changed in place.
+        AfterPatch
+    };
     class PathTreeObserver : public boost::noncopyable {
       public:
         using callback_argument = PathTree &;
@@ -26,12 +26,13 @@
 #define INCLUDED_PathTreeOwner_h_GUID_3B8C4AD4_90FA_4485_1388_CCFABF5EB66F
 
 // Internal Includes
-#include <osvr/Common/PathTreeObserverPtr.h>
+#include <osvr/Common/PathTreeObserver.h>
 #include <osvr/Common/PathTree.h>
 #include <osvr/Common/Export.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
 #include <json/value.h>
 
 // Standard includes
@@ -67,8 +68,35 @@ namespace common {
 
         /// @brief Replace the entirety of the path tree from the given
         /// serialized array of nodes.
+        ///
+        /// If the most recent call to applyTreeDelta() already brought the
+        /// tree up to the generation of this one, this does nothing: servers
+        /// announce the generation with a delta just ahead of the full tree.
+        /// Nor does it do anything if given the same nodes as last time, with
+        /// no deltas applied since (as from servers predating deltas, which
+        /// send the full tree every time a client connects).
         OSVR_COMMON_EXPORT void replaceTree(Json::Value const &nodes);
 
+        /// @brief Patch the path tree in place from a tree delta message
+        /// (see osvr::common::SystemComponent::treeDeltaOut).
+        ///
+        /// @returns true if the delta applied to our current tree
+        /// generation. If not, the tree is left untouched until a full tree
+        /// arrives: check takeFullTreeRequest() to see if one must be asked
+        /// for.
+        OSVR_COMMON_EXPORT bool applyTreeDelta(Json::Value const &delta);
+
+        /// @brief Returns true (once) if a delta could not be applied and no
+        /// full tree is known to be on its way, so the server should be asked
+        /// for one (see osvr::common::SystemComponent::sendTreeRequest()).
+        OSVR_COMMON_EXPORT bool takeFullTreeRequest();
+
+        /// @brief Accept a full tree from the server known to match the
+        /// current contents (e.g. a tree loaded from a cache), without
+        /// replacing it: keeps existing observers' state, while tracking the
+        /// tree generation as replaceTree() would.
+        OSVR_COMMON_EXPORT void confirmTree();
+
         /// @brief Access the path tree object itself
         PathTree &get() { return m_tree; }
 
@@ -77,8 +105,24 @@ namespace common {
 
       private:
         PathTree m_tree;
+        void m_notify(PathTreeEvents e);
         std::vector<PathTreeObserverWeakPtr> m_observers;
         bool m_valid = false;
+        /// @brief The nodes last passed to replaceTree()
+        Json::Value m_lastNodes;
+        /// @brief Set when a delta changed the tree since replaceTree()
+        bool m_patched = false;
+        /// @brief Tree generation, if known.
+        boost::optional<Json::UInt> m_generation;
+        /// @brief Generation the next full tree will have, if known.
+        boost::optional<Json::UInt> m_pendingGeneration;
+        /// @brief Set when a delta brought us up to date, so the matching
+        /// full tree can be skipped.
+        bool m_skipNextReplacement = false;
+        /// @brief Set when we need a full tree we haven't asked for yet.
+        bool m_wantFullTree = false;
+        /// @brief Set once we've asked for a full tree, until one arrives.
+        bool m_requestedFullTree = false;
     };
 } // namespace common
 } // namespace osvr
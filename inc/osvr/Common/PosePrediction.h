@@ -0,0 +1,165 @@
+/** @file
+    @brief Header providing extrapolation of pose state from the velocity and
+    acceleration state of the same interface.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PosePrediction_h_GUID_5C1E7A93_2B4D_4F08_9E6A_D38F07B2C4E1
+#define INCLUDED_PosePrediction_h_GUID_5C1E7A93_2B4D_4F08_9E6A_D38F07B2C4E1
+
+// Internal Includes
+#include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/ReportTypes.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/EigenCoreGeometry.h>
+#include <osvr/Util/EigenInterop.h>
+#include <osvr/Util/EigenQuatExponentialMap.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    /// @brief Longest interval (in seconds) we'll extrapolate a pose over:
+    /// past this, the motion model is more likely to hurt than help (e.g. a
+    /// tracker that stopped reporting).
+    static const double MAX_POSE_PREDICTION_INTERVAL = 0.1;
+
+    namespace pose_prediction {
+        /// @brief Returns the (half-angle) rotation vector of an incremental
+        /// quaternion, scaled to a rate per second.
+        inline Eigen::Vector3d
+        getRotationRate(OSVR_IncrementalQuaternion const &incRot) {
+            if (incRot.dt <= 0) {
+                return Eigen::Vector3d::Zero();
+            }
+            return util::quat_ln(util::fromQuat(incRot.incrementalRotation)) /
+                   incRot.dt;
+        }
+    } // namespace pose_prediction
+
+    /// @brief Extrapolates a room-space pose by dt seconds, given the
+    /// (room-space) velocity and, optionally, acceleration states.
+    ///
+    /// Uses a constant-acceleration model for position and treats the
+    /// angular velocity and acceleration as commuting (reasonable over the
+    /// short intervals prediction is meant for).
+    inline void predictPose(OSVR_PoseState &pose,
+                            OSVR_VelocityState const &vel,
+                            OSVR_AccelerationState const *accel, double dt) {
+        using pose_prediction::getRotationRate;
+        auto xlate = util::vecMap(pose.translation);
+        Eigen::Vector3d rot = Eigen::Vector3d::Zero();
+        if (vel.linearVelocityValid) {
+            xlate += util::vecMap(vel.linearVelocity) * dt;
+        }
+        if (vel.angularVelocityValid) {
+            rot += getRotationRate(vel.angularVelocity) * dt;
+        }
+        if (accel) {
+            auto halfDtSquared = 0.5 * dt * dt;
+            if (accel->linearAccelerationValid) {
+                xlate +=
+                    util::vecMap(accel->linearAcceleration) * halfDtSquared;
+            }
+            if (accel->angularAccelerationValid) {
+                rot += getRotationRate(accel->angularAcceleration) *
+                       halfDtSquared;
+            }
+        }
+        util::toQuat(
+            (util::quat_exp(rot) * util::fromQuat(pose.rotation)).normalized(),
+            pose.rotation);
+    }
+
+    namespace pose_prediction {
+        /// @brief Whether a velocity or acceleration state is recent enough
+        /// to extrapolate a pose with: not older than the pose report (it
+        /// would describe motion the pose already reflects), nor more than
+        /// MAX_POSE_PREDICTION_INTERVAL older than the target time.
+        inline bool isDerivativeUsable(util::time::TimeValue const &derivTime,
+                                       util::time::TimeValue const &poseTime,
+                                       util::time::TimeValue const &target) {
+            return util::time::duration(derivTime, poseTime) >= 0 &&
+                   util::time::duration(target, derivTime) <=
+                       MAX_POSE_PREDICTION_INTERVAL;
+        }
+    } // namespace pose_prediction
+
+    /// @brief Gets the pose state of an interface (or anything else with a
+    /// compatible getState() member template, such as an InterfaceState),
+    /// extrapolated to the target time using any velocity and acceleration
+    /// state it has.
+    ///
+    /// The interval is clamped to [0, MAX_POSE_PREDICTION_INTERVAL] past
+    /// the pose report: a target time before it gets the unmodified pose.
+    /// Velocity and acceleration states are only used if recent enough (see
+    /// pose_prediction::isDerivativeUsable()).
+    ///
+    /// Only reads state through getState(), so may be called while another
+    /// thread updates the interface: each state read is consistent, and the
+    /// timestamp checks reject velocity or acceleration that doesn't go with
+    /// the pose read.
+    ///
+    /// @param[out] timestamp Timestamp of the pose report used.
+    /// @returns false (leaving the outputs unmodified) if the interface has
+    /// no pose state.
+    template <typename StateSource>
+    inline bool getPoseStateAtTime(StateSource const &iface,
+                                   util::time::TimeValue const &target,
+                                   util::time::TimeValue &timestamp,
+                                   OSVR_PoseState &pose) {
+        using pose_prediction::isDerivativeUsable;
+        util::time::TimeValue poseTime;
+        OSVR_PoseState state;
+        if (!iface.template getState<OSVR_PoseReport>(poseTime, state)) {
+            return false;
+        }
+        auto dt = util::time::duration(target, poseTime);
+        if (dt > MAX_POSE_PREDICTION_INTERVAL) {
+            dt = MAX_POSE_PREDICTION_INTERVAL;
+        }
+        util::time::TimeValue velTime;
+        OSVR_VelocityState vel;
+        if (dt > 0 &&
+            iface.template getState<OSVR_VelocityReport>(velTime, vel) &&
+            isDerivativeUsable(velTime, poseTime, target)) {
+            util::time::TimeValue accelTime;
+            OSVR_AccelerationState accel;
+            auto hasAccel =
+                iface.template getState<OSVR_AccelerationReport>(accelTime,
+                                                                 accel) &&
+                isDerivativeUsable(accelTime, poseTime, target);
+            predictPose(state, vel, hasAccel ? &accel : nullptr, dt);
+        }
+        timestamp = poseTime;
+        pose = state;
+        return true;
+    }
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_PosePrediction_h_GUID_5C1E7A93_2B4D_4F08_9E6A_D38F07B2C4E1
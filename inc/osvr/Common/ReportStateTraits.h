@@ -46,6 +46,14 @@ namespace common {
         template <>
         struct KeepStateForReport<OSVR_ImagingReport> : std::false_type {};
 
+        /// @brief Don't store analog array reports as state either: they
+        /// point to channel values only valid during the callback. (Each
+        /// channel's state is still stored, from the individual analog
+        /// reports.)
+        template <>
+        struct KeepStateForReport<OSVR_AnalogArrayReport> : std::false_type {
+        };
+
     } // namespace traits
 
 } // namespace common
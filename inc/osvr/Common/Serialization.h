@@ -34,6 +34,7 @@
 #include <boost/noncopyable.hpp>
 
 // Standard includes
+#include <cstddef>
 #include <string>
 
 namespace osvr {
@@ -138,8 +139,64 @@ namespace common {
             BufferReaderType &m_reader;
         };
 
+        /// @brief Functor class used by osvr::common::getBufferSpaceRequired
+        /// to compute the size of a serialized message, alignment padding
+        /// included, without serializing it.
+        class SpaceRequirementFunctor : boost::noncopyable {
+          public:
+            /// @brief Constructor, taking the number of bytes already in the
+            /// buffer (which affects padding)
+            explicit SpaceRequirementFunctor(size_t existingBytes)
+                : m_start(existingBytes), m_bytes(existingBytes) {}
+
+            /// @brief Main function call operator method.
+            ///
+            /// @param v The value to process - in this case, to add the size
+            /// of.
+            template <typename T> void operator()(T const &v) {
+                apply<T, DefaultSerializationTag<T> >(v);
+            }
+
+            /// @brief Main function call operator method, taking a "tag type"
+            /// to specify non-default serialization-related behavior.
+            template <typename Tag, typename T>
+            void operator()(T const &v, Tag const &tag = Tag()) {
+                apply<T, Tag>(v, tag);
+            }
+
+            /// Message classes take the same path when sizing as when
+            /// serializing.
+            std::true_type isSerialize() const { return std::true_type(); }
+
+            std::false_type isDeserialize() const { return std::false_type(); }
+
+            /// @brief Gets the number of bytes the fields processed so far
+            /// would add to the buffer.
+            size_t get() const { return m_bytes - m_start; }
+
+          private:
+            template <typename T, typename Tag>
+            void apply(typename boost::call_traits<T>::param_type v,
+                       Tag const &tag = Tag()) {
+                m_bytes += getBufferSpaceRequiredRaw(m_bytes, v, tag);
+            }
+            size_t m_start;
+            size_t m_bytes;
+        };
+
     } // namespace serialization
 
+    /// @brief Computes the number of bytes that serializing a message (using
+    /// a `MessageClass`, as for osvr::common::serialize) would append to a
+    /// buffer already holding existingBytes bytes.
+    template <typename MessageClass>
+    inline size_t getBufferSpaceRequired(MessageClass &msg,
+                                         size_t existingBytes = 0) {
+        serialization::SpaceRequirementFunctor functor(existingBytes);
+        msg.processMessage(functor);
+        return functor.get();
+    }
+
     /// @brief Serializes a message into a buffer, using a `MessageClass`
     ///
     /// Your `MessageClass` class must implement a method `template<typename T>
@@ -152,8 +209,8 @@ namespace common {
     void serialize(BufferType &buf, MessageClass &msg) {
         static_assert(is_buffer<BufferType>::value,
                       "First argument must be a buffer object");
-        /// @todo add another functor to first compute message length and
-        /// reserve buffer space?
+        /// Size the buffer up front, so it grows at most once.
+        buf.reserve(buf.size() + getBufferSpaceRequired(msg, buf.size()));
         serialization::SerializeFunctor<BufferType> functor(buf);
         msg.processMessage(functor);
     }
@@ -30,6 +30,7 @@
 #include <osvr/Common/Endianness.h>
 #include <osvr/Common/SerializationTags.h>
 #include <osvr/Util/BoolC.h>
+#include <osvr/Util/QuaternionC.h>
 #include <osvr/Util/Vec2C.h>
 #include <osvr/Util/Vec3C.h>
 #include <osvr/Util/TypeSafeId.h>
@@ -364,6 +365,10 @@ namespace common {
                 deserializeRaw(reader, cVal);
                 val = (cVal == OSVR_TRUE);
             }
+            static size_t spaceRequired(size_t existingBytes,
+                                        Base::param_type, tag_type const &) {
+                return getBufferSpaceRequiredRaw(existingBytes, OSVR_CBool());
+            }
         };
         template <typename EnumType, typename IntegerType>
         struct SerializationTraits<EnumAsIntegerTag<EnumType, IntegerType>,
@@ -386,6 +391,12 @@ namespace common {
                 deserializeRaw(reader, intVal);
                 val = static_cast<EnumType>(intVal);
             }
+
+            static size_t spaceRequired(size_t existingBytes,
+                                        typename Base::param_type,
+                                        tag_type const &) {
+                return getBufferSpaceRequiredRaw(existingBytes, IntegerType());
+            }
         };
 
         /// @brief String, length-prefixed. (default)
@@ -558,6 +569,17 @@ namespace common {
             }
         };
 
+        template <>
+        struct SimpleStructSerialization<OSVR_Quaternion>
+            : SimpleStructSerializationBase {
+            template <typename F, typename T> static void apply(F &f, T &val) {
+                f(val.data[0]);
+                f(val.data[1]);
+                f(val.data[2]);
+                f(val.data[3]);
+            }
+        };
+
         template <typename Tag>
         struct SimpleStructSerialization<util::TypeSafeId<Tag>>
             : SimpleStructSerializationBase {
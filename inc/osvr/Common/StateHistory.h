@@ -0,0 +1,186 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_StateHistory_h_GUID_A4F2C8E1_6D3B_4E7A_9B15_0C7E2D8F4A63
+#define INCLUDED_StateHistory_h_GUID_A4F2C8E1_6D3B_4E7A_9B15_0C7E2D8F4A63
+
+// Internal Includes
+#include <osvr/Common/StateType.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/EigenInterop.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief A templated type containing state and a timestamp for known,
+    /// specialized report types.
+    template <typename ReportType> struct StateMapContents {
+        using state_type = traits::StateFromReport_t<ReportType>;
+        state_type state;
+        util::time::TimeValue timestamp;
+    };
+
+    /// @brief Fixed-capacity ring of the most recent timestamped states of a
+    /// single report type, oldest first.
+    ///
+    /// Storage is a single contiguous allocation made at construction, so
+    /// recording a state never allocates. Lookups by time assume states
+    /// arrive in timestamp order, as they do from a single device.
+    template <typename ReportType> class StateHistory {
+      public:
+        using value_type = StateMapContents<ReportType>;
+        using state_type = typename value_type::state_type;
+
+        explicit StateHistory(std::size_t capacity)
+            : m_entries(capacity > 0 ? capacity : 1) {}
+
+        std::size_t capacity() const { return m_entries.size(); }
+        std::size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        /// @brief Access by age: 0 is the oldest entry.
+        value_type const &operator[](std::size_t i) const {
+            return m_entries[(m_begin + i) % capacity()];
+        }
+
+        /// @brief Records a state, overwriting the oldest if full.
+        void push(value_type const &v) {
+            if (m_size < capacity()) {
+                m_entries[(m_begin + m_size) % capacity()] = v;
+                ++m_size;
+            } else {
+                m_entries[m_begin] = v;
+                m_begin = (m_begin + 1) % capacity();
+            }
+        }
+
+        /// @brief Returns the index of the first entry with a timestamp not
+        /// before the given time (size() if none).
+        std::size_t lowerBound(util::time::TimeValue const &when) const {
+            std::size_t lo = 0;
+            std::size_t hi = m_size;
+            while (lo < hi) {
+                auto mid = lo + (hi - lo) / 2;
+                if ((*this)[mid].timestamp < when) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            return lo;
+        }
+
+        /// @brief Returns the entry with the timestamp closest to the given
+        /// time, or nullptr if empty.
+        value_type const *
+        getNearest(util::time::TimeValue const &when) const {
+            if (empty()) {
+                return nullptr;
+            }
+            auto i = lowerBound(when);
+            if (i == m_size) {
+                return &(*this)[m_size - 1];
+            }
+            if (i > 0 && util::time::duration(when, (*this)[i - 1].timestamp) <
+                             util::time::duration((*this)[i].timestamp, when)) {
+                return &(*this)[i - 1];
+            }
+            return &(*this)[i];
+        }
+
+        /// @brief Finds the entries immediately before and after the given
+        /// time, which must lie within the recorded span.
+        ///
+        /// @param[out] alpha Position of the time between the two, in [0, 1].
+        /// @returns false if the time is outside the recorded span.
+        bool getBracket(util::time::TimeValue const &when,
+                        value_type const *&before, value_type const *&after,
+                        double &alpha) const {
+            auto i = lowerBound(when);
+            if (i == m_size) {
+                return false;
+            }
+            after = &(*this)[i];
+            if (!(when < after->timestamp)) {
+                /// Exact match.
+                before = after;
+                alpha = 0;
+                return true;
+            }
+            if (i == 0) {
+                return false;
+            }
+            before = &(*this)[i - 1];
+            auto span = util::time::duration(after->timestamp,
+                                              before->timestamp);
+            alpha = span > 0 ? util::time::duration(when, before->timestamp) /
+                                   span
+                             : 0;
+            return true;
+        }
+
+      private:
+        std::vector<value_type> m_entries;
+        std::size_t m_begin = 0;
+        std::size_t m_size = 0;
+    };
+
+    /// @name Interpolation of state types that have a meaningful in-between.
+    /// @{
+    inline OSVR_Vec3 interpolateState(OSVR_Vec3 const &a, OSVR_Vec3 const &b,
+                                      double alpha) {
+        OSVR_Vec3 ret;
+        util::vecMap(ret) =
+            util::vecMap(a) + (util::vecMap(b) - util::vecMap(a)) * alpha;
+        return ret;
+    }
+
+    inline OSVR_Quaternion interpolateState(OSVR_Quaternion const &a,
+                                            OSVR_Quaternion const &b,
+                                            double alpha) {
+        OSVR_Quaternion ret;
+        util::toQuat(util::fromQuat(a).slerp(alpha, util::fromQuat(b)), ret);
+        return ret;
+    }
+
+    inline OSVR_Pose3 interpolateState(OSVR_Pose3 const &a,
+                                       OSVR_Pose3 const &b, double alpha) {
+        OSVR_Pose3 ret;
+        ret.translation = interpolateState(a.translation, b.translation, alpha);
+        ret.rotation = interpolateState(a.rotation, b.rotation, alpha);
+        return ret;
+    }
+    /// @}
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_StateHistory_h_GUID_A4F2C8E1_6D3B_4E7A_9B15_0C7E2D8F4A63
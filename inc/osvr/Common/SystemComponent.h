@@ -31,12 +31,14 @@
 #include <osvr/Common/DeviceComponent.h>
 #include <osvr/Common/SerializationTags.h>
 #include <osvr/Common/PathTree_fwd.h>
+#include <osvr/Util/StdInt.h>
 
 // Library/third-party includes
 #include <json/value.h>
 
 // Standard includes
-// - none
+#include <map>
+#include <string>
 
 namespace osvr {
 namespace common {
@@ -69,6 +71,19 @@ namespace common {
             class MessageSerialization;
             static const char *identifier();
         };
+
+        class TreeDeltaFromServer
+            : public MessageRegistration<TreeDeltaFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+
+        class TreeRequestToServer
+            : public MessageRegistration<TreeRequestToServer> {
+          public:
+            static const char *identifier();
+        };
     } // namespace messages
 
     /// @brief BaseDevice component, to be used only with the "OSVR" special
@@ -110,15 +125,55 @@ namespace common {
                                    util::time::TimeValue const &)> JsonHandler;
         OSVR_COMMON_EXPORT void registerReplaceTreeHandler(JsonHandler cb);
 
+        /// @brief Sends the full path tree to clients: whenever it changes,
+        /// and for those that just connected or asked for it (see
+        /// treeRequestIn).
+        ///
+        /// Any changes since the tree last sent are sent first as a delta,
+        /// then the tree is preceded by a delta with no changes announcing
+        /// its generation: clients already at that generation can skip it,
+        /// while clients that don't support deltas just replace their tree.
         OSVR_COMMON_EXPORT void sendReplacementTree(PathTree &tree);
 
+        /// @brief Message from server, listing the nodes changed since the
+        /// previous tree generation. Also sent with no changes (`base` equal
+        /// to `generation`) immediately before a full tree.
+        ///
+        /// The payload is a JSON object with `generation` and `base` (the
+        /// generation it applies to) integers, a `set` array of nodes in the
+        /// same format as the full tree, and a `remove` array of paths.
+        messages::TreeDeltaFromServer treeDeltaOut;
+
+        OSVR_COMMON_EXPORT void registerTreeDeltaHandler(JsonHandler cb);
+
+        /// @brief Message from client, asking for the full path tree because
+        /// it got a delta it could not apply.
+        messages::TreeRequestToServer treeRequestIn;
+
+        OSVR_COMMON_EXPORT void sendTreeRequest();
+        OSVR_COMMON_EXPORT void
+        registerTreeRequestHandler(vrpn_MESSAGEHANDLER handler,
+                                   void *userdata);
+
       private:
         SystemComponent();
         virtual void m_parentSet();
+        /// @brief Sends a delta from the tree last sent to the given
+        /// serialized tree, if there are changes or `always` is set.
+        void m_sendDelta(Json::Value const &config, bool always);
         static int VRPN_CALLBACK
         m_handleReplaceTree(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK m_handleTreeDelta(void *userdata,
+                                                   vrpn_HANDLERPARAM p);
 
         std::vector<JsonHandler> m_replaceTreeHandlers;
+        std::vector<JsonHandler> m_treeDeltaHandlers;
+
+        /// @name Server-side record of the last tree sent
+        /// @{
+        uint32_t m_treeGeneration = 0;
+        std::map<std::string, Json::Value> m_sentNodes;
+        /// @}
     };
 } // namespace common
 } // namespace osvr
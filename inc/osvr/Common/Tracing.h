@@ -78,6 +78,16 @@ namespace common {
                                       std::string const &string) {
             Policy::mark((fixedString + string).c_str());
         }
+
+        /// @brief Writes the events recorded so far, from all threads, to a
+        /// Chrome trace-event format JSON file (viewable in chrome://tracing
+        /// or Perfetto). Recording continues.
+        ///
+        /// Only meaningful with the in-process backend (non-Windows): with
+        /// ETW, traces are collected by the system, so this returns false.
+        ///
+        /// @returns true if the file was written.
+        OSVR_COMMON_EXPORT bool writeTraceFile(std::string const &filename);
 #else  // OSVR_COMMON_TRACING_ENABLED ^^ // vv !OSVR_COMMON_TRACING_ENABLED
         struct MainTracePolicy {
             static TraceBeginStamp begin(const char *) { return 0; }
@@ -101,6 +111,7 @@ namespace common {
         inline void driverUpdateEnd(TraceBeginStamp) {}
         template <typename Policy>
         inline void markConcatenation(const char *, std::string const &) {}
+        inline bool writeTraceFile(std::string const &) { return false; }
 #endif // !OSVR_COMMON_TRACING_ENABLED
 
         // -- Common code between dummy implementation and real implementation
@@ -0,0 +1,143 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TrackerBatchMessage_h_GUID_A71C03E5_8D4B_4E92_B6F0_2C59E1D7A843
+#define INCLUDED_TrackerBatchMessage_h_GUID_A71C03E5_8D4B_4E92_B6F0_2C59E1D7A843
+
+// Internal Includes
+#include <osvr/Common/SerializationTraits.h>
+#include <osvr/Util/TrackerBatchEntryC.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    namespace serialization {
+        template <>
+        struct SimpleStructSerialization<OSVR_IncrementalQuaternion>
+            : SimpleStructSerializationBase {
+            template <typename F, typename T> static void apply(F &f, T &val) {
+                f(val.incrementalRotation);
+                f(val.dt);
+            }
+        };
+
+        /// Only the parts flagged as valid go on the wire: since the flags
+        /// are processed first, they're already available when
+        /// deserializing.
+        template <>
+        struct SimpleStructSerialization<OSVR_TrackerBatchEntry>
+            : SimpleStructSerializationBase {
+            template <typename F, typename T> static void apply(F &f, T &val) {
+                f(val.sensor);
+                f(val.poseValid);
+                f(val.velocity.linearVelocityValid);
+                f(val.velocity.angularVelocityValid);
+                f(val.acceleration.linearAccelerationValid);
+                f(val.acceleration.angularAccelerationValid);
+                if (val.poseValid) {
+                    f(val.pose.translation);
+                    f(val.pose.rotation);
+                }
+                if (val.velocity.linearVelocityValid) {
+                    f(val.velocity.linearVelocity);
+                }
+                if (val.velocity.angularVelocityValid) {
+                    f(val.velocity.angularVelocity);
+                }
+                if (val.acceleration.linearAccelerationValid) {
+                    f(val.acceleration.linearAcceleration);
+                }
+                if (val.acceleration.angularAccelerationValid) {
+                    f(val.acceleration.angularAcceleration);
+                }
+            }
+        };
+    } // namespace serialization
+
+    namespace messages {
+        /// @brief Tracker message carrying the data of any number of sensors
+        /// that share a timestamp, sent from the same sender as the standard
+        /// vrpn_Tracker messages, so a multi-sensor device costs one message
+        /// (and one dispatch on the client) per update instead of one per
+        /// sensor per kind of data.
+        class TrackerBatch {
+          public:
+            static const char *identifier() { return "com.osvr.tracker.batch"; }
+
+            class MessageSerialization {
+              public:
+                /// @brief Constructor for sending: the entries are not copied.
+                MessageSerialization(OSVR_TrackerBatchEntry const *entries,
+                                     std::size_t count)
+                    : m_entries(entries), m_count(count) {}
+
+                /// @brief Constructor for receiving, into a vector whose
+                /// storage may be reused from message to message.
+                explicit MessageSerialization(
+                    std::vector<OSVR_TrackerBatchEntry> &dest)
+                    : m_dest(&dest) {}
+
+                template <typename T> void processMessage(T &p) {
+                    m_process(p, p.isDeserialize());
+                }
+
+              private:
+                template <typename T>
+                void m_process(T &p, std::false_type /* isDeserialize */) {
+                    auto count = static_cast<uint32_t>(m_count);
+                    p(count);
+                    for (std::size_t i = 0; i < m_count; ++i) {
+                        p(m_entries[i]);
+                    }
+                }
+                template <typename T>
+                void m_process(T &p, std::true_type /* isDeserialize */) {
+                    uint32_t count;
+                    p(count);
+                    /// Entry by entry, so a bogus count runs out of buffer
+                    /// rather than allocating.
+                    m_dest->clear();
+                    for (uint32_t i = 0; i < count; ++i) {
+                        OSVR_TrackerBatchEntry entry = {};
+                        p(entry);
+                        m_dest->push_back(entry);
+                    }
+                }
+                OSVR_TrackerBatchEntry const *m_entries = nullptr;
+                std::size_t m_count = 0;
+                std::vector<OSVR_TrackerBatchEntry> *m_dest = nullptr;
+            };
+        };
+    } // namespace messages
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_TrackerBatchMessage_h_GUID_A71C03E5_8D4B_4E92_B6F0_2C59E1D7A843
@@ -125,6 +125,19 @@ namespace connection {
         /// handlers.
         OSVR_CONNECTION_EXPORT void triggerDescriptorHandlers();
 
+        /// @brief Set a function that wakes up whatever thread is calling
+        /// process(), should it be blocked waiting for work.
+        ///
+        /// Call before any devices are created: it is not synchronized with
+        /// wakeProcessingThread().
+        OSVR_CONNECTION_EXPORT void
+        setWakeupHandler(std::function<void()> handler);
+
+        /// @brief Ask for process() to be called again as soon as possible -
+        /// for instance, because a device thread is waiting to send. Safe to
+        /// call from any thread.
+        OSVR_CONNECTION_EXPORT void wakeProcessingThread();
+
         /// @brief Destructor
         OSVR_CONNECTION_EXPORT virtual ~Connection();
 
@@ -203,6 +216,7 @@ namespace connection {
       private:
         DeviceList m_devices;
         std::vector<std::function<void()> > m_descriptorHandlers;
+        std::function<void()> m_wakeupHandler;
         util::log::LoggerPtr m_log;
     };
 } // namespace connection
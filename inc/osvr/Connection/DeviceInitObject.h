@@ -74,6 +74,10 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     /// @brief Returns an analog interface through the pointer-pointer.
     void returnAnalogInterface(osvr::connection::AnalogServerInterface &iface);
 
+    /// @brief Send analog reports as delta-encoded messages, with values
+    /// quantized to multiples of quantum if it is greater than 0.
+    OSVR_CONNECTION_EXPORT void setAnalogDeltaEncoding(double quantum);
+
     /// @brief Set buttons: clears the boost::optional if 0 is passed.
     OSVR_CONNECTION_EXPORT void
     setButtons(OSVR_ChannelCount num,
@@ -146,6 +150,10 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     getContext();
 
     boost::optional<OSVR_ChannelCount> getAnalogs() const { return m_analogs; }
+    /// @brief Gets the analog quantum, if delta encoding was requested.
+    boost::optional<double> getAnalogDeltaEncoding() const {
+        return m_analogDeltaQuantum;
+    }
     boost::optional<OSVR_ChannelCount> getButtons() const { return m_buttons; }
     bool getTracker() const { return m_tracker; }
     osvr::connection::ServerInterfaceList const &getServerInterfaces() const {
@@ -163,6 +171,7 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     std::string m_qualifiedName;
     boost::optional<OSVR_ChannelCount> m_analogs;
     osvr::connection::AnalogServerInterface **m_analogIface;
+    boost::optional<double> m_analogDeltaQuantum;
     boost::optional<OSVR_ChannelCount> m_buttons;
     osvr::connection::ButtonServerInterface **m_buttonIface;
     bool m_tracker;
@@ -33,7 +33,8 @@
 #include <boost/assert.hpp>
 
 // Standard includes
-// - none
+#include <cstring>
+#include <type_traits>
 
 namespace osvr {
 namespace connection {
@@ -50,7 +51,54 @@ namespace connection {
             return m_token->getSendGuard();
         }
 
+        /// @brief For a queued async device, hands a copy of the report to
+        /// the server main thread, which calls send(target, report,
+        /// timestamp), and returns true without waiting.
+        ///
+        /// Returns false if the report wasn't queued (other kinds of device,
+        /// too large, or queue full): call send yourself under the send
+        /// guard. Report must be trivially copyable and small enough for a
+        /// queue slot, which is checked at compile time.
+        template <typename Target, typename Report>
+        bool queueSend(Target &target, Report const &report,
+                       util::time::TimeValue const &timestamp,
+                       void (*send)(Target &, Report const &,
+                                    util::time::TimeValue const &)) {
+            typedef QueuedReport<Target, Report> Queued;
+            static_assert(std::is_trivially_copyable<Report>::value,
+                          "Queued reports are copied as bytes, so must be "
+                          "trivially copyable.");
+            static_assert(sizeof(Queued) <= MAX_QUEUED_SEND_PAYLOAD,
+                          "Report too large to ever fit in the async report "
+                          "queue: send it under the send guard instead.");
+            BOOST_ASSERT_MSG(m_token != nullptr, "Can't queue a report "
+                                                 "before we've been supplied "
+                                                 "with a device token!");
+            Queued queued;
+            queued.send = send;
+            queued.report = report;
+            return m_token->queueSend(&Queued::call, &target, timestamp,
+                                      reinterpret_cast<const char *>(&queued),
+                                      sizeof(queued));
+        }
+
       private:
+        /// @brief The payload of a queued report: the report and the
+        /// function to send it with.
+        template <typename Target, typename Report> struct QueuedReport {
+            void (*send)(Target &, Report const &,
+                         util::time::TimeValue const &);
+            Report report;
+
+            static void call(void *target,
+                             util::time::TimeValue const &timestamp,
+                             const char *payload, size_t) {
+                QueuedReport queued;
+                std::memcpy(&queued, payload, sizeof(queued));
+                queued.send(*static_cast<Target *>(target), queued.report,
+                            timestamp);
+            }
+        };
         DeviceToken *m_token = nullptr;
     };
 } // namespace connection
@@ -42,12 +42,23 @@
 #include <boost/noncopyable.hpp>
 
 // Standard includes
+#include <cstddef>
 #include <string>
 #include <functional>
 
 namespace osvr {
 namespace connection {
     typedef std::function<OSVR_ReturnCode()> DeviceUpdateCallback;
+
+    /// @brief Function called on the server main thread to send a report
+    /// queued by a device thread with OSVR_DeviceTokenObject::queueSend()
+    typedef void (*QueuedSendFunction)(
+        void *target, util::time::TimeValue const &timestamp,
+        const char *payload, size_t len);
+
+    /// @brief Largest payload (in bytes) that
+    /// OSVR_DeviceTokenObject::queueSend() can queue.
+    static const std::size_t MAX_QUEUED_SEND_PAYLOAD = 224;
 } // namespace connection
 } // namespace osvr
 
@@ -62,6 +73,11 @@ struct OSVR_DeviceTokenObject : boost::noncopyable {
     /// thread of its own (managed by OSVR)
     OSVR_CONNECTION_EXPORT static osvr::connection::DeviceTokenPtr
     createAsyncDevice(osvr::connection::DeviceInitObject &init);
+    /// @brief Like createAsyncDevice(), but data sent from the device thread
+    /// is queued for the main thread (lock-free, without waiting) rather
+    /// than sent under a blocking handshake with it.
+    OSVR_CONNECTION_EXPORT static osvr::connection::DeviceTokenPtr
+    createQueuedAsyncDevice(osvr::connection::DeviceInitObject &init);
     /// @brief Creates a device token (and underlying ConnectionDevice) that
     /// has an update method that runs in the server mainloop.
     OSVR_CONNECTION_EXPORT static osvr::connection::DeviceTokenPtr
@@ -114,6 +130,17 @@ struct OSVR_DeviceTokenObject : boost::noncopyable {
 
     OSVR_CONNECTION_EXPORT osvr::util::GuardPtr getSendGuard();
 
+    /// @brief For a queued async device: copies the payload into the report
+    /// queue, to be sent from the main thread by calling f(target, timestamp,
+    /// payload, len), and returns true without waiting.
+    ///
+    /// Returns false for other kinds of devices, or if the payload is too
+    /// large or the queue full: send under the send guard instead.
+    OSVR_CONNECTION_EXPORT bool
+    queueSend(osvr::connection::QueuedSendFunction f, void *target,
+              osvr::util::time::TimeValue const &timestamp,
+              const char *payload, size_t len);
+
     /// @brief Interact with connection. Only legal to end up in
     /// ConnectionDevice::sendData from within here somehow.
     void connectionInteract();
@@ -147,6 +174,11 @@ struct OSVR_DeviceTokenObject : boost::noncopyable {
                             osvr::connection::MessageType *type,
                             const char *bytestream, size_t len) = 0;
     virtual osvr::util::GuardPtr m_getSendGuard() = 0;
+    /// @brief Default implementation: nothing is queued.
+    virtual bool m_queueSend(osvr::connection::QueuedSendFunction f,
+                             void *target,
+                             osvr::util::time::TimeValue const &timestamp,
+                             const char *payload, size_t len);
     virtual void m_connectionInteract() = 0;
     virtual void m_stopThreads();
 
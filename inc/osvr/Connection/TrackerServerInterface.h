@@ -29,12 +29,13 @@
 #include <osvr/Util/ChannelCountC.h>
 #include <osvr/Util/TimeValue.h>
 #include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TrackerBatchEntryC.h>
 
 // Library/third-party includes
 // - none
 
 // Standard includes
-// - none
+#include <cstddef>
 
 namespace osvr {
 namespace connection {
@@ -79,6 +80,13 @@ namespace connection {
         sendAccelReport(OSVR_AngularAccelerationState const &val,
                         OSVR_ChannelCount sensor,
                         util::time::TimeValue const &timestamp) = 0;
+
+        /// @brief Sends the data of several sensors, sharing a timestamp, as
+        /// a single message.
+        virtual void
+        sendBatchReport(OSVR_TrackerBatchEntry const *entries,
+                        std::size_t count,
+                        util::time::TimeValue const &timestamp) = 0;
     };
 
 } // namespace connection
@@ -39,8 +39,10 @@
 #include <boost/noncopyable.hpp>
 
 // Standard includes
+#include <functional>
 #include <string>
 #include <map>
+#include <vector>
 
 namespace osvr {
 /// @brief PluginHost functionality: loading, hosting, registering, destroying,
@@ -76,6 +78,16 @@ namespace pluginhost {
         /// @brief Trigger any registered hardware detect callbacks.
         OSVR_PLUGINHOST_EXPORT void triggerHardwareDetect();
 
+        /// @brief A call of one registered hardware detect callback.
+        typedef std::function<void()> HardwareDetectCall;
+
+        /// @brief Get a call for each registered hardware detect callback, so
+        /// they can be made one at a time (for instance, letting other work
+        /// happen in between). Only valid as long as this context and its
+        /// plugins are.
+        OSVR_PLUGINHOST_EXPORT std::vector<HardwareDetectCall>
+        getHardwareDetectCalls();
+
         /// @brief Call a driver instantiation callback for the given plugin
         /// name and driver name.
         /// @throws std::runtime_error if the plugin named hasn't been loaded,
@@ -70,6 +70,22 @@ osvrDeviceAnalogConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
                           OSVR_IN OSVR_ChannelCount numChan)
     OSVR_FUNC_NONNULL((1, 2));
 
+/** @brief Request that your device's analog reports be sent as delta-encoded
+    messages, carrying only the channels that changed, instead of standard
+    analog reports carrying every channel. Worthwhile for devices with many
+    channels, few of which change from one report to the next. Clients older
+    than this option won't see these reports.
+
+    @param opts The device init options object.
+    @param quantum If greater than 0, values are sent rounded to multiples of
+   this, and changes smaller than it are not sent. Otherwise, values are sent
+   exactly.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceAnalogConfigureDeltaEncoding(
+    OSVR_INOUT_PTR OSVR_DeviceInitOptions opts, OSVR_IN double quantum)
+    OSVR_FUNC_NONNULL((1));
+
 /** @brief Report the value of a single channel.
 */
 OSVR_PLUGINKIT_EXPORT
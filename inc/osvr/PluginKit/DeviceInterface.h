@@ -161,6 +161,35 @@ namespace pluginkit {
             initAsync(ctx, name.c_str(), options);
         }
 
+        /// @brief Initialize this device token as asynchronous with queued
+        /// reports, with the given name and options.
+        ///
+        /// @sa osvrDeviceQueuedAsyncInitWithOptions
+        void initQueuedAsync(OSVR_IN_PTR OSVR_PluginRegContext ctx,
+                             OSVR_IN_STRZ const char *name,
+                             OSVR_IN_OPT OSVR_DeviceInitOptions options = NULL) {
+            if (!options) {
+                options = osvrDeviceCreateInitOptions(ctx);
+            }
+            OSVR_ReturnCode ret =
+                osvrDeviceQueuedAsyncInitWithOptions(ctx, name, options, &m_dev);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not initialize device token: " +
+                                         std::string(name));
+            }
+        }
+
+        /// @overload
+        void initQueuedAsync(OSVR_IN_PTR OSVR_PluginRegContext ctx,
+                             OSVR_IN std::string const &name,
+                             OSVR_IN_OPT OSVR_DeviceInitOptions options = NULL) {
+            if (name.empty()) {
+                throw std::runtime_error("Could not initialize device token "
+                                         "with an empty name field!");
+            }
+            initQueuedAsync(ctx, name.c_str(), options);
+        }
+
         /// @brief Send a message on a registered interface type, providing the
         /// timestamp yourself
         ///
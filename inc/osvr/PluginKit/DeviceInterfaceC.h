@@ -245,6 +245,33 @@ osvrDeviceAsyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext ctx,
                                OSVR_OUT_PTR OSVR_DeviceToken *device)
     OSVR_FUNC_NONNULL((1, 2, 3, 4));
 
+/** @copydoc osvrDeviceAsyncInitWithOptions
+    @brief Initialize an asynchronous device token whose reports are queued.
+
+    Data sent through osvrDeviceSendData/osvrDeviceSendTimestampedData, and
+    reports sent through the tracker, analog, and button interfaces, are
+    placed in a bounded lock-free queue, drained by the server on its next
+    loop, rather than making your thread wait for the server loop before
+    each report. This suits high-rate devices.
+
+    Reports from all other interfaces (imaging, eye tracker, direction,
+    location 2D, locomotion, etc.), reports larger than a few hundred bytes
+    (including analog reports of more than 24 channels and button reports of
+    more than 128), and reports sent while the queue is full still wait for
+    the server loop as with osvrDeviceAsyncInitWithOptions. Nothing is
+    dropped, and the order of reports is kept.
+
+    In queued mode, osvrDeviceAnalogSetValue and osvrDeviceButtonSetValue
+    can't report an out-of-range channel: they return success and the report
+    is ignored when sent.
+*/
+OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
+osvrDeviceQueuedAsyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext ctx,
+                                     OSVR_IN_STRZ const char *name,
+                                     OSVR_IN_PTR OSVR_DeviceInitOptions options,
+                                     OSVR_OUT_PTR OSVR_DeviceToken *device)
+    OSVR_FUNC_NONNULL((1, 2, 3, 4));
+
 /** @} */
 
 /** @brief Request a thread sleep for at least the given number of microseconds.
@@ -115,32 +115,74 @@ namespace pluginkit {
         /// osvr::pluginkit::DeviceToken::send()
         void send(DeviceToken &dev, ImagingMessage const &message,
                   OSVR_TimeValue const &timestamp) {
+            m_requireInit();
+            cv::Mat const &frame(message.getFrame());
+            OSVR_ImagingMetadata metadata =
+                m_makeMetadata(frame.rows, frame.cols, frame.type());
+
+            OSVR_ReturnCode ret = osvrDeviceImagingReportFrame(
+                dev, m_iface, metadata, message.getBuf(), message.getSensor(),
+                &timestamp);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not send imaging message!");
+            }
+        }
+
+        /// @brief Gets a cv::Mat wrapping a writable buffer for the next frame
+        /// of the given sensor, typically an entry in the shared memory
+        /// ring buffer: decode or convert your frame directly into it (rather
+        /// than constructing an ImagingMessage, which copies), then call
+        /// commitFrame().
+        ///
+        /// The returned matrix does not own its data, which is only valid
+        /// until commitFrame() or the next acquireFrame() for that sensor.
+        cv::Mat acquireFrame(DeviceToken &dev, int rows, int cols, int type,
+                             OSVR_ChannelCount sensor = 0) {
+            m_requireInit();
+            OSVR_ImageBufferElement *buf = NULL;
+            OSVR_ReturnCode ret = osvrDeviceImagingAcquireFrameBuffer(
+                dev, m_iface, m_makeMetadata(rows, cols, type), sensor, &buf);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not acquire imaging buffer!");
+            }
+            return cv::Mat(rows, cols, type, buf);
+        }
+
+        /// @brief Sends the frame written into the matrix returned by the
+        /// most recent acquireFrame() for the given sensor.
+        void commitFrame(DeviceToken &dev, OSVR_TimeValue const &timestamp,
+                         OSVR_ChannelCount sensor = 0) {
+            m_requireInit();
+            OSVR_ReturnCode ret =
+                osvrDeviceImagingCommitFrame(dev, m_iface, sensor, &timestamp);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not send imaging message!");
+            }
+        }
+
+      private:
+        void m_requireInit() const {
             if (!m_iface) {
                 throw std::logic_error(
                     "Must initialize the imaging interface before using it!");
             }
-            cv::Mat const &frame(message.getFrame());
-            util::NumberTypeData typedata =
-                util::opencvNumberTypeData(frame.type());
+        }
+
+        static OSVR_ImagingMetadata m_makeMetadata(int rows, int cols,
+                                                   int type) {
+            util::NumberTypeData typedata = util::opencvNumberTypeData(type);
             OSVR_ImagingMetadata metadata;
-            metadata.channels = frame.channels();
+            metadata.channels = CV_MAT_CN(type);
             metadata.depth = static_cast<OSVR_ImageDepth>(typedata.getSize());
-            metadata.width = frame.cols;
-            metadata.height = frame.rows;
+            metadata.width = cols;
+            metadata.height = rows;
             metadata.type = typedata.isFloatingPoint()
                                 ? OSVR_IVT_FLOATING_POINT
                                 : (typedata.isSigned() ? OSVR_IVT_SIGNED_INT
                                                        : OSVR_IVT_UNSIGNED_INT);
-
-            OSVR_ReturnCode ret = osvrDeviceImagingReportFrame(
-                dev, m_iface, metadata, message.getBuf(), message.getSensor(),
-                &timestamp);
-            if (OSVR_RETURN_SUCCESS != ret) {
-                throw std::runtime_error("Could not send imaging message!");
-            }
+            return metadata;
         }
 
-      private:
         OSVR_ImagingDeviceInterface m_iface;
     };
     /// @}
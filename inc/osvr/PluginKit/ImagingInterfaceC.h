@@ -96,6 +96,54 @@ osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
                              OSVR_IN OSVR_ChannelCount sensor,
                              OSVR_IN_PTR OSVR_TimeValue const *timestamp)
     OSVR_FUNC_NONNULL((1, 2, 4, 6));
+
+/** @brief Get a writable buffer for the next frame for a sensor, so the image
+    can be decoded or converted directly into the memory that will be shared
+    with clients, instead of being copied there by
+    osvrDeviceImagingReportFrame(). Follow with a call to
+    osvrDeviceImagingCommitFrame() once the frame has been written.
+
+    The buffer remains owned by the imaging interface, and is only valid until
+    the matching commit, or the next acquire for the same sensor (which
+    abandons the first).
+
+    The buffer is written in place only where the shared memory is in
+    lock-free mode; otherwise it is copied from on commit, as with
+    osvrDeviceImagingReportFrame().
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param metadata Metadata of the image that will be written to the buffer:
+    determines the buffer size.
+    @param sensor Sensor number, usually 0
+    @param [out] buffer Pointer to the writable buffer, aligned to at least
+    OSVR_DEFAULT_ALIGN_SIZE.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceImagingAcquireFrameBuffer(
+    OSVR_IN_PTR OSVR_DeviceToken dev,
+    OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ImagingMetadata metadata, OSVR_IN OSVR_ChannelCount sensor,
+    OSVR_OUT_PTR OSVR_ImageBufferElement **buffer)
+    OSVR_FUNC_NONNULL((1, 2, 5));
+
+/** @brief Report the frame written into the buffer most recently acquired for
+    a sensor by osvrDeviceImagingAcquireFrameBuffer().
+
+    The buffer is released whether or not this succeeds.
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param sensor Sensor number, usually 0
+    @param timestamp Timestamp correlating to frame.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceImagingCommitFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
+                             OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                             OSVR_IN OSVR_ChannelCount sensor,
+                             OSVR_IN_PTR OSVR_TimeValue const *timestamp)
+    OSVR_FUNC_NONNULL((1, 2, 4));
 /** @} */ /* end of group */
 
 OSVR_EXTERN_C_END
@@ -33,6 +33,7 @@
 #include <osvr/PluginKit/DeviceInterfaceC.h>
 #include <osvr/Util/ClientReportTypesC.h>
 #include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/TrackerBatchEntryC.h>
 
 /* Library/third-party includes */
 /* none */
@@ -205,6 +206,23 @@ OSVR_ReturnCode osvrDeviceTrackerSendAngularAccelerationTimestamped(
     OSVR_IN_PTR OSVR_TimeValue const *timestamp)
     OSVR_FUNC_NONNULL((1, 2, 3, 5));
 
+/** @brief Report the data of several sensors, all using the supplied
+   timestamp, as a single message: cheaper than individual reports for devices
+   that update many sensors at once.
+
+   @param entries Array of one entry per sensor: only the parts of each entry
+   flagged as valid are sent.
+   @param count Number of entries.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceTrackerSendBatchTimestamped(
+    OSVR_IN_PTR OSVR_DeviceToken dev,
+    OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN_READS(count) OSVR_TrackerBatchEntry const *entries,
+    OSVR_IN OSVR_ChannelCount count,
+    OSVR_IN_PTR OSVR_TimeValue const *timestamp)
+    OSVR_FUNC_NONNULL((1, 2, 5));
+
 /** @} */ /* end of group */
 
 OSVR_EXTERN_C_END
@@ -29,6 +29,7 @@
 #include <osvr/Server/Export.h>
 #include <osvr/Server/ServerPtr.h>
 #include <osvr/Connection/ConnectionPtr.h>
+#include <osvr/Common/LowLatency.h>
 #include <osvr/Common/PathElementTypes_fwd.h>
 #include <osvr/Util/UniquePtr.h>
 
@@ -158,10 +159,24 @@ namespace server {
         /// @brief Adds the behavior that hardware detection should take place
         /// on client connection.
         ///
+        /// Connections close together (several clients starting at once, or
+        /// one reconnecting repeatedly) share a single detection. Where device
+        /// hotplug can be watched, this is the same as
+        /// setHardwareDetectOnHotplug() instead: client connections don't
+        /// trigger detection at all.
+        ///
         /// Safe to call from any thread, even when server is running, though it
         /// makes the most sense as a startup option.
         OSVR_SERVER_EXPORT void setHardwareDetectOnConnection();
 
+        /// @brief Adds the behavior that hardware detection should take place
+        /// when devices are plugged in, where that can be watched (Linux):
+        /// elsewhere, this does nothing.
+        ///
+        /// Safe to call from any thread, even when server is running, though it
+        /// makes the most sense as a startup option.
+        OSVR_SERVER_EXPORT void setHardwareDetectOnHotplug();
+
         /// @brief Instantiate the named driver with parameters.
         /// @param plugin The name of a plugin.
         /// @param driver The name of a driver registered by the plugin for
@@ -176,6 +191,10 @@ namespace server {
 
         /// @brief Run all hardware detect callbacks.
         ///
+        /// Once the server is started in its own thread, the callbacks run
+        /// in a separate thread, one at a time, each excluding the main loop
+        /// while it runs: so the main loop keeps going between them.
+        ///
         /// Safe to call from any thread, even when server is running.
         OSVR_SERVER_EXPORT void triggerHardwareDetect();
 
@@ -242,6 +261,31 @@ namespace server {
         /// Call only before starting the server or from within server thread.
         OSVR_SERVER_EXPORT void setSleepTime(int microseconds);
 
+        /// @brief Sets whether the server loop should block until there is
+        /// work to do (an asynchronous device sending data, a call from
+        /// another thread, or on Linux, a client message) instead of always
+        /// sleeping for the sleep time. In this mode the sleep time (or 1ms,
+        /// if it is 0) is only the longest the loop waits before polling
+        /// synchronous devices again.
+        ///
+        /// Call only before starting the server.
+        OSVR_SERVER_EXPORT void setEventDriven(bool eventDriven);
+
+        /// @brief Sets the low-latency settings applied to the server thread
+        /// (and process) while clients are connected. Any settings that can't
+        /// be applied are logged.
+        ///
+        /// Call only before starting the server.
+        OSVR_SERVER_EXPORT void
+        setLowLatencyOptions(common::LowLatencyOptions const &opts);
+
+        /// @brief Wakes up the server loop if it is waiting, in event-driven
+        /// mode - for instance, when something a mainloop method services is
+        /// ready.
+        ///
+        /// Safe to call from any thread, even when server is running.
+        OSVR_SERVER_EXPORT void wakeMainloop();
+
 #if 0
         /// @brief Returns the amount of time (in microseconds) that the server
         /// loop sleeps each loop.
@@ -237,6 +237,24 @@ typedef struct OSVR_AnalogReport {
     OSVR_AnalogState state;
 } OSVR_AnalogReport;
 
+/** @brief Type of a span of consecutive analog channel values */
+typedef struct OSVR_AnalogArrayState {
+    /** @brief Number of channels in the span */
+    OSVR_ChannelCount numChannels;
+    /** @brief The channel values: only valid for the duration of the
+        callback. */
+    const OSVR_AnalogState *values;
+} OSVR_AnalogArrayState;
+
+/** @brief Report type for a callback on an analog interface delivering a
+    span of channels at once. */
+typedef struct OSVR_AnalogArrayReport {
+    /** @brief Identifies the first sensor/channel in the span */
+    int32_t sensor;
+    /** @brief The channel values, starting with that of sensor. */
+    OSVR_AnalogArrayState state;
+} OSVR_AnalogArrayReport;
+
 /** @brief Type of location within a 2D region/surface, in normalized
     coordinates (in range [0, 1] in standard OSVR coordinate system)
 */
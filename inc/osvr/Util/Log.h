@@ -87,6 +87,11 @@ namespace util {
         /// all logger sinks.
         OSVR_UTIL_EXPORT void flush();
 
+        /// @brief For implementations with a centralized logger registry, set
+        /// whether the console and log files are written by background threads
+        /// (the default) rather than by the thread logging.
+        OSVR_UTIL_EXPORT void setAsyncLogging(bool enable);
+
         OSVR_UTIL_EXPORT std::string getLoggingDirectory(bool make_dir = false);
 
     } // end namespace log
@@ -0,0 +1,100 @@
+/** @file
+    @brief Header providing a per-call-site rate limit for log messages that
+    might otherwise be emitted every frame or every report.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_LogRateLimiter_h_GUID_3E5A9C27_B1D4_4F60_8A73_C92E06D5B1F4
+#define INCLUDED_LogRateLimiter_h_GUID_3E5A9C27_B1D4_4F60_8A73_C92E06D5B1F4
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+
+namespace osvr {
+namespace util {
+    namespace log {
+        /// @brief Lets a log call site through at most once per interval,
+        /// keeping count of the messages it held back. Thread-safe and
+        /// lock-free, so it can be shared by every thread reaching the call
+        /// site.
+        ///
+        /// Typical usage, with a function-local static so each call site has
+        /// its own limit:
+        ///
+        /// ~~~{.cpp}
+        /// static util::log::LogRateLimiter limiter{std::chrono::seconds(1)};
+        /// if (limiter.allow()) {
+        ///     logger->warn() << "Something happened again ("
+        ///                    << limiter.takeSuppressedCount()
+        ///                    << " similar messages suppressed)";
+        /// }
+        /// ~~~
+        class LogRateLimiter {
+          public:
+            typedef std::chrono::steady_clock clock;
+
+            explicit LogRateLimiter(clock::duration interval)
+                : m_interval(interval.count()) {}
+
+            LogRateLimiter(LogRateLimiter const &) = delete;
+            LogRateLimiter &operator=(LogRateLimiter const &) = delete;
+
+            /// @brief Returns true if the message should be logged now;
+            /// otherwise, counts it as suppressed.
+            bool allow() {
+                auto now = clock::now().time_since_epoch().count();
+                auto next = m_next.load(std::memory_order_relaxed);
+                if (now >= next &&
+                    m_next.compare_exchange_strong(
+                        next, now + m_interval, std::memory_order_relaxed)) {
+                    return true;
+                }
+                m_suppressed.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            /// @brief Gets the number of messages suppressed since the last
+            /// call, resetting it.
+            std::size_t takeSuppressedCount() {
+                return m_suppressed.exchange(0, std::memory_order_relaxed);
+            }
+
+          private:
+            typedef clock::duration::rep rep;
+            const rep m_interval;
+            std::atomic<rep> m_next{std::numeric_limits<rep>::min()};
+            std::atomic<std::size_t> m_suppressed{0};
+        };
+    } // namespace log
+} // namespace util
+} // namespace osvr
+
+#endif // INCLUDED_LogRateLimiter_h_GUID_3E5A9C27_B1D4_4F60_8A73_C92E06D5B1F4
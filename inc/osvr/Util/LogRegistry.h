@@ -54,6 +54,7 @@ namespace osvr {
 namespace util {
     namespace log {
         class filter_sink;
+        class async_sink;
 
         class LogRegistry {
           public:
@@ -114,6 +115,13 @@ namespace util {
              */
             void setConsoleLevel(LogLevel severity);
 
+            /**
+             * @brief Sets whether console and log file output is written by a
+             * background thread (the default), instead of by the thread
+             * logging.
+             */
+            void setAsync(bool async);
+
             std::string const &getLogFileBaseName() const {
                 return logFileBaseName_;
             }
@@ -127,12 +135,18 @@ namespace util {
           private:
             void setLevelImpl(LogLevel severity);
             void setConsoleLevelImpl(LogLevel severity);
+            /// The lowest level that any of our sinks will write.
+            LogLevel getEffectiveLevel() const;
+            /// Sets the level of the registered loggers to that level.
+            void applyEffectiveLevel();
             void createFileSink();
             LogLevel minLevel_;
             LogLevel consoleLevel_;
 
             std::vector<spdlog::sink_ptr> sinks_;
             std::shared_ptr<filter_sink> console_filter_;
+            std::shared_ptr<async_sink> console_sink_;
+            std::shared_ptr<async_sink> file_sink_;
             LoggerPtr consoleOnlyLog_;
             LoggerPtr generalLog_;
             Logger *generalPurposeLog_ = nullptr;
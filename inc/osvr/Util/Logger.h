@@ -38,9 +38,11 @@
 
 // Standard includes
 #include <initializer_list>
-#include <memory>  // for std::shared_ptr
-#include <sstream> // for std::ostringstream
-#include <string>  // for std::string
+#include <memory>      // for std::shared_ptr
+#include <new>         // for placement new
+#include <sstream>     // for std::ostringstream
+#include <string>      // for std::string
+#include <type_traits> // for std::aligned_storage
 
 // Forward declarations
 
@@ -120,53 +122,109 @@ namespace util {
             /// Set the log level at which this logger will trigger a flush.
             OSVR_UTIL_EXPORT void flushOn(LogLevel level);
 
+            /// Whether a message at the given level would be forwarded on to
+            /// the sinks, rather than filtered out.
+            ///
+            /// Loggers from the LogRegistry have their level kept at the
+            /// lowest level any of the registry's sinks will write, so this
+            /// is false for messages that no sink would output.
+            OSVR_UTIL_EXPORT bool shouldLog(LogLevel level) const;
+
             /// An object returned the logging functions (including operator<<),
             /// serves to accumulate streamed output in a single ostringstream
             /// then write it to the logger at the end of the expression's
             /// lifetime.
+            ///
+            /// If the logger's level filters out the message, nothing is
+            /// allocated or written: the first value streamed in is skipped,
+            /// and the rest go to a stream with no buffer, which doesn't
+            /// format them.
             class StreamProxy {
               public:
                 StreamProxy(Logger &logger, LogLevel level)
                     : logger_(logger), level_(level),
-                      os_(new std::ostringstream) {}
+                      enabled_(logger.shouldLog(level)) {
+                    if (enabled_) {
+                        os_.reset(new std::ostringstream);
+                    }
+                }
 
                 StreamProxy(Logger &logger, LogLevel level,
                             const std::string &msg)
-                    : logger_(logger), level_(level),
-                      os_(new std::ostringstream) {
-                    (*os_) << msg;
+                    : StreamProxy(logger, level) {
+                    if (os_) {
+                        (*os_) << msg;
+                    }
                 }
 
                 /// destructor appends the finished stringstream at the end
                 /// of the expression.
                 ~StreamProxy() {
-                    if (active_ && os_) {
+                    if (active_ && enabled_ && os_) {
                         logger_.write(level_, os_->str().c_str());
                     }
+                    if (nullStream_) {
+                        nullStream_->~NullStream();
+                    }
                 }
 
                 /// move construction
                 StreamProxy(StreamProxy &&other)
                     : logger_(other.logger_), level_(other.level_),
-                      os_(std::move(other.os_)), active_(other.active_) {
+                      os_(std::move(other.os_)), active_(other.active_),
+                      enabled_(other.enabled_) {
                     other.active_ = false;
                 }
 
                 StreamProxy(StreamProxy const &) = delete;
                 StreamProxy &operator=(StreamProxy const &) = delete;
 
-                operator std::ostream &() { return (*os_); }
+                operator std::ostream &() { return stream(); }
 
                 template <typename T> std::ostream &operator<<(T &&what) {
-                    (*os_) << std::forward<T>(what);
-                    return (*os_);
+                    if (enabled_) {
+                        (*os_) << std::forward<T>(what);
+                    }
+                    return stream();
+                }
+
+                /// @name Manipulators (like std::endl)
+                /// @{
+                std::ostream &
+                operator<<(std::ostream &(*manip)(std::ostream &)) {
+                    return stream() << manip;
+                }
+                std::ostream &
+                operator<<(std::ios_base &(*manip)(std::ios_base &)) {
+                    return stream() << manip;
                 }
+                /// @}
 
               private:
+                typedef std::ostream NullStream;
+
+                /// The stream output goes to: for a filtered-out message, one
+                /// with no buffer, constructed in place the first time it's
+                /// needed.
+                std::ostream &stream() {
+                    if (enabled_) {
+                        return *os_;
+                    }
+                    if (!nullStream_) {
+                        nullStream_ = new (&nullStorage_) NullStream(nullptr);
+                    }
+                    return *nullStream_;
+                }
+
                 Logger &logger_;
                 LogLevel level_;
                 std::unique_ptr<std::ostringstream> os_;
                 bool active_ = true;
+                bool enabled_;
+                NullStream *nullStream_ = nullptr;
+                std::aligned_storage<
+                    sizeof(NullStream),
+                    std::alignment_of<NullStream>::value>::type nullStorage_;
             };
 
             /// @name logger->info(msg) (with optional << "more message") call
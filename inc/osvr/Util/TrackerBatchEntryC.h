@@ -0,0 +1,71 @@
+/** @file
+    @brief Header
+
+    Must be c-safe!
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+/*
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#ifndef INCLUDED_TrackerBatchEntryC_h_GUID_4B8E2D17_C3A9_4F60_9E15_7A2D0C6F38B4
+#define INCLUDED_TrackerBatchEntryC_h_GUID_4B8E2D17_C3A9_4F60_9E15_7A2D0C6F38B4
+
+/* Internal Includes */
+#include <osvr/Util/APIBaseC.h>
+#include <osvr/Util/BoolC.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+
+/* Library/third-party includes */
+/* none */
+
+/* Standard includes */
+/* none */
+
+OSVR_EXTERN_C_BEGIN
+
+/** @addtogroup PluginKit
+@{
+*/
+
+/** @brief The data for one sensor in a batched tracker report: several
+    sensors' worth of these share a single timestamp and are sent as a single
+    message.
+
+    Velocity and acceleration are sent only if at least one of their
+    components is flagged valid.
+*/
+typedef struct OSVR_TrackerBatchEntry {
+    /** @brief The sensor this entry reports on */
+    OSVR_ChannelCount sensor;
+    /** @brief Whether #OSVR_TrackerBatchEntry::pose should be reported */
+    OSVR_CBool poseValid;
+    OSVR_PoseState pose;
+    OSVR_VelocityState velocity;
+    OSVR_AccelerationState acceleration;
+} OSVR_TrackerBatchEntry;
+
+/** @} */
+
+OSVR_EXTERN_C_END
+
+#endif
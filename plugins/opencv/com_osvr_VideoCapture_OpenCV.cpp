@@ -103,11 +103,14 @@ class CameraDevice : boost::noncopyable {
             return OSVR_RETURN_FAILURE;
         }
 
-        // Send the image.
+        // Send the image, copying it only once: straight from the capture
+        // buffer into the shared memory ring buffer.
         // Note that if larger than 160x120 (RGB), will used shared memory
         // backend only.
-        m_dev.send(m_imaging, osvr::pluginkit::ImagingMessage(m_frame),
-                   frameTime);
+        cv::Mat out = m_imaging.acquireFrame(m_dev, m_frame.rows, m_frame.cols,
+                                             m_frame.type());
+        m_frame.copyTo(out);
+        m_imaging.commitFrame(m_dev, frameTime);
 
         return OSVR_RETURN_SUCCESS;
     }
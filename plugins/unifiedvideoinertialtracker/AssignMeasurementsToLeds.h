@@ -39,6 +39,7 @@
 #include <cstddef>
 #include <iostream>
 #include <iterator>
+#include <numeric>
 #include <stdexcept>
 #include <tuple>
 #include <utility>
@@ -107,24 +108,30 @@ namespace vbtracker {
                 }
             }
 
+            float maxThresh = 0;
             for (auto &meas : measurements_) {
                 /// Populate the measurement ref vector.
                 measRefs_.push_back(&meas);
+                maxThresh = std::max(maxThresh, getDistanceThreshold(meas));
             }
 
-            /// Do the O(n * m) distance computation to populate the vector that
-            /// will become our min-heap.
+            /// Bin the LEDs into a grid with cells at least as large as the
+            /// largest search radius, so each measurement only has to look at
+            /// the LEDs in the (at most) 3x3 cells around it, instead of doing
+            /// the O(n * m) distance computation against every LED, to
+            /// populate the vector that will become our min-heap.
+            buildGrid(maxThresh);
             auto nMeas = measRefs_.size();
-            auto nLed = ledRefs_.size();
             for (size_type measIdx = 0; measIdx < nMeas; ++measIdx) {
-                auto distThreshSquared =
-                    getDistanceThresholdSquared(*measRefs_[measIdx]);
-                for (size_type ledIdx = 0; ledIdx < nLed; ++ledIdx) {
+                auto const &meas = *measRefs_[measIdx];
+                auto thresh = getDistanceThreshold(meas);
+                auto distThreshSquared = thresh * thresh;
+                forEachLedNear(meas.loc, thresh, [&](size_type ledIdx) {
                     /// WARNING: watch the order of arguments to this function,
                     /// since the type of the indices is identical...
                     possiblyPushLedMeasurement(ledIdx, measIdx,
                                                distThreshSquared);
-                }
+                });
             }
             /// Turn that vector into our min-heap.
 
@@ -399,11 +406,93 @@ namespace vbtracker {
         }
         /// @}
 
+        /// Sets up the structure-of-arrays copy of the LED locations and the
+        /// uniform grid over them (in compressed-row form: the LED indices
+        /// sorted by cell, and the offset where each cell's entries begin).
+        void buildGrid(float minCellSize) {
+            auto nLed = ledRefs_.size();
+            ledX_.resize(nLed);
+            ledY_.resize(nLed);
+            if (nLed == 0) {
+                return;
+            }
+            for (size_type i = 0; i < nLed; ++i) {
+                auto loc = ledRefs_[i]->getLocation();
+                ledX_[i] = loc.x;
+                ledY_[i] = loc.y;
+            }
+            auto xRange = std::minmax_element(begin(ledX_), end(ledX_));
+            auto yRange = std::minmax_element(begin(ledY_), end(ledY_));
+            gridMinX_ = *xRange.first;
+            gridMinY_ = *yRange.first;
+            auto width = *xRange.second - gridMinX_;
+            auto height = *yRange.second - gridMinY_;
+
+            /// Keep the cell count proportional to the LED count, even if the
+            /// search radius is tiny compared to how spread out they are.
+            cellSize_ = std::max(minCellSize, 1.f);
+            auto maxCells = static_cast<float>(4 * nLed);
+            while ((width / cellSize_ + 1) * (height / cellSize_ + 1) >
+                   maxCells) {
+                cellSize_ *= 2;
+            }
+            gridWidth_ = cellCoord(width) + 1;
+            gridHeight_ = cellCoord(height) + 1;
+
+            /// Counting sort of the LED indices by cell.
+            cellStart_.assign(gridWidth_ * gridHeight_ + 1, 0);
+            ledCell_.resize(nLed);
+            for (size_type i = 0; i < nLed; ++i) {
+                ledCell_[i] = cellCoord(ledY_[i] - gridMinY_) * gridWidth_ +
+                              cellCoord(ledX_[i] - gridMinX_);
+                cellStart_[ledCell_[i] + 1]++;
+            }
+            std::partial_sum(begin(cellStart_), end(cellStart_),
+                             begin(cellStart_));
+            cellLeds_.resize(nLed);
+            cellFill_.assign(begin(cellStart_), end(cellStart_) - 1);
+            for (size_type i = 0; i < nLed; ++i) {
+                cellLeds_[cellFill_[ledCell_[i]]++] = i;
+            }
+        }
+
+        size_type cellCoord(float offset) const {
+            return static_cast<size_type>(offset / cellSize_);
+        }
+
+        /// Calls f with the index of every LED in the grid cells overlapping
+        /// the square of the given radius around the location: a superset of
+        /// those within that distance.
+        template <typename F>
+        void forEachLedNear(cv::Point2f const &loc, float radius, F &&f) const {
+            if (ledX_.empty()) {
+                return;
+            }
+            auto clampedCell = [&](float offset, size_type gridSize) {
+                if (offset <= 0) {
+                    return size_type(0);
+                }
+                return std::min(cellCoord(offset), gridSize - 1);
+            };
+            auto x0 = clampedCell(loc.x - radius - gridMinX_, gridWidth_);
+            auto x1 = clampedCell(loc.x + radius - gridMinX_, gridWidth_);
+            auto y0 = clampedCell(loc.y - radius - gridMinY_, gridHeight_);
+            auto y1 = clampedCell(loc.y + radius - gridMinY_, gridHeight_);
+            for (auto y = y0; y <= y1; ++y) {
+                auto rowBegin = y * gridWidth_;
+                for (auto i = cellStart_[rowBegin + x0],
+                          e = cellStart_[rowBegin + x1 + 1];
+                     i < e; ++i) {
+                    std::forward<F>(f)(cellLeds_[i]);
+                }
+            }
+        }
+
         void possiblyPushLedMeasurement(std::size_t ledIdx, std::size_t measIdx,
                                         float distThreshSquared) {
             auto meas = measRefs_[measIdx];
-            auto led = ledRefs_[ledIdx];
-            auto squaredDist = sqDist(led->getLocation(), meas->loc);
+            auto squaredDist =
+                sqDist(cv::Point2f(ledX_[ledIdx], ledY_[ledIdx]), meas->loc);
             if (squaredDist < distThreshSquared) {
                 // If we're within the threshold, let's push this candidate
                 // on the vector that will be turned into a heap.
@@ -450,12 +539,8 @@ namespace vbtracker {
 
         /// For a given measurement, compute the corresponding search distance
         /// threshold
-        ///
-        /// Squared, so we can just use squared norm instead of doing square
-        /// roots
-        float getDistanceThresholdSquared(LedMeasurement const &meas) const {
-            auto thresh = blobMoveThreshFactor_ * meas.diameter;
-            return thresh * thresh;
+        float getDistanceThreshold(LedMeasurement const &meas) const {
+            return blobMoveThreshFactor_ * meas.diameter;
         }
 
         /// min heap comparator needs greater-than, want to compare on the
@@ -491,6 +576,23 @@ namespace vbtracker {
         std::vector<LedIter> ledRefs_;
         std::vector<MeasPtr> measRefs_;
         HeapType distanceHeap_;
+
+        /// @name LED locations and the grid over them
+        /// @brief Contiguous arrays indexed like ledRefs_, or by cell.
+        /// @{
+        std::vector<float> ledX_;
+        std::vector<float> ledY_;
+        std::vector<size_type> ledCell_;
+        std::vector<size_type> cellStart_;
+        std::vector<size_type> cellFill_;
+        std::vector<size_type> cellLeds_;
+        float gridMinX_ = 0;
+        float gridMinY_ = 0;
+        float cellSize_ = 1;
+        size_type gridWidth_ = 0;
+        size_type gridHeight_ = 0;
+        /// @}
+
         size_type numMatches_ = 0;
         LedGroup &leds_;
         LedMeasurementVec const &measurements_;
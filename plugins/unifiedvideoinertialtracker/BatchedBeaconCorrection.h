@@ -0,0 +1,260 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_BatchedBeaconCorrection_h_GUID_0E7A4C19_6B2D_4F83_A1C5_93D8E52B7F60
+#define INCLUDED_BatchedBeaconCorrection_h_GUID_0E7A4C19_6B2D_4F83_A1C5_93D8E52B7F60
+
+// Internal Includes
+#include "ImagePointMeasurement.h"
+#include "ModelTypes.h"
+
+// Library/third-party includes
+#include <Eigen/Cholesky>
+#include <Eigen/Core>
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    namespace batched_correction {
+        static const std::size_t BODY_DIM =
+            kalman::types::Dimension<BodyState>::value;
+        static const std::size_t BEACON_DIM =
+            kalman::types::Dimension<BeaconState>::value;
+        static const std::size_t MEAS_DIM = ImagePointMeasurement::DIMENSION;
+    } // namespace batched_correction
+
+    /// Accumulates the image-space beacon measurements of a frame, then
+    /// corrects the body state and the autocalibrating beacon states with all
+    /// of them at once, instead of one beacon at a time (SCAAT-style).
+    ///
+    /// The augmented state (body plus every beacon measured) has a
+    /// block-diagonal error covariance, since body/beacon cross-covariances
+    /// aren't kept between frames, so only the dense body block and the small
+    /// beacon blocks are ever formed. Like the one-at-a-time correction, the
+    /// cross-covariances produced by the correction are dropped.
+    class BatchedBeaconCorrection {
+      public:
+        void clear() {
+            m_entries.clear();
+            m_beacons.clear();
+        }
+
+        bool empty() const { return m_entries.empty(); }
+        std::size_t size() const { return m_entries.size(); }
+
+        /// Queues a measurement of a beacon.
+        ///
+        /// @param state The augmented state (body and this beacon) that meas
+        /// has been updated from and that the correction will be applied to.
+        /// @param meas Measurement, with its variance already set.
+        void add(AugmentedStateWithBeacon &state,
+                 ImagePointMeasurement const &meas) {
+            using namespace batched_correction;
+            Entry entry;
+            ImagePointMeasurement::Jacobian H = meas.getJacobian(state);
+            entry.bodyJacobian = H.leftCols<BODY_DIM>();
+            entry.beaconJacobian = H.rightCols<BEACON_DIM>();
+            entry.residual = meas.getResidual(state);
+            entry.covariance = meas.getCovariance(state);
+            addToBeaconGroup(state.b());
+            m_entries.push_back(entry);
+        }
+
+        /// Corrects the body state and all measured beacons, then clears the
+        /// queued measurements.
+        ///
+        /// @return false (and changes nothing) if the correction turned out
+        /// to be non-finite.
+        bool apply(BodyState &body) {
+            auto ret = applyImpl(body);
+            clear();
+            return ret;
+        }
+
+      private:
+        using DynMatrix = Eigen::MatrixXd;
+        using DynVector = Eigen::VectorXd;
+
+        template <std::size_t Rows, std::size_t Cols>
+        using UnalignedMatrix =
+            Eigen::Matrix<double, Rows, Cols, Eigen::DontAlign>;
+        struct Entry {
+            UnalignedMatrix<batched_correction::MEAS_DIM,
+                            batched_correction::BODY_DIM>
+                bodyJacobian;
+            UnalignedMatrix<batched_correction::MEAS_DIM,
+                            batched_correction::BEACON_DIM>
+                beaconJacobian;
+            UnalignedMatrix<batched_correction::MEAS_DIM, 1> residual;
+            UnalignedMatrix<batched_correction::MEAS_DIM,
+                            batched_correction::MEAS_DIM>
+                covariance;
+        };
+
+        /// A beacon state and the measurements (normally just one) of it.
+        struct BeaconGroup {
+            BeaconState *state;
+            std::vector<std::size_t> entries;
+        };
+
+        /// Records that the next entry measures the given beacon.
+        void addToBeaconGroup(BeaconState &beacon) {
+            for (auto &group : m_beacons) {
+                if (group.state == &beacon) {
+                    group.entries.push_back(m_entries.size());
+                    return;
+                }
+            }
+            m_beacons.push_back(BeaconGroup{&beacon, {m_entries.size()}});
+        }
+
+        bool applyImpl(BodyState &body) {
+            using namespace batched_correction;
+            const auto numMeas = m_entries.size();
+            if (numMeas == 0) {
+                return false;
+            }
+            const auto m = numMeas * MEAS_DIM;
+
+            /// Stacked measurement Jacobian (body part), residual, and
+            /// measurement covariance.
+            DynMatrix Ha(m, BODY_DIM);
+            DynVector residual(m);
+            DynMatrix S = DynMatrix::Zero(m, m);
+            for (std::size_t i = 0; i < numMeas; ++i) {
+                auto const &entry = m_entries[i];
+                Ha.middleRows<MEAS_DIM>(i * MEAS_DIM) = entry.bodyJacobian;
+                residual.segment<MEAS_DIM>(i * MEAS_DIM) = entry.residual;
+                S.block<MEAS_DIM, MEAS_DIM>(i * MEAS_DIM, i * MEAS_DIM) =
+                    entry.covariance;
+            }
+
+            /// Body contribution: the only dense part.
+            const kalman::types::SquareMatrix<BODY_DIM> Pa =
+                body.errorCovariance();
+            DynMatrix PHtA = Pa * Ha.transpose();
+            S.noalias() += Ha * PHtA;
+
+            /// Beacon contributions: only couple measurements of the same
+            /// beacon.
+            std::vector<DynMatrix> PHtB(m_beacons.size());
+            for (std::size_t b = 0; b < m_beacons.size(); ++b) {
+                auto const &group = m_beacons[b];
+                const auto n = group.entries.size();
+                DynMatrix Hb(n * MEAS_DIM, BEACON_DIM);
+                for (std::size_t j = 0; j < n; ++j) {
+                    Hb.middleRows<MEAS_DIM>(j * MEAS_DIM) =
+                        m_entries[group.entries[j]].beaconJacobian;
+                }
+                PHtB[b] = group.state->errorCovariance() * Hb.transpose();
+                DynMatrix HPHt = Hb * PHtB[b];
+                for (std::size_t j = 0; j < n; ++j) {
+                    for (std::size_t k = 0; k < n; ++k) {
+                        S.block<MEAS_DIM, MEAS_DIM>(
+                            group.entries[j] * MEAS_DIM,
+                            group.entries[k] * MEAS_DIM) +=
+                            HPHt.block<MEAS_DIM, MEAS_DIM>(j * MEAS_DIM,
+                                                           k * MEAS_DIM);
+                    }
+                }
+            }
+
+            /// Single decomposition of the innovation covariance.
+            Eigen::LDLT<DynMatrix> denom(S);
+            DynVector weightedResidual = denom.solve(residual);
+            DynMatrix Sinv = denom.solve(DynMatrix::Identity(m, m));
+
+            /// Gathers the rows/columns of a vector/matrix in measurement
+            /// space belonging to a beacon's measurements.
+            auto gatherVector = [&](BeaconGroup const &group,
+                                    DynVector const &v) {
+                DynVector ret(group.entries.size() * MEAS_DIM);
+                for (std::size_t j = 0; j < group.entries.size(); ++j) {
+                    ret.segment<MEAS_DIM>(j * MEAS_DIM) =
+                        v.segment<MEAS_DIM>(group.entries[j] * MEAS_DIM);
+                }
+                return ret;
+            };
+            auto gatherSinv = [&](BeaconGroup const &group) {
+                const auto n = group.entries.size();
+                DynMatrix ret(n * MEAS_DIM, n * MEAS_DIM);
+                for (std::size_t j = 0; j < n; ++j) {
+                    for (std::size_t k = 0; k < n; ++k) {
+                        ret.block<MEAS_DIM, MEAS_DIM>(j * MEAS_DIM,
+                                                      k * MEAS_DIM) =
+                            Sinv.block<MEAS_DIM, MEAS_DIM>(
+                                group.entries[j] * MEAS_DIM,
+                                group.entries[k] * MEAS_DIM);
+                    }
+                }
+                return ret;
+            };
+
+            /// Compute all corrections before applying any, so we can bail
+            /// out cleanly.
+            kalman::types::Vector<BODY_DIM> bodyCorrection =
+                PHtA * weightedResidual;
+            kalman::types::SquareMatrix<BODY_DIM> newPa =
+                Pa - PHtA * Sinv * PHtA.transpose();
+            if (!bodyCorrection.array().allFinite() ||
+                !newPa.array().allFinite()) {
+                return false;
+            }
+            std::vector<Eigen::Vector3d> beaconCorrections(m_beacons.size());
+            std::vector<Eigen::Matrix3d> newPb(m_beacons.size());
+            for (std::size_t b = 0; b < m_beacons.size(); ++b) {
+                auto const &group = m_beacons[b];
+                beaconCorrections[b] =
+                    PHtB[b] * gatherVector(group, weightedResidual);
+                newPb[b] = group.state->errorCovariance() -
+                           PHtB[b] * gatherSinv(group) * PHtB[b].transpose();
+                if (!beaconCorrections[b].array().allFinite() ||
+                    !newPb[b].array().allFinite()) {
+                    return false;
+                }
+            }
+
+            body.setStateVector(body.stateVector() + bodyCorrection);
+            body.setErrorCovariance(newPa);
+            body.postCorrect();
+            for (std::size_t b = 0; b < m_beacons.size(); ++b) {
+                auto &beacon = *m_beacons[b].state;
+                beacon.setStateVector(beacon.stateVector() +
+                                      beaconCorrections[b]);
+                beacon.setErrorCovariance(newPb[b]);
+                beacon.postCorrect();
+            }
+            return true;
+        }
+
+        std::vector<Entry> m_entries;
+        std::vector<BeaconGroup> m_beacons;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_BatchedBeaconCorrection_h_GUID_0E7A4C19_6B2D_4F83_A1C5_93D8E52B7F60
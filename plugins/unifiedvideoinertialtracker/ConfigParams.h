@@ -65,6 +65,27 @@ namespace vbtracker {
         std::int32_t angularVelocityMicrosecondsOffset = 0;
     };
 
+    /// Parameters for limiting blob extraction to regions of interest around
+    /// where the beacons are predicted to be seen.
+    struct RegionOfInterestParams {
+        /// Should blob extraction be limited to regions of interest around
+        /// the beacons of targets with a pose estimate?
+        bool enabled = false;
+
+        /// Padding, in pixels, on each side of a predicted beacon location: it
+        /// has to cover the blob, a frame's motion, and prediction error.
+        int padding = 24;
+
+        /// Process the full frame at least once every this many frames even
+        /// while tracking, to notice anything the predictions miss.
+        int fullFrameInterval = 30;
+
+        /// While some target has no pose estimate, each periodic full frame
+        /// becomes a run of this many, so that target's beacons can be seen
+        /// in enough consecutive frames to be identified.
+        int searchFrames = 20;
+    };
+
     struct TuningParams {
         TuningParams();
         double noveltyPenaltyBase;
@@ -112,6 +133,11 @@ namespace vbtracker {
         /// milliseconds between updates?
         bool continuousReporting = true;
 
+        /// Should all the body reports of an update go out as a single batched
+        /// tracker message, instead of the standard pose and velocity messages?
+        /// Only clients that understand the batch message will see them.
+        bool batchedReports = false;
+
         /// Should we open the camera in high-gain mode?
         bool highGain = true;
 
@@ -207,6 +233,11 @@ namespace vbtracker {
         /// measurements with a "bad" residual
         double highResidualVariancePenalty = 7.513691210865344;
 
+        /// When true, the Kalman estimator gates and weights each frame's
+        /// beacon measurements as usual, but then corrects with all of them in
+        /// a single update, rather than one beacon at a time.
+        bool batchedKalmanCorrection = false;
+
         /// When true, will stream debug info (variance, pixel measurement,
         /// pixel residual) on up to the first 34 beacons of your first sensor
         /// as analogs.
@@ -253,6 +284,9 @@ namespace vbtracker {
         /// IMU input-related parameters.
         IMUInputParams imu;
 
+        /// Region-of-interest (tracking mode) blob extraction parameters.
+        RegionOfInterestParams regionOfInterest;
+
         /// x, y, z, with y up, all in meters.
         double cameraPosition[3];
 
@@ -144,6 +144,7 @@ namespace vbtracker {
 
         getOptionalParameter(config.continuousReporting, root,
                              "continuousReporting");
+        getOptionalParameter(config.batchedReports, root, "batchedReports");
         getOptionalParameter(config.extraVerbose, root, "extraVerbose");
         getOptionalParameter(config.highGain, root, "highGain");
         getOptionalParameter(config.calibrationFile, root, "calibrationFile");
@@ -193,6 +194,8 @@ namespace vbtracker {
                              "measurementVarianceScaleFactor");
         getOptionalParameter(config.highResidualVariancePenalty, root,
                              "highResidualVariancePenalty");
+        getOptionalParameter(config.batchedKalmanCorrection, root,
+                             "batchedKalmanCorrection");
 #if 0
         getOptionalParameter(config.boundingBoxFilterRatio, root,
                              "boundingBoxFilterRatio");
@@ -223,6 +226,19 @@ namespace vbtracker {
                                          config.extractParams);
         }
 
+        /// Region-of-interest blob extraction parameters
+        if (root.isMember("regionOfInterest")) {
+            Json::Value const &roi = root["regionOfInterest"];
+            getOptionalParameter(config.regionOfInterest.enabled, roi,
+                                 "enabled");
+            getOptionalParameter(config.regionOfInterest.padding, roi,
+                                 "padding");
+            getOptionalParameter(config.regionOfInterest.fullFrameInterval,
+                                 roi, "fullFrameInterval");
+            getOptionalParameter(config.regionOfInterest.searchFrames, roi,
+                                 "searchFrames");
+        }
+
         /// IMU-related parameters
         if (root.isMember("imu")) {
             Json::Value const &imu = root["imu"];
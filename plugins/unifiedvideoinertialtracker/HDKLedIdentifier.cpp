@@ -36,9 +36,13 @@
 namespace osvr {
 namespace vbtracker {
     static const auto VALIDCHARS = "*.";
+    /// Longest pattern for which we use a flat lookup table: at 16 frames,
+    /// that's 64k entries, beyond which we switch to a hash map.
+    static const std::size_t MAX_TABLE_PATTERN_LENGTH = 16;
+    static const UnderlyingBeaconIdType NO_PATTERN = -1;
     OsvrHdkLedIdentifier::~OsvrHdkLedIdentifier() {}
-    // Convert from string encoding representations into lists
-    // of boolean values for use in comparison.
+    // Convert from string encoding representations into packed bits, and
+    // record every rotation of each in our lookup table.
     OsvrHdkLedIdentifier::OsvrHdkLedIdentifier(
         const PatternStringList &PATTERNS) {
         // Ensure that we have at least one entry in our list and
@@ -61,14 +65,19 @@ namespace vbtracker {
             // If we still have 0 as the pattern length, return.
             return;
         }
+        if (d_length > MAX_PACKED_PATTERN_LENGTH) {
+            throw std::runtime_error("Got a pattern too long to identify!");
+        }
 
-        // Decode each string into a new list of boolean values, making
-        // sure each have the correct length.
+        if (d_length <= MAX_TABLE_PATTERN_LENGTH) {
+            d_table.assign(std::size_t(1) << d_length, NO_PATTERN);
+        }
 
-        for (auto &pat : PATTERNS) {
-            if (pat.empty() || pat.find_first_not_of(VALIDCHARS) != pat.npos) {
+        for (size_t i = 0; i < PATTERNS.size(); ++i) {
+            auto &pat = PATTERNS[i];
+            PackedPattern bits;
+            if (pat.empty() || !packPattern(pat, bits)) {
                 // This is an intentionally disabled beacon/pattern.
-                d_patterns.emplace_back();
                 continue;
             }
 
@@ -77,17 +86,32 @@ namespace vbtracker {
                 throw std::runtime_error("Got a pattern of incorrect length!");
             }
 
-            // Make a wrapped pattern, which is the original pattern plus
-            // a second copy of the pattern that has all but the last
-            // character in it.  This will enable use to use the string
-            // find() routine to see if any shift of the pattern is a
-            // match.
-            auto wrapped = pat + pat;
-            wrapped.pop_back();
-            d_patterns.push_back(std::move(wrapped));
+            // Record every rotation, since we don't know when the code
+            // started: for the HDK, the codes are rotationally invariant. If
+            // patterns collide, the first one wins.
+            for (size_t shift = 0; shift < d_length; ++shift) {
+                auto id = static_cast<UnderlyingBeaconIdType>(i);
+                if (!d_table.empty()) {
+                    if (d_table[bits] == NO_PATTERN) {
+                        d_table[bits] = id;
+                    }
+                } else {
+                    d_map.emplace(bits, id);
+                }
+                bits = rotatePattern(bits, d_length);
+            }
         }
     }
 
+    UnderlyingBeaconIdType
+    OsvrHdkLedIdentifier::lookup(PackedPattern bits) const {
+        if (!d_table.empty()) {
+            return d_table[bits];
+        }
+        auto it = d_map.find(bits);
+        return it == d_map.end() ? NO_PATTERN : it->second;
+    }
+
     ZeroBasedBeaconId
     OsvrHdkLedIdentifier::getId(ZeroBasedBeaconId currentId,
                                 BrightnessList &brightnesses,
@@ -124,25 +148,15 @@ namespace vbtracker {
             return currentId;
         }
 
-        // Get a list of boolean values for 0's and 1's using
-        // the threshold computed above.
-        auto bits = getBitsUsingThreshold(brightnesses, threshold);
-
-        // Search through the available patterns to see if the passed-in
-        // pattern matches any of them.  If so, return that pattern.  We
-        // need to check all potential rotations of the pattern, since we
-        // don't know when the code started.  For the HDK, the codes are
-        // rotationally invariant.  We do this by making wrapped strings
-        // and seeing if the pattern shows up anywhe in them, relying on
-        // the std::string find method to do efficiently.
-        for (size_t i = 0; i < d_patterns.size(); i++) {
-            if (d_patterns[i].empty()) {
-                /// Skip turned-off patterns.
-                continue;
-            }
-            if (d_patterns[i].find(bits) != std::string::npos) {
-                return ZeroBasedBeaconId(i);
-            }
+        // Pack the 0's and 1's from the threshold computed above, and look
+        // them up directly: any rotation of any pattern is in the table.
+        PackedPattern bits = 0;
+        for (auto val : brightnesses) {
+            bits = (bits << 1) | (val >= threshold ? 1 : 0);
+        }
+        auto id = lookup(bits);
+        if (id != NO_PATTERN) {
+            return ZeroBasedBeaconId(id);
         }
 
         // No pattern recognized and we should have recognized one, so return
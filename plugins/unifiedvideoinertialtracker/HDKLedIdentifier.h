@@ -27,12 +27,14 @@
 
 // Internal Includes
 #include "LedIdentifier.h"
+#include "PackedLedPattern.h"
 
 // Library/third-party includes
 // - none
 
 // Standard includes
-// - none
+#include <unordered_map>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
@@ -42,7 +44,7 @@ namespace vbtracker {
         /// @brief Give it a list of patterns to use.  There is a string for
         /// each LED, and each is encoded with '*' meaning that the LED is
         /// bright and '.' that it is dim at this point in time. All patterns
-        /// must have the same length.
+        /// must have the same length, no more than MAX_PACKED_PATTERN_LENGTH.
         OsvrHdkLedIdentifier(const PatternStringList &PATTERNS);
 
         ~OsvrHdkLedIdentifier() override;
@@ -56,8 +58,15 @@ namespace vbtracker {
                                 bool blobsKeepId) const override;
 
       private:
-        size_t d_length;        //< Length of all patterns
-        PatternList d_patterns; //< Patterns by index
+        /// Finds the pattern with this rotation, or returns a negative value.
+        UnderlyingBeaconIdType lookup(PackedPattern bits) const;
+
+        size_t d_length; //< Length of all patterns
+        /// Pattern index for every rotation of every pattern, indexed by the
+        /// packed bits - used for patterns up to MAX_TABLE_PATTERN_LENGTH.
+        std::vector<UnderlyingBeaconIdType> d_table;
+        /// Same contents as d_table, for longer patterns.
+        std::unordered_map<PackedPattern, UnderlyingBeaconIdType> d_map;
     };
 
 } // End namespace vbtracker
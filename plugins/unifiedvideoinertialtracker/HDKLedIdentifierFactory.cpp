@@ -169,6 +169,12 @@ namespace vbtracker {
         return ret;
     }
 
+    PatternStringList const &getHDKLedPatterns(uint8_t sensor) {
+        BOOST_ASSERT_MSG(sensor < 2, "Valid sensors are only 0 or 1!");
+        return sensor == 0 ? OsvrHdkLedIdentifier_SENSOR0_PATTERNS
+                           : OsvrHdkLedIdentifier_SENSOR1_PATTERNS;
+    }
+
     LedIdentifierPtr createHDKUnifiedLedIdentifier() {
         LedIdentifierPtr ret;
         std::vector<std::string> patterns =
@@ -242,5 +248,19 @@ namespace vbtracker {
         return createHDKLedIdentifier(
             OsvrHdkLedIdentifier_RANDOM_IMAGES_PATTERNS);
     }
+
+    LedPatternAllocator createHDKPatternAllocator() {
+        LedPatternAllocator ret;
+        for (uint8_t sensor = 0; sensor < 2; ++sensor) {
+            for (auto pat : getHDKLedPatterns(sensor)) {
+                /// Disabled beacons (prefixed with 'X') may still blink.
+                if (!pat.empty() && pat.front() == 'X') {
+                    pat.erase(0, 1);
+                }
+                ret.reserve({pat});
+            }
+        }
+        return ret;
+    }
 } // End namespace vbtracker
 } // End namespace osvr
@@ -28,6 +28,7 @@
 // Internal Includes
 #include "Types.h"
 #include "LedIdentifier.h"
+#include "LedPatternAllocator.h"
 
 // Library/third-party includes
 // - none
@@ -42,6 +43,11 @@ namespace vbtracker {
     /// @param sensor either 0 (front plate) or 1 (back plate)
     LedIdentifierPtr createHDKLedIdentifier(uint8_t sensor);
 
+    /// @brief Gets the as-built HDK patterns used by createHDKLedIdentifier(),
+    /// in beacon order, including disabled ones (prefixed with 'X').
+    /// @param sensor either 0 (front plate) or 1 (back plate)
+    PatternStringList const &getHDKLedPatterns(uint8_t sensor);
+
     /// @brief Factory function to create an HDK Led Identifier object
     ///        using the presumed order that generated the simulated
     ///        images, which turned out to be changed before release.
@@ -56,6 +62,11 @@ namespace vbtracker {
     /// @brief Factory function to create an HDK Led Identifier object using the
     /// random images patterns.
     LedIdentifierPtr createRandomHDKLedIdentifier();
+
+    /// @brief Creates a pattern allocator with all the HDK (front and back
+    /// plate) patterns, including disabled ones, reserved, to hand out
+    /// patterns to additional devices tracked alongside an HDK.
+    LedPatternAllocator createHDKPatternAllocator();
 } // End namespace vbtracker
 } // End namespace osvr
 
@@ -0,0 +1,150 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "LedPatternAllocator.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <bitset>
+#include <stdexcept>
+
+namespace osvr {
+namespace vbtracker {
+    static const std::size_t MAX_ALLOCATOR_PATTERN_LENGTH = 20;
+
+    LedPatternAllocator::LedPatternAllocator(std::size_t length,
+                                             std::size_t minBright,
+                                             std::size_t maxBright)
+        : m_length(length) {
+        if (length < 2 || length > MAX_ALLOCATOR_PATTERN_LENGTH) {
+            throw std::invalid_argument("Pattern length must be between 2 "
+                                        "and 20 frames for allocation");
+        }
+        /// Need at least one bright and one dim frame to threshold.
+        minBright = std::max<std::size_t>(minBright, 1);
+        maxBright = std::min(maxBright, length - 1);
+
+        /// Enumerate one representative (the smallest rotation) of each
+        /// aperiodic pattern with an acceptable number of bright frames,
+        /// fewest bright frames first.
+        PackedPattern end = PackedPattern(1) << length;
+        for (auto bright = minBright; bright <= maxBright; ++bright) {
+            for (PackedPattern pattern = 0; pattern < end; ++pattern) {
+                if (std::bitset<32>(pattern).count() != bright) {
+                    continue;
+                }
+                if (canonicalPattern(pattern, length) != pattern ||
+                    isPeriodicPattern(pattern, length)) {
+                    continue;
+                }
+                m_candidates.push_back(pattern);
+            }
+        }
+    }
+
+    void LedPatternAllocator::reserve(PatternStringList const &patterns) {
+        for (auto const &pat : patterns) {
+            PackedPattern bits;
+            if (pat.size() != m_length || !packPattern(pat, bits)) {
+                continue;
+            }
+            m_used.insert(canonicalPattern(bits, m_length));
+        }
+    }
+
+    PatternStringList
+    LedPatternAllocator::allocate(std::size_t numBeacons,
+                                  AdjacencyList const &adjacent) {
+        std::vector<std::vector<std::size_t>> neighbors(numBeacons);
+        for (auto const &pair : adjacent) {
+            if (pair.first >= numBeacons || pair.second >= numBeacons) {
+                throw std::out_of_range("Adjacency refers to a beacon index "
+                                        "beyond the number allocated");
+            }
+            neighbors[pair.first].push_back(pair.second);
+            neighbors[pair.second].push_back(pair.first);
+        }
+
+        /// Greedy assignment: each beacon gets the first available candidate,
+        /// in whichever rotation (the beacons of a device blink in lockstep)
+        /// doesn't overlap the bright frames of its already-assigned
+        /// neighbors.
+        std::vector<PackedPattern> assigned(numBeacons);
+        std::vector<bool> isAssigned(numBeacons, false);
+        std::unordered_set<PackedPattern> taken;
+        for (std::size_t beacon = 0; beacon < numBeacons; ++beacon) {
+            auto conflicts = [&](PackedPattern pattern) {
+                for (auto other : neighbors[beacon]) {
+                    if (isAssigned[other] && (assigned[other] & pattern)) {
+                        return true;
+                    }
+                }
+                return false;
+            };
+            bool found = false;
+            for (auto candidate : m_candidates) {
+                if (!isAvailable(candidate) || taken.count(candidate)) {
+                    continue;
+                }
+                auto pattern = candidate;
+                for (std::size_t shift = 0; shift < m_length; ++shift) {
+                    if (!conflicts(pattern)) {
+                        found = true;
+                        break;
+                    }
+                    pattern = rotatePattern(pattern, m_length);
+                }
+                if (found) {
+                    assigned[beacon] = pattern;
+                    isAssigned[beacon] = true;
+                    taken.insert(candidate);
+                    break;
+                }
+            }
+            if (!found) {
+                throw std::runtime_error(
+                    "Not enough LED patterns available to satisfy the "
+                    "allocation request");
+            }
+        }
+
+        PatternStringList ret;
+        for (auto pattern : assigned) {
+            m_used.insert(canonicalPattern(pattern, m_length));
+            ret.push_back(unpackPattern(pattern, m_length));
+        }
+        return ret;
+    }
+
+    std::size_t LedPatternAllocator::numAvailable() const {
+        return std::count_if(
+            m_candidates.begin(), m_candidates.end(),
+            [&](PackedPattern candidate) { return isAvailable(candidate); });
+    }
+} // namespace vbtracker
+} // namespace osvr
@@ -0,0 +1,97 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_LedPatternAllocator_h_GUID_9D27C4E3_51B8_4A0F_8E6C_2F4B7A1D903E
+#define INCLUDED_LedPatternAllocator_h_GUID_9D27C4E3_51B8_4A0F_8E6C_2F4B7A1D903E
+
+// Internal Includes
+#include "PackedLedPattern.h"
+#include "Types.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// Hands out blink patterns for additional devices at runtime, so they can
+    /// be tracked by the same camera as (and be told apart from) the devices
+    /// whose patterns were reserved, without fixed allocations of the limited
+    /// pattern space.
+    ///
+    /// Patterns handed out are distinct from every rotation of every reserved
+    /// or previously allocated pattern, and beacons listed as adjacent are
+    /// never bright in the same frame (which makes them blur together, as seen
+    /// on the left side of the HDK 1.3).
+    class LedPatternAllocator {
+      public:
+        /// Pairs of (zero-based) beacon indices, within one allocation, that
+        /// are physically adjacent.
+        using AdjacencyList = std::vector<std::pair<std::size_t, std::size_t>>;
+
+        /// @param length Frames per pattern (at most 20, to keep the search
+        /// space enumerable).
+        /// @param minBright Fewest bright frames per pattern
+        /// @param maxBright Most bright frames per pattern: patterns with
+        /// fewer bright frames are handed out first.
+        explicit LedPatternAllocator(std::size_t length = 16,
+                                     std::size_t minBright = 3,
+                                     std::size_t maxBright = 5);
+
+        std::size_t getPatternLength() const { return m_length; }
+
+        /// Marks patterns (in the '*' and '.' string form, as used by the
+        /// identifier) as in use. Disabled/invalid entries are ignored.
+        void reserve(PatternStringList const &patterns);
+
+        /// Allocates a pattern for each of numBeacons beacons.
+        ///
+        /// @throws std::runtime_error if the constraints can't be satisfied;
+        /// in that case, nothing is allocated.
+        PatternStringList allocate(std::size_t numBeacons,
+                                   AdjacencyList const &adjacent = {});
+
+        /// Number of patterns that could still be allocated, ignoring
+        /// adjacency constraints.
+        std::size_t numAvailable() const;
+
+      private:
+        bool isAvailable(PackedPattern canonical) const {
+            return m_used.find(canonical) == m_used.end();
+        }
+        std::size_t m_length;
+        /// Candidate patterns (one rotation of each), in preference order.
+        std::vector<PackedPattern> m_candidates;
+        /// Canonical forms of reserved or allocated patterns.
+        std::unordered_set<PackedPattern> m_used;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_LedPatternAllocator_h_GUID_9D27C4E3_51B8_4A0F_8E6C_2F4B7A1D903E
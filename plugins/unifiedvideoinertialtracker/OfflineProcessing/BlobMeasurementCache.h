@@ -0,0 +1,331 @@
+/** @file
+    @brief Header providing a compact binary cache of per-frame blob
+    measurements (and IMU samples), so tracker parameters can be iterated on
+    without re-decoding video and re-running blob extraction.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_BlobMeasurementCache_h_GUID_6C1F0B52_3A8E_4E27_9D4B_81E5A2F07C36
+#define INCLUDED_BlobMeasurementCache_h_GUID_6C1F0B52_3A8E_4E27_9D4B_81E5A2F07C36
+
+// Internal Includes
+#include "../BodyIdTypes.h"
+#include "../CannedIMUMeasurement.h"
+#include <LedMeasurement.h>
+#include <osvr/Util/Angles.h>
+#include <osvr/Util/EigenCoreGeometry.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// On-disk layout of the blob cache: a FileHeader, followed by one record
+    /// per frame, each a FrameHeader followed by that many IMUSamples (those
+    /// received before the frame) and then that many Measurements (raw - that
+    /// is, still distorted). All records are fixed-size, 8-byte multiples in
+    /// host byte order, so the file can be mapped and walked in place.
+    namespace blob_cache {
+        static const char MAGIC[8] = {'U', 'V', 'B', 'I', 'B', 'L', 'O', 'B'};
+        static const std::uint32_t VERSION = 1;
+
+        struct FileHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::int32_t imageWidth;
+            std::int32_t imageHeight;
+            std::uint32_t reserved;
+        };
+
+        struct FrameHeader {
+            std::int64_t seconds;
+            std::int32_t microseconds;
+            std::uint32_t numIMUSamples;
+            std::uint32_t numMeasurements;
+            std::uint32_t reserved;
+        };
+
+        struct IMUSample {
+            enum Flags : std::uint32_t {
+                ORIENTATION_VALID = 1 << 0,
+                ANG_VEL_VALID = 1 << 1
+            };
+            std::int64_t seconds;
+            std::int32_t microseconds;
+            std::uint32_t body;
+            std::uint32_t flags;
+            std::uint32_t reserved;
+            double yawCorrection;
+            double quat[4];
+            double quatVariance[3];
+            double angVel[3];
+            double angVelVariance[3];
+        };
+
+        struct Measurement {
+            enum Flags : std::uint32_t { KNOW_BOUNDING_BOX = 1 << 0 };
+            float x;
+            float y;
+            float diameter;
+            float area;
+            float circularity;
+            float boundingBoxWidth;
+            float boundingBoxHeight;
+            std::uint32_t flags;
+        };
+
+        static_assert(sizeof(FileHeader) % 8 == 0 &&
+                          sizeof(FrameHeader) % 8 == 0 &&
+                          sizeof(IMUSample) % 8 == 0 &&
+                          sizeof(Measurement) % 8 == 0,
+                      "Blob cache records must keep 8-byte alignment");
+    } // namespace blob_cache
+
+    /// A timestamped IMU report for a given body, as cached.
+    struct CachedIMUSample {
+        BodyId body;
+        util::time::TimeValue tv;
+        CannedIMUMeasurement meas;
+    };
+
+    /// One frame's worth of data read back from a blob cache.
+    struct CachedBlobFrame {
+        util::time::TimeValue tv;
+        /// Raw (distorted) measurements, as extracted from the frame.
+        LedMeasurementVec measurements;
+        /// IMU samples received before this frame, oldest first.
+        std::vector<CachedIMUSample> imuSamples;
+    };
+
+    /// Writes a blob cache file as frames are processed.
+    class BlobCacheWriter {
+      public:
+        /// @throws std::runtime_error if the file can't be opened.
+        BlobCacheWriter(std::string const &fn, cv::Size imageSize)
+            : file_(fn, std::ios::out | std::ios::binary | std::ios::trunc) {
+            if (!file_) {
+                throw std::runtime_error("Could not open blob cache file " +
+                                         fn + " for writing");
+            }
+            blob_cache::FileHeader header = {};
+            std::memcpy(header.magic, blob_cache::MAGIC, sizeof(header.magic));
+            header.version = blob_cache::VERSION;
+            header.imageWidth = imageSize.width;
+            header.imageHeight = imageSize.height;
+            write(header);
+        }
+
+        /// Queues an IMU sample, to be written ahead of the next frame.
+        void addIMUSample(BodyId body, util::time::TimeValue const &tv,
+                          CannedIMUMeasurement const &meas) {
+            blob_cache::IMUSample sample = {};
+            sample.seconds = tv.seconds;
+            sample.microseconds = tv.microseconds;
+            sample.body = body.value();
+            sample.yawCorrection = util::getRadians(meas.getYawCorrection());
+            if (meas.orientationValid()) {
+                sample.flags |= blob_cache::IMUSample::ORIENTATION_VALID;
+                Eigen::Quaterniond quat;
+                Eigen::Vector3d var;
+                meas.restoreQuat(quat);
+                meas.restoreQuatVariance(var);
+                Eigen::Vector4d::Map(sample.quat) = quat.coeffs();
+                Eigen::Vector3d::Map(sample.quatVariance) = var;
+            }
+            if (meas.angVelValid()) {
+                sample.flags |= blob_cache::IMUSample::ANG_VEL_VALID;
+                Eigen::Vector3d angVel;
+                Eigen::Vector3d var;
+                meas.restoreAngVel(angVel);
+                meas.restoreAngVelVariance(var);
+                Eigen::Vector3d::Map(sample.angVel) = angVel;
+                Eigen::Vector3d::Map(sample.angVelVariance) = var;
+            }
+            pendingIMU_.push_back(sample);
+        }
+
+        /// Writes a frame's raw measurements, along with any queued IMU
+        /// samples.
+        void addFrame(util::time::TimeValue const &tv,
+                      LedMeasurementVec const &measurements) {
+            blob_cache::FrameHeader header = {};
+            header.seconds = tv.seconds;
+            header.microseconds = tv.microseconds;
+            header.numIMUSamples =
+                static_cast<std::uint32_t>(pendingIMU_.size());
+            header.numMeasurements =
+                static_cast<std::uint32_t>(measurements.size());
+            write(header);
+            for (auto const &sample : pendingIMU_) {
+                write(sample);
+            }
+            pendingIMU_.clear();
+            for (auto const &meas : measurements) {
+                blob_cache::Measurement out = {};
+                out.x = meas.loc.x;
+                out.y = meas.loc.y;
+                out.diameter = meas.diameter;
+                out.area = meas.area;
+                out.circularity = meas.circularity;
+                if (meas.knowBoundingBox()) {
+                    out.flags |= blob_cache::Measurement::KNOW_BOUNDING_BOX;
+                    out.boundingBoxWidth = meas.boundingBoxSize().width;
+                    out.boundingBoxHeight = meas.boundingBoxSize().height;
+                }
+                write(out);
+            }
+        }
+
+        bool good() const { return static_cast<bool>(file_); }
+
+      private:
+        template <typename T> void write(T const &record) {
+            file_.write(reinterpret_cast<const char *>(&record),
+                        sizeof(record));
+        }
+        std::ofstream file_;
+        std::vector<blob_cache::IMUSample> pendingIMU_;
+    };
+
+    /// Reads a blob cache file, by mapping it into memory and walking the
+    /// records in place.
+    class BlobCacheReader {
+      public:
+        /// @throws std::runtime_error if the file can't be mapped or isn't a
+        /// blob cache of a version we understand.
+        explicit BlobCacheReader(std::string const &fn) {
+            namespace bip = boost::interprocess;
+            try {
+                mapping_ = bip::file_mapping(fn.c_str(), bip::read_only);
+                region_ = bip::mapped_region(mapping_, bip::read_only);
+            } catch (bip::interprocess_exception &e) {
+                throw std::runtime_error("Could not map blob cache file " +
+                                         fn + ": " + e.what());
+            }
+            cur_ = static_cast<const char *>(region_.get_address());
+            end_ = cur_ + region_.get_size();
+            blob_cache::FileHeader header;
+            if (!read(header) ||
+                std::memcmp(header.magic, blob_cache::MAGIC,
+                            sizeof(header.magic)) != 0) {
+                throw std::runtime_error(fn + " is not a blob cache file");
+            }
+            if (header.version != blob_cache::VERSION) {
+                throw std::runtime_error(fn + " is a blob cache file of an "
+                                              "unsupported version");
+            }
+            imageSize_ = cv::Size(header.imageWidth, header.imageHeight);
+        }
+
+        /// Size of the images the measurements were extracted from.
+        cv::Size getImageSize() const { return imageSize_; }
+
+        /// Reads the next frame into the given structure, reusing its
+        /// storage.
+        ///
+        /// @return false at the end of the file (or at a truncated final
+        /// record, which is dropped).
+        bool nextFrame(CachedBlobFrame &frame) {
+            blob_cache::FrameHeader header;
+            auto recordStart = cur_;
+            if (!read(header) ||
+                static_cast<std::size_t>(end_ - cur_) <
+                    header.numIMUSamples * sizeof(blob_cache::IMUSample) +
+                        header.numMeasurements *
+                            sizeof(blob_cache::Measurement)) {
+                cur_ = recordStart;
+                return false;
+            }
+            frame.tv.seconds = header.seconds;
+            frame.tv.microseconds = header.microseconds;
+
+            frame.imuSamples.clear();
+            for (std::uint32_t i = 0; i < header.numIMUSamples; ++i) {
+                blob_cache::IMUSample sample;
+                read(sample);
+                CachedIMUSample out;
+                out.body = BodyId(
+                    static_cast<BodyId::wrapped_type>(sample.body));
+                out.tv.seconds = sample.seconds;
+                out.tv.microseconds = sample.microseconds;
+                out.meas.setYawCorrection(sample.yawCorrection *
+                                          util::radians);
+                if (sample.flags & blob_cache::IMUSample::ORIENTATION_VALID) {
+                    Eigen::Quaterniond quat;
+                    quat.coeffs() = Eigen::Vector4d::Map(sample.quat);
+                    out.meas.setOrientation(
+                        quat, Eigen::Vector3d::Map(sample.quatVariance));
+                }
+                if (sample.flags & blob_cache::IMUSample::ANG_VEL_VALID) {
+                    out.meas.setAngVel(
+                        Eigen::Vector3d::Map(sample.angVel),
+                        Eigen::Vector3d::Map(sample.angVelVariance));
+                }
+                frame.imuSamples.push_back(out);
+            }
+
+            frame.measurements.clear();
+            for (std::uint32_t i = 0; i < header.numMeasurements; ++i) {
+                blob_cache::Measurement meas;
+                read(meas);
+                frame.measurements.emplace_back(meas.x, meas.y, meas.diameter,
+                                                imageSize_, meas.area);
+                auto &out = frame.measurements.back();
+                out.circularity = meas.circularity;
+                if (meas.flags & blob_cache::Measurement::KNOW_BOUNDING_BOX) {
+                    out.setBoundingBox(cv::Size2f(meas.boundingBoxWidth,
+                                                  meas.boundingBoxHeight));
+                }
+            }
+            return true;
+        }
+
+      private:
+        template <typename T> bool read(T &record) {
+            if (static_cast<std::size_t>(end_ - cur_) < sizeof(record)) {
+                return false;
+            }
+            std::memcpy(&record, cur_, sizeof(record));
+            cur_ += sizeof(record);
+            return true;
+        }
+        boost::interprocess::file_mapping mapping_;
+        boost::interprocess::mapped_region region_;
+        const char *end_ = nullptr;
+        const char *cur_ = nullptr;
+        cv::Size imageSize_;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_BlobMeasurementCache_h_GUID_6C1F0B52_3A8E_4E27_9D4B_81E5A2F07C36
@@ -29,6 +29,7 @@
 #include "../ConfigurationParser.h"
 #include "../MakeHDKTrackingSystem.h"
 #include "../TrackedBodyTarget.h"
+#include "BlobMeasurementCache.h"
 #include "CSVCellGroup.h"
 #include "GenerateBlobDebugImage.h"
 #include "QuatToEuler.h"
@@ -88,6 +89,18 @@ namespace vbtracker {
 
         void processFrame(cv::Mat const &frame);
 
+        /// Processes a frame of raw measurements, and the IMU samples that
+        /// preceded it, replayed from a blob cache, bypassing image
+        /// processing (so there are no rejects or debug images).
+        void processCachedFrame(CachedBlobFrame const &frame,
+                                cv::Size imageSize);
+
+        /// Starts writing the raw measurements of each frame processed from
+        /// video to a blob cache file, for later replay.
+        void cacheBlobsTo(std::string const &fn, cv::Size imageSize) {
+            blobCache_.reset(new BlobCacheWriter(fn, imageSize));
+        }
+
         bool everHadPose() const { return everHadPose_; }
         bool hasPose() const { return hasPose_; }
 
@@ -109,6 +122,9 @@ namespace vbtracker {
         /// of the innards: sets rawMeasurements_, undistortedMeasurements_, and
         /// leaves useful state in extractor_.
         ImageOutputDataPtr imageProc(cv::Mat const &frame);
+        /// Hands off the image processing results to the tracking system and
+        /// logs the outcome.
+        void processImageData(ImageOutputDataPtr &&imageData);
         void logRow();
 
         /// @name Constants
@@ -140,6 +156,10 @@ namespace vbtracker {
         LedMeasurementVec rawMeasurements_;
         LedMeasurementVec undistortedMeasurements_;
         cv::Mat lastFrame_;
+        std::unique_ptr<BlobCacheWriter> blobCache_;
+        /// Blank stand-ins for the frame, when replaying a blob cache.
+        cv::Mat replayFrame_;
+        cv::Mat replayGray_;
         util::CSV csv_;
         std::size_t frame_ = 0;
         bool hasPose_ = false;
@@ -156,7 +176,49 @@ namespace vbtracker {
 
         /// Image processing.
         auto imageData = imageProc(frame);
+        if (blobCache_) {
+            blobCache_->addFrame(currentTime_, rawMeasurements_);
+        }
+
+        processImageData(std::move(imageData));
+    }
+
+    void
+    TrackerOfflineProcessing::processCachedFrame(CachedBlobFrame const &frame,
+                                                 cv::Size imageSize) {
+        if ((frame_ % 100) == 0) {
+            std::cout << "Processing frame " << frame_ << std::endl;
+        }
+        for (auto const &sample : frame.imuSamples) {
+            if (sample.body.value() >= system_->getNumBodies()) {
+                continue;
+            }
+            auto &body = system_->getBody(sample.body);
+            if (body.hasIMU()) {
+                body.incorporateNewMeasurementFromIMU(sample.tv, sample.meas);
+            }
+        }
+        currentTime_ = frame.tv;
 
+        if (replayGray_.size() != imageSize) {
+            replayFrame_ = cv::Mat::zeros(imageSize, CV_8UC3);
+            replayGray_ = cv::Mat::zeros(imageSize, CV_8UC1);
+        }
+        ImageOutputDataPtr imageData(new ImageProcessingOutput);
+        imageData->tv = currentTime_;
+        imageData->camParams = camParams_; // undistorted!
+        imageData->frame = replayFrame_;
+        imageData->frameGray = replayGray_;
+        rawMeasurements_ = frame.measurements;
+        undistortedMeasurements_ =
+            undistortLeds(rawMeasurements_, camParamsDistorted_);
+        imageData->ledMeasurements = undistortedMeasurements_;
+
+        processImageData(std::move(imageData));
+    }
+
+    void
+    TrackerOfflineProcessing::processImageData(ImageOutputDataPtr &&imageData) {
         /// Hand off the image processing results
         auto indices = system_->updateBodiesFromVideoData(std::move(imageData));
         logRow();
@@ -318,6 +380,8 @@ namespace vbtracker {
     }
 
     static bool g_saveFramesLostFix = false;
+    static bool g_cacheBlobs = false;
+    static const auto BLOB_CACHE_EXTENSION = ".blobs";
 
     bool processAVI(std::string const &fn, TrackerOfflineProcessing &app) {
         cv::VideoCapture capture;
@@ -328,6 +392,17 @@ namespace vbtracker {
         }
         cv::Mat frame;
         capture >> frame;
+        if (g_cacheBlobs) {
+            auto cacheName = fn + BLOB_CACHE_EXTENSION;
+            try {
+                app.cacheBlobsTo(cacheName, frame.size());
+            } catch (std::exception &e) {
+                std::cerr << e.what() << std::endl;
+                return false;
+            }
+            std::cout << "Will cache blob measurements to " << cacheName
+                      << std::endl;
+        }
         while (capture.read(frame)) {
             app.processFrame(frame);
             if (g_saveFramesLostFix && !app.hasPose() && app.everHadPose()) {
@@ -341,10 +416,28 @@ namespace vbtracker {
         return true;
     }
 
+    /// Replays the measurements cached from a previous run on a video,
+    /// skipping the decoding and blob extraction.
+    bool processBlobCache(std::string const &fn,
+                          TrackerOfflineProcessing &app) {
+        try {
+            BlobCacheReader reader(fn);
+            CachedBlobFrame frame;
+            while (reader.nextFrame(frame)) {
+                app.processCachedFrame(frame, reader.getImageSize());
+            }
+        } catch (std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
 } // namespace vbtracker
 } // namespace osvr
 
 static const auto DEBUG_FRAMES_SWITCH = "--save-debug-frames";
+static const auto CACHE_BLOBS_SWITCH = "--cache-blobs";
 
 using namespace osvr::util::args;
 int main(int argc, char *argv[]) {
@@ -384,17 +477,20 @@ int main(int argc, char *argv[]) {
             return -1;
         }
 
-        /// Get video filename
+        /// Get video filename (or the name of a blob cache made from a video)
         auto numVideoNames = handle_arg(args, [&](std::string const &arg) {
-            auto ret = boost::iends_with(arg, ".avi");
+            auto ret = boost::iends_with(arg, ".avi") ||
+                       boost::iends_with(
+                           arg, osvr::vbtracker::BLOB_CACHE_EXTENSION);
             if (ret) {
                 videoNames.push_back(arg);
             }
             return ret;
         });
         if (numVideoNames < 1) {
-            std::cerr << "Must pass at least one video filename to this app!"
-                      << std::endl;
+            std::cerr << "Must pass at least one video (or "
+                      << osvr::vbtracker::BLOB_CACHE_EXTENSION
+                      << " blob cache) filename to this app!" << std::endl;
             return -1;
         }
 
@@ -405,6 +501,9 @@ int main(int argc, char *argv[]) {
                       << std::endl;
         }
 
+        osvr::vbtracker::g_cacheBlobs =
+            handle_has_iswitch(args, CACHE_BLOBS_SWITCH);
+
         if (!args.empty()) {
             std::cerr
                 << "Unrecognized arguments left after parsing command line!"
@@ -421,7 +520,11 @@ int main(int argc, char *argv[]) {
     for (auto &videoName : videoNames) {
         std::cout << "Processing input video " << videoName << std::endl;
         osvr::vbtracker::TrackerOfflineProcessing app(params);
-        auto success = osvr::vbtracker::processAVI(videoName, app);
+        auto success =
+            boost::iends_with(videoName,
+                              osvr::vbtracker::BLOB_CACHE_EXTENSION)
+                ? osvr::vbtracker::processBlobCache(videoName, app)
+                : osvr::vbtracker::processAVI(videoName, app);
 
         if (success) {
             std::cout << "Processed a total of " << app.getFrameCount()
@@ -0,0 +1,129 @@
+/** @file
+    @brief Header providing helpers for LED blink patterns packed into
+    integers, one bit per frame.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PackedLedPattern_h_GUID_3B8E5F21_7C4A_4D9E_A612_5E0F9C2D7B48
+#define INCLUDED_PackedLedPattern_h_GUID_3B8E5F21_7C4A_4D9E_A612_5E0F9C2D7B48
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace osvr {
+namespace vbtracker {
+    /// A blink pattern packed into an integer: the first (oldest) frame is the
+    /// most significant of the pattern-length low bits, bright is 1.
+    using PackedPattern = std::uint32_t;
+
+    /// Longest pattern that fits in a PackedPattern.
+    static const std::size_t MAX_PACKED_PATTERN_LENGTH = 32;
+
+    namespace packed_pattern {
+        static const char BRIGHT = '*';
+        static const char DIM = '.';
+
+        inline PackedPattern getMask(std::size_t length) {
+            return length >= MAX_PACKED_PATTERN_LENGTH
+                       ? ~PackedPattern(0)
+                       : (PackedPattern(1) << length) - 1;
+        }
+    } // namespace packed_pattern
+
+    /// Packs a pattern string of '*' (bright) and '.' (dim), which must be no
+    /// longer than MAX_PACKED_PATTERN_LENGTH.
+    ///
+    /// @return false if the string contains any other characters.
+    inline bool packPattern(std::string const &pattern, PackedPattern &out) {
+        PackedPattern ret = 0;
+        for (auto c : pattern) {
+            ret <<= 1;
+            if (c == packed_pattern::BRIGHT) {
+                ret |= 1;
+            } else if (c != packed_pattern::DIM) {
+                return false;
+            }
+        }
+        out = ret;
+        return true;
+    }
+
+    /// Inverse of packPattern()
+    inline std::string unpackPattern(PackedPattern pattern,
+                                     std::size_t length) {
+        std::string ret(length, packed_pattern::DIM);
+        for (std::size_t i = 0; i < length; ++i) {
+            if ((pattern >> (length - 1 - i)) & 1) {
+                ret[i] = packed_pattern::BRIGHT;
+            }
+        }
+        return ret;
+    }
+
+    /// Rotates a pattern so it starts one frame later, with the first frame
+    /// wrapping around to the end: the packed equivalent of moving the first
+    /// character of the string to the end.
+    inline PackedPattern rotatePattern(PackedPattern pattern,
+                                       std::size_t length) {
+        auto first = (pattern >> (length - 1)) & 1;
+        return ((pattern << 1) | first) & packed_pattern::getMask(length);
+    }
+
+    /// Gets the smallest value among all rotations of a pattern, so that
+    /// patterns that are rotations of each other (and thus indistinguishable
+    /// when we don't know when the pattern started) compare equal.
+    inline PackedPattern canonicalPattern(PackedPattern pattern,
+                                          std::size_t length) {
+        auto ret = pattern;
+        for (std::size_t i = 1; i < length; ++i) {
+            pattern = rotatePattern(pattern, length);
+            if (pattern < ret) {
+                ret = pattern;
+            }
+        }
+        return ret;
+    }
+
+    /// Is the pattern identical to some non-trivial rotation of itself? (If
+    /// so, it has fewer distinct phases than frames.)
+    inline bool isPeriodicPattern(PackedPattern pattern, std::size_t length) {
+        auto rotated = pattern;
+        for (std::size_t i = 1; i < length; ++i) {
+            rotated = rotatePattern(rotated, length);
+            if (rotated == pattern) {
+                return true;
+            }
+        }
+        return false;
+    }
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_PackedLedPattern_h_GUID_3B8E5F21_7C4A_4D9E_A612_5E0F9C2D7B48
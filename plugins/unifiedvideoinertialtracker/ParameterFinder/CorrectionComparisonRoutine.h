@@ -0,0 +1,90 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_CorrectionComparisonRoutine_h_GUID_5D3B9E70_2A1F_4C86_B7E4_0F61C8A2D953
+#define INCLUDED_CorrectionComparisonRoutine_h_GUID_5D3B9E70_2A1F_4C86_B7E4_0F61C8A2D953
+
+// Internal Includes
+#include "OptimizationBase.h"
+#include "UtilityFunctions.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace osvr {
+namespace vbtracker {
+
+    /// Analysis routine: runs the main algorithm over the data set with the
+    /// one-beacon-at-a-time Kalman correction and with the batched one,
+    /// reporting accuracy (compared to the reference tracker) and time taken
+    /// for each.
+    void compareKalmanCorrection(MeasurementsRows const &data,
+                                 OptimCommonData const &commonData) {
+        for (auto batched : {false, true}) {
+            ConfigParams params = commonData.initialParams;
+            params.batchedKalmanCorrection = batched;
+
+            auto optim = OptimData::make(params, commonData);
+            MainAlgoUnderStudy mainAlgo;
+            ReferenceTracker ref;
+            std::size_t samples = 0;
+            double accum = 0;
+
+            auto begin = std::chrono::steady_clock::now();
+            for (auto const &rowPtr : data) {
+                mainAlgo(optim, *rowPtr);
+                ref(optim, *rowPtr);
+                if (mainAlgo.havePose()) {
+                    accum += costMeasurement(ref.getPose(), mainAlgo.getPose());
+                    samples++;
+                }
+            }
+            auto end = std::chrono::steady_clock::now();
+            auto elapsed =
+                std::chrono::duration<double, std::milli>(end - begin).count();
+
+            std::cout << (batched ? "Batched" : "One-at-a-time")
+                      << " Kalman correction:\n";
+            if (samples > 0) {
+                std::cout << "  average cost " << std::setw(9)
+                          << accum / static_cast<double>(samples) << " over "
+                          << samples << " frames with pose, "
+                          << mainAlgo.getNumResets(optim) << " resets\n";
+            } else {
+                std::cout << "  no frames with pose!\n";
+            }
+            std::cout << "  " << elapsed << " ms for " << data.size()
+                      << " frames (" << elapsed / data.size()
+                      << " ms per frame)" << std::endl;
+        }
+    }
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_CorrectionComparisonRoutine_h_GUID_5D3B9E70_2A1F_4C86_B7E4_0F61C8A2D953
@@ -34,18 +34,165 @@
 // - none
 
 // Standard includes
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
 
+    /// Runs the tracker over the whole data set with the given parameters,
+    /// comparing its results at each step to some source of reference data,
+    /// and returns the resulting cost.
+    ///
+    /// Only reads the data set and common data, and builds its own tracking
+    /// system, so it may be called concurrently from several threads. Its
+    /// summary line is written to the stream in a single operation, under the
+    /// lock, to keep concurrent output legible.
+    template <typename TrackingReferenceType, typename ParamSet>
+    double computeParamSetCost(MeasurementsRows const &data,
+                               OptimCommonData const &commonData,
+                               Vec<ParamSet::Dimension> const &paramVec,
+                               std::mutex &outputMutex) {
+        ConfigParams params = commonData.initialParams;
+
+        /// Update config from provided param vec
+        ParamSet::updateParamsFromVec(params, paramVec);
+
+        auto optim = OptimData::make(params, commonData);
+
+        MainAlgoUnderStudy mainAlgo;
+        TrackingReferenceType ref;
+        std::size_t samples = 0;
+        double accum = 0;
+
+        /// Main algorithm loop
+        for (auto const &rowPtr : data) {
+            mainAlgo(optim, *rowPtr);
+            ref(optim, *rowPtr);
+            if (ref.havePose() && mainAlgo.havePose()) {
+                auto cost = costMeasurement(ref.getPose(), mainAlgo.getPose());
+                accum += cost;
+                samples++;
+            }
+        }
+
+        std::ostringstream os;
+        auto effectiveCost = getReallyBigCost();
+        /// Cost accumulation/post-processing.
+        if (samples > 0) {
+            auto avgCost = (accum / static_cast<double>(samples));
+            auto numResets = mainAlgo.getNumResets(optim);
+            /// Sometimes gets stuck in parameter ditches where we get
+            /// very few tracked frames
+            effectiveCost =
+                avgCost * (numResets + 1) * (numResets + 1) / samples;
+            if (std::isnan(effectiveCost)) {
+                effectiveCost = getReallyBigCost();
+            }
+            os << std::setw(15) << std::to_string(effectiveCost)
+               << " effective cost (average cost of " << std::setw(9)
+               << avgCost << " over " << std::setw(4) << samples
+               << " eligible frames with " << std::setw(2) << numResets
+               << " resets)\n";
+        } else {
+            os << "No samples with pose for both algorithms?\n";
+        }
+        {
+            std::lock_guard<std::mutex> lock(outputMutex);
+            std::cout << os.str() << std::flush;
+        }
+        return effectiveCost;
+    }
+
+    /// Parallel multi-start variant of the optimizer: runs independent
+    /// NEWUOA searches from the initial vector and from random perturbations
+    /// of it (seeded deterministically, scaled by the initial trust region
+    /// radius), on as many threads as are useful, and keeps the best result.
+    ///
+    /// The loaded data set is shared, read-only, among all the threads: only
+    /// the tracking system is built per cost evaluation, as in the serial
+    /// optimizer.
+    template <typename TrackingReferenceType, typename ParamSet>
+    void runParallelOptimizer(MeasurementsRows const &data,
+                              OptimCommonData const &commonData,
+                              std::size_t maxRuns, std::size_t numStarts,
+                              Vec<ParamSet::Dimension> &x) {
+        using ParamVec = Vec<ParamSet::Dimension>;
+        const auto rho = ParamSet::getRho();
+        const auto rhoBeg = std::max(rho.first, rho.second);
+
+        std::vector<ParamVec> starts(numStarts, x);
+        {
+            std::mt19937 rng(0);
+            std::uniform_real_distribution<double> dist(-rhoBeg, rhoBeg);
+            for (std::size_t i = 1; i < numStarts; ++i) {
+                for (std::size_t j = 0; j < ParamSet::Dimension; ++j) {
+                    starts[i][j] += dist(rng);
+                }
+            }
+        }
+        std::vector<double> results(numStarts, getReallyBigCost());
+
+        std::size_t numThreads = std::thread::hardware_concurrency();
+        numThreads = std::max<std::size_t>(
+            1, std::min(numThreads == 0 ? 1 : numThreads, numStarts));
+        std::cout << "Running " << numStarts << " optimizer starts on "
+                  << numThreads << " threads" << std::endl;
+
+        std::mutex outputMutex;
+        std::atomic<std::size_t> nextStart(0);
+        auto worker = [&] {
+            while (true) {
+                auto i = nextStart++;
+                if (i >= numStarts) {
+                    return;
+                }
+                auto functor = [&](ParamVec const &paramVec) -> double {
+                    return computeParamSetCost<TrackingReferenceType,
+                                               ParamSet>(
+                        data, commonData, paramVec, outputMutex);
+                };
+                results[i] = ei_newuoa_wrapped(
+                    starts[i], rho, static_cast<long>(maxRuns), functor);
+                std::lock_guard<std::mutex> lock(outputMutex);
+                std::cout << "Optimizer start " << i << " finished with cost "
+                          << results[i] << std::endl;
+            }
+        };
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < numThreads; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        auto best = std::distance(
+            results.begin(), std::min_element(results.begin(), results.end()));
+        std::cout << "Best result came from optimizer start " << best
+                  << std::endl;
+        x = starts[best];
+    }
+
     /// The main optimization routine, in which we run the tracker repeatedly
     /// with different parameters and compare its results at each step to some
     /// source of reference data.
+    ///
+    /// With numStarts greater than 1, runs that many optimizer starts in
+    /// parallel (see runParallelOptimizer()).
     template <typename TrackingReferenceType, typename ParamSet>
     void runOptimizer(MeasurementsRows const &data, bool costOnly,
-                      OptimCommonData const &commonData, std::size_t maxRuns) {
+                      OptimCommonData const &commonData, std::size_t maxRuns,
+                      std::size_t numStarts) {
 
         std::cout << "Max runs: " << maxRuns << std::endl;
 
@@ -58,52 +205,10 @@ namespace vbtracker {
                   << ParamSet::getVecElementNames() << "\n";
         std::cout << "Initial vector:\n"
                   << x.format(getFullFormat()) << std::endl;
+        std::mutex outputMutex;
         auto functor = [&](ParamVec const &paramVec) -> double {
-            ConfigParams params = commonData.initialParams;
-
-            /// Update config from provided param vec
-            ParamSet::updateParamsFromVec(params, paramVec);
-
-            auto optim = OptimData::make(params, commonData);
-
-            MainAlgoUnderStudy mainAlgo;
-            TrackingReferenceType ref;
-            std::size_t samples = 0;
-            double accum = 0;
-
-            /// Main algorithm loop
-            for (auto const &rowPtr : data) {
-                mainAlgo(optim, *rowPtr);
-                ref(optim, *rowPtr);
-                if (ref.havePose() && mainAlgo.havePose()) {
-                    auto cost =
-                        costMeasurement(ref.getPose(), mainAlgo.getPose());
-                    accum += cost;
-                    samples++;
-                }
-            }
-
-            /// Cost accumulation/post-processing.
-            if (samples > 0) {
-                auto avgCost = (accum / static_cast<double>(samples));
-                auto numResets = mainAlgo.getNumResets(optim);
-                /// Sometimes gets stuck in parameter ditches where we get
-                /// very few tracked frames
-                auto effectiveCost =
-                    avgCost * (numResets + 1) * (numResets + 1) / samples;
-                if (std::isnan(effectiveCost)) {
-                    effectiveCost = getReallyBigCost();
-                }
-                std::cout << std::setw(15) << std::to_string(effectiveCost)
-                          << " effective cost (average cost of " << std::setw(9)
-                          << avgCost << " over " << std::setw(4) << samples
-                          << " eligible frames with " << std::setw(2)
-                          << numResets << " resets)\n";
-                return effectiveCost;
-            }
-            std::cout << "No samples with pose for both algorithms?"
-                      << std::endl;
-            return getReallyBigCost();
+            return computeParamSetCost<TrackingReferenceType, ParamSet>(
+                data, commonData, paramVec, outputMutex);
         };
 
         if (costOnly) {
@@ -113,16 +218,24 @@ namespace vbtracker {
                 << cost << std::endl;
             return;
         }
-        auto ret = ei_newuoa_wrapped(x, ParamSet::getRho(),
-                                     static_cast<long>(maxRuns), functor);
-        std::cout << "Optimizer returned " << ret
-                  << " and these parameter values:" << std::endl;
+        if (numStarts > 1) {
+            runParallelOptimizer<TrackingReferenceType, ParamSet>(
+                data, commonData, maxRuns, numStarts, x);
+            std::cout << "Parallel optimizer chose these parameter values:"
+                      << std::endl;
+        } else {
+            auto ret = ei_newuoa_wrapped(x, ParamSet::getRho(),
+                                         static_cast<long>(maxRuns), functor);
+            std::cout << "Optimizer returned " << ret
+                      << " and these parameter values:" << std::endl;
+        }
         std::cout << x.format(getFullFormat()) << std::endl;
         std::cout << "for parameters described as, respectively,\n"
                   << ParamSet::getVecElementNames() << std::endl;
     }
-    using ParamOptimizerFunc = std::function<void(
-        MeasurementsRows const &, bool, OptimCommonData const &, std::size_t)>;
+    using ParamOptimizerFunc =
+        std::function<void(MeasurementsRows const &, bool,
+                           OptimCommonData const &, std::size_t, std::size_t)>;
 } // namespace vbtracker
 } // namespace osvr
 #endif // INCLUDED_ParamFindingRoutine_h_GUID_C2088279_D54B_4D8B_562E_5748C748DAD0
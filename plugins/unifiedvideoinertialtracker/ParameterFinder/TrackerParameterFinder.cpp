@@ -23,6 +23,7 @@
 // limitations under the License.
 
 // Internal Includes
+#include "CorrectionComparisonRoutine.h"
 #include "LoadRows.h"
 #include "ParamFindingRoutine.h"
 #include "ParameterSets.h"
@@ -36,7 +37,10 @@
 #include <boost/algorithm/string/predicate.hpp> // for argument handling
 
 // Standard includes
+#include <algorithm>
 #include <iostream>
+#include <string>
+#include <thread>
 
 /// Define to add a "press enter to exit" thing at the end.
 #undef PAUSE_BEFORE_EXIT
@@ -56,6 +60,7 @@ enum class OptimizationRoutine {
     RefTracker,
     ParamViaRansac,
     ParamViaRefTracker,
+    CompareKalmanCorrection,
     Unrecognized = -1
 };
 
@@ -63,7 +68,8 @@ static const auto DEFAULT_ROUTINE = OptimizationRoutine::RefTracker;
 
 static const auto RECOGNIZED_ROUTINES = {
     OptimizationRoutine::RefTracker, OptimizationRoutine::ParamViaRansac,
-    OptimizationRoutine::ParamViaRefTracker};
+    OptimizationRoutine::ParamViaRefTracker,
+    OptimizationRoutine::CompareKalmanCorrection};
 
 const char *routineToString(OptimizationRoutine routine) {
     switch (routine) {
@@ -76,6 +82,9 @@ const char *routineToString(OptimizationRoutine routine) {
     case OptimizationRoutine::ParamViaRefTracker:
         return "ParamViaRefTracker";
         break;
+    case OptimizationRoutine::CompareKalmanCorrection:
+        return "CompareKalmanCorrection";
+        break;
     case OptimizationRoutine::Unrecognized:
     default:
         return "ERROR - UNRECOGNIZED";
@@ -102,7 +111,8 @@ struct PrintParamSetOptions {
 };
 
 int usage(const char *argv0) {
-    std::cerr << "Usage: " << argv0 << " [<routine> [<paramset> [--cost]]]\n"
+    std::cerr << "Usage: " << argv0
+              << " [<routine> [<paramset> [--cost | --parallel[=<n>]]]]\n"
               << std::endl;
     std::cerr
         << "where <routine> is one of the following (case insensitive): \n";
@@ -117,7 +127,10 @@ int usage(const char *argv0) {
     osvr::typepack::for_each_type<ps::ParamSets>(PrintParamSetOptions{});
     std::cerr << "as well as an additional optional switch, --cost, if you'd "
                  "like to just run the current parameters through and compute "
-                 "the cost, rather than optimize.\n\n";
+                 "the cost, rather than optimize, or --parallel, to run "
+                 "several optimizer starts concurrently (one per hardware "
+                 "thread, unless you specify a number with --parallel=<n>) "
+                 "and keep the best result.\n\n";
     std::cerr
         << "\nIf no routine is explicitly specified, the default routine is "
         << routineToString(DEFAULT_ROUTINE) << "\n";
@@ -149,15 +162,40 @@ template <typename RefSource> class ParseArgumentAsParamSet {
 
 template <typename RefSource>
 int parseParamSetForParamOptimizer(osvr::vbtracker::ParamOptimizerFunc &func,
-                                   bool &costOnly, int argc, char *argv[]) {
+                                   bool &costOnly, std::size_t &numStarts,
+                                   int argc, char *argv[]) {
     if (argc > 4) {
         std::cerr << "Too many command line arguments!" << std::endl;
         return usage(argv[0]);
     }
     if (argc > 3) {
-        if (boost::iequals(argv[3], "--cost")) {
+        static const auto PARALLEL_SWITCH = std::string("--parallel");
+        const auto arg = std::string(argv[3]);
+        if (boost::iequals(arg, "--cost")) {
             std::cout << "Will run for just cost-only." << std::endl;
             costOnly = true;
+        } else if (boost::istarts_with(arg, PARALLEL_SWITCH)) {
+            numStarts = std::max(1u, std::thread::hardware_concurrency());
+            if (arg.size() > PARALLEL_SWITCH.size()) {
+                if (arg[PARALLEL_SWITCH.size()] != '=') {
+                    std::cerr << "Didn't recognize " << arg << std::endl;
+                    return usage(argv[0]);
+                }
+                try {
+                    numStarts = std::stoul(
+                        arg.substr(PARALLEL_SWITCH.size() + 1));
+                } catch (std::exception &) {
+                    numStarts = 0;
+                }
+                if (numStarts == 0) {
+                    std::cerr << "Couldn't parse a positive number of "
+                                 "parallel optimizer starts from "
+                              << arg << std::endl;
+                    return usage(argv[0]);
+                }
+            }
+            std::cout << "Will run " << numStarts
+                      << " optimizer starts in parallel." << std::endl;
         } else {
             std::cerr << "Too many command line arguments - didn't recognize "
                          "the last one!"
@@ -224,6 +262,7 @@ int main(int argc, char *argv[]) {
     }
 
     bool costOnly = false;
+    std::size_t numStarts = 1;
     osvr::vbtracker::ParamOptimizerFunc paramOptFunc;
     {
         int ret = 0;
@@ -231,7 +270,7 @@ int main(int argc, char *argv[]) {
         case OptimizationRoutine::ParamViaRansac:
             ret =
                 parseParamSetForParamOptimizer<osvr::vbtracker::RansacOneEuro>(
-                    paramOptFunc, costOnly, argc, argv);
+                    paramOptFunc, costOnly, numStarts, argc, argv);
             if (ret != 0) {
                 /// There was an error, and the function already told the user
                 /// about it.
@@ -242,8 +281,8 @@ int main(int argc, char *argv[]) {
         case OptimizationRoutine::ParamViaRefTracker:
 
             ret = parseParamSetForParamOptimizer<
-                osvr::vbtracker::ReferenceTracker>(paramOptFunc, costOnly, argc,
-                                                   argv);
+                osvr::vbtracker::ReferenceTracker>(paramOptFunc, costOnly,
+                                                   numStarts, argc, argv);
             if (ret != 0) {
                 /// There was an error, and the function already told the user
                 /// about it.
@@ -252,6 +291,7 @@ int main(int argc, char *argv[]) {
             break;
 
         case OptimizationRoutine::RefTracker:
+        case OptimizationRoutine::CompareKalmanCorrection:
         /// no param set here
         default:
             if (argc > 2) {
@@ -291,16 +331,25 @@ int main(int argc, char *argv[]) {
             data, osvr::vbtracker::OptimCommonData{camParams, params});
         break;
 
+    case OptimizationRoutine::CompareKalmanCorrection:
+        /// Not an optimization: runs the tracker with each of the Kalman
+        /// correction modes to compare their accuracy and speed.
+        osvr::vbtracker::compareKalmanCorrection(
+            data, osvr::vbtracker::OptimCommonData{camParams, params});
+        break;
+
     case OptimizationRoutine::ParamViaRansac:
 
         paramOptFunc(data, costOnly,
-                     osvr::vbtracker::OptimCommonData{camParams, params}, 30);
+                     osvr::vbtracker::OptimCommonData{camParams, params}, 30,
+                     numStarts);
         break;
 
     case OptimizationRoutine::ParamViaRefTracker:
 
         paramOptFunc(data, costOnly,
-                     osvr::vbtracker::OptimCommonData{camParams, params}, 300);
+                     osvr::vbtracker::OptimCommonData{camParams, params}, 300,
+                     numStarts);
         break;
 
     default:
@@ -99,6 +99,7 @@ namespace vbtracker {
           m_distanceMeasVarianceIntercept(
               params.tuning.distanceMeasVarianceIntercept),
           m_extraVerbose(params.extraVerbose),
+          m_batchedCorrection(params.batchedKalmanCorrection),
           m_randEngine(std::random_device()()) {
         std::tie(m_minBoxRatio, m_maxBoxRatio) =
             std::minmax({params.boundingBoxFilterRatio,
@@ -325,6 +326,13 @@ namespace vbtracker {
             debug.variance = effectiveVariance;
             meas.setVariance(effectiveVariance);
 
+            if (m_batchedCorrection) {
+                /// Correct with all of them at once, below - so in this mode,
+                /// every beacon was gated against the same predicted state.
+                m_batch.add(state, meas);
+                continue;
+            }
+
             /// Now, do the correction.
             auto model = kalman::makeAugmentedProcessModel(p.processModel,
                                                            beaconProcess);
@@ -361,6 +369,15 @@ namespace vbtracker {
             gotMeasurement = true;
         }
 
+        if (!m_batch.empty()) {
+            auto numBatched = m_batch.size();
+            gotMeasurement = m_batch.apply(p.state);
+            if (!gotMeasurement) {
+                std::cout << "Non-finite state correction processing batch of "
+                          << numBatched << " beacons" << std::endl;
+            }
+        }
+
         handlePossiblyMisidentifiedLeds();
 
         if (gotMeasurement) {
@@ -26,6 +26,7 @@
 #define INCLUDED_PoseEstimator_SCAATKalman_h_GUID_F1FC2154_E59B_4598_70C2_253F8EA31485
 
 // Internal Includes
+#include "BatchedBeaconCorrection.h"
 #include "ConfigParams.h"
 #include "ModelTypes.h"
 #include "PoseEstimatorTypes.h"
@@ -100,6 +101,8 @@ namespace vbtracker {
         const double m_distanceMeasVarianceBase;
         const double m_distanceMeasVarianceIntercept;
         const bool m_extraVerbose;
+        const bool m_batchedCorrection;
+        BatchedBeaconCorrection m_batch;
         std::mt19937 m_randEngine;
         static const int SIGNAL_HAVE_NOT_SEEN_BEACONS_YET = -1;
         int m_lastUsableBeaconsSeen = SIGNAL_HAVE_NOT_SEEN_BEACONS_YET;
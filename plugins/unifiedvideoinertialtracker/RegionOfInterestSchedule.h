@@ -0,0 +1,78 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_RegionOfInterestSchedule_h_GUID_363B2E14_E418_4E21_9928_114C90012C03
+#define INCLUDED_RegionOfInterestSchedule_h_GUID_363B2E14_E418_4E21_9928_114C90012C03
+
+// Internal Includes
+#include "ConfigParams.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+
+namespace osvr {
+namespace vbtracker {
+    /// Decides, frame by frame, whether blob extraction may be limited to the
+    /// regions of interest around predicted beacons, or has to process the
+    /// full frame.
+    class RegionOfInterestSchedule {
+      public:
+        explicit RegionOfInterestSchedule(RegionOfInterestParams const &params)
+            : m_params(params) {}
+
+        /// @param havePredictions Whether any target has predicted beacons.
+        /// @param allPredicted Whether every target does.
+        /// @returns true if the next frame should be processed in full.
+        bool useFullFrame(bool havePredictions, bool allPredicted) {
+            if (m_framesSinceFullFrame >= m_params.fullFrameInterval) {
+                /// Time for a full frame, or a run of them if there's a
+                /// target to find.
+                m_fullFramesLeft =
+                    allPredicted ? 1 : std::max(1, m_params.searchFrames);
+            }
+            if (!havePredictions || m_fullFramesLeft > 0) {
+                if (m_fullFramesLeft > 0) {
+                    --m_fullFramesLeft;
+                }
+                m_framesSinceFullFrame = 0;
+                return true;
+            }
+            ++m_framesSinceFullFrame;
+            return false;
+        }
+
+      private:
+        RegionOfInterestParams m_params;
+        /// Frames processed by regions of interest since the last full frame.
+        int m_framesSinceFullFrame = 0;
+        /// Full frames left in the current run of them.
+        int m_fullFramesLeft = 0;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_RegionOfInterestSchedule_h_GUID_363B2E14_E418_4E21_9928_114C90012C03
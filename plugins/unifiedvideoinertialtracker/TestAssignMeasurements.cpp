@@ -0,0 +1,182 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "AssignMeasurementsToLeds.h"
+
+// Library/third-party includes
+#include <catch.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace osvr::vbtracker;
+
+namespace {
+static const cv::Size IMAGE_SIZE(640, 480);
+static const float BLOB_MOVE_THRESH = 4.f;
+
+using MatchList = std::vector<std::pair<Led const *, LedMeasurement const *>>;
+
+LedMeasurement makeMeasurement(float x, float y, float diameter) {
+    return LedMeasurement(x, y, diameter, IMAGE_SIZE);
+}
+
+/// Drains every match out of AssignMeasurementsToLeds, which finds the
+/// candidates with its grid.
+MatchList matchWithGrid(LedGroup &leds, LedMeasurementVec const &meas) {
+    AssignMeasurementsToLeds assignment(leds, meas, leds.size(),
+                                        BLOB_MOVE_THRESH);
+    assignment.populateStructures();
+    MatchList ret;
+    while (assignment.hasMoreMatches()) {
+        auto match = assignment.getMatch();
+        ret.emplace_back(&match.first, &match.second);
+    }
+    return ret;
+}
+
+/// The same greedy closest-first matching, considering every LED and
+/// measurement pair.
+MatchList matchByBruteForce(LedGroup const &leds,
+                            LedMeasurementVec const &meas) {
+    using Candidate = std::tuple<float, Led const *, LedMeasurement const *>;
+    std::vector<Candidate> candidates;
+    for (auto const &led : leds) {
+        for (auto const &m : meas) {
+            auto thresh = BLOB_MOVE_THRESH * m.diameter;
+            auto dist = sqDist(led.getLocation(), m.loc);
+            if (dist < thresh * thresh) {
+                candidates.emplace_back(dist, &led, &m);
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](Candidate const &a, Candidate const &b) {
+                  return std::get<0>(a) < std::get<0>(b);
+              });
+    std::vector<Led const *> usedLeds;
+    std::vector<LedMeasurement const *> usedMeas;
+    MatchList ret;
+    for (auto const &c : candidates) {
+        auto led = std::get<1>(c);
+        auto m = std::get<2>(c);
+        if (std::find(usedLeds.begin(), usedLeds.end(), led) !=
+                usedLeds.end() ||
+            std::find(usedMeas.begin(), usedMeas.end(), m) != usedMeas.end()) {
+            continue;
+        }
+        usedLeds.push_back(led);
+        usedMeas.push_back(m);
+        ret.emplace_back(led, m);
+    }
+    return ret;
+}
+
+void requireSameMatches(LedGroup &leds, LedMeasurementVec const &meas) {
+    auto expected = matchByBruteForce(leds, meas);
+    auto actual = matchWithGrid(leds, meas);
+    REQUIRE(actual.size() == expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        CAPTURE(i);
+        /// LEDs at the same location are interchangeable.
+        REQUIRE(actual[i].first->getLocation() ==
+                expected[i].first->getLocation());
+        REQUIRE(actual[i].second == expected[i].second);
+    }
+}
+
+void addLed(LedGroup &leds, float x, float y) {
+    leds.emplace_back(nullptr, makeMeasurement(x, y, 4.f));
+}
+} // namespace
+
+TEST_CASE("AssignMeasurementsToLeds grid matches brute force") {
+    LedGroup leds;
+    LedMeasurementVec meas;
+    std::mt19937 gen(4321);
+
+    SECTION("no LEDs") {
+        meas.push_back(makeMeasurement(10, 10, 4));
+        requireSameMatches(leds, meas);
+    }
+    SECTION("no measurements") {
+        addLed(leds, 10, 10);
+        requireSameMatches(leds, meas);
+    }
+    SECTION("all LEDs at one point") {
+        for (int i = 0; i < 5; ++i) {
+            addLed(leds, 100, 100);
+        }
+        meas.push_back(makeMeasurement(101, 100, 2));
+        meas.push_back(makeMeasurement(100, 140, 2));
+        meas.push_back(makeMeasurement(100, 103, 1));
+        requireSameMatches(leds, meas);
+    }
+    SECTION("measurements outside the LED bounds") {
+        addLed(leds, 100, 100);
+        addLed(leds, 120, 110);
+        meas.push_back(makeMeasurement(90, 95, 4));
+        meas.push_back(makeMeasurement(130, 125, 6));
+        meas.push_back(makeMeasurement(-20, 500, 20));
+        requireSameMatches(leds, meas);
+    }
+    SECTION("random scenes") {
+        std::uniform_real_distribution<float> xDist(0.f, IMAGE_SIZE.width);
+        std::uniform_real_distribution<float> yDist(0.f, IMAGE_SIZE.height);
+        std::uniform_real_distribution<float> jitter(-12.f, 12.f);
+        std::uniform_real_distribution<float> diameter(0.5f, 8.f);
+        std::uniform_int_distribution<int> count(0, 60);
+        for (int scene = 0; scene < 200; ++scene) {
+            CAPTURE(scene);
+            leds.clear();
+            meas.clear();
+            auto nLeds = count(gen);
+            for (int i = 0; i < nLeds; ++i) {
+                addLed(leds, xDist(gen), yDist(gen));
+            }
+            /// Measurements near the LEDs, some spurious ones anywhere, and
+            /// an occasional huge one whose radius spans many cells.
+            for (auto const &led : leds) {
+                auto loc = led.getLocation();
+                meas.push_back(makeMeasurement(loc.x + jitter(gen),
+                                               loc.y + jitter(gen),
+                                               diameter(gen)));
+            }
+            auto nSpurious = count(gen) / 4;
+            for (int i = 0; i < nSpurious; ++i) {
+                meas.push_back(
+                    makeMeasurement(xDist(gen), yDist(gen), diameter(gen)));
+            }
+            if (scene % 10 == 0) {
+                meas.push_back(makeMeasurement(xDist(gen), yDist(gen), 40.f));
+            }
+            requireSameMatches(leds, meas);
+        }
+    }
+}
@@ -0,0 +1,251 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "BatchedBeaconCorrection.h"
+#include "ImagePointMeasurement.h"
+#include "ModelTypes.h"
+#include <osvr/Kalman/AugmentedProcessModel.h>
+#include <osvr/Kalman/ConstantProcess.h>
+#include <osvr/Kalman/FlexibleKalmanCorrect.h>
+
+// Library/third-party includes
+#include <Eigen/Cholesky>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <catch.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace osvr::vbtracker;
+
+namespace {
+static const double TOLERANCE = 1e-12;
+static const std::size_t BODY_DIM = batched_correction::BODY_DIM;
+static const std::size_t BEACON_DIM = batched_correction::BEACON_DIM;
+static const std::size_t MEAS_DIM = batched_correction::MEAS_DIM;
+
+/// Elementwise agreement, relative to the magnitude of the expected values
+/// where they're larger than 1.
+template <typename Actual, typename Expected>
+bool agrees(Actual const &actual, Expected const &expected) {
+    double scale = std::max(1., expected.cwiseAbs().maxCoeff());
+    return (actual - expected).cwiseAbs().maxCoeff() <= TOLERANCE * scale;
+}
+
+CameraModel makeCamera() {
+    CameraModel cam;
+    cam.principalPoint = Eigen::Vector2d(320, 240);
+    cam.focalLength = 700;
+    return cam;
+}
+
+/// A deterministic, well-conditioned, symmetric positive-definite matrix.
+Eigen::MatrixXd makeCovariance(std::size_t n, double scale, int seed) {
+    Eigen::MatrixXd a(n, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            a(i, j) = ((seed + 7 * i + 13 * j + i * j) % 11) / 11. - 0.5;
+        }
+    }
+    return scale * (a * a.transpose() / n +
+                    Eigen::MatrixXd::Identity(n, n) * 0.1);
+}
+
+BodyState makeBody() {
+    BodyState body;
+    Eigen::Matrix<double, BODY_DIM, 1> x;
+    x << 0.03, -0.02, 0.45, 0, 0, 0, 0.1, 0.05, -0.2, 0.3, -0.1, 0.2;
+    body.setStateVector(x);
+    body.setQuaternion(
+        Eigen::Quaterniond(Eigen::AngleAxisd(0.3, Eigen::Vector3d(1, 2, 3)
+                                                      .normalized())));
+    body.setErrorCovariance(makeCovariance(BODY_DIM, 1e-3, 1));
+    return body;
+}
+
+std::vector<BeaconState> makeBeacons() {
+    std::vector<BeaconState> beacons;
+    beacons.emplace_back(0.002, -0.001, 0.,
+                         makeCovariance(BEACON_DIM, 1e-5, 2));
+    beacons.emplace_back(-0.001, 0.003, 0.001,
+                         makeCovariance(BEACON_DIM, 2e-5, 3));
+    beacons.emplace_back(0., 0.001, -0.002,
+                         makeCovariance(BEACON_DIM, 1e-5, 4));
+    return beacons;
+}
+
+/// Beacon positions in the target frame, before autocalibration.
+std::vector<Eigen::Vector3d> makeBeaconLocations() {
+    return {Eigen::Vector3d(0.04, 0.02, 0.), Eigen::Vector3d(-0.03, 0.01, 0.01),
+            Eigen::Vector3d(0.01, -0.04, 0.02)};
+}
+
+/// A measurement of a beacon: which one, the offset from where the state
+/// predicts it to be seen, and its variance.
+struct Observation {
+    std::size_t beacon;
+    Eigen::Vector2d offset;
+    double variance;
+};
+
+ImagePointMeasurement makeMeasurement(AugmentedStateWithBeacon const &state,
+                                      Eigen::Vector3d const &location,
+                                      Observation const &obs) {
+    ImagePointMeasurement meas(makeCamera(), location);
+    meas.updateFromState(state);
+    /// With no measurement set yet, the residual is minus the prediction.
+    meas.setMeasurement(Eigen::Vector2d::Zero());
+    meas.setMeasurement(obs.offset - meas.getResidual(state));
+    meas.setVariance(obs.variance);
+    return meas;
+}
+
+/// The body state a correction of the given body state vector should
+/// produce: only the externalized rotation differs.
+BodyState correctedBody(BodyState const &body,
+                        Eigen::Matrix<double, BODY_DIM, 1> const &x,
+                        Eigen::MatrixXd const &cov) {
+    BodyState ret = body;
+    ret.setStateVector(x);
+    ret.setErrorCovariance(cov);
+    ret.postCorrect();
+    return ret;
+}
+
+void checkBody(BodyState const &actual, BodyState const &expected) {
+    REQUIRE(agrees(actual.stateVector(), expected.stateVector()));
+    REQUIRE(agrees(actual.getQuaternion().coeffs(),
+                   expected.getQuaternion().coeffs()));
+    REQUIRE(agrees(actual.errorCovariance(), expected.errorCovariance()));
+}
+} // namespace
+
+TEST_CASE("Batched correction of one beacon matches the SCAAT correction") {
+    auto location = makeBeaconLocations()[0];
+    Observation obs{0, Eigen::Vector2d(1.5, -2.), 2.};
+
+    auto seqBody = makeBody();
+    auto seqBeacon = makeBeacons()[0];
+    {
+        auto state = osvr::kalman::makeAugmentedState(seqBody, seqBeacon);
+        auto meas = makeMeasurement(state, location, obs);
+        BodyProcessModel processModel;
+        osvr::kalman::ConstantProcess<BeaconState> beaconProcess;
+        auto model = osvr::kalman::makeAugmentedProcessModel(processModel,
+                                                             beaconProcess);
+        auto correction = osvr::kalman::beginCorrection(state, model, meas);
+        REQUIRE(correction.stateCorrectionFinite);
+        REQUIRE(correction.finishCorrection());
+    }
+
+    auto batchBody = makeBody();
+    auto batchBeacon = makeBeacons()[0];
+    BatchedBeaconCorrection batch;
+    {
+        auto state = osvr::kalman::makeAugmentedState(batchBody, batchBeacon);
+        batch.add(state, makeMeasurement(state, location, obs));
+    }
+    REQUIRE(batch.size() == 1);
+    REQUIRE(batch.apply(batchBody));
+    REQUIRE(batch.empty());
+
+    checkBody(batchBody, seqBody);
+    REQUIRE(agrees(batchBeacon.stateVector(), seqBeacon.stateVector()));
+    REQUIRE(
+        agrees(batchBeacon.errorCovariance(), seqBeacon.errorCovariance()));
+}
+
+TEST_CASE("Batched correction matches sequential correction of the frame") {
+    /// Includes a beacon measured twice, which couples its measurements.
+    const std::vector<Observation> observations = {
+        {0, Eigen::Vector2d(1.5, -2.), 2.},
+        {1, Eigen::Vector2d(-0.5, 0.75), 1.},
+        {2, Eigen::Vector2d(3., 1.), 4.},
+        {0, Eigen::Vector2d(0.25, -1.), 3.}};
+    auto locations = makeBeaconLocations();
+    const auto body = makeBody();
+    const auto beacons = makeBeacons();
+    const auto numBeacons = beacons.size();
+
+    /// Batched: every measurement is made against the same predicted state.
+    auto batchBody = body;
+    auto batchBeacons = beacons;
+    BatchedBeaconCorrection batch;
+    for (auto const &obs : observations) {
+        auto state = osvr::kalman::makeAugmentedState(
+            batchBody, batchBeacons[obs.beacon]);
+        batch.add(state, makeMeasurement(state, locations[obs.beacon], obs));
+    }
+    REQUIRE(batch.size() == observations.size());
+    REQUIRE(batch.apply(batchBody));
+
+    /// Sequential: the textbook one-measurement-at-a-time update of the
+    /// full augmented state (body and all beacons), linearized at the same
+    /// predicted state, keeping all cross-covariances between steps.
+    const auto n = BODY_DIM + numBeacons * BEACON_DIM;
+    Eigen::MatrixXd P = Eigen::MatrixXd::Zero(n, n);
+    P.topLeftCorner<BODY_DIM, BODY_DIM>() = body.errorCovariance();
+    for (std::size_t b = 0; b < numBeacons; ++b) {
+        P.block<BEACON_DIM, BEACON_DIM>(BODY_DIM + b * BEACON_DIM,
+                                        BODY_DIM + b * BEACON_DIM) =
+            beacons[b].errorCovariance();
+    }
+    Eigen::VectorXd dx = Eigen::VectorXd::Zero(n);
+    for (auto const &obs : observations) {
+        auto bodyCopy = body;
+        auto beaconCopy = beacons[obs.beacon];
+        auto state = osvr::kalman::makeAugmentedState(bodyCopy, beaconCopy);
+        auto meas = makeMeasurement(state, locations[obs.beacon], obs);
+        ImagePointMeasurement::Jacobian Hsmall = meas.getJacobian(state);
+        Eigen::MatrixXd H = Eigen::MatrixXd::Zero(MEAS_DIM, n);
+        H.leftCols<BODY_DIM>() = Hsmall.leftCols<BODY_DIM>();
+        H.middleCols<BEACON_DIM>(BODY_DIM + obs.beacon * BEACON_DIM) =
+            Hsmall.rightCols<BEACON_DIM>();
+        Eigen::VectorXd innovation = meas.getResidual(state) - H * dx;
+        Eigen::MatrixXd PHt = P * H.transpose();
+        Eigen::MatrixXd S = H * PHt + meas.getCovariance(state);
+        Eigen::LDLT<Eigen::MatrixXd> denom(S);
+        dx += PHt * denom.solve(innovation);
+        P -= PHt * denom.solve(PHt.transpose());
+    }
+
+    auto expectedBody =
+        correctedBody(body, body.stateVector() + dx.head<BODY_DIM>(),
+                      P.topLeftCorner<BODY_DIM, BODY_DIM>());
+    checkBody(batchBody, expectedBody);
+    for (std::size_t b = 0; b < numBeacons; ++b) {
+        const auto offset = BODY_DIM + b * BEACON_DIM;
+        CAPTURE(b);
+        REQUIRE(agrees(batchBeacons[b].stateVector(),
+                       beacons[b].stateVector() +
+                           dx.segment<BEACON_DIM>(offset)));
+        REQUIRE(agrees(batchBeacons[b].errorCovariance(),
+                       P.block<BEACON_DIM, BEACON_DIM>(offset, offset)));
+    }
+}
@@ -0,0 +1,246 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "OfflineProcessing/BlobMeasurementCache.h"
+
+// Library/third-party includes
+#include <catch.hpp>
+
+// Standard includes
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace osvr::vbtracker;
+
+namespace {
+static const char CACHE_FILE[] = "uvbi-test-blob-cache.bin";
+static const cv::Size IMAGE_SIZE(640, 480);
+
+/// Removes the cache file when the test is done with it.
+struct CacheFileCleanup {
+    ~CacheFileCleanup() { std::remove(CACHE_FILE); }
+};
+
+std::string readFile() {
+    std::ifstream file(CACHE_FILE, std::ios::in | std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>());
+}
+
+void writeFile(std::string const &contents) {
+    std::ofstream file(CACHE_FILE,
+                       std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(contents.data(), contents.size());
+}
+
+void openCache() { BlobCacheReader reader(CACHE_FILE); }
+
+osvr::util::time::TimeValue makeTime(std::int64_t seconds,
+                                     std::int32_t microseconds) {
+    osvr::util::time::TimeValue ret;
+    ret.seconds = seconds;
+    ret.microseconds = microseconds;
+    return ret;
+}
+
+LedMeasurementVec makeMeasurements() {
+    LedMeasurementVec ret;
+    ret.emplace_back(12.5f, 300.25f, 4.f, IMAGE_SIZE, 11.5f);
+    ret.back().circularity = 0.75f;
+    ret.emplace_back(600.f, 7.125f, 6.5f, IMAGE_SIZE, 30.f);
+    ret.back().circularity = 0.5f;
+    ret.back().setBoundingBox(cv::Size2f(7.f, 6.f));
+    return ret;
+}
+
+void requireSameTime(osvr::util::time::TimeValue const &a,
+                     osvr::util::time::TimeValue const &b) {
+    REQUIRE(a.seconds == b.seconds);
+    REQUIRE(a.microseconds == b.microseconds);
+}
+
+void requireSameMeasurements(LedMeasurementVec const &expected,
+                             LedMeasurementVec const &actual) {
+    REQUIRE(actual.size() == expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        auto const &e = expected[i];
+        auto const &a = actual[i];
+        REQUIRE(a.loc == e.loc);
+        REQUIRE(a.diameter == e.diameter);
+        REQUIRE(a.area == e.area);
+        REQUIRE(a.circularity == e.circularity);
+        REQUIRE(a.imageSize == e.imageSize);
+        REQUIRE(a.knowBoundingBox() == e.knowBoundingBox());
+        if (e.knowBoundingBox()) {
+            REQUIRE(a.boundingBoxSize() == e.boundingBoxSize());
+        }
+        REQUIRE(a == e);
+    }
+}
+
+/// Writes two frames: the first with an orientation and an angular velocity
+/// sample ahead of it, the second with none.
+void writeCache() {
+    BlobCacheWriter writer(CACHE_FILE, IMAGE_SIZE);
+    CannedIMUMeasurement orientation;
+    orientation.setYawCorrection(0.25 * osvr::util::radians);
+    orientation.setOrientation(
+        Eigen::Quaterniond(Eigen::AngleAxisd(0.5, Eigen::Vector3d::UnitY())),
+        Eigen::Vector3d(1e-3, 2e-3, 3e-3));
+    writer.addIMUSample(BodyId(0), makeTime(10, 100), orientation);
+    CannedIMUMeasurement angVel;
+    angVel.setAngVel(Eigen::Vector3d(0.1, -0.2, 0.3),
+                     Eigen::Vector3d(4e-3, 5e-3, 6e-3));
+    writer.addIMUSample(BodyId(3), makeTime(10, 200), angVel);
+    writer.addFrame(makeTime(10, 300), makeMeasurements());
+    writer.addFrame(makeTime(11, 999999), LedMeasurementVec{});
+    REQUIRE(writer.good());
+}
+} // namespace
+
+TEST_CASE("Blob cache round trip") {
+    CacheFileCleanup cleanup;
+    writeCache();
+
+    BlobCacheReader reader(CACHE_FILE);
+    REQUIRE(reader.getImageSize() == IMAGE_SIZE);
+
+    CachedBlobFrame frame;
+    REQUIRE(reader.nextFrame(frame));
+    requireSameTime(makeTime(10, 300), frame.tv);
+    requireSameMeasurements(makeMeasurements(), frame.measurements);
+    REQUIRE(frame.imuSamples.size() == 2);
+
+    auto const &orientation = frame.imuSamples[0];
+    REQUIRE(orientation.body == BodyId(0));
+    requireSameTime(makeTime(10, 100), orientation.tv);
+    REQUIRE(osvr::util::getRadians(orientation.meas.getYawCorrection()) ==
+            0.25);
+    REQUIRE(orientation.meas.orientationValid());
+    REQUIRE_FALSE(orientation.meas.angVelValid());
+    Eigen::Quaterniond quat;
+    orientation.meas.restoreQuat(quat);
+    REQUIRE(quat.coeffs() ==
+            Eigen::Quaterniond(
+                Eigen::AngleAxisd(0.5, Eigen::Vector3d::UnitY()))
+                .coeffs());
+    Eigen::Vector3d var;
+    orientation.meas.restoreQuatVariance(var);
+    REQUIRE(var == Eigen::Vector3d(1e-3, 2e-3, 3e-3));
+
+    auto const &angVel = frame.imuSamples[1];
+    REQUIRE(angVel.body == BodyId(3));
+    requireSameTime(makeTime(10, 200), angVel.tv);
+    REQUIRE(osvr::util::getRadians(angVel.meas.getYawCorrection()) == 0.);
+    REQUIRE_FALSE(angVel.meas.orientationValid());
+    REQUIRE(angVel.meas.angVelValid());
+    Eigen::Vector3d vel;
+    angVel.meas.restoreAngVel(vel);
+    REQUIRE(vel == Eigen::Vector3d(0.1, -0.2, 0.3));
+    angVel.meas.restoreAngVelVariance(var);
+    REQUIRE(var == Eigen::Vector3d(4e-3, 5e-3, 6e-3));
+
+    /// The second frame reuses the storage, so nothing stale is left over.
+    REQUIRE(reader.nextFrame(frame));
+    requireSameTime(makeTime(11, 999999), frame.tv);
+    REQUIRE(frame.measurements.empty());
+    REQUIRE(frame.imuSamples.empty());
+
+    REQUIRE_FALSE(reader.nextFrame(frame));
+    REQUIRE_FALSE(reader.nextFrame(frame));
+}
+
+TEST_CASE("Blob cache with a truncated final record") {
+    CacheFileCleanup cleanup;
+    writeCache();
+    auto contents = readFile();
+    /// The second frame is just a header, at the end.
+    auto secondFrame = contents.size() - sizeof(blob_cache::FrameHeader);
+
+    SECTION("partial frame header") {
+        writeFile(contents.substr(0, secondFrame + 4));
+        BlobCacheReader reader(CACHE_FILE);
+        CachedBlobFrame frame;
+        REQUIRE(reader.nextFrame(frame));
+        requireSameMeasurements(makeMeasurements(), frame.measurements);
+        REQUIRE_FALSE(reader.nextFrame(frame));
+    }
+
+    SECTION("partial frame body") {
+        /// Some of the first frame's last measurement is gone too.
+        writeFile(contents.substr(0, secondFrame - 4));
+        BlobCacheReader reader(CACHE_FILE);
+        CachedBlobFrame frame;
+        REQUIRE_FALSE(reader.nextFrame(frame));
+    }
+
+    SECTION("header only") {
+        writeFile(contents.substr(0, sizeof(blob_cache::FileHeader)));
+        BlobCacheReader reader(CACHE_FILE);
+        REQUIRE(reader.getImageSize() == IMAGE_SIZE);
+        CachedBlobFrame frame;
+        REQUIRE_FALSE(reader.nextFrame(frame));
+    }
+}
+
+TEST_CASE("Blob cache with a bad file header is rejected") {
+    CacheFileCleanup cleanup;
+    writeCache();
+    auto contents = readFile();
+
+    SECTION("short file header") {
+        writeFile(contents.substr(0, sizeof(blob_cache::FileHeader) - 1));
+        REQUIRE_THROWS_AS(openCache(), std::runtime_error);
+    }
+
+    SECTION("empty file") {
+        writeFile(std::string());
+        REQUIRE_THROWS_AS(openCache(), std::runtime_error);
+    }
+
+    SECTION("wrong magic") {
+        contents[0] = 'X';
+        writeFile(contents);
+        REQUIRE_THROWS_AS(openCache(), std::runtime_error);
+    }
+
+    SECTION("wrong version") {
+        blob_cache::FileHeader header;
+        std::memcpy(&header, contents.data(), sizeof(header));
+        header.version = blob_cache::VERSION + 1;
+        contents.replace(0, sizeof(header),
+                         reinterpret_cast<const char *>(&header),
+                         sizeof(header));
+        writeFile(contents);
+        REQUIRE_THROWS_AS(openCache(), std::runtime_error);
+    }
+
+    SECTION("missing file") {
+        std::remove(CACHE_FILE);
+        REQUIRE_THROWS_AS(openCache(), std::runtime_error);
+    }
+}
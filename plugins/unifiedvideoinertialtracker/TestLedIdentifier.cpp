@@ -0,0 +1,257 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "HDKLedIdentifier.h"
+#include "HDKLedIdentifierFactory.h"
+#include "LED.h"
+#include "LedPatternAllocator.h"
+#include "PackedLedPattern.h"
+#include <IdentifierHelpers.h>
+
+// Library/third-party includes
+#include <catch.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+using namespace osvr::vbtracker;
+
+namespace {
+static const std::size_t PATTERN_LENGTH = 16;
+static const Brightness DIM_VALUE = 1.f;
+static const Brightness BRIGHT_VALUE = 2.f;
+static const UnderlyingBeaconIdType NOT_RECOGNIZED =
+    Led::SENTINEL_NO_PATTERN_RECOGNIZED_DESPITE_SUFFICIENT_DATA;
+
+/// The string search OsvrHdkLedIdentifier used before it packed patterns
+/// into a lookup table, kept as the reference for what it must return.
+class ReferenceIdentifier {
+  public:
+    explicit ReferenceIdentifier(PatternStringList const &patterns) {
+        for (auto const &pat : patterns) {
+            if (pat.empty() || pat.find_first_not_of("*.") != pat.npos) {
+                m_wrapped.emplace_back();
+                continue;
+            }
+            auto wrapped = pat + pat;
+            wrapped.pop_back();
+            m_wrapped.push_back(wrapped);
+        }
+    }
+
+    UnderlyingBeaconIdType getId(BrightnessList const &brightnesses) const {
+        Brightness minVal, maxVal;
+        std::tie(minVal, maxVal) = findMinMaxBrightness(brightnesses);
+        if (maxVal - minVal <= 0.3) {
+            return Led::SENTINEL_INSUFFICIENT_EXTREMA_DIFFERENCE;
+        }
+        auto bits = getBitsUsingThreshold(brightnesses, (minVal + maxVal) / 2);
+        for (std::size_t i = 0; i < m_wrapped.size(); ++i) {
+            if (!m_wrapped[i].empty() &&
+                m_wrapped[i].find(bits) != std::string::npos) {
+                return static_cast<UnderlyingBeaconIdType>(i);
+            }
+        }
+        return NOT_RECOGNIZED;
+    }
+
+  private:
+    std::vector<std::string> m_wrapped;
+};
+
+/// Brightness history for a packed input, oldest frame first.
+BrightnessList makeBrightnesses(PackedPattern input) {
+    BrightnessList ret;
+    for (std::size_t i = 0; i < PATTERN_LENGTH; ++i) {
+        auto bright = (input >> (PATTERN_LENGTH - 1 - i)) & 1;
+        ret.push_back(bright ? BRIGHT_VALUE : DIM_VALUE);
+    }
+    return ret;
+}
+
+/// Identifies a new LED with the packed input as its brightness history.
+UnderlyingBeaconIdType identify(LedIdentifier const &identifier,
+                                PackedPattern input) {
+    auto brightnesses = makeBrightnesses(input);
+    bool lastBright = false;
+    return identifier
+        .getId(ZeroBasedBeaconId(
+                   Led::SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA),
+               brightnesses, lastBright, false)
+        .value();
+}
+
+void requireMatchesReference(PatternStringList const &patterns) {
+    OsvrHdkLedIdentifier identifier(patterns);
+    ReferenceIdentifier reference(patterns);
+    for (PackedPattern input = 0; input < (1u << PATTERN_LENGTH); ++input) {
+        auto expected = reference.getId(makeBrightnesses(input));
+        auto actual = identify(identifier, input);
+        if (actual != expected) {
+            /// Only build the message for failures: this runs 64k times.
+            CAPTURE(unpackPattern(input, PATTERN_LENGTH));
+            REQUIRE(actual == expected);
+        }
+    }
+}
+
+PatternStringList unifiedHDKPatterns() {
+    auto ret = getHDKLedPatterns(0);
+    auto const &back = getHDKLedPatterns(1);
+    ret.insert(ret.end(), back.begin(), back.end());
+    return ret;
+}
+
+std::size_t countBright(std::string const &pattern) {
+    return std::count(pattern.begin(), pattern.end(), '*');
+}
+
+PackedPattern pack(std::string const &pattern) {
+    PackedPattern ret = 0;
+    REQUIRE(packPattern(pattern, ret));
+    return ret;
+}
+} // namespace
+
+TEST_CASE("OsvrHdkLedIdentifier matches the string search for every input") {
+    SECTION("HDK front plate") {
+        requireMatchesReference(getHDKLedPatterns(0));
+    }
+    SECTION("HDK back plate") {
+        requireMatchesReference(getHDKLedPatterns(1));
+    }
+    SECTION("HDK front and back plates") {
+        requireMatchesReference(unifiedHDKPatterns());
+    }
+    SECTION("rotations of one another, disabled and invalid patterns") {
+        /// The first of patterns that are rotations of each other wins.
+        requireMatchesReference({"***.............", "..***...........",
+                                 "", "X**.............", "*.*.*...........",
+                                 "..*.*.*........."});
+    }
+    SECTION("random patterns") {
+        std::mt19937 gen(1234);
+        std::uniform_int_distribution<PackedPattern> dist(
+            0, (1u << PATTERN_LENGTH) - 1);
+        PatternStringList patterns;
+        for (int i = 0; i < 40; ++i) {
+            patterns.push_back(unpackPattern(dist(gen), PATTERN_LENGTH));
+        }
+        requireMatchesReference(patterns);
+    }
+}
+
+TEST_CASE("LedPatternAllocator") {
+    SECTION("rejects unenumerable lengths") {
+        REQUIRE_THROWS_AS(LedPatternAllocator(1), std::invalid_argument);
+        REQUIRE_THROWS_AS(LedPatternAllocator(21), std::invalid_argument);
+    }
+
+    SECTION("allocates distinct, aperiodic patterns within the limits") {
+        LedPatternAllocator allocator(16, 3, 5);
+        auto before = allocator.numAvailable();
+        auto patterns = allocator.allocate(40);
+        REQUIRE(patterns.size() == 40);
+        REQUIRE(allocator.numAvailable() == before - 40);
+        std::set<PackedPattern> canonical;
+        for (auto const &pat : patterns) {
+            CAPTURE(pat);
+            REQUIRE(pat.size() == 16);
+            REQUIRE(countBright(pat) >= 3);
+            REQUIRE(countBright(pat) <= 5);
+            auto bits = pack(pat);
+            REQUIRE_FALSE(isPeriodicPattern(bits, 16));
+            REQUIRE(canonical.insert(canonicalPattern(bits, 16)).second);
+        }
+
+        AND_THEN("later allocations avoid them") {
+            auto more = allocator.allocate(10);
+            for (auto const &pat : more) {
+                CAPTURE(pat);
+                REQUIRE(canonical.insert(canonicalPattern(pack(pat), 16))
+                            .second);
+            }
+        }
+    }
+
+    SECTION("adjacent beacons are never bright together") {
+        LedPatternAllocator allocator(16, 3, 5);
+        LedPatternAllocator::AdjacencyList adjacent;
+        for (std::size_t i = 0; i + 1 < 20; ++i) {
+            adjacent.emplace_back(i, i + 1);
+        }
+        adjacent.emplace_back(0, 19);
+        adjacent.emplace_back(3, 12);
+        auto patterns = allocator.allocate(20, adjacent);
+        REQUIRE(patterns.size() == 20);
+        for (auto const &pair : adjacent) {
+            CAPTURE(patterns[pair.first]);
+            CAPTURE(patterns[pair.second]);
+            REQUIRE((pack(patterns[pair.first]) &
+                     pack(patterns[pair.second])) == 0);
+        }
+    }
+
+    SECTION("rejects adjacency beyond the beacons allocated") {
+        LedPatternAllocator allocator;
+        REQUIRE_THROWS_AS(allocator.allocate(2, {{0, 2}}), std::out_of_range);
+    }
+
+    SECTION("allocates nothing if it can't allocate everything") {
+        /// Aperiodic 4-frame patterns with 1 to 3 bright frames, up to
+        /// rotation: "...*", "..**" and ".***".
+        LedPatternAllocator allocator(4, 1, 3);
+        REQUIRE(allocator.numAvailable() == 3);
+        REQUIRE_THROWS_AS(allocator.allocate(4), std::runtime_error);
+        REQUIRE(allocator.numAvailable() == 3);
+        REQUIRE(allocator.allocate(3).size() == 3);
+        REQUIRE(allocator.numAvailable() == 0);
+    }
+
+    SECTION("HDK allocator hands out patterns the HDK identifier can't see") {
+        auto allocator = createHDKPatternAllocator();
+        auto patterns = allocator.allocate(20);
+        auto hdk = unifiedHDKPatterns();
+        for (auto &pat : hdk) {
+            if (!pat.empty() && pat.front() == 'X') {
+                pat.erase(0, 1);
+            }
+        }
+        OsvrHdkLedIdentifier identifier(hdk);
+        for (auto const &pat : patterns) {
+            CAPTURE(pat);
+            auto bits = pack(pat);
+            for (std::size_t shift = 0; shift < 16; ++shift) {
+                REQUIRE(identify(identifier, bits) == NOT_RECOGNIZED);
+                bits = rotatePattern(bits, 16);
+            }
+        }
+    }
+}
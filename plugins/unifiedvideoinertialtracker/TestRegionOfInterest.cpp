@@ -0,0 +1,175 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "RegionOfInterestSchedule.h"
+#include <EdgeHoleBasedLedExtractor.h>
+#include <EdgeHoleBlobExtractor.h>
+#include <cvUtils.h>
+
+// Library/third-party includes
+#include <catch.hpp>
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <algorithm>
+
+using namespace osvr::vbtracker;
+
+namespace {
+static const cv::Size IMAGE_SIZE(320, 240);
+static const cv::Point LED_A(80, 60);
+static const cv::Point LED_B(240, 180);
+static const int PADDING = 24;
+
+/// Dark frame with a bright disk at each LED location.
+cv::Mat makeFrame() {
+    cv::Mat ret(IMAGE_SIZE, CV_8UC1, cv::Scalar(0));
+    cv::circle(ret, LED_A, 6, cv::Scalar(255), -1);
+    cv::circle(ret, LED_B, 6, cv::Scalar(255), -1);
+    return ret;
+}
+
+cv::Rect regionAround(cv::Point pt) {
+    return cv::Rect(pt.x - PADDING, pt.y - PADDING, 2 * PADDING + 1,
+                    2 * PADDING + 1);
+}
+
+void requireSameMeasurements(LedMeasurementVec const &a,
+                             LedMeasurementVec const &b) {
+    REQUIRE(a.size() == b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        REQUIRE(a[i].loc.x == Approx(b[i].loc.x));
+        REQUIRE(a[i].loc.y == Approx(b[i].loc.y));
+        REQUIRE(a[i].diameter == Approx(b[i].diameter));
+    }
+}
+
+/// Sorts by location, since the region order is up to the extractor.
+LedMeasurementVec sorted(LedMeasurementVec v) {
+    std::sort(v.begin(), v.end(),
+              [](LedMeasurement const &a, LedMeasurement const &b) {
+                  return a.loc.x < b.loc.x;
+              });
+    return v;
+}
+} // namespace
+
+TEST_CASE("clipAndMergeRegions") {
+    RegionList regions;
+    SECTION("clips to the image and drops empty regions") {
+        regions.emplace_back(-10, -10, 20, 20);
+        regions.emplace_back(400, 400, 10, 10);
+        clipAndMergeRegions(regions, IMAGE_SIZE);
+        REQUIRE(regions.size() == 1);
+        REQUIRE(regions[0] == cv::Rect(0, 0, 10, 10));
+    }
+    SECTION("merges overlapping and touching regions") {
+        regions.emplace_back(0, 0, 10, 10);
+        regions.emplace_back(100, 100, 10, 10);
+        regions.emplace_back(5, 5, 10, 10);
+        regions.emplace_back(15, 0, 5, 5);
+        clipAndMergeRegions(regions, IMAGE_SIZE);
+        REQUIRE(regions.size() == 2);
+        REQUIRE(regions[0] == cv::Rect(0, 0, 20, 15));
+        REQUIRE(regions[1] == cv::Rect(100, 100, 10, 10));
+    }
+}
+
+TEST_CASE("RegionOfInterestSchedule") {
+    RegionOfInterestParams params;
+    params.enabled = true;
+    params.fullFrameInterval = 5;
+    params.searchFrames = 3;
+    RegionOfInterestSchedule schedule(params);
+    SECTION("full frames without predictions") {
+        for (int i = 0; i < 20; ++i) {
+            REQUIRE(schedule.useFullFrame(false, false));
+        }
+    }
+    SECTION("one full frame per interval while tracking everything") {
+        for (int cycle = 0; cycle < 3; ++cycle) {
+            for (int i = 0; i < params.fullFrameInterval; ++i) {
+                REQUIRE_FALSE(schedule.useFullFrame(true, true));
+            }
+            REQUIRE(schedule.useFullFrame(true, true));
+        }
+    }
+    SECTION("runs of full frames while a target is lost, regions otherwise") {
+        for (int cycle = 0; cycle < 3; ++cycle) {
+            for (int i = 0; i < params.fullFrameInterval; ++i) {
+                REQUIRE_FALSE(schedule.useFullFrame(true, false));
+            }
+            for (int i = 0; i < params.searchFrames; ++i) {
+                REQUIRE(schedule.useFullFrame(true, false));
+            }
+        }
+    }
+}
+
+TEST_CASE("EdgeHoleBasedLedExtractor regions of interest") {
+    auto frame = makeFrame();
+    BlobParams params;
+    EdgeHoleBasedLedExtractor fullExtractor;
+    auto full = sorted(fullExtractor(frame, params));
+    REQUIRE(full.size() == 2);
+
+    EdgeHoleBasedLedExtractor extractor;
+    SECTION("regions around every LED find the same measurements") {
+        auto regions = RegionList{regionAround(LED_B), regionAround(LED_A)};
+        auto roi = sorted(extractor(frame, params, regions));
+        requireSameMeasurements(full, roi);
+    }
+    SECTION("a region around one LED finds only that one") {
+        auto roi = extractor(frame, params, RegionList{regionAround(LED_A)});
+        REQUIRE(roi.size() == 1);
+        REQUIRE(roi[0].loc.x == Approx(full[0].loc.x));
+        REQUIRE(roi[0].loc.y == Approx(full[0].loc.y));
+    }
+    SECTION("only the latest regions are left in the intermediate images") {
+        extractor(frame, params);
+        extractor(frame, params, RegionList{regionAround(LED_A)});
+        extractor(frame, params, RegionList{regionAround(LED_B)});
+        cv::Mat edge = extractor.getEdgeDetectedImage().clone();
+        cv::Mat gray = extractor.getInputGrayImage().clone();
+        auto roi = regionAround(LED_B);
+        REQUIRE(cv::countNonZero(edge(roi)) > 0);
+        edge(roi).setTo(0);
+        gray(roi).setTo(0);
+        REQUIRE(cv::countNonZero(edge) == 0);
+        REQUIRE(cv::countNonZero(gray) == 0);
+    }
+}
+
+TEST_CASE("EdgeHoleBlobExtractor copies only the regions") {
+    auto frame = makeFrame();
+    auto extractor = makeEdgeHoleBlobExtractor(BlobParams{}, EdgeHoleParams{});
+    auto roi = regionAround(LED_A);
+    auto measurements = extractor->extractBlobs(frame, RegionList{roi});
+    REQUIRE(measurements.size() == 1);
+    cv::Mat latest = extractor->getLatestGrayImage();
+    REQUIRE(latest.size() == frame.size());
+    REQUIRE(cv::countNonZero(latest(roi) != frame(roi)) == 0);
+}
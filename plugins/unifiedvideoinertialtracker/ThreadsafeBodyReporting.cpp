@@ -86,6 +86,12 @@ namespace vbtracker {
 
     bool BodyReporting::getReport(double additionalPrediction,
                                   BodyReport &report) {
+        return getReport(additionalPrediction, util::time::getNow(), report);
+    }
+
+    bool BodyReporting::getReport(double additionalPrediction,
+                                  util::time::TimeValue const &currentTime,
+                                  BodyReport &report) {
 
         QueueValueType queueVal;
         bool gotOne = false;
@@ -114,7 +120,6 @@ namespace vbtracker {
 
         if (doingPrediction) {
             // If we have non-zero velocity, then we can do some prediction.
-            auto currentTime = util::time::getNow();
             /// Difference between measurement time and now.
             auto dt = osvrTimeValueDurationSeconds(&currentTime, &m_dataTime);
             /// and the additional time into the future we'd like to predict.
@@ -78,6 +78,14 @@ namespace vbtracker {
         /// additionalPrediction if nonzero). If false is returned, no reports
         /// were available to consume.
         bool getReport(double additionalPrediction, BodyReport &report);
+
+        /// @overload
+        ///
+        /// Takes "now" as a parameter, so that several bodies can be
+        /// predicted to the same time (and share a timestamp).
+        bool getReport(double additionalPrediction,
+                       util::time::TimeValue const &currentTime,
+                       BodyReport &report);
         /// @}
 
         /// @name processing-thread methods
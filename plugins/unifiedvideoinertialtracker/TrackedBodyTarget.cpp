@@ -32,6 +32,7 @@
 #include "PoseEstimator_RANSAC.h"
 #include "PoseEstimator_RANSACKalman.h"
 #include "PoseEstimator_SCAATKalman.h"
+#include "ProjectPoint.h"
 #include "TrackedBody.h"
 #include "cvToEigen.h"
 #include <osvr/Util/CSV.h>
@@ -660,6 +661,35 @@ namespace vbtracker {
         return gotPose;
     }
 
+    void TrackedBodyTarget::predictBeaconImageLocations(
+        CameraParameters const &camParams, BodyState const &bodyState,
+        std::vector<cv::Point2f> &out) const {
+        Eigen::Quaterniond rot = bodyState.getCombinedQuaternion();
+        /// Same state correction as updatePoseEstimateFromLeds()
+        Eigen::Vector3d xlate =
+            bodyState.position() - computeTranslationCorrectionToBody(rot);
+        auto focalLength = camParams.focalLength();
+        Eigen::Vector2d principalPoint = camParams.eiPrincipalPoint();
+        for (std::size_t i = 0; i < m_numBeacons; ++i) {
+            /// Skip beacons facing away from the camera (emission vector with
+            /// a non-negative camera-space z component)
+            auto emissionZ =
+                (rot * cvToVector(m_beaconEmissionDirection[i])).z();
+            if (emissionZ >= 0) {
+                continue;
+            }
+            Eigen::Vector3d beacon =
+                m_targetToBody + m_beacons[i]->stateVector();
+            if ((rot * beacon + xlate).z() <= 0) {
+                /// Behind the camera
+                continue;
+            }
+            Eigen::Vector2d loc = projectPoint(xlate, rot, focalLength,
+                                               principalPoint, beacon);
+            out.push_back(vecToPoint(loc.cast<float>()));
+        }
+    }
+
     Eigen::Vector3d TrackedBodyTarget::getStateCorrection() const {
 // return m_impl->bodyInterface.state.getQuaternion().conjugate() *
 // m_beaconOffset;
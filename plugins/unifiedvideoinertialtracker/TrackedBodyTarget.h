@@ -156,6 +156,13 @@ namespace vbtracker {
             Eigen::Quaterniond &quat, int skipBrightsCutoff = -1,
             std::size_t iterations = 5);
 
+        /// Predicts where the beacons facing the camera will be seen in the
+        /// (undistorted) image, for a camera-space body state, the same way
+        /// the pose estimators do, appending the image points.
+        void predictBeaconImageLocations(CameraParameters const &camParams,
+                                         BodyState const &bodyState,
+                                         std::vector<cv::Point2f> &out) const;
+
         /// Did this target yet, or last time it was asked to, compute a
         /// pose estimate?
         bool hasPoseEstimate() const { return m_hasPoseEstimate; }
@@ -35,8 +35,10 @@
 // Library/third-party includes
 #include <osvr/Util/EigenInterop.h>
 #include <osvr/Util/Finally.h>
+#include <osvr/Util/LogRateLimiter.h>
 
 // Standard includes
+#include <chrono>
 #include <future>
 #include <iostream>
 #include <type_traits>
@@ -197,16 +199,27 @@ namespace vbtracker {
 
     void TrackerThread::doFrame() {
         // Check camera status.
+        // These can repeat every frame, so rate-limit them.
+        static util::log::LogRateLimiter notOkLimiter{std::chrono::seconds(1)};
+        static util::log::LogRateLimiter grabLimiter{std::chrono::seconds(1)};
         if (!m_cam.ok()) {
             // Hmm, camera seems bad. Might regain it? Skip for now...
-            warn() << "Camera is reporting it is not OK." << std::endl;
+            if (notOkLimiter.allow()) {
+                warn() << "Camera is reporting it is not OK. ("
+                       << notOkLimiter.takeSuppressedCount()
+                       << " similar messages suppressed)" << std::endl;
+            }
             return;
         }
         // Trigger a grab.
         if (!m_cam.grab()) {
             // Again failing without quitting, in hopes we get better luck
             // next time...
-            warn() << "Camera grab failed." << std::endl;
+            if (grabLimiter.allow()) {
+                warn() << "Camera grab failed. ("
+                       << grabLimiter.takeSuppressedCount()
+                       << " similar messages suppressed)" << std::endl;
+            }
             return;
         }
         // When we triggered the grab was a good guess of the time
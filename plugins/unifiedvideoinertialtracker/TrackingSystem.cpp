@@ -80,8 +80,7 @@ namespace vbtracker {
         ret->frame = frame;
         ret->frameGray = frameGray;
         ret->camParams = camParams.createUndistortedVariant();
-        auto rawMeasurements =
-            m_impl->blobExtractor->extractBlobs(ret->frameGray);
+        auto const &rawMeasurements = extractBlobs(ret->frameGray, camParams);
         ret->ledMeasurements = undistortLeds(rawMeasurements, camParams);
         return ret;
     }
@@ -180,6 +179,71 @@ namespace vbtracker {
             /// seen for a given body.
             body->pruneHistory(m_impl->lastFrame);
         }
+
+        updateBeaconPredictions();
+    }
+
+    void TrackingSystem::updateBeaconPredictions() {
+        if (!m_params.regionOfInterest.enabled) {
+            return;
+        }
+        auto &predictions = m_impl->predictionScratch;
+        predictions.clear();
+        /// A target without a pose could be anywhere in the frame: it's left
+        /// to the full frames to find it, without giving up the regions of
+        /// interest for the others.
+        bool allTracking = true;
+        forEachTarget(*this, [&](TrackedBodyTarget &target) {
+            if (!target.hasPoseEstimate()) {
+                allTracking = false;
+                return;
+            }
+            target.predictBeaconImageLocations(
+                m_impl->camParams, target.getBody().getState(), predictions);
+        });
+        std::lock_guard<std::mutex> lock(m_impl->predictionMutex);
+        m_impl->predictedBeacons.swap(predictions);
+        m_impl->allTargetsPredicted = allTracking;
+    }
+
+    LedMeasurementVec const &
+    TrackingSystem::extractBlobs(cv::Mat const &frameGray,
+                                 CameraParameters const &camParams) {
+        auto &extractor = *m_impl->blobExtractor;
+        auto const &roiParams = m_params.regionOfInterest;
+        if (!roiParams.enabled) {
+            return extractor.extractBlobs(frameGray);
+        }
+
+        auto &predictions = m_impl->framePredictions;
+        bool allPredicted;
+        {
+            std::lock_guard<std::mutex> lock(m_impl->predictionMutex);
+            predictions = m_impl->predictedBeacons;
+            allPredicted = m_impl->allTargetsPredicted;
+        }
+        if (m_impl->roiSchedule.useFullFrame(!predictions.empty(),
+                                             allPredicted)) {
+            return extractor.extractBlobs(frameGray);
+        }
+
+        /// Predictions are in undistorted image space, but blobs are
+        /// extracted from the raw image.
+        auto distortionModel = CameraDistortionModel{
+            Eigen::Vector2d{camParams.focalLengthX(), camParams.focalLengthY()},
+            cvToVector(camParams.principalPoint()),
+            Eigen::Vector3d{camParams.k1(), camParams.k2(), camParams.k3()}};
+        auto padding = roiParams.padding;
+        auto &regions = m_impl->regions;
+        regions.clear();
+        for (auto const &pt : predictions) {
+            Eigen::Vector2d loc =
+                distortionModel.distortPoint(cvToVector(pt).cast<double>());
+            regions.emplace_back(static_cast<int>(loc.x()) - padding,
+                                 static_cast<int>(loc.y()) - padding,
+                                 2 * padding + 1, 2 * padding + 1);
+        }
+        return extractor.extractBlobs(frameGray, regions);
     }
 
     void TrackingSystem::calibrationVideoPhaseThree() {
@@ -163,6 +163,19 @@ namespace vbtracker {
         /// calibration is incomplete.
         void calibrationVideoPhaseThree();
 
+        /// Called at the end of updatePoseEstimates() to predict where beacons
+        /// will be seen, for region-of-interest blob extraction.
+        void updateBeaconPredictions();
+
+        /// Blob extraction for performInitialImageProcessing(): when enabled,
+        /// just the regions around the beacons predicted for targets that are
+        /// tracking. The full frame is processed when no target has
+        /// predictions, and periodically - for a run of frames, if some
+        /// target isn't tracking, so it can be found.
+        LedMeasurementVec const &
+        extractBlobs(cv::Mat const &frameGray,
+                     CameraParameters const &camParams);
+
         using BodyPtr = std::unique_ptr<TrackedBody>;
         ConfigParams m_params;
 
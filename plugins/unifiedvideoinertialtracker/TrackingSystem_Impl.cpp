@@ -39,6 +39,7 @@ namespace vbtracker {
     TrackingSystem::Impl::Impl(ConfigParams const &params)
         : blobExtractor(
               makeBlobExtractor(params.blobParams, params.extractParams)),
+          roiSchedule(params.regionOfInterest),
           debugDisplay(new TrackingDebugDisplay(params)),
           calib(Eigen::Vector3d(params.cameraPosition), params.cameraIsForward),
           cameraPose(Eigen::Isometry3d::Identity()),
@@ -27,6 +27,7 @@
 
 // Internal Includes
 #include "ConfigParams.h"
+#include "RegionOfInterestSchedule.h"
 #include "RoomCalibration.h"
 #include "TrackingSystem.h"
 #include <CameraParameters.h>
@@ -40,6 +41,8 @@
 
 // Standard includes
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
@@ -72,6 +75,27 @@ namespace vbtracker {
 
         LedUpdateCount updateCount;
         BlobExtractorPtr blobExtractor;
+
+        /// @name Region-of-interest blob extraction state
+        /// @brief Predictions are made on the tracker thread and used on the
+        /// image processing thread, so they're guarded by a mutex.
+        /// @{
+        std::mutex predictionMutex;
+        /// Predicted (undistorted) beacon image locations for the next frame,
+        /// for the targets with a pose estimate.
+        std::vector<cv::Point2f> predictedBeacons;
+        /// Whether every target had a pose estimate for those predictions.
+        bool allTargetsPredicted = false;
+        /// Tracker thread scratch for building predictions.
+        std::vector<cv::Point2f> predictionScratch;
+        /// Image processing thread copy of the predictions.
+        std::vector<cv::Point2f> framePredictions;
+        /// Image processing thread regions of interest.
+        RegionList regions;
+        /// Image processing thread choice of full frames.
+        RegionOfInterestSchedule roiSchedule;
+        /// @}
+
         std::unique_ptr<TrackingDebugDisplay> debugDisplay;
     };
 
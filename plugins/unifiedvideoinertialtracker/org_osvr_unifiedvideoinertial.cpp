@@ -73,6 +73,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 // Anonymous namespace to avoid symbol collision
 namespace {
@@ -110,8 +111,11 @@ class UnifiedVideoInertialTracker : boost::noncopyable {
     const std::int32_t m_oriUsecOffset = 0;
     const std::int32_t m_angvelUsecOffset = 0;
     const bool m_continuousReporting;
+    const bool m_batchedReports;
     const bool m_debugData;
     BodyReportingVector m_bodyReportingVector;
+    /// Reused storage for the per-update batch of body reports.
+    std::vector<OSVR_TrackerBatchEntry> m_reportBatch;
     std::unique_ptr<TrackerThread> m_trackerThreadManager;
     bool m_threadLoopStarted = false;
     std::thread m_trackerThread;
@@ -128,6 +132,7 @@ class UnifiedVideoInertialTracker : boost::noncopyable {
           m_oriUsecOffset(params.imu.orientationMicrosecondsOffset),
           m_angvelUsecOffset(params.imu.angularVelocityMicrosecondsOffset),
           m_continuousReporting(params.continuousReporting),
+          m_batchedReports(params.batchedReports),
           m_debugData(params.streamBeaconDebugInfo) {
         if (params.numThreads > 0) {
             // Set the number of threads for OpenCV to use.
@@ -346,27 +351,53 @@ inline OSVR_ReturnCode UnifiedVideoInertialTracker::update() {
         m_trackerThreadManager->permitStart();
         return OSVR_RETURN_SUCCESS;
     }
-    namespace ei = osvr::util::eigen_interop;
     std::size_t numSensors = m_bodyReportingVector.size();
     /// On each update pass, we go through and attempt to report for every body,
-    /// at the current time + additional prediction as requested.
+    /// at the current time + additional prediction as requested. If batching
+    /// is enabled, reports sharing a timestamp (all the predicted ones, since
+    /// they share "now") go out as a single batched message.
+    auto now = osvr::util::time::getNow();
+    OSVR_TimeValue batchTime;
+    auto sendBatch = [&] {
+        if (!m_reportBatch.empty()) {
+            osvrDeviceTrackerSendBatchTimestamped(
+                m_dev, m_tracker, m_reportBatch.data(),
+                static_cast<OSVR_ChannelCount>(m_reportBatch.size()),
+                &batchTime);
+            m_reportBatch.clear();
+        }
+    };
     for (std::size_t i = 0; i < numSensors; ++i) {
         osvr::vbtracker::BodyReport report;
-        auto gotReport =
-            m_bodyReportingVector[i]->getReport(m_additionalPrediction, report);
+        auto gotReport = m_bodyReportingVector[i]->getReport(
+            m_additionalPrediction, now, report);
         if (!gotReport) {
             /// couldn't get a report for this sensor for one reason or another.
             // std::cout << "Couldn't get report for " << i << std::endl;
             continue;
         }
-        osvrDeviceTrackerSendPoseTimestamped(m_dev, m_tracker, &report.pose, i,
-                                             &report.timestamp);
-        if (OSVR_TRUE == report.vel.angularVelocityValid ||
-            OSVR_TRUE == report.vel.linearVelocityValid) {
-            osvrDeviceTrackerSendVelocityTimestamped(
-                m_dev, m_tracker, &report.vel, i, &report.timestamp);
+        if (!m_batchedReports) {
+            osvrDeviceTrackerSendPoseTimestamped(m_dev, m_tracker, &report.pose,
+                                                 i, &report.timestamp);
+            if (OSVR_TRUE == report.vel.angularVelocityValid ||
+                OSVR_TRUE == report.vel.linearVelocityValid) {
+                osvrDeviceTrackerSendVelocityTimestamped(
+                    m_dev, m_tracker, &report.vel, i, &report.timestamp);
+            }
+            continue;
+        }
+        if (!m_reportBatch.empty() && report.timestamp != batchTime) {
+            sendBatch();
         }
+        batchTime = report.timestamp;
+        OSVR_TrackerBatchEntry entry = {};
+        entry.sensor = static_cast<OSVR_ChannelCount>(i);
+        entry.poseValid = OSVR_TRUE;
+        entry.pose = report.pose;
+        entry.velocity = report.vel;
+        m_reportBatch.push_back(entry);
     }
+    sendBatch();
     if (m_debugData) {
         osvr::vbtracker::DebugArray arr;
         /// send each debug report that has been queued.
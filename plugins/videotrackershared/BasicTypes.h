@@ -51,6 +51,9 @@ namespace vbtracker {
 
     typedef std::vector<cv::Vec3d> Vec3Vector;
 
+    /// Image-space rectangles (regions of interest) to restrict processing to.
+    typedef std::vector<cv::Rect> RegionList;
+
 } // namespace vbtracker
 } // namespace osvr
 #endif // INCLUDED_BasicTypes_h_GUID_50E022F0_DE76_4DA9_68DD_D503E4165E36
@@ -38,6 +38,7 @@
 #endif
 
 // Standard includes
+#include <algorithm>
 #include <iostream>
 #include <utility>
 
@@ -95,6 +96,7 @@ namespace vbtracker {
 
         verbose_ = verboseBlobOutput;
 
+        wroteFullFrame_ = true;
         gray.copyTo(gray_);
 
         /// Set up the threshold parameters
@@ -165,10 +167,138 @@ namespace vbtracker {
             [&](ContourType &&contour) { checkBlob(std::move(contour), p); });
         return measurements_;
     }
+
+    LedMeasurementVec const &EdgeHoleBasedLedExtractor::
+    operator()(cv::Mat const &gray, BlobParams const &p,
+               RegionList const &regions, bool verboseBlobOutput) {
+        reset();
+
+#ifdef OSVR_UVBI_CORE
+        BlobExtraction trace;
+#endif
+
+        verbose_ = verboseBlobOutput;
+
+        regions_ = regions;
+        clipAndMergeRegions(regions_, gray.size());
+
+        clearPreviousOutput(gray.size(), gray.type());
+        blurred_.create(gray.size(), gray.type());
+        edgeTemp_.create(gray.size(), EDGE_DETECT_DEST_DEPTH);
+        /// Recorded before anything is written, so an early out below still
+        /// gets cleared next time.
+        writtenRegions_ = regions_;
+        if (regions_.empty()) {
+            return measurements_;
+        }
+
+        /// Set up the threshold parameters from the range across all regions,
+        /// copying out the gray image data we'll need later as we go.
+        auto rangeInfo = ImageRangeInfo(gray(regions_.front()));
+        for (auto const &roi : regions_) {
+            auto grayRoi = gray_(roi);
+            gray(roi).copyTo(grayRoi);
+            auto roiRange = ImageRangeInfo(gray(roi));
+            rangeInfo.minVal = std::min(rangeInfo.minVal, roiRange.minVal);
+            rangeInfo.maxVal = std::max(rangeInfo.maxVal, roiRange.maxVal);
+        }
+        if (rangeInfo.maxVal < p.absoluteMinThreshold) {
+            /// Early out - empty regions!
+            return measurements_;
+        }
+
+        auto thresholdInfo = ImageThresholdInfo(rangeInfo, p);
+        minBeaconCenterVal_ =
+            static_cast<std::uint8_t>(thresholdInfo.minThreshold);
+
+        /// Pixels outside the regions may be stale (or, in the input, not
+        /// copied at all: see GenericBlobExtractor), so every filter isolates
+        /// each region.
+        static const int ISOLATED_BORDER =
+            cv::BORDER_DEFAULT | cv::BORDER_ISOLATED;
+        for (auto const &roi : regions_) {
+            auto blurredRoi = blurred_(roi);
+            auto edgeRoi = edge_(roi);
+            auto edgeTempRoi = edgeTemp_(roi);
+            auto edgeBinaryRoi = edgeBinary_(roi);
+            cv::GaussianBlur(gray(roi), blurredRoi,
+                             cv::Size(extParams_.preEdgeDetectionBlurSize,
+                                      extParams_.preEdgeDetectionBlurSize),
+                             0, 0, ISOLATED_BORDER);
+
+            cv::Laplacian(blurredRoi, edgeRoi, CV_8U,
+                          extParams_.laplacianKSize,
+                          extParams_.laplacianScale, 0, ISOLATED_BORDER);
+
+            if (extParams_.edgeDetectErosion) {
+#ifdef OSVR_OPENCV_2
+                compressionArtifactRemoval_->apply(edge_, edge_, roi,
+                                                   roi.tl(), true);
+#else
+                cv::erode(edgeRoi, edgeRoi, compressionArtifactRemovalKernel_,
+                          cv::Point(-1, -1), 1,
+                          cv::BORDER_CONSTANT | cv::BORDER_ISOLATED);
+#endif
+            }
+
+            if (extParams_.postEdgeDetectionBlur) {
+                cv::GaussianBlur(edgeRoi, edgeTempRoi,
+                                 cv::Size(extParams_.postEdgeDetectionBlurSize,
+                                          extParams_.postEdgeDetectionBlurSize),
+                                 0, 0, ISOLATED_BORDER);
+                cv::threshold(edgeTempRoi, edgeBinaryRoi,
+                              extParams_.postEdgeDetectionBlurThreshold, 255,
+                              cv::THRESH_BINARY);
+            } else {
+                cv::threshold(edgeRoi, edgeBinaryRoi,
+                              extParams_.postEdgeDetectionBlurThreshold, 255,
+                              cv::THRESH_BINARY);
+            }
+
+            /// Contours come back relative to the region: move them back into
+            /// full-image coordinates before checking them.
+            edgeBinaryRoi.copyTo(binTemp_);
+            auto offset = roi.tl();
+            consumeHolesOfConnectedComponents(
+                binTemp_, contoursTempStorage_, hierarchyTempStorage_,
+                [&](ContourType &&contour) {
+                    for (auto &pt : contour) {
+                        pt += offset;
+                    }
+                    checkBlob(std::move(contour), p);
+                });
+        }
+        return measurements_;
+    }
+
+    void EdgeHoleBasedLedExtractor::clearPreviousOutput(cv::Size size,
+                                                        int type) {
+        auto mustClearAll = wroteFullFrame_ || gray_.size() != size ||
+                            gray_.type() != type || edge_.size() != size ||
+                            edgeBinary_.size() != size;
+        gray_.create(size, type);
+        edge_.create(size, EDGE_DETECT_DEST_DEPTH);
+        edgeBinary_.create(size, EDGE_DETECT_DEST_DEPTH);
+        if (mustClearAll) {
+            gray_.setTo(0);
+            edge_.setTo(0);
+            edgeBinary_.setTo(0);
+        } else {
+            for (auto const &roi : writtenRegions_) {
+                gray_(roi).setTo(0);
+                edge_(roi).setTo(0);
+                edgeBinary_(roi).setTo(0);
+            }
+        }
+        writtenRegions_.clear();
+        wroteFullFrame_ = false;
+    }
+
     /// out of line for unique_ptr-based pimpl.
     EdgeHoleBasedLedExtractor::~EdgeHoleBasedLedExtractor() = default;
 
     void EdgeHoleBasedLedExtractor::reset() {
+        regions_.clear();
         contours_.clear();
         measurements_.clear();
         rejectList_.clear();
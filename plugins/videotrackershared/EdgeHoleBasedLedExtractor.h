@@ -82,6 +82,19 @@ namespace vbtracker {
         LedMeasurementVec const &operator()(cv::Mat const &gray,
                                             BlobParams const &p,
                                             bool verboseBlobOutput = false);
+
+        /// Like the full-frame operator(), but only processes the given
+        /// regions of interest (typically padded areas around predicted beacon
+        /// locations), which are clipped to the image and merged where they
+        /// overlap. The filters treat the edge of each region like the edge
+        /// of an image, and the threshold range is computed over the regions
+        /// only, so regions should be padded to include some background.
+        ///
+        /// Everything outside the regions is zero in the intermediate images.
+        LedMeasurementVec const &operator()(cv::Mat const &gray,
+                                            BlobParams const &p,
+                                            RegionList const &regions,
+                                            bool verboseBlobOutput = false);
         ~EdgeHoleBasedLedExtractor();
 
         using ContourId = std::size_t;
@@ -105,6 +118,9 @@ namespace vbtracker {
             return measurements_;
         }
         RejectList const &getRejectList() const { return rejectList_; }
+        /// The merged, clipped regions processed in the last call, empty
+        /// after a full-frame call.
+        RegionList const &getRegions() const { return regions_; }
 
       private:
 #if OSVR_EDGEHOLE_UMAT
@@ -116,6 +132,11 @@ namespace vbtracker {
             return input;
         }
 #endif
+        /// Allocates the full-size images for a region-of-interest call and
+        /// zeroes whatever the last call wrote to them: the whole images
+        /// after a full-frame call (or if they were reallocated), otherwise
+        /// just its regions.
+        void clearPreviousOutput(cv::Size size, int type);
         void checkBlob(ContourType &&contour, BlobParams const &p);
         void addToRejectList(ContourId id, RejectReason reason,
                              BlobData const &data) {
@@ -162,6 +183,12 @@ namespace vbtracker {
         std::unique_ptr<RealtimeLaplacian> laplacianImpl_;
 #endif
 
+        RegionList regions_;
+        /// @name What the last call wrote to gray_, edge_ and edgeBinary_
+        /// @{
+        RegionList writtenRegions_;
+        bool wroteFullFrame_ = false;
+        /// @}
         ContourList contours_;
         LedMeasurementVec measurements_;
         RejectList rejectList_;
@@ -52,6 +52,11 @@ namespace vbtracker {
         return m_extractor(getLatestGrayImage(), m_params);
     }
 
+    LedMeasurementVec
+    EdgeHoleBlobExtractor::extractBlobsInRegions_(RegionList const &regions) {
+        return m_extractor(getLatestGrayImage(), m_params, regions);
+    }
+
     BlobExtractorPtr
     makeEdgeHoleBlobExtractor(BlobParams const &blobParams,
                               EdgeHoleParams const &extParams) {
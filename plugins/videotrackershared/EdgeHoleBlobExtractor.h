@@ -49,6 +49,9 @@ namespace vbtracker {
         cv::Mat generateDebugThresholdImage_() const override;
         cv::Mat generateDebugBlobImage_() const override;
         LedMeasurementVec extractBlobs_() override;
+        bool supportsRegions_() const override { return true; }
+        LedMeasurementVec
+        extractBlobsInRegions_(RegionList const &regions) override;
 
       private:
         BlobParams m_params;
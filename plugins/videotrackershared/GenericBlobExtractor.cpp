@@ -24,6 +24,7 @@
 
 // Internal Includes
 #include "GenericBlobExtractor.h"
+#include "cvUtils.h"
 
 // Library/third-party includes
 // - none
@@ -53,13 +54,48 @@ namespace vbtracker {
 
     LedMeasurementVec const &
     GenericBlobExtractor::extractBlobs(cv::Mat const &grayImage) {
+        setLatestGrayImage(grayImage);
+        latestMeasurements_ = extractBlobs_();
+        return latestMeasurements_;
+    }
+
+    LedMeasurementVec const &
+    GenericBlobExtractor::extractBlobs(cv::Mat const &grayImage,
+                                       RegionList const &regions) {
+        if (!supportsRegions_()) {
+            return extractBlobs(grayImage);
+        }
+        latestRegions_ = regions;
+        clipAndMergeRegions(latestRegions_, grayImage.size());
+        setLatestGrayImage(grayImage, latestRegions_);
+        latestMeasurements_ = extractBlobsInRegions_(latestRegions_);
+        return latestMeasurements_;
+    }
+
+    LedMeasurementVec
+    GenericBlobExtractor::extractBlobsInRegions_(RegionList const &) {
+        return extractBlobs_();
+    }
+
+    void GenericBlobExtractor::setLatestGrayImage(cv::Mat const &grayImage) {
         latestMeasurements_.clear();
         lastGrayImage_ = grayImage.clone();
 
         m_debugThresholdImageDirty = true;
         m_debugBlobImageDirty = true;
-        latestMeasurements_ = extractBlobs_();
-        return latestMeasurements_;
+    }
+
+    void GenericBlobExtractor::setLatestGrayImage(cv::Mat const &grayImage,
+                                                  RegionList const &regions) {
+        latestMeasurements_.clear();
+        lastGrayImage_.create(grayImage.size(), grayImage.type());
+        for (auto const &roi : regions) {
+            auto dest = lastGrayImage_(roi);
+            grayImage(roi).copyTo(dest);
+        }
+
+        m_debugThresholdImageDirty = true;
+        m_debugBlobImageDirty = true;
     }
 
 } // namespace vbtracker
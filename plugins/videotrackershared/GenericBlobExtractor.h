@@ -49,6 +49,15 @@ namespace vbtracker {
         cv::Mat const &getDebugBlobImage();
 
         LedMeasurementVec const &extractBlobs(cv::Mat const &grayImage);
+
+        /// Extracts blobs from only the given regions of the image, for
+        /// extractors that support it (the rest process the whole image).
+        ///
+        /// The regions are clipped and merged (see clipAndMergeRegions()),
+        /// and only they are copied into the latest gray image: the rest of
+        /// it is left over from earlier frames.
+        LedMeasurementVec const &extractBlobs(cv::Mat const &grayImage,
+                                              RegionList const &regions);
         LedMeasurementVec const &getLatestMeasurements() const {
             return latestMeasurements_;
         }
@@ -57,10 +66,22 @@ namespace vbtracker {
         virtual cv::Mat generateDebugThresholdImage_() const = 0;
         virtual cv::Mat generateDebugBlobImage_() const = 0;
         virtual LedMeasurementVec extractBlobs_() = 0;
+        /// Whether extractBlobsInRegions_() is implemented: if not, the
+        /// default, region calls process the whole image with extractBlobs_().
+        virtual bool supportsRegions_() const { return false; }
+        /// Called with clipped and merged regions, only if
+        /// supportsRegions_(). Default implementation ignores the regions and
+        /// calls extractBlobs_()
+        virtual LedMeasurementVec
+        extractBlobsInRegions_(RegionList const &regions);
         GenericBlobExtractor() = default;
 
       private:
+        void setLatestGrayImage(cv::Mat const &grayImage);
+        void setLatestGrayImage(cv::Mat const &grayImage,
+                                RegionList const &regions);
         cv::Mat lastGrayImage_;
+        RegionList latestRegions_;
         LedMeasurementVec latestMeasurements_;
 
         bool m_debugThresholdImageDirty = true;
@@ -26,6 +26,7 @@
 #define INCLUDED_cvUtils_h_GUID_65B004C2_722B_4BBF_4EC7_05B2AD861254
 
 // Internal Includes
+#include <BasicTypes.h>
 #include <BlobExtractor.h>
 
 // Library/third-party includes
@@ -33,6 +34,7 @@
 #include <opencv2/imgproc/imgproc.hpp>
 
 // Standard includes
+#include <algorithm>
 #include <cstdint>
 #include <random>
 #include <utility>
@@ -44,6 +46,39 @@ namespace vbtracker {
         return cv::Point2f(static_cast<float>(p.x), static_cast<float>(p.y));
     }
 
+    /// Clips the regions to the image, drops empty ones, and merges any that
+    /// overlap or touch (so a blob can't be split between two regions).
+    inline void clipAndMergeRegions(RegionList &regions, cv::Size size) {
+        auto const imageRect = cv::Rect(cv::Point(), size);
+        for (auto &roi : regions) {
+            roi &= imageRect;
+        }
+        regions.erase(std::remove_if(regions.begin(), regions.end(),
+                                     [](cv::Rect const &roi) {
+                                         return roi.area() == 0;
+                                     }),
+                      regions.end());
+        auto touches = [](cv::Rect const &a, cv::Rect const &b) {
+            return a.x <= b.x + b.width && b.x <= a.x + a.width &&
+                   a.y <= b.y + b.height && b.y <= a.y + a.height;
+        };
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (std::size_t i = 0; i < regions.size(); ++i) {
+                for (std::size_t j = i + 1; j < regions.size();) {
+                    if (touches(regions[i], regions[j])) {
+                        regions[i] |= regions[j];
+                        regions.erase(regions.begin() + j);
+                        merged = true;
+                    } else {
+                        ++j;
+                    }
+                }
+            }
+        }
+    }
+
     inline void drawSubpixelPoint(cv::Mat image, cv::Point2d point,
                                   cv::Scalar color = cv::Scalar(0, 0, 0),
                                   double radius = 1.,
@@ -0,0 +1,209 @@
+/** @file
+    @brief Header providing the per-device dispatcher of analog reports,
+    including the delta-encoded analog messages.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AnalogDispatcher_h_GUID_6D1B9E53_2A7C_4F80_93E6_B84C0F21D7A5
+#define INCLUDED_AnalogDispatcher_h_GUID_6D1B9E53_2A7C_4F80_93E6_B84C0F21D7A5
+
+// Internal Includes
+#include "DeviceDispatcher.h"
+#include <osvr/Common/AnalogDeltaMessage.h>
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Util/TimeValueC.h>
+#include <osvr/Util/UniquePtr.h>
+#include <osvr/Util/Verbosity.h>
+
+// Library/third-party includes
+#include <boost/optional.hpp>
+#include <vrpn_Analog.h>
+#include <vrpn_ConnectionPtr.h>
+
+// Standard includes
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+namespace osvr {
+namespace client {
+
+    /// @brief Owns the one analog remote for a device, however many handlers
+    /// its channels are routed to, passing each channel of a report only to
+    /// the handlers for that channel.
+    ///
+    /// Also handles the delta-encoded analog messages a device may send in
+    /// place of the standard ones, keeping the last value of every channel
+    /// so the array reports always carry them all. Until we've heard a value
+    /// for every channel (from a full message, sent on connection and
+    /// periodically), reports of all channels are held back, rather than
+    /// reporting the channels we don't know yet as 0.
+    ///
+    /// Handler must have these, for the dispatcher to call:
+    /// - `deliver(OSVR_TimeValue const &, int32_t sensor, double value)`,
+    ///   a report of one channel.
+    /// - `deliverArray(OSVR_TimeValue const &, double const *values,
+    ///   int count)`, the values of every channel, starting at channel 0.
+    template <typename Handler> class AnalogDispatcher {
+      public:
+        AnalogDispatcher(vrpn_ConnectionPtr const &conn, const char *src)
+            : m_conn(conn), m_remote(new vrpn_Analog_Remote(src, conn.get())) {
+            m_deltaSender = m_conn->register_sender(src);
+            m_deltaType = m_conn->register_message_type(
+                common::messages::AnalogDelta::identifier());
+            m_conn->register_handler(m_deltaType,
+                                     &AnalogDispatcher::handleDelta, this,
+                                     m_deltaSender);
+            m_remote->register_change_handler(this,
+                                              &AnalogDispatcher::handle);
+            OSVR_DEV_VERBOSE("Constructed an AnalogDispatcher for " << src);
+        }
+        ~AnalogDispatcher() {
+            m_conn->unregister_handler(m_deltaType,
+                                       &AnalogDispatcher::handleDelta, this,
+                                       m_deltaSender);
+            m_remote->unregister_change_handler(this,
+                                                &AnalogDispatcher::handle);
+        }
+
+        void subscribe(Handler &handler,
+                       boost::optional<int> const &sensor) {
+            m_subscribers.add(handler, sensor);
+        }
+        void unsubscribe(Handler &handler,
+                         boost::optional<int> const &sensor) {
+            m_subscribers.remove(handler, sensor);
+        }
+
+        /// @brief Called from the update of every subscribed handler, but
+        /// only services the remote for one of them.
+        void update(Handler &caller) {
+            if (m_subscribers.driver() == &caller) {
+                m_remote->mainloop();
+            }
+        }
+
+      private:
+        static void VRPN_CALLBACK handle(void *userdata, vrpn_ANALOGCB info) {
+            auto self = static_cast<AnalogDispatcher *>(userdata);
+            self->m_handle(info);
+        }
+        void m_handle(vrpn_ANALOGCB const &info) {
+            OSVR_TimeValue timestamp;
+            osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+            m_subscribers.forEachSubscribedSensor(
+                info.num_channel, [&](int sensor) {
+                    m_subscribers.forSensor(
+                        sensor, [&](Handler &handler) {
+                            handler.deliver(timestamp, sensor,
+                                            info.channel[sensor]);
+                        });
+                });
+            m_subscribers.forEach([&](Handler &handler) {
+                handler.deliverArray(timestamp, info.channel, info.num_channel);
+            });
+        }
+
+        static int VRPN_CALLBACK handleDelta(void *userdata,
+                                             vrpn_HANDLERPARAM p) {
+            auto self = static_cast<AnalogDispatcher *>(userdata);
+            self->m_handleDelta(p);
+            return 0;
+        }
+
+        /// Apply the changed channels to our copy of the device state, then
+        /// pass them on: each one to the handlers for its channel, and the
+        /// whole state, once we know all of it, to the handlers for all
+        /// channels.
+        void m_handleDelta(vrpn_HANDLERPARAM const &p) {
+            auto bufReader = common::readExternalBuffer(p.buffer,
+                                                        p.payload_len);
+            common::messages::AnalogDelta::MessageSerialization msg(m_delta);
+            try {
+                common::deserialize(bufReader, msg);
+            } catch (std::exception &e) {
+                OSVR_DEV_VERBOSE("Could not deserialize a delta analog "
+                                 "report: "
+                                 << e.what());
+                return;
+            }
+            if (msg.getNumChannels() != m_channels.size()) {
+                /// New device layout (or our first message): forget what we
+                /// knew.
+                m_channels.assign(msg.getNumChannels(), 0.);
+                m_known.assign(msg.getNumChannels(), false);
+                m_numKnown = 0;
+            }
+            OSVR_TimeValue timestamp;
+            osvrStructTimevalToTimeValue(&timestamp, &(p.msg_time));
+            auto count = static_cast<int>(m_channels.size());
+            for (auto const &entry : m_delta) {
+                if (entry.channel < count) {
+                    m_channels[entry.channel] = entry.value;
+                    if (!m_known[entry.channel]) {
+                        m_known[entry.channel] = true;
+                        ++m_numKnown;
+                    }
+                }
+            }
+            for (auto const &entry : m_delta) {
+                int sensor = entry.channel;
+                if (sensor >= count) {
+                    continue;
+                }
+                m_subscribers.forSensor(
+                    sensor, [&](Handler &handler) {
+                        handler.deliver(timestamp, sensor, entry.value);
+                    });
+                m_subscribers.forSensorOnly(
+                    sensor, [&](Handler &handler) {
+                        handler.deliverArray(timestamp, m_channels.data(),
+                                             count);
+                    });
+            }
+            if (m_numKnown < m_channels.size()) {
+                return;
+            }
+            m_subscribers.forAllSensors([&](Handler &handler) {
+                handler.deliverArray(timestamp, m_channels.data(), count);
+            });
+        }
+
+        vrpn_ConnectionPtr m_conn;
+        vrpn_int32 m_deltaSender;
+        vrpn_int32 m_deltaType;
+        /// Reused storage for received delta messages.
+        std::vector<common::messages::AnalogDeltaEntry> m_delta;
+        /// Last value of every channel, from delta messages.
+        std::vector<double> m_channels;
+        /// Which channels of m_channels have had a value, and how many.
+        std::vector<bool> m_known;
+        std::size_t m_numKnown = 0;
+        unique_ptr<vrpn_Analog_Remote> m_remote;
+        SensorSubscriberTable<Handler> m_subscribers;
+    };
+
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_AnalogDispatcher_h_GUID_6D1B9E53_2A7C_4F80_93E6_B84C0F21D7A5
@@ -24,9 +24,14 @@
 
 // Internal Includes
 #include "AnalogRemoteFactory.h"
+#include "AnalogDispatcher.h"
+#include "DeviceDispatcher.h"
 #include "RemoteHandlerInternals.h"
 #include "VRPNConnectionCollection.h"
+#include <osvr/Common/AnalogDeltaMessage.h>
+#include <osvr/Common/Buffer.h>
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/Serialization.h>
 #include <osvr/Util/QuatlibInteropC.h>
 #include <osvr/Util/EigenInterop.h>
 #include <osvr/Common/PathTreeFull.h>
@@ -37,7 +42,6 @@
 #include <osvr/Common/JSONTransformVisitor.h>
 #include "PureClientContext.h"
 #include <osvr/Client/InterfaceTree.h>
-#include <osvr/Util/ValueOrRange.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -49,71 +53,75 @@
 #include <json/reader.h>
 
 // Standard includes
-// - none
+#include <vector>
 
 namespace osvr {
 namespace client {
 
     class VRPNAnalogHandler : public RemoteHandler {
       public:
-        typedef util::ValueOrRange<int> RangeType;
-        VRPNAnalogHandler(vrpn_ConnectionPtr const &conn, const char *src,
+        VRPNAnalogHandler(shared_ptr<VRPNAnalogDispatcher> const &dispatcher,
                           boost::optional<int> sensor,
-                          common::InterfaceList &ifaces)
-            : m_remote(new vrpn_Analog_Remote(src, conn.get())),
-              m_internals(ifaces), m_all(!sensor.is_initialized()) {
-            m_remote->register_change_handler(this, &VRPNAnalogHandler::handle);
-            OSVR_DEV_VERBOSE("Constructed an AnalogHandler for " << src);
-
-            if (sensor.is_initialized()) {
-                m_sensors.setValue(*sensor);
-            }
-        }
-        virtual ~VRPNAnalogHandler() {
-            m_remote->unregister_change_handler(this,
-                                                &VRPNAnalogHandler::handle);
-        }
-
-        static void VRPN_CALLBACK handle(void *userdata, vrpn_ANALOGCB info) {
-            auto self = static_cast<VRPNAnalogHandler *>(userdata);
-            self->m_handle(info);
+                          common::InterfaceList &ifaces);
+        virtual ~VRPNAnalogHandler();
+
+        /// @brief Report from the dispatcher, for a channel we're interested
+        /// in.
+        void deliver(OSVR_TimeValue const &timestamp, int32_t sensor,
+                     double state) {
+            OSVR_AnalogReport report;
+            report.sensor = sensor;
+            /// @todo handle transform?
+            report.state = state;
+            m_internals.setStateAndTriggerCallbacks(timestamp, report);
         }
-        virtual void update() { m_remote->mainloop(); }
 
-      private:
-        void m_handle(vrpn_ANALOGCB const &info) {
-            auto maxChannel =
-                m_all ? info.num_channel - 1 : m_sensors.getValue();
-            if (m_sensors.isValue() && (maxChannel < m_sensors.getValue())) {
-                // early out if we're looking for just a single channel number
-                // that isn't in this report.
-                return;
-            }
-            OSVR_TimeValue timestamp;
-            osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
-
-            if (m_all) {
-                if (m_sensors.empty()) {
-                    m_sensors.setRangeMaxMin(maxChannel);
-                } else {
-                    m_sensors.extendRangeToMax(maxChannel);
+        /// @brief All channel values from the dispatcher, starting at channel
+        /// 0: passed on as one array report, or as a one-element array of our
+        /// channel if we have one.
+        void deliverArray(OSVR_TimeValue const &timestamp, double const *values,
+                          int count) {
+            OSVR_AnalogArrayReport report;
+            if (m_sensor) {
+                if (*m_sensor < 0 || *m_sensor >= count) {
+                    return;
                 }
+                report.sensor = *m_sensor;
+                report.state.numChannels = 1;
+                report.state.values = values + *m_sensor;
+            } else {
+                report.sensor = 0;
+                report.state.numChannels =
+                    static_cast<OSVR_ChannelCount>(count);
+                report.state.values = values;
             }
-            for (auto sensor : m_sensors.getIntersection(
-                     RangeType::RangeZeroTo(maxChannel))) {
-                OSVR_AnalogReport report;
-                report.sensor = sensor;
-                /// @todo handle transform?
-                report.state = info.channel[report.sensor];
-                m_internals.setStateAndTriggerCallbacks(timestamp, report);
-            }
+            m_internals.forEachInterface(
+                [&timestamp, &report](common::ClientInterface &iface) {
+                    iface.triggerCallbacks(timestamp, report);
+                });
         }
-        unique_ptr<vrpn_Analog_Remote> m_remote;
+
+        virtual void update();
+
+      private:
+        shared_ptr<VRPNAnalogDispatcher> m_dispatcher;
         RemoteHandlerInternals m_internals;
-        bool m_all;
-        RangeType m_sensors;
+        boost::optional<int> m_sensor;
     };
 
+    VRPNAnalogHandler::VRPNAnalogHandler(
+        shared_ptr<VRPNAnalogDispatcher> const &dispatcher,
+        boost::optional<int> sensor, common::InterfaceList &ifaces)
+        : m_dispatcher(dispatcher), m_internals(ifaces), m_sensor(sensor) {
+        m_dispatcher->subscribe(*this, m_sensor);
+    }
+
+    VRPNAnalogHandler::~VRPNAnalogHandler() {
+        m_dispatcher->unsubscribe(*this, m_sensor);
+    }
+
+    void VRPNAnalogHandler::update() { m_dispatcher->update(*this); }
+
     AnalogRemoteFactory::AnalogRemoteFactory(
         VRPNConnectionCollection const &conns)
         : m_conns(conns) {}
@@ -132,9 +140,10 @@ namespace client {
         auto const &devElt = source.getDeviceElement();
 
         /// @todo find out why make_shared causes a crash here
-        ret.reset(new VRPNAnalogHandler(m_conns.getConnection(devElt),
-                                        devElt.getFullDeviceName().c_str(),
-                                        source.getSensorNumber(), ifaces));
+        auto dispatcher = m_dispatchers.get(m_conns.getConnection(devElt),
+                                            devElt.getFullDeviceName());
+        ret.reset(new VRPNAnalogHandler(dispatcher, source.getSensorNumber(),
+                                        ifaces));
         return ret;
     }
 
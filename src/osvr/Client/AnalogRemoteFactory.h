@@ -26,6 +26,7 @@
 #define INCLUDED_AnalogRemoteFactory_h_GUID_F2F60718_042B_44BD_B697_50D3434C72CE
 
 // Internal Includes
+#include "DeviceDispatcher.h"
 #include "VRPNConnectionCollection.h"
 #include <osvr/Common/InterfaceList.h>
 #include <osvr/Common/OriginalSource.h>
@@ -42,6 +43,9 @@
 
 namespace osvr {
 namespace client {
+    template <typename Handler> class AnalogDispatcher;
+    class VRPNAnalogHandler;
+    typedef AnalogDispatcher<VRPNAnalogHandler> VRPNAnalogDispatcher;
 
     class AnalogRemoteFactory {
       public:
@@ -57,6 +61,8 @@ namespace client {
 
       private:
         VRPNConnectionCollection m_conns;
+        /// One dispatcher per device, shared by the handlers for its sensors.
+        DeviceDispatcherRegistry<VRPNAnalogDispatcher> m_dispatchers;
     };
 
 } // namespace client
@@ -31,7 +31,6 @@
 #include <osvr/Common/PathElementTypes.h>
 #include <osvr/Common/ClientInterface.h>
 #include <osvr/Util/Verbosity.h>
-#include <osvr/Common/DeduplicatingFunctionWrapper.h>
 
 // Library/third-party includes
 #include <json/value.h>
@@ -68,17 +67,22 @@ namespace client {
         m_systemDevice = common::createClientDevice(sysDeviceName, m_mainConn);
         m_systemComponent =
             m_systemDevice->addComponent(common::SystemComponent::create());
-        using DedupJsonFunction =
-            common::DeduplicatingFunctionWrapper<Json::Value const &>;
         m_systemComponent->registerReplaceTreeHandler(
-            DedupJsonFunction([&](Json::Value nodes) {
+            [&](Json::Value const &nodes, util::time::TimeValue const &) {
 
                 OSVR_DEV_VERBOSE("Got updated path tree, processing");
 
                 // Tree observers will handle destruction/creation of remote
                 // handlers.
                 m_pathTreeOwner.replaceTree(nodes);
-            }));
+            });
+        m_systemComponent->registerTreeDeltaHandler(
+            [&](Json::Value const &delta, util::time::TimeValue const &) {
+                if (!m_pathTreeOwner.applyTreeDelta(delta) &&
+                    m_pathTreeOwner.takeFullTreeRequest()) {
+                    m_systemComponent->sendTreeRequest();
+                }
+            });
 
         // No startup spin.
     }
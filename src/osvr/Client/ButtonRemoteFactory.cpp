@@ -24,6 +24,7 @@
 
 // Internal Includes
 #include "ButtonRemoteFactory.h"
+#include "DeviceDispatcher.h"
 #include "RemoteHandlerInternals.h"
 #include "VRPNConnectionCollection.h"
 #include <osvr/Common/ClientInterface.h>
@@ -32,7 +33,6 @@
 #include <osvr/Util/UniquePtr.h>
 #include <osvr/Common/OriginalSource.h>
 #include <osvr/Client/InterfaceTree.h>
-#include <osvr/Util/ValueOrRange.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -49,91 +49,119 @@
 namespace osvr {
 namespace client {
 
+    class VRPNButtonDispatcher;
+
     class VRPNButtonHandler : public RemoteHandler {
       public:
-        typedef util::ValueOrRange<int> RangeType;
-        VRPNButtonHandler(vrpn_ConnectionPtr const &conn, const char *src,
+        VRPNButtonHandler(shared_ptr<VRPNButtonDispatcher> const &dispatcher,
                           boost::optional<int> sensor,
-                          common::InterfaceList &ifaces)
-            : m_remote(new vrpn_Button_Remote(src, conn.get())),
-              m_internals(ifaces), m_all(!sensor.is_initialized()) {
-            m_remote->register_change_handler(this, &VRPNButtonHandler::handle);
-            m_remote->register_states_handler(
-                this, &VRPNButtonHandler::handle_states);
-            OSVR_DEV_VERBOSE("Constructed a ButtonHandler for " << src);
+                          common::InterfaceList &ifaces);
+        virtual ~VRPNButtonHandler();
 
-            if (sensor.is_initialized()) {
-                m_sensors.setValue(*sensor);
-            }
+        /// @brief Report from the dispatcher, for a button we're interested
+        /// in.
+        void deliver(OSVR_TimeValue const &timestamp, int32_t sensor,
+                     vrpn_int32 state) {
+            OSVR_ButtonReport report;
+            report.sensor = sensor;
+            report.state = static_cast<uint8_t>(state);
+            m_internals.setStateAndTriggerCallbacks(timestamp, report);
         }
-        virtual ~VRPNButtonHandler() {
+
+        virtual void update();
+
+      private:
+        shared_ptr<VRPNButtonDispatcher> m_dispatcher;
+        RemoteHandlerInternals m_internals;
+        boost::optional<int> m_sensor;
+    };
+
+    /// @brief Owns the one button remote for a device, however many handlers
+    /// its buttons are routed to, passing each button's state only to the
+    /// handlers for that button.
+    class VRPNButtonDispatcher {
+      public:
+        VRPNButtonDispatcher(vrpn_ConnectionPtr const &conn, const char *src)
+            : m_remote(new vrpn_Button_Remote(src, conn.get())) {
+            m_remote->register_change_handler(this,
+                                              &VRPNButtonDispatcher::handle);
+            m_remote->register_states_handler(
+                this, &VRPNButtonDispatcher::handle_states);
+            OSVR_DEV_VERBOSE("Constructed a ButtonDispatcher for " << src);
+        }
+        ~VRPNButtonDispatcher() {
             m_remote->unregister_change_handler(this,
-                                                &VRPNButtonHandler::handle);
+                                                &VRPNButtonDispatcher::handle);
             m_remote->unregister_states_handler(
-                this, &VRPNButtonHandler::handle_states);
+                this, &VRPNButtonDispatcher::handle_states);
+        }
+
+        void subscribe(VRPNButtonHandler &handler,
+                       boost::optional<int> const &sensor) {
+            m_subscribers.add(handler, sensor);
+        }
+        void unsubscribe(VRPNButtonHandler &handler,
+                         boost::optional<int> const &sensor) {
+            m_subscribers.remove(handler, sensor);
+        }
+
+        /// @brief Called from the update of every subscribed handler, but
+        /// only services the remote for one of them.
+        void update(VRPNButtonHandler &caller) {
+            if (m_subscribers.driver() == &caller) {
+                m_remote->mainloop();
+            }
         }
 
+      private:
         static void VRPN_CALLBACK handle(void *userdata, vrpn_BUTTONCB info) {
-            auto self = static_cast<VRPNButtonHandler *>(userdata);
+            auto self = static_cast<VRPNButtonDispatcher *>(userdata);
             self->m_handle(info);
         }
 
         static void VRPN_CALLBACK handle_states(void *userdata,
                                                 vrpn_BUTTONSTATESCB info) {
-            auto self = static_cast<VRPNButtonHandler *>(userdata);
+            auto self = static_cast<VRPNButtonDispatcher *>(userdata);
             self->m_handle(info);
         }
-        virtual void update() { m_remote->mainloop(); }
 
-      private:
         void m_handle(vrpn_BUTTONCB const &info) {
-            if (!m_all && !m_sensors.contains(info.button)) {
-                return;
-            }
-
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
-
-            m_report(timestamp, info.button, info.state);
+            m_subscribers.forSensor(
+                info.button, [&](VRPNButtonHandler &handler) {
+                    handler.deliver(timestamp, info.button, info.state);
+                });
         }
         void m_handle(vrpn_BUTTONSTATESCB const &info) {
-            auto maxChannel =
-                m_all ? info.num_buttons - 1 : m_sensors.getValue();
-            if (!m_all &&
-                m_sensors.getIntersection(RangeType::RangeZeroTo(maxChannel))
-                    .empty()) {
-                // early out if we're looking for just a single channel number
-                // that isn't in this report.
-                return;
-            }
-            if (m_all) {
-                if (m_sensors.empty()) {
-                    m_sensors.setRangeMaxMin(maxChannel);
-                } else {
-                    m_sensors.extendRangeToMax(maxChannel);
-                }
-            }
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
-
-            for (auto sensor : m_sensors.getIntersection(
-                     RangeType::RangeZeroTo(maxChannel))) {
-                m_report(timestamp, sensor, info.states[sensor]);
-            }
-        }
-        void m_report(OSVR_TimeValue const &timestamp, int32_t sensor,
-                      vrpn_int32 state) {
-            OSVR_ButtonReport report;
-            report.sensor = sensor;
-            report.state = static_cast<uint8_t>(state);
-            m_internals.setStateAndTriggerCallbacks(timestamp, report);
+            m_subscribers.forEachSubscribedSensor(
+                info.num_buttons, [&](int sensor) {
+                    m_subscribers.forSensor(
+                        sensor, [&](VRPNButtonHandler &handler) {
+                            handler.deliver(timestamp, sensor,
+                                            info.states[sensor]);
+                        });
+                });
         }
         unique_ptr<vrpn_Button_Remote> m_remote;
-        RemoteHandlerInternals m_internals;
-        bool m_all;
-        RangeType m_sensors;
+        SensorSubscriberTable<VRPNButtonHandler> m_subscribers;
     };
 
+    VRPNButtonHandler::VRPNButtonHandler(
+        shared_ptr<VRPNButtonDispatcher> const &dispatcher,
+        boost::optional<int> sensor, common::InterfaceList &ifaces)
+        : m_dispatcher(dispatcher), m_internals(ifaces), m_sensor(sensor) {
+        m_dispatcher->subscribe(*this, m_sensor);
+    }
+
+    VRPNButtonHandler::~VRPNButtonHandler() {
+        m_dispatcher->unsubscribe(*this, m_sensor);
+    }
+
+    void VRPNButtonHandler::update() { m_dispatcher->update(*this); }
+
     ButtonRemoteFactory::ButtonRemoteFactory(
         VRPNConnectionCollection const &conns)
         : m_conns(conns) {}
@@ -152,9 +180,10 @@ namespace client {
         auto const &devElt = source.getDeviceElement();
 
         /// @todo find out why make_shared causes a crash here
-        ret.reset(new VRPNButtonHandler(m_conns.getConnection(devElt),
-                                        devElt.getFullDeviceName().c_str(),
-                                        source.getSensorNumber(), ifaces));
+        auto dispatcher = m_dispatchers.get(m_conns.getConnection(devElt),
+                                            devElt.getFullDeviceName());
+        ret.reset(new VRPNButtonHandler(dispatcher, source.getSensorNumber(),
+                                        ifaces));
         return ret;
     }
 
@@ -26,6 +26,7 @@
 #define INCLUDED_ButtonRemoteFactory_h_GUID_B51EC814_96AA_4195_DACE_7B0CF376AEA8
 
 // Internal Includes
+#include "DeviceDispatcher.h"
 #include "VRPNConnectionCollection.h"
 #include <osvr/Common/InterfaceList.h>
 #include <osvr/Common/OriginalSource.h>
@@ -41,6 +42,7 @@
 
 namespace osvr {
 namespace client {
+    class VRPNButtonDispatcher;
 
     class ButtonRemoteFactory {
       public:
@@ -56,6 +58,8 @@ namespace client {
 
       private:
         VRPNConnectionCollection m_conns;
+        /// One dispatcher per device, shared by the handlers for its sensors.
+        DeviceDispatcherRegistry<VRPNButtonDispatcher> m_dispatchers;
     };
 
 } // namespace client
@@ -32,6 +32,7 @@
 #include <osvr/Common/ClientInterface.h>
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Common/ResolveTreeNode.h>
+#include <osvr/Common/PathElementTypes.h>
 
 // Library/third-party includes
 #include <boost/assert.hpp>
@@ -52,6 +53,12 @@ namespace client {
         m_treeObserver->setEventCallback(
             common::PathTreeEvents::AfterUpdate,
             [&](common::PathTree &) { m_connectNeededCallbacks(); });
+        m_treeObserver->setEventCallback(
+            common::PathTreeEvents::AboutToPatch,
+            [&](common::PathTree &) { m_snapshotHandledSources(); });
+        m_treeObserver->setEventCallback(
+            common::PathTreeEvents::AfterPatch,
+            [&](common::PathTree &) { m_reconnectChangedSources(); });
     }
 
     void ClientInterfaceObjectManager::addInterface(
@@ -132,6 +139,49 @@ namespace client {
                          << " unconnected paths successfully";
     }
 
+    Json::Value ClientInterfaceObjectManager::m_getSourceSignature(
+        std::string const &path) {
+        Json::Value ret(Json::nullValue);
+        auto source = common::resolveTreeNode(m_pathTree, path);
+        if (!source.is_initialized() || !source->isResolved()) {
+            return ret;
+        }
+        auto const &dev = source->getDeviceElement();
+        ret["device"] = source->getDevicePath();
+        ret["fullDeviceName"] = dev.getFullDeviceName();
+        ret["server"] = dev.getServer();
+        ret["interface"] = source->getInterfaceName();
+        auto sensor = source->getSensorNumber();
+        if (sensor) {
+            ret["sensor"] = *sensor;
+        }
+        if (source->hasTransform()) {
+            ret["transform"] = source->getTransformJson();
+        }
+        return ret;
+    }
+
+    void ClientInterfaceObjectManager::m_snapshotHandledSources() {
+        m_handledSources.clear();
+        m_interfaces.visitPathsWithHandlers([&](std::string const &path) {
+            m_handledSources[path] = m_getSourceSignature(path);
+        });
+    }
+
+    void ClientInterfaceObjectManager::m_reconnectChangedSources() {
+        auto rebuilt = size_t{0};
+        for (auto const &handled : m_handledSources) {
+            if (m_getSourceSignature(handled.first) != handled.second) {
+                m_connectCallbacksOnPath(handled.first);
+                rebuilt++;
+            }
+        }
+        logger()->debug() << "Path tree patched: rebuilt " << rebuilt << " of "
+                          << m_handledSources.size() << " handlers";
+        m_handledSources.clear();
+        m_connectNeededCallbacks();
+    }
+
     util::log::LoggerPtr const &ClientInterfaceObjectManager::logger() const {
         return m_ctx->logger();
     }
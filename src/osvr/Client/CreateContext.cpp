@@ -38,13 +38,19 @@ namespace osvr {
 namespace client {
     common::ClientContext *createContext(const char appId[],
                                          const char host[]) {
+        return createContext(appId, host, ContextOptions{});
+    }
+
+    common::ClientContext *createContext(const char appId[],
+                                         const char host[],
+                                         ContextOptions const &options) {
         common::ClientContext *ret = nullptr;
         if (!appId || std::strlen(appId) == 0) {
             OSVR_DEV_VERBOSE("Could not create client context - null or empty "
                              "appId provided!");
             return ret;
         }
-        ret = common::makeContext<PureClientContext>(appId, host);
+        ret = common::makeContext<PureClientContext>(appId, host, options);
         return ret;
     }
 
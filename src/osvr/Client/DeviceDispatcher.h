@@ -0,0 +1,278 @@
+/** @file
+    @brief Header providing the shared pieces of the per-device report
+    dispatchers: one VRPN remote per device, fanning reports out to the
+    handlers subscribed to each sensor.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DeviceDispatcher_h_GUID_4A8E2C61_9F3B_4D07_B5A2_E17C0D6F9B38
+#define INCLUDED_DeviceDispatcher_h_GUID_4A8E2C61_9F3B_4D07_B5A2_E17C0D6F9B38
+
+// Internal Includes
+#include <osvr/Util/SharedPtr.h>
+
+// Library/third-party includes
+#include <boost/optional.hpp>
+#include <vrpn_ConnectionPtr.h>
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace osvr {
+namespace client {
+
+    /// @brief The handlers subscribed to the reports of one device, indexed
+    /// by sensor so that a report is only delivered to the handlers
+    /// interested in its sensor, however many handlers share the device.
+    ///
+    /// Subscribers may be added or removed from within the calls made while
+    /// delivering a report (a callback freeing or creating an interface, for
+    /// instance): a removed subscriber is never called again, while one added
+    /// mid-delivery is left out of the for...() call in progress.
+    template <typename Subscriber> class SensorSubscriberTable {
+      public:
+        /// @param sub Subscriber, which must be removed before it is
+        /// destroyed.
+        /// @param sensor The sensor subscribed to, or empty for all of them.
+        void add(Subscriber &sub, boost::optional<int> const &sensor) {
+            ++m_size;
+            m_order.push_back(&sub);
+            if (!sensor) {
+                m_all.push_back(&sub);
+                return;
+            }
+            if (*sensor < 0) {
+                /// Never reported, so nothing to index.
+                return;
+            }
+            auto idx = static_cast<std::size_t>(*sensor);
+            if (idx >= m_bySensor.size()) {
+                m_bySensor.resize(idx + 1);
+            }
+            m_bySensor[idx].push_back(&sub);
+        }
+
+        /// @param sensor Must match the one passed to add()
+        void remove(Subscriber &sub, boost::optional<int> const &sensor) {
+            --m_size;
+            erase(m_order, &sub);
+            if (!sensor) {
+                erase(m_all, &sub);
+            } else if (*sensor >= 0 &&
+                       static_cast<std::size_t>(*sensor) < m_bySensor.size()) {
+                erase(m_bySensor[*sensor], &sub);
+            }
+        }
+
+        bool empty() const { return m_size == 0; }
+
+        /// @brief The subscriber responsible for work done once per update
+        /// for the whole device (the longest-subscribed one), or nullptr.
+        Subscriber *driver() const {
+            for (auto sub : m_order) {
+                if (sub) {
+                    return sub;
+                }
+            }
+            return nullptr;
+        }
+
+        /// @brief Calls f(subscriber) for each subscriber to the given sensor,
+        /// including those subscribed to all sensors.
+        template <typename F> void forSensor(int sensor, F &&f) {
+            DispatchScope scope(*this);
+            auto allEnd = m_all.size();
+            forSensorOnly(sensor, f);
+            forList(m_all, allEnd, f);
+        }
+
+        /// @brief Calls f(subscriber) for each subscriber to just the given
+        /// sensor.
+        template <typename F> void forSensorOnly(int sensor, F &&f) {
+            if (sensor >= 0 &&
+                static_cast<std::size_t>(sensor) < m_bySensor.size()) {
+                auto idx = static_cast<std::size_t>(sensor);
+                DispatchScope scope(*this);
+                /// Indexing each time, since an add() may reallocate both
+                /// levels.
+                for (std::size_t i = 0, e = m_bySensor[idx].size(); i < e;
+                     ++i) {
+                    if (auto sub = m_bySensor[idx][i]) {
+                        f(*sub);
+                    }
+                }
+            }
+        }
+
+        /// @brief Calls f(subscriber) for each subscriber to all sensors.
+        template <typename F> void forAllSensors(F &&f) {
+            forList(m_all, m_all.size(), f);
+        }
+
+        /// @brief Calls f(subscriber) for every subscriber.
+        template <typename F> void forEach(F &&f) {
+            forList(m_order, m_order.size(), f);
+        }
+
+        /// @brief Calls f(sensor) for each sensor less than count that has at
+        /// least one subscriber.
+        template <typename F>
+        void forEachSubscribedSensor(int count, F &&f) {
+            DispatchScope scope(*this);
+            if (!m_all.empty()) {
+                for (int sensor = 0; sensor < count; ++sensor) {
+                    f(sensor);
+                }
+                return;
+            }
+            for (int sensor = 0;
+                 sensor < std::min(count, static_cast<int>(m_bySensor.size()));
+                 ++sensor) {
+                if (!m_bySensor[sensor].empty()) {
+                    f(sensor);
+                }
+            }
+        }
+
+      private:
+        typedef std::vector<Subscriber *> SubscriberList;
+
+        /// @brief Marks a delivery in progress, during which removal only
+        /// nulls out entries: they're erased once the outermost delivery
+        /// ends.
+        class DispatchScope {
+          public:
+            explicit DispatchScope(SensorSubscriberTable &table)
+                : m_table(table) {
+                ++m_table.m_dispatchDepth;
+            }
+            ~DispatchScope() {
+                if (--m_table.m_dispatchDepth == 0 && m_table.m_removed) {
+                    m_table.compact();
+                }
+            }
+
+          private:
+            DispatchScope(DispatchScope const &) = delete;
+            DispatchScope &operator=(DispatchScope const &) = delete;
+            SensorSubscriberTable &m_table;
+        };
+
+        /// @param end Size of the list when the delivery started: anything
+        /// added since isn't called.
+        template <typename F>
+        void forList(SubscriberList &list, std::size_t end, F &&f) {
+            DispatchScope scope(*this);
+            /// Indexing each time, since an add() may reallocate.
+            for (std::size_t i = 0; i < end; ++i) {
+                if (auto sub = list[i]) {
+                    f(*sub);
+                }
+            }
+        }
+
+        void erase(SubscriberList &list, Subscriber *sub) {
+            if (m_dispatchDepth > 0) {
+                std::replace(list.begin(), list.end(), sub,
+                             static_cast<Subscriber *>(nullptr));
+                m_removed = true;
+                return;
+            }
+            list.erase(std::remove(list.begin(), list.end(), sub), list.end());
+        }
+
+        void compact() {
+            auto compactList = [](SubscriberList &list) {
+                list.erase(std::remove(list.begin(), list.end(), nullptr),
+                           list.end());
+            };
+            compactList(m_order);
+            compactList(m_all);
+            for (auto &list : m_bySensor) {
+                compactList(list);
+            }
+            m_removed = false;
+        }
+
+        /// All subscribers, in order of subscription.
+        SubscriberList m_order;
+        SubscriberList m_all;
+        std::vector<SubscriberList> m_bySensor;
+        std::size_t m_size = 0;
+        /// Number of deliveries in progress (they may nest).
+        int m_dispatchDepth = 0;
+        /// Whether any entries were nulled out rather than erased.
+        bool m_removed = false;
+    };
+
+    /// @brief Hands out the dispatcher for a device, creating it when the
+    /// first handler for that device needs it. Copies share their
+    /// dispatchers, which last as long as some handler holds on to them.
+    ///
+    /// Dispatcher must be constructible from a vrpn_ConnectionPtr and the
+    /// full device name.
+    template <typename Dispatcher> class DeviceDispatcherRegistry {
+      public:
+        DeviceDispatcherRegistry() : m_dispatchers(make_shared<Map>()) {}
+
+        shared_ptr<Dispatcher> get(vrpn_ConnectionPtr const &conn,
+                                   std::string const &device) {
+            eraseExpired();
+            auto &entry = (*m_dispatchers)[device];
+            auto ret = entry.lock();
+            if (!ret) {
+                ret = make_shared<Dispatcher>(conn, device.c_str());
+                entry = ret;
+            }
+            return ret;
+        }
+
+        /// @brief Number of devices with a dispatcher, including any whose
+        /// dispatcher has expired since the last call to get().
+        std::size_t size() const { return m_dispatchers->size(); }
+
+      private:
+        /// @brief Drops the entries of devices no handler uses anymore, so
+        /// the map doesn't keep growing as devices come and go.
+        void eraseExpired() {
+            auto &dispatchers = *m_dispatchers;
+            for (auto it = dispatchers.begin(); it != dispatchers.end();) {
+                if (it->second.expired()) {
+                    it = dispatchers.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        typedef std::unordered_map<std::string, weak_ptr<Dispatcher>> Map;
+        shared_ptr<Map> m_dispatchers;
+    };
+
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_DeviceDispatcher_h_GUID_4A8E2C61_9F3B_4D07_B5A2_E17C0D6F9B38
@@ -0,0 +1,193 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PathTreeCache.h"
+#include <osvr/Util/GetEnvironmentVariable.h>
+#include <osvr/Util/PlatformConfig.h>
+
+// Library/third-party includes
+#include <boost/filesystem.hpp>
+#include <json/reader.h>
+#include <json/writer.h>
+
+// Standard includes
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+namespace osvr {
+namespace client {
+    static const char SERVER_KEY[] = "server";
+    static const char HASH_KEY[] = "hash";
+    static const char NODES_KEY[] = "nodes";
+
+    namespace fs = boost::filesystem;
+
+    /// @brief Per-user directory for non-essential data: empty if we can't
+    /// tell where that is.
+    static inline fs::path getCacheDirectory() {
+        using osvr::util::getEnvironmentVariable;
+        fs::path dir;
+#if defined(OSVR_LINUX)
+        auto xdg_cache_dir = getEnvironmentVariable("XDG_CACHE_HOME");
+        auto home_dir = getEnvironmentVariable("HOME");
+        if (xdg_cache_dir) {
+            dir = *xdg_cache_dir;
+        } else if (home_dir) {
+            dir = fs::path(*home_dir) / ".cache";
+        } else {
+            return dir;
+        }
+        dir /= "osvr";
+#elif defined(OSVR_MACOSX)
+        auto home_dir = getEnvironmentVariable("HOME");
+        if (!home_dir) {
+            return dir;
+        }
+        dir = fs::path(*home_dir) / "Library" / "Caches" / "OSVR";
+#elif defined(OSVR_WINDOWS)
+        auto local_app_dir = getEnvironmentVariable("LocalAppData");
+        if (!local_app_dir) {
+            return dir;
+        }
+        dir = fs::path(*local_app_dir) / "OSVR" / "Cache";
+#endif
+        return dir;
+    }
+
+    /// @brief Turns a host name (possibly with a port) into something safe
+    /// to use in a filename.
+    static inline std::string sanitizeHost(std::string const &host) {
+        std::string ret;
+        for (auto c : host) {
+            ret.push_back(std::isalnum(static_cast<unsigned char>(c)) ? c
+                                                                      : '_');
+        }
+        return ret;
+    }
+
+    static inline std::string hashToString(PathTreeCache::Hash h) {
+        std::ostringstream os;
+        os << std::hex << h;
+        return os.str();
+    }
+
+    PathTreeCache::PathTreeCache(std::string const &host)
+        : PathTreeCache(host, getCacheDirectory().string()) {}
+
+    PathTreeCache::PathTreeCache(std::string const &host,
+                                 std::string const &directory)
+        : m_host(host) {
+        if (!directory.empty()) {
+            m_filename = (fs::path(directory) /
+                          ("pathtree-" + sanitizeHost(host) + ".json"))
+                             .string();
+        }
+    }
+
+    boost::optional<Json::Value> PathTreeCache::load() {
+        boost::optional<Json::Value> ret;
+        if (m_filename.empty()) {
+            return ret;
+        }
+        std::ifstream file{m_filename};
+        if (!file) {
+            return ret;
+        }
+        Json::Reader reader;
+        Json::Value root;
+        if (!reader.parse(file, root) || !root.isObject()) {
+            return ret;
+        }
+        if (root[SERVER_KEY].asString() != m_host) {
+            return ret;
+        }
+        auto const &nodes = root[NODES_KEY];
+        auto h = hash(nodes);
+        if (!nodes.isArray() || root[HASH_KEY].asString() != hashToString(h)) {
+            /// Damaged or edited: ignore it.
+            return ret;
+        }
+        m_hash = h;
+        ret = nodes;
+        return ret;
+    }
+
+    bool PathTreeCache::matchOrStore(Json::Value const &nodes) {
+        auto h = hash(nodes);
+        if (m_hash && *m_hash == h) {
+            return true;
+        }
+        m_hash = h;
+        if (m_filename.empty()) {
+            return false;
+        }
+        Json::Value root(Json::objectValue);
+        root[SERVER_KEY] = m_host;
+        root[HASH_KEY] = hashToString(h);
+        root[NODES_KEY] = nodes;
+
+        /// Unique, since other clients of the same server may be writing
+        /// too.
+        boost::system::error_code ec;
+        fs::path target{m_filename};
+        fs::path temp = target;
+        temp += fs::unique_path(".%%%%-%%%%-%%%%.tmp", ec);
+        if (!ec) {
+            fs::create_directories(target.parent_path(), ec);
+        }
+        if (ec) {
+            return false;
+        }
+        {
+            std::ofstream file{temp.string()};
+            file << Json::FastWriter().write(root);
+            file.close();
+            if (!file) {
+                fs::remove(temp, ec);
+                return false;
+            }
+        }
+        fs::rename(temp, target, ec);
+        if (ec) {
+            fs::remove(temp, ec);
+        }
+        return false;
+    }
+
+    PathTreeCache::Hash PathTreeCache::hash(Json::Value const &nodes) {
+        /// 64-bit FNV-1a over the compact serialization: stable across runs
+        /// and builds, unlike std::hash.
+        auto serialized = Json::FastWriter().write(nodes);
+        Hash ret = 14695981039346656037ULL;
+        for (auto c : serialized) {
+            ret ^= static_cast<unsigned char>(c);
+            ret *= 1099511628211ULL;
+        }
+        return ret;
+    }
+
+} // namespace client
+} // namespace osvr
@@ -0,0 +1,93 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PathTreeCache_h_GUID_6C1F0B2E_84D7_4A39_9E52_B3A70D18F6C4
+#define INCLUDED_PathTreeCache_h_GUID_6C1F0B2E_84D7_4A39_9E52_B3A70D18F6C4
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/optional.hpp>
+#include <json/value.h>
+
+// Standard includes
+#include <cstdint>
+#include <string>
+
+namespace osvr {
+namespace client {
+
+    /// @brief On-disk copy of the last full path tree received from a
+    /// server, so a client can resolve its interfaces before the server
+    /// sends the real one.
+    ///
+    /// There is one cache file per server (host), storing the nodes along
+    /// with a hash of them, used both to detect a damaged file and to check
+    /// the tree later received against the cached one cheaply.
+    class PathTreeCache {
+      public:
+        typedef std::uint64_t Hash;
+
+        /// @param host The server the trees come from.
+        explicit PathTreeCache(std::string const &host);
+
+        /// @brief Constructor keeping the cache file in the given directory
+        /// instead of the per-user cache directory.
+        PathTreeCache(std::string const &host, std::string const &directory);
+
+        /// @brief Loads the cached tree for our server, if there is a valid
+        /// one, recording its hash.
+        boost::optional<Json::Value> load();
+
+        /// @brief Compares the given tree with the cached one, saving it for
+        /// our server if it differs.
+        ///
+        /// The file is written to a temporary file first, then renamed over
+        /// the old one, so a concurrent load() never sees a partial file.
+        ///
+        /// @return true if nodes matched the cached tree (so nothing was
+        /// written), false if they didn't - whether or not saving succeeded.
+        bool matchOrStore(Json::Value const &nodes);
+
+        /// @brief Hash of the last tree loaded or stored, if any.
+        boost::optional<Hash> const &getHash() const { return m_hash; }
+
+        /// @brief Path of the cache file: empty if there's nowhere to put
+        /// it.
+        std::string const &getFilename() const { return m_filename; }
+
+        /// @brief Hash of a serialized array of path tree nodes.
+        static Hash hash(Json::Value const &nodes);
+
+      private:
+        std::string m_host;
+        std::string m_filename;
+        boost::optional<Hash> m_hash;
+    };
+
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_PathTreeCache_h_GUID_6C1F0B2E_84D7_4A39_9E52_B3A70D18F6C4
@@ -31,7 +31,6 @@
 #include <osvr/Common/PathElementTypes.h>
 #include <osvr/Common/ClientInterface.h>
 #include <osvr/Util/Verbosity.h>
-#include <osvr/Common/DeduplicatingFunctionWrapper.h>
 
 #include <boost/algorithm/string.hpp>
 
@@ -85,8 +84,10 @@ namespace client {
     static const std::chrono::milliseconds STARTUP_LOOP_SLEEP(1);
 
     PureClientContext::PureClientContext(const char appId[], const char host[],
+                                         ContextOptions const &options,
                                          common::ClientContextDeleter del)
         : ::OSVR_ClientContextObject(appId, del), m_host(host),
+          m_startTime(std::chrono::steady_clock::now()),
           m_ifaceMgr(m_pathTreeOwner, m_factory,
                      *static_cast<common::ClientContext *>(this)) {
 
@@ -106,22 +107,34 @@ namespace client {
         m_systemDevice = common::createClientDevice(sysDeviceName, m_mainConn);
         m_systemComponent =
             m_systemDevice->addComponent(common::SystemComponent::create());
-        using DedupJsonFunction =
-            common::DeduplicatingFunctionWrapper<Json::Value const &>;
 
         m_systemComponent->registerReplaceTreeHandler(
-            DedupJsonFunction([&](Json::Value nodes) {
-                logger()->debug("Got updated path tree, processing");
-                // Replace localhost before we even convert the json to a tree.
-                // replace the @localhost with the correct host name
-                // in case we are a remote client, otherwise the connection
-                // would fail
-                replaceLocalhostServers(nodes, m_host);
-
-                // Tree observers will handle destruction/creation of remote
-                // handlers.
-                m_pathTreeOwner.replaceTree(nodes);
-            }));
+            [&](Json::Value nodes, util::time::TimeValue const &) {
+                m_handleTree(std::move(nodes));
+            });
+        m_systemComponent->registerTreeDeltaHandler(
+            [&](Json::Value const &delta, util::time::TimeValue const &) {
+                auto patch = delta;
+                replaceLocalhostServers(patch["set"], m_host);
+                if (m_pathTreeOwner.applyTreeDelta(patch)) {
+                    logger()->debug("Patched path tree in place");
+                } else if (m_pathTreeOwner.takeFullTreeRequest()) {
+                    logger()->debug("Could not patch path tree, requesting "
+                                    "the full tree");
+                    m_systemComponent->sendTreeRequest();
+                }
+            });
+
+        if (options.usePathTreeCache) {
+            m_treeCache.reset(new PathTreeCache(m_host));
+            m_loadCachedTree();
+        }
+
+        if (!options.waitForConnection) {
+            logger()->debug("Not waiting for connection: will connect to the "
+                            "server during updates");
+            return;
+        }
 
         typedef std::chrono::system_clock clock;
         auto begin = clock::now();
@@ -145,7 +158,7 @@ namespace client {
 
         // Spin the update to get a path tree
         auto treeEnd = begin + STARTUP_TREE_TIMEOUT;
-        while (clock::now() < treeEnd && !m_pathTreeOwner) {
+        while (clock::now() < treeEnd && !m_gotServerTree) {
             m_update();
             std::this_thread::sleep_for(STARTUP_LOOP_SLEEP);
         }
@@ -153,7 +166,7 @@ namespace client {
 
         // this message is just "info" if we're all good, but "notice" if we
         // aren't fully set up yet.
-        logger()->log(m_pathTreeOwner ? util::log::LogLevel::info
+        logger()->log(m_gotServerTree ? util::log::LogLevel::info
                                       : util::log::LogLevel::notice)
             << "Connection process took "
             << std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -161,7 +174,7 @@ namespace client {
                    .count()
             << "ms: " << (m_gotConnection ? "have connection to server, "
                                           : "don't have connection to server, ")
-            << (m_pathTreeOwner ? "have path tree" : "don't have path tree");
+            << (m_gotServerTree ? "have path tree" : "don't have path tree");
     }
 
     PureClientContext::~PureClientContext() {}
@@ -197,7 +210,53 @@ namespace client {
     }
 
     bool PureClientContext::m_getStatus() const {
-        return m_gotConnection && m_pathTreeOwner;
+        return m_gotConnection && m_gotServerTree;
+    }
+
+    void PureClientContext::m_handleTree(Json::Value nodes) {
+        logger()->debug("Got updated path tree, processing");
+        // Replace localhost before we even convert the json to a tree.
+        // replace the @localhost with the correct host name
+        // in case we are a remote client, otherwise the connection
+        // would fail
+        replaceLocalhostServers(nodes, m_host);
+
+        auto matchesCache = m_treeCache && m_treeCache->matchOrStore(nodes);
+        if (m_usingCachedTree && matchesCache) {
+            // Our speculative handlers are the right ones: keep them.
+            m_pathTreeOwner.confirmTree();
+        } else {
+            if (m_usingCachedTree) {
+                logger()->info(
+                    "Path tree from server differs from the cached one");
+            }
+            // Tree observers will handle destruction/creation of remote
+            // handlers.
+            m_pathTreeOwner.replaceTree(nodes);
+        }
+        m_usingCachedTree = false;
+
+        if (!m_gotServerTree) {
+            m_gotServerTree = true;
+            logger()->info()
+                << "Got path tree from server "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - m_startTime)
+                       .count()
+                << "ms after startup"
+                << (matchesCache ? ", matching the cached one" : "");
+        }
+    }
+
+    void PureClientContext::m_loadCachedTree() {
+        auto nodes = m_treeCache->load();
+        if (!nodes) {
+            logger()->debug("No cached path tree for this server");
+            return;
+        }
+        logger()->debug("Starting with the cached path tree for this server");
+        m_pathTreeOwner.replaceTree(*nodes);
+        m_usingCachedTree = true;
     }
 
     common::PathTree const &PureClientContext::m_getPathTree() const {
@@ -37,13 +37,17 @@
 #include <osvr/Client/InterfaceTree.h>
 #include <osvr/Client/RemoteHandlerFactory.h>
 #include <osvr/Client/ClientInterfaceObjectManager.h>
+#include <osvr/Client/CreateContext.h>
 #include <osvr/Common/PathTreeOwner.h>
+#include "PathTreeCache.h"
 
 // Library/third-party includes
 #include <vrpn_ConnectionPtr.h>
 #include <json/value.h>
 
 // Standard includes
+#include <chrono>
+#include <memory>
 #include <string>
 
 namespace osvr {
@@ -54,6 +58,10 @@ namespace client {
         PureClientContext(const char appId[], common::ClientContextDeleter del)
             : PureClientContext(appId, "localhost", del) {}
         PureClientContext(const char appId[], const char host[],
+                          common::ClientContextDeleter del)
+            : PureClientContext(appId, host, ContextOptions{}, del) {}
+        PureClientContext(const char appId[], const char host[],
+                          ContextOptions const &options,
                           common::ClientContextDeleter del);
         virtual ~PureClientContext();
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -80,6 +88,13 @@ namespace client {
 
         bool m_getStatus() const override;
 
+        /// @brief Handles a full path tree from the server.
+        void m_handleTree(Json::Value nodes);
+
+        /// @brief Starts out with the cached path tree for this server, if
+        /// any.
+        void m_loadCachedTree();
+
         /// @brief The main OSVR server host: usually localhost
         std::string m_host;
 
@@ -108,6 +123,20 @@ namespace client {
         /// @brief Have we gotten a connection to the main server?
         bool m_gotConnection = false;
 
+        /// @brief Have we gotten a path tree from the server? (As opposed to
+        /// only the cached one, or none at all.)
+        bool m_gotServerTree = false;
+
+        /// @brief Is the current path tree the cached one, not yet checked
+        /// against the server's?
+        bool m_usingCachedTree = false;
+
+        /// @brief Cache of the last path tree from this server, if enabled.
+        std::unique_ptr<PathTreeCache> m_treeCache;
+
+        /// @brief When construction started, for reporting startup time.
+        std::chrono::steady_clock::time_point m_startTime;
+
         /// @brief Room to world transform.
         common::Transform m_roomToWorld;
 
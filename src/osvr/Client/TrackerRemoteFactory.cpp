@@ -24,15 +24,20 @@
 
 // Internal Includes
 #include "TrackerRemoteFactory.h"
+#include "DeviceDispatcher.h"
 #include "PureClientContext.h"
 #include "RemoteHandlerInternals.h"
 #include "VRPNConnectionCollection.h"
 #include <osvr/Client/InterfaceTree.h>
+#include <osvr/Common/Buffer.h>
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/CompiledTransform.h>
 #include <osvr/Common/JSONTransformVisitor.h>
 #include <osvr/Common/OriginalSource.h>
 #include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/Serialization.h>
 #include <osvr/Common/Tracing.h>
+#include <osvr/Common/TrackerBatchMessage.h>
 #include <osvr/Common/TrackerSensorInfo.h>
 #include <osvr/Common/Transform.h>
 #include <osvr/Util/ChannelCountC.h>
@@ -50,12 +55,14 @@
 #include <vrpn_Tracker.h>
 
 // Standard includes
-// - none
+#include <vector>
 
 namespace ei = osvr::util::eigen_interop;
 
 namespace osvr {
 namespace client {
+    class VRPNTrackerDispatcher;
+
     class VRPNTrackerHandler : public RemoteHandler {
       public:
         struct Options {
@@ -63,91 +70,78 @@ namespace client {
             bool reportPosition = false;
             bool reportOrientation = false;
         };
-        VRPNTrackerHandler(vrpn_ConnectionPtr const &conn, const char *src,
+        VRPNTrackerHandler(shared_ptr<VRPNTrackerDispatcher> const &dispatcher,
                            Options const &options,
                            common::TrackerSensorInfo const &info,
                            common::Transform const &t,
                            boost::optional<int> sensor,
                            common::InterfaceList &ifaces,
-                           common::ClientContext &ctx)
-            : m_remote(new vrpn_Tracker_Remote(src, conn.get())),
-              m_transform(t), m_ctx(ctx), m_internals(ifaces), m_opts(options),
-              m_info(info), m_sensor(sensor) {
-            if (m_info.reportsPosition || m_info.reportsOrientation) {
-                m_remote->register_change_handler(this,
-                                                  &VRPNTrackerHandler::handle,
-                                                  m_sensor.get_value_or(-1));
-            }
-            if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
-                m_remote->register_change_handler(
-                    this, &VRPNTrackerHandler::handleVel,
-                    m_sensor.get_value_or(-1));
-            }
-            if (m_info.reportsLinearAcceleration ||
-                m_info.reportsAngularAcceleration) {
-                m_remote->register_change_handler(
-                    this, &VRPNTrackerHandler::handleAccel,
-                    m_sensor.get_value_or(-1));
-            }
-            OSVR_DEV_VERBOSE("Constructed a TrackerHandler for "
-                             << src << " sensor " << m_sensor.get_value_or(-1));
-        }
-        virtual ~VRPNTrackerHandler() {
-            if (m_info.reportsPosition || m_info.reportsOrientation) {
-                m_remote->unregister_change_handler(this,
-                                                    &VRPNTrackerHandler::handle,
-                                                    m_sensor.get_value_or(-1));
-            }
-            if (m_info.reportsLinearVelocity || m_info.reportsAngularVelocity) {
-                m_remote->unregister_change_handler(
-                    this, &VRPNTrackerHandler::handleVel,
-                    m_sensor.get_value_or(-1));
-            }
-            if (m_info.reportsLinearAcceleration ||
-                m_info.reportsAngularAcceleration) {
-                m_remote->unregister_change_handler(
-                    this, &VRPNTrackerHandler::handleAccel,
-                    m_sensor.get_value_or(-1));
-            }
-        }
+                           common::ClientContext &ctx);
+        virtual ~VRPNTrackerHandler();
 
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
-        common::Transform getCurrentTransform() const {
-            auto ret = m_transform;
-            ret.transform(m_ctx.getRoomToWorldTransform());
-            return ret;
+        /// @brief Gets the route transform combined with the room-to-world
+        /// transform, recompiling it only if the latter has changed.
+        common::CompiledTransform const &getCurrentTransform() {
+            auto generation = m_ctx.getRoomToWorldTransformGeneration();
+            if (!m_compiledValid || generation != m_compiledGeneration) {
+                auto xform = m_transform;
+                xform.transform(m_ctx.getRoomToWorldTransform());
+                m_compiled = common::CompiledTransform(xform);
+                m_compiledGeneration = generation;
+                m_compiledValid = true;
+            }
+            return m_compiled;
         }
 
-        static void VRPN_CALLBACK handle(void *userdata, vrpn_TRACKERCB info) {
-            auto self = static_cast<VRPNTrackerHandler *>(userdata);
-            self->m_handle(info);
+        /// @name Reports from the dispatcher, filtered to our sensor.
+        /// Validity flags are masked with what our source says it reports.
+        /// @{
+        void deliverPose(OSVR_TimeValue const &timestamp, int32_t sensor,
+                         OSVR_PoseState const &pose) {
+            if (m_info.reportsPosition || m_info.reportsOrientation) {
+                m_reportPose(timestamp, sensor, pose);
+            }
         }
-        static void VRPN_CALLBACK handleVel(void *userdata,
-                                            vrpn_TRACKERVELCB info) {
-            auto self = static_cast<VRPNTrackerHandler *>(userdata);
-            self->m_handle(info);
+        void deliverVelocity(OSVR_TimeValue const &timestamp, int32_t sensor,
+                             OSVR_VelocityState state) {
+            state.linearVelocityValid =
+                state.linearVelocityValid && m_info.reportsLinearVelocity;
+            state.angularVelocityValid =
+                state.angularVelocityValid && m_info.reportsAngularVelocity;
+            if (state.linearVelocityValid || state.angularVelocityValid) {
+                m_reportVelocity(timestamp, sensor, state);
+            }
         }
-        static void VRPN_CALLBACK handleAccel(void *userdata,
-                                              vrpn_TRACKERACCCB info) {
-            auto self = static_cast<VRPNTrackerHandler *>(userdata);
-            self->m_handle(info);
+        void deliverAccel(OSVR_TimeValue const &timestamp, int32_t sensor,
+                          OSVR_AccelerationState state) {
+            state.linearAccelerationValid = state.linearAccelerationValid &&
+                                            m_info.reportsLinearAcceleration;
+            state.angularAccelerationValid =
+                state.angularAccelerationValid &&
+                m_info.reportsAngularAcceleration;
+            if (state.linearAccelerationValid ||
+                state.angularAccelerationValid) {
+                m_reportAccel(timestamp, sensor, state);
+            }
         }
-        virtual void update() { m_remote->mainloop(); }
+        /// @}
+
+        virtual void update();
 
       private:
-        /// Pass pose messages on to the client
-        void m_handle(vrpn_TRACKERCB const &info) {
+        void m_reportPose(OSVR_TimeValue const &timestamp, int32_t sensor,
+                          OSVR_PoseState const &pose) {
             common::tracing::markNewTrackerData();
             OSVR_PoseReport report;
-            report.sensor = info.sensor;
-            OSVR_TimeValue timestamp;
-            osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
-            osvrQuatFromQuatlib(&(report.pose.rotation), info.quat);
-            osvrVec3FromQuatlib(&(report.pose.translation), info.pos);
-            auto xform = getCurrentTransform();
-            ei::map(report.pose) =
-                xform.transform(ei::map(report.pose).matrix());
+            report.sensor = sensor;
+            report.pose = pose;
+            Eigen::Quaterniond rotation = ei::map(report.pose.rotation);
+            Eigen::Vector3d translation = ei::map(report.pose.translation);
+            getCurrentTransform().transformPose(rotation, translation);
+            ei::map(report.pose.rotation) = rotation;
+            ei::map(report.pose.translation) = translation;
 
             if (m_opts.reportPose) {
                 m_internals.setStateAndTriggerCallbacks(timestamp, report);
@@ -155,7 +149,7 @@ namespace client {
 
             if (m_opts.reportPosition) {
                 OSVR_PositionReport positionReport;
-                positionReport.sensor = info.sensor;
+                positionReport.sensor = sensor;
                 positionReport.xyz = report.pose.translation;
 
                 m_internals.setStateAndTriggerCallbacks(timestamp,
@@ -164,110 +158,93 @@ namespace client {
 
             if (m_opts.reportOrientation) {
                 OSVR_OrientationReport oriReport;
-                oriReport.sensor = info.sensor;
+                oriReport.sensor = sensor;
                 oriReport.rotation = report.pose.rotation;
 
                 m_internals.setStateAndTriggerCallbacks(timestamp, oriReport);
             }
         }
 
-        /// Pass velocity messages on to the client
-        void m_handle(vrpn_TRACKERVELCB const &info) {
+        void m_reportVelocity(OSVR_TimeValue const &timestamp,
+                              int32_t sensor, OSVR_VelocityState const &state) {
             /// @todo should we be marking a trace event here?
             // common::tracing::markNewTrackerData();
 
-            OSVR_TimeValue timestamp;
-            osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
-
             OSVR_VelocityReport overallReport;
-            overallReport.sensor = info.sensor;
-            auto xform = getCurrentTransform();
-
-            overallReport.state.linearVelocityValid =
-                m_info.reportsLinearVelocity;
-            if (m_info.reportsLinearVelocity) {
-                OSVR_LinearVelocityState vel;
-                osvrVec3FromQuatlib(&(vel), info.vel);
+            overallReport.sensor = sensor;
+            overallReport.state = state;
+            auto const &xform = getCurrentTransform();
 
+            if (state.linearVelocityValid) {
+                OSVR_LinearVelocityState vel = state.linearVelocity;
                 ei::map(vel) = xform.transformDerivative(ei::map(vel));
 
                 overallReport.state.linearVelocity = vel;
                 OSVR_LinearVelocityReport report;
-                report.sensor = info.sensor;
+                report.sensor = sensor;
                 report.state = vel;
                 m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
 
-            overallReport.state.angularVelocityValid =
-                m_info.reportsAngularVelocity;
-            if (m_info.reportsAngularVelocity) {
-                OSVR_AngularVelocityState state;
-                osvrQuatFromQuatlib(&(state.incrementalRotation),
-                                    info.vel_quat);
-                state.dt = info.vel_quat_dt;
-
-                ei::map(state.incrementalRotation) = xform.transformDerivative(
-                    ei::map(state.incrementalRotation));
+            if (state.angularVelocityValid) {
+                OSVR_AngularVelocityState angState = state.angularVelocity;
+                ei::map(angState.incrementalRotation) =
+                    xform.transformDerivative(
+                        ei::map(angState.incrementalRotation));
 
-                overallReport.state.angularVelocity = state;
+                overallReport.state.angularVelocity = angState;
                 OSVR_AngularVelocityReport report;
-                report.sensor = info.sensor;
-                report.state = state;
+                report.sensor = sensor;
+                report.state = angState;
                 m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
 
             m_internals.setStateAndTriggerCallbacks(timestamp, overallReport);
         }
 
-        /// Pass acceleration messages on to the client
-        void m_handle(vrpn_TRACKERACCCB const &info) {
+        void m_reportAccel(OSVR_TimeValue const &timestamp, int32_t sensor,
+                           OSVR_AccelerationState const &state) {
             /// @todo should we be marking a trace event here?
             // common::tracing::markNewTrackerData();
-            OSVR_TimeValue timestamp;
-            osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
 
             OSVR_AccelerationReport overallReport;
-            overallReport.sensor = info.sensor;
-
-            auto xform = getCurrentTransform();
-
-            overallReport.state.linearAccelerationValid =
-                m_info.reportsLinearAcceleration;
-            if (m_info.reportsLinearAcceleration) {
-                OSVR_LinearAccelerationState accel;
-                osvrVec3FromQuatlib(&(accel), info.acc);
+            overallReport.sensor = sensor;
+            overallReport.state = state;
+            auto const &xform = getCurrentTransform();
 
+            if (state.linearAccelerationValid) {
+                OSVR_LinearAccelerationState accel = state.linearAcceleration;
                 ei::map(accel) = xform.transformDerivative(ei::map(accel));
 
                 overallReport.state.linearAcceleration = accel;
                 OSVR_LinearAccelerationReport report;
-                report.sensor = info.sensor;
+                report.sensor = sensor;
                 report.state = accel;
                 m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
-            overallReport.state.angularAccelerationValid =
-                m_info.reportsAngularAcceleration;
-            if (m_info.reportsAngularAcceleration) {
-
-                OSVR_AngularAccelerationState state;
-                osvrQuatFromQuatlib(&(state.incrementalRotation),
-                                    info.acc_quat);
-                state.dt = info.acc_quat_dt;
 
-                ei::map(state.incrementalRotation) = xform.transformDerivative(
-                    ei::map(state.incrementalRotation));
+            if (state.angularAccelerationValid) {
+                OSVR_AngularAccelerationState angState =
+                    state.angularAcceleration;
+                ei::map(angState.incrementalRotation) =
+                    xform.transformDerivative(
+                        ei::map(angState.incrementalRotation));
 
-                overallReport.state.angularAcceleration = state;
+                overallReport.state.angularAcceleration = angState;
                 OSVR_AngularAccelerationReport report;
-                report.sensor = info.sensor;
-                report.state = state;
+                report.sensor = sensor;
+                report.state = angState;
                 m_internals.setStateAndTriggerCallbacks(timestamp, report);
             }
 
             m_internals.setStateAndTriggerCallbacks(timestamp, overallReport);
         }
-        unique_ptr<vrpn_Tracker_Remote> m_remote;
+
+        shared_ptr<VRPNTrackerDispatcher> m_dispatcher;
         common::Transform m_transform;
+        common::CompiledTransform m_compiled;
+        std::uint32_t m_compiledGeneration = 0;
+        bool m_compiledValid = false;
         common::ClientContext &m_ctx;
         RemoteHandlerInternals m_internals;
         Options m_opts;
@@ -275,6 +252,183 @@ namespace client {
         boost::optional<int> m_sensor;
     };
 
+    /// @brief Owns the one tracker remote (and batched report handler) for a
+    /// device, however many handlers its sensors are routed to, converting
+    /// each report once and passing it only to the handlers for its sensor.
+    class VRPNTrackerDispatcher {
+      public:
+        VRPNTrackerDispatcher(vrpn_ConnectionPtr const &conn, const char *src)
+            : m_conn(conn),
+              m_remote(new vrpn_Tracker_Remote(src, conn.get())) {
+            m_batchSender = m_conn->register_sender(src);
+            m_batchType = m_conn->register_message_type(
+                common::messages::TrackerBatch::identifier());
+            m_conn->register_handler(m_batchType,
+                                     &VRPNTrackerDispatcher::handleBatch,
+                                     this, m_batchSender);
+            m_remote->register_change_handler(this,
+                                              &VRPNTrackerDispatcher::handle);
+            m_remote->register_change_handler(
+                this, &VRPNTrackerDispatcher::handleVel);
+            m_remote->register_change_handler(
+                this, &VRPNTrackerDispatcher::handleAccel);
+            OSVR_DEV_VERBOSE("Constructed a TrackerDispatcher for " << src);
+        }
+        ~VRPNTrackerDispatcher() {
+            m_conn->unregister_handler(m_batchType,
+                                       &VRPNTrackerDispatcher::handleBatch,
+                                       this, m_batchSender);
+            m_remote->unregister_change_handler(
+                this, &VRPNTrackerDispatcher::handle);
+            m_remote->unregister_change_handler(
+                this, &VRPNTrackerDispatcher::handleVel);
+            m_remote->unregister_change_handler(
+                this, &VRPNTrackerDispatcher::handleAccel);
+        }
+
+        void subscribe(VRPNTrackerHandler &handler,
+                       boost::optional<int> const &sensor) {
+            m_subscribers.add(handler, sensor);
+        }
+        void unsubscribe(VRPNTrackerHandler &handler,
+                         boost::optional<int> const &sensor) {
+            m_subscribers.remove(handler, sensor);
+        }
+
+        /// @brief Called from the update of every subscribed handler, but
+        /// only services the remote for one of them.
+        void update(VRPNTrackerHandler &caller) {
+            if (m_subscribers.driver() == &caller) {
+                m_remote->mainloop();
+            }
+        }
+
+      private:
+        static void VRPN_CALLBACK handle(void *userdata, vrpn_TRACKERCB info) {
+            auto self = static_cast<VRPNTrackerDispatcher *>(userdata);
+            self->m_handle(info);
+        }
+        static void VRPN_CALLBACK handleVel(void *userdata,
+                                            vrpn_TRACKERVELCB info) {
+            auto self = static_cast<VRPNTrackerDispatcher *>(userdata);
+            self->m_handle(info);
+        }
+        static void VRPN_CALLBACK handleAccel(void *userdata,
+                                              vrpn_TRACKERACCCB info) {
+            auto self = static_cast<VRPNTrackerDispatcher *>(userdata);
+            self->m_handle(info);
+        }
+        static int VRPN_CALLBACK handleBatch(void *userdata,
+                                             vrpn_HANDLERPARAM p) {
+            auto self = static_cast<VRPNTrackerDispatcher *>(userdata);
+            self->m_handleBatch(p);
+            return 0;
+        }
+
+        void m_handle(vrpn_TRACKERCB const &info) {
+            OSVR_TimeValue timestamp;
+            osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+            OSVR_PoseState pose;
+            osvrQuatFromQuatlib(&(pose.rotation), info.quat);
+            osvrVec3FromQuatlib(&(pose.translation), info.pos);
+            m_subscribers.forSensor(
+                info.sensor, [&](VRPNTrackerHandler &handler) {
+                    handler.deliverPose(timestamp, info.sensor, pose);
+                });
+        }
+
+        void m_handle(vrpn_TRACKERVELCB const &info) {
+            OSVR_TimeValue timestamp;
+            osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+            OSVR_VelocityState state;
+            state.linearVelocityValid = true;
+            osvrVec3FromQuatlib(&(state.linearVelocity), info.vel);
+            state.angularVelocityValid = true;
+            osvrQuatFromQuatlib(&(state.angularVelocity.incrementalRotation),
+                                info.vel_quat);
+            state.angularVelocity.dt = info.vel_quat_dt;
+            m_subscribers.forSensor(
+                info.sensor, [&](VRPNTrackerHandler &handler) {
+                    handler.deliverVelocity(timestamp, info.sensor, state);
+                });
+        }
+
+        void m_handle(vrpn_TRACKERACCCB const &info) {
+            OSVR_TimeValue timestamp;
+            osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+            OSVR_AccelerationState state;
+            state.linearAccelerationValid = true;
+            osvrVec3FromQuatlib(&(state.linearAcceleration), info.acc);
+            state.angularAccelerationValid = true;
+            osvrQuatFromQuatlib(
+                &(state.angularAcceleration.incrementalRotation),
+                info.acc_quat);
+            state.angularAcceleration.dt = info.acc_quat_dt;
+            m_subscribers.forSensor(
+                info.sensor, [&](VRPNTrackerHandler &handler) {
+                    handler.deliverAccel(timestamp, info.sensor, state);
+                });
+        }
+
+        /// Deserialize a batch once, then pass each entry on to the handlers
+        /// for its sensor.
+        void m_handleBatch(vrpn_HANDLERPARAM const &p) {
+            auto bufReader = common::readExternalBuffer(p.buffer,
+                                                        p.payload_len);
+            common::messages::TrackerBatch::MessageSerialization msg(m_batch);
+            try {
+                common::deserialize(bufReader, msg);
+            } catch (std::exception &e) {
+                OSVR_DEV_VERBOSE("Could not deserialize a batched tracker "
+                                 "report: "
+                                 << e.what());
+                return;
+            }
+            OSVR_TimeValue timestamp;
+            osvrStructTimevalToTimeValue(&timestamp, &(p.msg_time));
+            for (auto const &entry : m_batch) {
+                auto sensor = static_cast<int32_t>(entry.sensor);
+                m_subscribers.forSensor(
+                    sensor, [&](VRPNTrackerHandler &handler) {
+                        if (entry.poseValid) {
+                            handler.deliverPose(timestamp, sensor, entry.pose);
+                        }
+                        handler.deliverVelocity(timestamp, sensor,
+                                                entry.velocity);
+                        handler.deliverAccel(timestamp, sensor,
+                                             entry.acceleration);
+                    });
+            }
+        }
+
+        vrpn_ConnectionPtr m_conn;
+        vrpn_int32 m_batchSender;
+        vrpn_int32 m_batchType;
+        /// Reused storage for received batches.
+        std::vector<OSVR_TrackerBatchEntry> m_batch;
+        unique_ptr<vrpn_Tracker_Remote> m_remote;
+        SensorSubscriberTable<VRPNTrackerHandler> m_subscribers;
+    };
+
+    VRPNTrackerHandler::VRPNTrackerHandler(
+        shared_ptr<VRPNTrackerDispatcher> const &dispatcher,
+        Options const &options, common::TrackerSensorInfo const &info,
+        common::Transform const &t, boost::optional<int> sensor,
+        common::InterfaceList &ifaces, common::ClientContext &ctx)
+        : m_dispatcher(dispatcher), m_transform(t), m_ctx(ctx),
+          m_internals(ifaces), m_opts(options), m_info(info),
+          m_sensor(sensor) {
+        m_dispatcher->subscribe(*this, m_sensor);
+        OSVR_DEV_VERBOSE("Constructed a TrackerHandler for sensor "
+                         << m_sensor.get_value_or(-1));
+    }
+
+    VRPNTrackerHandler::~VRPNTrackerHandler() {
+        m_dispatcher->unsubscribe(*this, m_sensor);
+    }
+
+    void VRPNTrackerHandler::update() { m_dispatcher->update(*this); }
+
     TrackerRemoteFactory::TrackerRemoteFactory(
         VRPNConnectionCollection const &conns)
         : m_conns(conns) {}
@@ -305,9 +459,11 @@ namespace client {
         }
 
         /// @todo find out why make_shared causes a crash here
-        ret.reset(new VRPNTrackerHandler(
-            m_conns.getConnection(devElt), devElt.getFullDeviceName().c_str(),
-            opts, info, xform, source.getSensorNumber(), ifaces, ctx));
+        auto dispatcher = m_dispatchers.get(m_conns.getConnection(devElt),
+                                            devElt.getFullDeviceName());
+        ret.reset(new VRPNTrackerHandler(dispatcher, opts, info, xform,
+                                         source.getSensorNumber(), ifaces,
+                                         ctx));
         return ret;
     }
 
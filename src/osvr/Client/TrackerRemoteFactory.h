@@ -26,6 +26,7 @@
 #define INCLUDED_TrackerRemoteFactory_h_GUID_C473E294_CC7C_49A2_C03F_B47458E22EDB
 
 // Internal Includes
+#include "DeviceDispatcher.h"
 #include "VRPNConnectionCollection.h"
 #include <osvr/Common/InterfaceList.h>
 #include <osvr/Common/OriginalSource.h>
@@ -42,6 +43,7 @@
 
 namespace osvr {
 namespace client {
+    class VRPNTrackerDispatcher;
 
     class TrackerRemoteFactory {
       public:
@@ -57,6 +59,8 @@ namespace client {
 
       private:
         VRPNConnectionCollection m_conns;
+        /// One dispatcher per device, shared by the handlers for its sensors.
+        DeviceDispatcherRegistry<VRPNTrackerDispatcher> m_dispatchers;
     };
 
 } // namespace client
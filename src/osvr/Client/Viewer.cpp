@@ -26,6 +26,7 @@
 #include <osvr/Client/Viewer.h>
 #include <osvr/Common/ReportTypes.h>
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/PosePrediction.h>
 
 // Library/third-party includes
 // - none
@@ -48,6 +49,17 @@ namespace client {
         return pose;
     }
 
+    OSVR_Pose3 Viewer::getPose(util::time::TimeValue const &when) const {
+        OSVR_TimeValue timestamp;
+        OSVR_Pose3 pose;
+        bool hasState =
+            common::getPoseStateAtTime(*m_head, when, timestamp, pose);
+        if (!hasState) {
+            throw NoPoseYet();
+        }
+        return pose;
+    }
+
     bool Viewer::hasPose() const {
         return m_head->hasStateForReportType<OSVR_PoseReport>();
     }
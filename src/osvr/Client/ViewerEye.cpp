@@ -26,6 +26,7 @@
 #include <osvr/Client/ViewerEye.h>
 #include <osvr/Common/ReportTypes.h>
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/PosePrediction.h>
 #include <osvr/Util/EigenInterop.h>
 #include <osvr/Util/ProjectionMatrix.h>
 #include <osvr/Util/MatrixConventions.h>
@@ -45,12 +46,30 @@ namespace client {
         if (!hasState) {
             throw NoPoseYet();
         }
+        return m_applyEyeOffset(pose);
+    }
+
+    Eigen::Isometry3d
+    ViewerEye::getPoseIsometry(util::time::TimeValue const &when) const {
+        OSVR_TimeValue timestamp;
+        OSVR_Pose3 pose;
+        bool hasState =
+            common::getPoseStateAtTime(*m_pose, when, timestamp, pose);
+        if (!hasState) {
+            throw NoPoseYet();
+        }
+        return m_applyEyeOffset(pose);
+    }
+
+    Eigen::Isometry3d
+    ViewerEye::m_applyEyeOffset(OSVR_Pose3 const &pose) const {
         Eigen::Isometry3d transformedPose =
             util::fromPose(pose) * Eigen::Translation3d(m_offset) *
             Eigen::AngleAxisd(util::getRadians(m_opticalAxisOffsetY),
                               Eigen::Vector3d::UnitY());
         return transformedPose;
     }
+
     OSVR_Pose3 ViewerEye::getPose() const {
         Eigen::Isometry3d transformedPose = getPoseIsometry();
         OSVR_Pose3 pose;
@@ -58,6 +77,13 @@ namespace client {
         return pose;
     }
 
+    OSVR_Pose3 ViewerEye::getPose(util::time::TimeValue const &when) const {
+        Eigen::Isometry3d transformedPose = getPoseIsometry(when);
+        OSVR_Pose3 pose;
+        util::toPose(transformedPose, pose);
+        return pose;
+    }
+
     bool ViewerEye::hasPose() const {
         return m_pose->hasStateForReportType<OSVR_PoseReport>();
     }
@@ -67,6 +93,12 @@ namespace client {
         return transformedPose.inverse().matrix();
     }
 
+    Eigen::Matrix4d
+    ViewerEye::getView(util::time::TimeValue const &when) const {
+        Eigen::Isometry3d transformedPose = getPoseIsometry(when);
+        return transformedPose.inverse().matrix();
+    }
+
     util::Rectd ViewerEye::m_getRect(double near, double /*far*/ = 100) const {
         util::Rectd rect(m_unitBounds);
         // Scale the in-plane positions based on the near plane to put
@@ -45,8 +45,11 @@ static inline osvr::util::log::LoggerPtr make_clientkit_logger() {
     return log::make_logger(log::OSVR_CLIENTKIT_LOG_NAME);
 }
 
-OSVR_ClientContext osvrClientInit(const char applicationIdentifier[],
-                                  uint32_t /*flags*/) {
+static inline OSVR_ClientContext
+createClientContext(const char applicationIdentifier[], uint32_t flags) {
+    ::osvr::client::ContextOptions options;
+    options.waitForConnection = !(flags & OSVR_CLIENT_INIT_NONBLOCKING);
+    options.usePathTreeCache = (flags & OSVR_CLIENT_INIT_CACHED_PATH_TREE) != 0;
     auto host = osvr::util::getEnvironmentVariable(HOST_ENV_VAR);
     if (host.is_initialized()) {
 
@@ -54,10 +57,20 @@ OSVR_ClientContext osvrClientInit(const char applicationIdentifier[],
                                           << ": Connecting to non-default host "
                                           << *host;
         return ::osvr::client::createContext(applicationIdentifier,
-                                             host->c_str());
+                                             host->c_str(), options);
     }
     make_clientkit_logger()->debug("Connecting to default (local) host");
-    return ::osvr::client::createContext(applicationIdentifier);
+    return ::osvr::client::createContext(applicationIdentifier, "localhost",
+                                         options);
+}
+
+OSVR_ClientContext osvrClientInit(const char applicationIdentifier[],
+                                  uint32_t flags) {
+    auto ctx = createClientContext(applicationIdentifier, flags);
+    if (ctx && (flags & OSVR_CLIENT_INIT_BACKGROUND_UPDATE)) {
+        ctx->startBackgroundUpdates();
+    }
+    return ctx;
 }
 
 OSVR_ReturnCode osvrClientCheckStatus(OSVR_ClientContext ctx) {
@@ -121,6 +121,14 @@ OSVR_ReturnCode osvrClientGetDisplay(OSVR_ClientContext ctx,
     BOOST_ASSERT_MSG(displayInputIndex < disp->cfg->getNumDisplayInputs(),     \
                      "Must pass a valid display input index.")
 
+#define OSVR_VALIDATE_TIME_PTR(X)                                              \
+    OSVR_UTIL_MULTILINE_BEGIN                                                  \
+    if (nullptr == X) {                                                        \
+        OSVR_DEV_VERBOSE("Passed a null pointer for the target time!");        \
+        return OSVR_RETURN_FAILURE;                                            \
+    }                                                                          \
+    OSVR_UTIL_MULTILINE_END
+
 OSVR_ReturnCode osvrClientFreeDisplay(OSVR_DisplayConfig disp) {
     OSVR_VALIDATE_DISPLAY_CONFIG;
     OSVR_ClientContext ctx = disp->ctx;
@@ -191,6 +199,28 @@ OSVR_ReturnCode osvrClientGetViewerPose(OSVR_DisplayConfig disp,
     return OSVR_RETURN_FAILURE;
 }
 
+OSVR_ReturnCode osvrClientGetViewerPoseAtTime(OSVR_DisplayConfig disp,
+                                              OSVR_ViewerCount viewer,
+                                              OSVR_TimeValue const *when,
+                                              OSVR_Pose3 *pose) {
+    OSVR_VALIDATE_DISPLAY_CONFIG;
+    OSVR_VALIDATE_VIEWER_ID;
+    OSVR_VALIDATE_TIME_PTR(when);
+    OSVR_VALIDATE_OUTPUT_PTR(pose, "viewer pose");
+    try {
+        *pose = disp->cfg->getViewer(viewer).getPose(*when);
+        return OSVR_RETURN_SUCCESS;
+    } catch (osvr::client::NoPoseYet &) {
+        OSVR_DEV_VERBOSE("Error getting viewer pose: no pose yet available");
+        return OSVR_RETURN_FAILURE;
+    } catch (std::exception &e) {
+
+        OSVR_DEV_VERBOSE("Error getting viewer pose - exception: " << e.what());
+        return OSVR_RETURN_FAILURE;
+    }
+    return OSVR_RETURN_FAILURE;
+}
+
 OSVR_ReturnCode osvrClientGetNumEyesForViewer(OSVR_DisplayConfig disp,
                                               OSVR_ViewerCount viewer,
                                               OSVR_EyeCount *eyes) {
@@ -225,18 +255,46 @@ OSVR_ReturnCode osvrClientGetViewerEyePose(OSVR_DisplayConfig disp,
     return OSVR_RETURN_FAILURE;
 }
 
+OSVR_ReturnCode osvrClientGetViewerEyePoseAtTime(OSVR_DisplayConfig disp,
+                                                 OSVR_ViewerCount viewer,
+                                                 OSVR_EyeCount eye,
+                                                 OSVR_TimeValue const *when,
+                                                 OSVR_Pose3 *pose) {
+    OSVR_VALIDATE_DISPLAY_CONFIG;
+    OSVR_VALIDATE_VIEWER_ID;
+    OSVR_VALIDATE_EYE_ID;
+    OSVR_VALIDATE_TIME_PTR(when);
+    OSVR_VALIDATE_OUTPUT_PTR(pose, "eye pose");
+    try {
+        *pose = disp->cfg->getViewerEye(viewer, eye).getPose(*when);
+        return OSVR_RETURN_SUCCESS;
+    } catch (osvr::client::NoPoseYet &) {
+        OSVR_DEV_VERBOSE(
+            "Error getting viewer eye pose: no pose yet available");
+        return OSVR_RETURN_FAILURE;
+    } catch (std::exception &e) {
+
+        OSVR_DEV_VERBOSE(
+            "Error getting viewer eye pose - exception: " << e.what());
+        return OSVR_RETURN_FAILURE;
+    }
+    return OSVR_RETURN_FAILURE;
+}
+
+/// @param when Time to predict the pose for, or nullptr for the latest pose.
 template <typename Scalar>
-static inline OSVR_ReturnCode getViewMatrixImpl(OSVR_DisplayConfig disp,
-                                                OSVR_ViewerCount viewer,
-                                                OSVR_EyeCount eye, Scalar *mat,
-                                                OSVR_MatrixConventions flags) {
+static inline OSVR_ReturnCode
+getViewMatrixImpl(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer,
+                  OSVR_EyeCount eye, Scalar *mat, OSVR_MatrixConventions flags,
+                  OSVR_TimeValue const *when = nullptr) {
     OSVR_VALIDATE_DISPLAY_CONFIG;
     OSVR_VALIDATE_VIEWER_ID;
     OSVR_VALIDATE_EYE_ID;
     OSVR_VALIDATE_OUTPUT_PTR(mat, "view matrix");
     try {
+        auto const &viewerEye = disp->cfg->getViewerEye(viewer, eye);
         osvr::util::matrixEigenAssign(
-            disp->cfg->getViewerEye(viewer, eye).getView(), flags, mat);
+            when ? viewerEye.getView(*when) : viewerEye.getView(), flags, mat);
         return OSVR_RETURN_SUCCESS;
     } catch (osvr::client::NoPoseYet &) {
         OSVR_DEV_VERBOSE(
@@ -265,6 +323,20 @@ OSVR_ReturnCode osvrClientGetViewerEyeViewMatrixf(
     return getViewMatrixImpl(disp, viewer, eye, mat, flags);
 }
 
+OSVR_ReturnCode osvrClientGetViewerEyeViewMatrixdAtTime(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_TimeValue const *when, OSVR_MatrixConventions flags, double *mat) {
+    OSVR_VALIDATE_TIME_PTR(when);
+    return getViewMatrixImpl(disp, viewer, eye, mat, flags, when);
+}
+
+OSVR_ReturnCode osvrClientGetViewerEyeViewMatrixfAtTime(
+    OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye,
+    OSVR_TimeValue const *when, OSVR_MatrixConventions flags, float *mat) {
+    OSVR_VALIDATE_TIME_PTR(when);
+    return getViewMatrixImpl(disp, viewer, eye, mat, flags, when);
+}
+
 OSVR_ReturnCode
 osvrClientGetNumSurfacesForViewerEye(OSVR_DisplayConfig disp,
                                      OSVR_ViewerCount viewer, OSVR_EyeCount eye,
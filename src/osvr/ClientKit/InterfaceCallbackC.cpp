@@ -51,6 +51,7 @@ OSVR_CALLBACK_METHODS(LinearAcceleration)
 OSVR_CALLBACK_METHODS(AngularAcceleration)
 OSVR_CALLBACK_METHODS(Button)
 OSVR_CALLBACK_METHODS(Analog)
+OSVR_CALLBACK_METHODS(AnalogArray)
 OSVR_CALLBACK_METHODS(Imaging)
 OSVR_CALLBACK_METHODS(Location2D)
 OSVR_CALLBACK_METHODS(Direction)
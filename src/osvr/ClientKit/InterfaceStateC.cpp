@@ -24,7 +24,9 @@
 
 // Internal Includes
 #include <osvr/ClientKit/InterfaceStateC.h>
+#include <osvr/Common/ClientContext.h>
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/PosePrediction.h>
 
 // Library/third-party includes
 // - none
@@ -61,3 +63,114 @@ OSVR_CALLBACK_METHODS(NaviVelocity)
 OSVR_CALLBACK_METHODS(NaviPosition)
 
 #undef OSVR_CALLBACK_METHODS
+
+OSVR_ReturnCode osvrSetStateHistoryCapacity(OSVR_ClientInterface iface,
+                                            uint32_t capacity) {
+    if (!iface) {
+        return OSVR_RETURN_FAILURE;
+    }
+    iface->setStateHistoryCapacity(capacity);
+    return OSVR_RETURN_SUCCESS;
+}
+
+#define OSVR_HISTORY_METHODS(TYPE)                                             \
+    OSVR_ReturnCode osvrGet##TYPE##StateNearest(                               \
+        OSVR_ClientInterface iface, struct OSVR_TimeValue const *when,         \
+        struct OSVR_TimeValue *timestamp, OSVR_##TYPE##State *state) {         \
+        if (!iface || !when || !timestamp || !state) {                         \
+            return OSVR_RETURN_FAILURE;                                        \
+        }                                                                      \
+        auto lock = iface->getContext().lockUpdates();                         \
+        auto history = iface->getStateHistory<OSVR_##TYPE##Report>();          \
+        auto entry = history ? history->getNearest(*when) : nullptr;           \
+        if (!entry) {                                                          \
+            return OSVR_RETURN_FAILURE;                                        \
+        }                                                                      \
+        *timestamp = entry->timestamp;                                         \
+        *state = entry->state;                                                 \
+        return OSVR_RETURN_SUCCESS;                                            \
+    }                                                                          \
+    OSVR_ReturnCode osvrGet##TYPE##StateRange(                                 \
+        OSVR_ClientInterface iface, struct OSVR_TimeValue const *begin,        \
+        struct OSVR_TimeValue const *end, struct OSVR_TimeValue *timestamps,   \
+        OSVR_##TYPE##State *states, uint32_t maxStates, uint32_t *numStates) { \
+        if (!iface || !begin || !end || !timestamps || !states ||              \
+            !numStates) {                                                      \
+            return OSVR_RETURN_FAILURE;                                        \
+        }                                                                      \
+        auto lock = iface->getContext().lockUpdates();                         \
+        auto history = iface->getStateHistory<OSVR_##TYPE##Report>();          \
+        if (!history) {                                                        \
+            return OSVR_RETURN_FAILURE;                                        \
+        }                                                                      \
+        uint32_t n = 0;                                                        \
+        for (auto i = history->lowerBound(*begin);                             \
+             i < history->size() && n < maxStates &&                           \
+             !(*end < (*history)[i].timestamp);                                \
+             ++i, ++n) {                                                       \
+            timestamps[n] = (*history)[i].timestamp;                           \
+            states[n] = (*history)[i].state;                                   \
+        }                                                                      \
+        *numStates = n;                                                        \
+        return OSVR_RETURN_SUCCESS;                                            \
+    }
+
+OSVR_HISTORY_METHODS(Pose)
+OSVR_HISTORY_METHODS(Position)
+OSVR_HISTORY_METHODS(Orientation)
+OSVR_HISTORY_METHODS(Velocity)
+OSVR_HISTORY_METHODS(LinearVelocity)
+OSVR_HISTORY_METHODS(AngularVelocity)
+OSVR_HISTORY_METHODS(Acceleration)
+OSVR_HISTORY_METHODS(LinearAcceleration)
+OSVR_HISTORY_METHODS(AngularAcceleration)
+OSVR_HISTORY_METHODS(Button)
+OSVR_HISTORY_METHODS(Analog)
+OSVR_HISTORY_METHODS(Location2D)
+OSVR_HISTORY_METHODS(Direction)
+OSVR_HISTORY_METHODS(EyeTracker2D)
+OSVR_HISTORY_METHODS(EyeTracker3D)
+OSVR_HISTORY_METHODS(EyeTrackerBlink)
+OSVR_HISTORY_METHODS(NaviVelocity)
+OSVR_HISTORY_METHODS(NaviPosition)
+
+#undef OSVR_HISTORY_METHODS
+
+#define OSVR_INTERPOLATED_METHODS(TYPE)                                        \
+    OSVR_ReturnCode osvrGet##TYPE##StateInterpolated(                          \
+        OSVR_ClientInterface iface, struct OSVR_TimeValue const *when,         \
+        OSVR_##TYPE##State *state) {                                           \
+        if (!iface || !when || !state) {                                       \
+            return OSVR_RETURN_FAILURE;                                        \
+        }                                                                      \
+        auto lock = iface->getContext().lockUpdates();                         \
+        auto history = iface->getStateHistory<OSVR_##TYPE##Report>();          \
+        using Entry = osvr::common::StateMapContents<OSVR_##TYPE##Report>;     \
+        Entry const *before = nullptr;                                         \
+        Entry const *after = nullptr;                                          \
+        double alpha = 0;                                                      \
+        if (!history || !history->getBracket(*when, before, after, alpha)) {   \
+            return OSVR_RETURN_FAILURE;                                        \
+        }                                                                      \
+        *state = osvr::common::interpolateState(before->state, after->state,   \
+                                                alpha);                        \
+        return OSVR_RETURN_SUCCESS;                                            \
+    }
+
+OSVR_INTERPOLATED_METHODS(Pose)
+OSVR_INTERPOLATED_METHODS(Position)
+OSVR_INTERPOLATED_METHODS(Orientation)
+
+#undef OSVR_INTERPOLATED_METHODS
+
+OSVR_ReturnCode osvrGetPoseStateAtTime(OSVR_ClientInterface iface,
+                                       struct OSVR_TimeValue const *targetTime,
+                                       struct OSVR_TimeValue *timestamp,
+                                       OSVR_PoseState *state) {
+    if (!iface || !targetTime || !timestamp || !state) {
+        return OSVR_RETURN_FAILURE;
+    }
+    bool hasState = osvr::common::getPoseStateAtTime(*iface, *targetTime,
+                                                     *timestamp, *state);
+    return hasState ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;
+}
@@ -42,6 +42,9 @@ using ::osvr::make_shared;
 namespace osvr {
 namespace common {
     void deleteContext(ClientContext *ctx) {
+        /// Must stop before the derived object is destroyed, since the thread
+        /// calls into it.
+        ctx->stopBackgroundUpdates();
         auto del = ctx->getDeleter();
         (*del)(ctx);
     }
@@ -76,6 +79,10 @@ OSVR_ClientContextObject::OSVR_ClientContextObject(const char appId[],
           appId, osvr::common::getStandardClientInterfaceFactory(), del) {}
 
 OSVR_ClientContextObject::~OSVR_ClientContextObject() {
+    BOOST_ASSERT_MSG(!isUpdatingInBackground(),
+                     "Background updates must be stopped before destruction: "
+                     "use deleteContext()");
+    stopBackgroundUpdates();
     m_logger->info() << "OSVR client context shut down for " << m_appId;
     m_logger->flush();
 }
@@ -85,13 +92,55 @@ std::string const &OSVR_ClientContextObject::getAppId() const {
 }
 
 void OSVR_ClientContextObject::update() {
+    if (isUpdatingInBackground()) {
+        return;
+    }
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    m_updateLocked();
+}
+
+void OSVR_ClientContextObject::m_updateLocked() {
     m_update();
     for (auto const &iface : m_interfaces) {
         iface->update();
     }
 }
 
+void OSVR_ClientContextObject::startBackgroundUpdates(
+    std::chrono::microseconds interval) {
+    if (isUpdatingInBackground()) {
+        return;
+    }
+    m_logger->info() << "Starting background updates every "
+                     << interval.count() << "us";
+    m_runUpdateThread = true;
+    m_updateThread = std::thread([this, interval] {
+        while (m_runUpdateThread) {
+            {
+                std::lock_guard<std::recursive_mutex> lock(m_mutex);
+                m_updateLocked();
+            }
+            std::this_thread::sleep_for(interval);
+        }
+    });
+}
+
+void OSVR_ClientContextObject::stopBackgroundUpdates() {
+    if (!isUpdatingInBackground()) {
+        return;
+    }
+    m_runUpdateThread = false;
+    m_updateThread.join();
+    m_logger->info() << "Stopped background updates";
+}
+
+std::unique_lock<std::recursive_mutex>
+OSVR_ClientContextObject::lockUpdates() const {
+    return std::unique_lock<std::recursive_mutex>(m_mutex);
+}
+
 ClientInterfacePtr OSVR_ClientContextObject::getInterface(const char path[]) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     auto ret = m_clientInterfaceFactory(*this, path);
     if (!ret) {
         return ret;
@@ -103,6 +152,7 @@ ClientInterfacePtr OSVR_ClientContextObject::getInterface(const char path[]) {
 
 ClientInterfacePtr
 OSVR_ClientContextObject::releaseInterface(ClientInterface *iface) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     ClientInterfacePtr ret;
     if (!iface) {
         return ret;
@@ -129,6 +179,7 @@ OSVR_ClientContextObject::releaseInterface(ClientInterface *iface) {
 
 std::string
 OSVR_ClientContextObject::getStringParameter(std::string const &path) const {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     return getJSONStringFromTree(getPathTree(), path);
 }
 
@@ -137,10 +188,12 @@ osvr::common::PathTree const &OSVR_ClientContextObject::getPathTree() const {
 }
 
 void OSVR_ClientContextObject::sendRoute(std::string const &route) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     m_sendRoute(route);
 }
 
 bool OSVR_ClientContextObject::releaseObject(void *obj) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     return m_ownedObjects.release(obj);
 }
 
@@ -151,14 +204,19 @@ OSVR_ClientContextObject::getRoomToWorldTransform() const {
 
 void OSVR_ClientContextObject::setRoomToWorldTransform(
     osvr::common::Transform const &xform) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     m_setRoomToWorldTransform(xform);
+    ++m_roomToWorldGeneration;
 }
 
 ClientContextDeleter OSVR_ClientContextObject::getDeleter() const {
     return m_deleter;
 }
 
-bool OSVR_ClientContextObject::getStatus() const { return m_getStatus(); }
+bool OSVR_ClientContextObject::getStatus() const {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    return m_getStatus();
+}
 
 void OSVR_ClientContextObject::log(osvr::util::log::LogLevel severity,
                                    const char *message) {
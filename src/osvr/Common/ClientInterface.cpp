@@ -24,6 +24,7 @@
 
 // Internal Includes
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/ClientContext.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -43,3 +44,8 @@ std::string const &OSVR_ClientInterfaceObject::getPath() const {
 }
 
 void OSVR_ClientInterfaceObject::update() {}
+
+std::unique_lock<std::recursive_mutex>
+OSVR_ClientInterfaceObject::m_lockContext() const {
+    return m_ctx.lockUpdates();
+}
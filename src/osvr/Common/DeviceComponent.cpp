@@ -51,6 +51,11 @@ namespace common {
         return *m_parent;
     }
 
+    Buffer<> &DeviceComponent::m_getMessageBuffer() {
+        m_messageBuffer.clear();
+        return m_messageBuffer;
+    }
+
     void DeviceComponent::m_registerHandler(vrpn_MESSAGEHANDLER handler,
                                             void *userdata,
                                             RawMessageType const &msgType) {
@@ -78,7 +78,7 @@ namespace common {
                                           OSVR_ChannelCount sensor,
                                           OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        auto &buf = m_getMessageBuffer();
         messages::DirectionRecord::MessageSerialization msg(direction, sensor);
         serialize(buf, msg);
 
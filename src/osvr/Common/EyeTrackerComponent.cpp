@@ -73,7 +73,7 @@ namespace common {
     EyeTrackerComponent::sendNotification(OSVR_ChannelCount sensor,
                                           OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        auto &buf = m_getMessageBuffer();
         OSVR_EyeNotification notification;
         notification.sensor = sensor;
         messages::EyeRegion::MessageSerialization msg(notification);
@@ -55,6 +55,11 @@ namespace common {
     /// that would interfere with communication.
     static IPCRingBuffer::abi_level_type SHM_SOURCE_ABI_LEVEL = 0;
 
+    /// @brief the ABI level of the lock-free layout (LockFreeBookkeeping,
+    /// SeqlockSlotHeader): same bumping rules as SHM_SOURCE_ABI_LEVEL, but must
+    /// never be equal to it.
+    static IPCRingBuffer::abi_level_type SHM_LOCK_FREE_ABI_LEVEL = 1;
+
 /// Some tests that can be automated for ensuring validity of the ABI level
 /// number.
 /// The base boost version test has been moved exclusively to CMake, to error
@@ -110,25 +115,43 @@ namespace common {
             size_t alignedEntrySize = opts.getEntrySize() + opts.getAlignment();
             size_t dataSize = alignedEntrySize * (opts.getEntries() + 1);
             // Give 33% overhead on the raw bookkeeping data
-            static const size_t BOOKKEEPING_SIZE =
-                (sizeof(detail::Bookkeeping) +
-                 (sizeof(detail::ElementData) * opts.getEntries())) *
-                4 / 3;
+            const size_t BOOKKEEPING_SIZE =
+                opts.getLockFree()
+                    ? (sizeof(detail::LockFreeBookkeeping) +
+                       (sizeof(detail::LockFreeBookkeeping::Slot) *
+                        opts.getEntries())) *
+                          4 / 3
+                    : (sizeof(detail::Bookkeeping) +
+                       (sizeof(detail::ElementData) * opts.getEntries())) *
+                          4 / 3;
             return dataSize + BOOKKEEPING_SIZE;
         }
 
         class SharedMemorySegmentHolder {
           public:
-            SharedMemorySegmentHolder() : m_bookkeeping(nullptr) {}
+            SharedMemorySegmentHolder()
+                : m_bookkeeping(nullptr), m_lockFreeBookkeeping(nullptr) {}
             virtual ~SharedMemorySegmentHolder(){};
 
+            /// @brief Non-null only in the (default) locking mode.
             detail::Bookkeeping *getBookkeeping() { return m_bookkeeping; }
 
+            /// @brief Non-null only in lock-free mode.
+            detail::LockFreeBookkeeping *getLockFreeBookkeeping() {
+                return m_lockFreeBookkeeping;
+            }
+
+            bool hasBookkeeping() const {
+                return nullptr != m_bookkeeping ||
+                       nullptr != m_lockFreeBookkeeping;
+            }
+
             virtual uint64_t getSize() const = 0;
             virtual uint64_t getFreeMemory() const = 0;
 
           protected:
             detail::Bookkeeping *m_bookkeeping;
+            detail::LockFreeBookkeeping *m_lockFreeBookkeeping;
         };
 
         template <typename ManagedMemory>
@@ -168,12 +191,22 @@ namespace common {
                     return;
                 }
                 // detail::Bookkeeping::destroy(*Base::m_shm);
-                Base::m_bookkeeping =
-                    detail::Bookkeeping::construct(*Base::m_shm, opts);
+                if (opts.getLockFree()) {
+                    Base::m_lockFreeBookkeeping =
+                        detail::LockFreeBookkeeping::construct(*Base::m_shm,
+                                                               opts);
+                } else {
+                    Base::m_bookkeeping =
+                        detail::Bookkeeping::construct(*Base::m_shm, opts);
+                }
             }
 
             virtual ~ServerSharedMemorySegmentHolder() {
+                if (!Base::m_shm) {
+                    return;
+                }
                 detail::Bookkeeping::destroy(*Base::m_shm);
+                detail::LockFreeBookkeeping::destroy(*Base::m_shm);
                 removeSharedMemory();
             }
 
@@ -204,6 +237,10 @@ namespace common {
                     return;
                 }
                 Base::m_bookkeeping = detail::Bookkeeping::find(*Base::m_shm);
+                if (nullptr == Base::m_bookkeeping) {
+                    Base::m_lockFreeBookkeeping =
+                        detail::LockFreeBookkeeping::find(*Base::m_shm);
+                }
             }
 
             virtual ~ClientSharedMemorySegmentHolder() {}
@@ -224,7 +261,7 @@ namespace common {
                 ret.reset(
                     new ClientSharedMemorySegmentHolder<ManagedMemory>(opts));
             }
-            if (nullptr == ret->getBookkeeping()) {
+            if (!ret->hasBookkeeping()) {
                 ret.reset();
             } else {
                 getIPCRingBufferLogger().debug()
@@ -295,21 +332,42 @@ namespace common {
         m_entrySize = entrySize;
         return *this;
     }
+
+    IPCRingBuffer::Options &IPCRingBuffer::Options::setLockFree(bool lockFree) {
+        m_lockFree = lockFree;
+        return *this;
+    }
+
     class IPCRingBuffer::Impl {
       public:
         Impl(unique_ptr<SharedMemorySegmentHolder> &&segment,
              Options const &opts)
-            : m_seg(std::move(segment)), m_bookkeeping(nullptr), m_opts(opts) {
+            : m_seg(std::move(segment)), m_bookkeeping(nullptr),
+              m_lockFreeBookkeeping(nullptr), m_opts(opts) {
             m_bookkeeping = m_seg->getBookkeeping();
-            m_opts.setEntries(m_bookkeeping->getCapacity());
-            m_opts.setEntrySize(m_bookkeeping->getBufferLength());
+            m_lockFreeBookkeeping = m_seg->getLockFreeBookkeeping();
+            if (m_lockFreeBookkeeping) {
+                m_opts.setLockFree(true);
+                m_opts.setEntries(m_lockFreeBookkeeping->getCapacity());
+                m_opts.setEntrySize(m_lockFreeBookkeeping->getBufferLength());
+            } else {
+                m_opts.setLockFree(false);
+                m_opts.setEntries(m_bookkeeping->getCapacity());
+                m_opts.setEntrySize(m_bookkeeping->getBufferLength());
+            }
         }
 
         detail::IPCPutResultPtr put() {
+            if (m_lockFreeBookkeeping) {
+                return m_lockFreeBookkeeping->produceElement();
+            }
             return m_bookkeeping->produceElement();
         }
 
         detail::IPCGetResultPtr get(sequence_type num) {
+            if (m_lockFreeBookkeeping) {
+                return m_lockFreeBookkeeping->consumeElement(num);
+            }
             detail::IPCGetResultPtr ret;
             auto boundsLock = m_bookkeeping->getSharableLock();
             auto elt = m_bookkeeping->getBySequenceNumber(num, boundsLock);
@@ -318,12 +376,15 @@ namespace common {
                 auto buf = elt->getBuf(readerLock);
                 /// The nullptr will be filled in by the main object.
                 ret.reset(new detail::IPCGetResult{buf, std::move(readerLock),
-                                                   num, nullptr});
+                                                   num, nullptr, nullptr});
             }
             return ret;
         }
 
         detail::IPCGetResultPtr getLatest() {
+            if (m_lockFreeBookkeeping) {
+                return m_lockFreeBookkeeping->consumeLatest();
+            }
             detail::IPCGetResultPtr ret;
             auto boundsLock = m_bookkeeping->getSharableLock();
             auto elt = m_bookkeeping->back(boundsLock);
@@ -333,7 +394,8 @@ namespace common {
                 /// The nullptr will be filled in by the main object.
                 ret.reset(new detail::IPCGetResult{
                     buf, std::move(readerLock),
-                    m_bookkeeping->backSequenceNumber(boundsLock), nullptr});
+                    m_bookkeeping->backSequenceNumber(boundsLock), nullptr,
+                    nullptr});
             }
             return ret;
         }
@@ -343,6 +405,7 @@ namespace common {
       private:
         unique_ptr<SharedMemorySegmentHolder> m_seg;
         detail::Bookkeeping *m_bookkeeping;
+        detail::LockFreeBookkeeping *m_lockFreeBookkeeping;
 
         Options m_opts;
     };
@@ -393,6 +456,15 @@ namespace common {
         return SHM_SOURCE_ABI_LEVEL;
     }
 
+    IPCRingBuffer::abi_level_type IPCRingBuffer::getLockFreeABILevel() {
+        return SHM_LOCK_FREE_ABI_LEVEL;
+    }
+
+    bool IPCRingBuffer::isABILevelSupported(abi_level_type level) {
+        return level == SHM_SOURCE_ABI_LEVEL ||
+               level == SHM_LOCK_FREE_ABI_LEVEL;
+    }
+
     IPCRingBufferPtr IPCRingBuffer::create(Options const &opts) {
         return m_constructorHelper(opts, true);
     }
@@ -413,6 +485,14 @@ namespace common {
         return m_impl->getOpts().getName();
     }
 
+    bool IPCRingBuffer::isLockFree() const {
+        return m_impl->getOpts().getLockFree();
+    }
+
+    IPCRingBuffer::abi_level_type IPCRingBuffer::getInstanceABILevel() const {
+        return isLockFree() ? getLockFreeABILevel() : getABILevel();
+    }
+
     uint32_t IPCRingBuffer::getEntrySize() const {
         return m_impl->getOpts().getEntrySize();
     }
@@ -429,6 +509,10 @@ namespace common {
                                                     size_t len) {
         auto proxy = put();
         std::memcpy(proxy.get(), data, len);
+        if (proxy.m_data) {
+            /// Lets lock-free readers copy just this much.
+            proxy.m_data->seqlockGuard.setLength(static_cast<uint32_t>(len));
+        }
         return proxy.getSequenceNumber();
     }
 
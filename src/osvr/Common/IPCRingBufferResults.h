@@ -27,8 +27,10 @@
 
 // Internal Includes
 #include <osvr/Common/IPCRingBuffer.h>
+#include "IPCRingBufferSeqlock.h"
 #include "SharedMemory.h"
 #include "SharedMemoryObjectWithMutex.h"
+#include <osvr/Util/AlignedMemoryUniquePtr.h>
 
 // Library/third-party includes
 // - none
@@ -46,14 +48,24 @@ namespace common {
                 OSVR_DEV_VERBOSE("Releasing exclusive lock on sequence "
                                  << seq);
 #endif
-                elementLock.unlock();
-                boundsLock.unlock();
+                /// Publish first in lock-free mode (no-op otherwise)
+                seqlockGuard.release();
+                if (elementLock) {
+                    elementLock.unlock();
+                }
+                if (boundsLock) {
+                    boundsLock.unlock();
+                }
             }
             IPCRingBuffer::value_type *buffer;
             IPCRingBuffer::sequence_type seq;
+            /// @brief Only locked in the (default) locking mode.
             ipc::exclusive_lock_type elementLock;
+            /// @brief Only locked in the (default) locking mode.
             ipc::exclusive_lock_type boundsLock;
             IPCRingBufferPtr shm;
+            /// @brief Only active in lock-free mode.
+            SeqlockWriteGuard seqlockGuard;
         };
 
         struct IPCGetResult {
@@ -62,12 +74,18 @@ namespace common {
 #ifdef OSVR_SHM_LOCK_DEBUGGING
                 OSVR_DEV_VERBOSE("Releasing shared lock on sequence " << seq);
 #endif
-                elementLock.unlock();
+                if (elementLock) {
+                    elementLock.unlock();
+                }
             }
             IPCRingBuffer::value_type *buffer;
+            /// @brief Only locked in the (default) locking mode.
             ipc::sharable_lock_type elementLock;
             IPCRingBuffer::sequence_type seq;
             IPCRingBufferPtr shm;
+            /// @brief In lock-free mode, the validated private copy of the
+            /// entry that buffer points into.
+            util::AlignedImageBufferPtr privateCopy;
         };
     } // namespace detail
 
@@ -0,0 +1,166 @@
+/** @file
+    @brief Header containing the sequence-lock primitives used by the
+   lock-free mode of IPCRingBuffer.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_IPCRingBufferSeqlock_h_GUID_0C9E7D4A_2E5B_4C1F_9A43_7B0D6E2F81C5
+#define INCLUDED_IPCRingBufferSeqlock_h_GUID_0C9E7D4A_2E5B_4C1F_9A43_7B0D6E2F81C5
+
+// Internal Includes
+#include <osvr/Common/IPCRingBuffer.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>
+#include <utility>
+
+namespace osvr {
+namespace common {
+    namespace detail {
+        /// @brief The atomic type placed in shared memory. It must be
+        /// lock-free (and thus address-free) to be meaningful across processes.
+        typedef std::atomic<uint32_t> shared_atomic_uint32;
+        static_assert(ATOMIC_INT_LOCK_FREE == 2,
+                      "Lock-free IPC ring buffer mode requires always-lock-free "
+                      "32-bit atomics.");
+        static_assert(sizeof(shared_atomic_uint32) == sizeof(uint32_t),
+                      "Shared-memory atomics must have the same layout as the "
+                      "underlying integer.");
+
+        /// @brief Per-entry header for the lock-free ring buffer mode.
+        ///
+        /// The version is even when the slot is stable and odd while the
+        /// producer is writing into it. The sequence number identifies which
+        /// "put" currently occupies (or is about to occupy) the slot, and the
+        /// length is how many bytes of the slot that put filled.
+        struct SeqlockSlotHeader {
+            SeqlockSlotHeader() : version(0), seq(0), length(0) {}
+            shared_atomic_uint32 version;
+            shared_atomic_uint32 seq;
+            shared_atomic_uint32 length;
+        };
+
+        /// @brief Snapshot of a slot taken before reading its contents, to
+        /// be validated after the read.
+        struct SeqlockReadTicket {
+            uint32_t version;
+            IPCRingBuffer::sequence_type seq;
+            uint32_t length;
+            /// @brief false if the slot was being written when we looked.
+            bool stable;
+        };
+
+        /// @brief Begin an optimistic read of a slot.
+        inline SeqlockReadTicket
+        seqlockBeginRead(SeqlockSlotHeader const &slot) {
+            SeqlockReadTicket ret;
+            ret.version = slot.version.load(std::memory_order_acquire);
+            ret.seq = slot.seq.load(std::memory_order_relaxed);
+            ret.length = slot.length.load(std::memory_order_relaxed);
+            ret.stable = (ret.version & 0x1) == 0;
+            return ret;
+        }
+
+        /// @brief Finish an optimistic read of a slot: returns true only if
+        /// the data read since the matching seqlockBeginRead() was neither
+        /// torn by a concurrent write nor replaced by a newer entry.
+        inline bool seqlockValidateRead(SeqlockSlotHeader const &slot,
+                                        SeqlockReadTicket const &ticket) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return ticket.stable &&
+                   slot.version.load(std::memory_order_relaxed) ==
+                       ticket.version;
+        }
+
+        /// @brief RAII object owned by the producer for the duration of a
+        /// single "put" in lock-free mode: marks the slot as being written
+        /// on construction, and publishes it on destruction. Never blocks.
+        class SeqlockWriteGuard {
+          public:
+            SeqlockWriteGuard() {}
+            /// @param length Initial length of the entry: the whole slot,
+            /// unless the producer says otherwise with setLength().
+            SeqlockWriteGuard(SeqlockSlotHeader &slot,
+                              shared_atomic_uint32 &published,
+                              IPCRingBuffer::sequence_type seq,
+                              uint32_t length)
+                : m_slot(&slot), m_published(&published), m_seq(seq) {
+                /// Odd version: readers will reject this slot from now on.
+                auto v = m_slot->version.load(std::memory_order_relaxed);
+                m_slot->version.store(v + 1, std::memory_order_relaxed);
+                m_slot->seq.store(seq, std::memory_order_relaxed);
+                m_slot->length.store(length, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+            }
+
+            ~SeqlockWriteGuard() { release(); }
+
+            SeqlockWriteGuard(SeqlockWriteGuard const &) = delete;
+            SeqlockWriteGuard &operator=(SeqlockWriteGuard const &) = delete;
+
+            SeqlockWriteGuard(SeqlockWriteGuard &&other) { swap(other); }
+            SeqlockWriteGuard &operator=(SeqlockWriteGuard &&other) {
+                swap(other);
+                return *this;
+            }
+
+            void swap(SeqlockWriteGuard &other) {
+                std::swap(m_slot, other.m_slot);
+                std::swap(m_published, other.m_published);
+                std::swap(m_seq, other.m_seq);
+            }
+
+            /// @brief Record how many bytes of the slot this put actually
+            /// filled, so readers copy only those. No-op if not active.
+            void setLength(uint32_t length) {
+                if (nullptr != m_slot) {
+                    m_slot->length.store(length, std::memory_order_relaxed);
+                }
+            }
+
+            /// @brief Publish the slot: back to an even version, and bump the
+            /// published count so getLatest() can find it.
+            void release() {
+                if (nullptr == m_slot) {
+                    return;
+                }
+                auto v = m_slot->version.load(std::memory_order_relaxed);
+                m_slot->version.store(v + 1, std::memory_order_release);
+                m_published->store(m_seq + 1, std::memory_order_release);
+                m_slot = nullptr;
+                m_published = nullptr;
+            }
+
+          private:
+            SeqlockSlotHeader *m_slot = nullptr;
+            shared_atomic_uint32 *m_published = nullptr;
+            IPCRingBuffer::sequence_type m_seq = 0;
+        };
+    } // namespace detail
+
+} // namespace common
+} // namespace osvr
+#endif // INCLUDED_IPCRingBufferSeqlock_h_GUID_0C9E7D4A_2E5B_4C1F_9A43_7B0D6E2F81C5
@@ -29,6 +29,7 @@
 // Internal Includes
 #include <osvr/Common/IPCRingBuffer.h>
 #include "IPCRingBufferResults.h"
+#include "IPCRingBufferSeqlock.h"
 #include "SharedMemoryObjectWithMutex.h"
 #include <osvr/Util/StdInt.h>
 #include <osvr/Util/Verbosity.h>
@@ -37,6 +38,8 @@
 #include <boost/noncopyable.hpp>
 
 // Standard includes
+#include <algorithm>
+#include <cstring>
 #include <utility>
 
 namespace osvr {
@@ -201,7 +204,8 @@ namespace common {
                 /// shared memory nullptr filled in by outer class
                 IPCPutResultPtr ret(new IPCPutResult{
                     back(lock)->getBuf(elementLock), sequenceNumber,
-                    std::move(elementLock), std::move(lock), nullptr});
+                    std::move(elementLock), std::move(lock), nullptr,
+                    SeqlockWriteGuard()});
                 return ret;
             }
 
@@ -214,6 +218,163 @@ namespace common {
             raw_index_type m_size;
             uint32_t m_bufLen;
         };
+
+        /// @brief Bookkeeping for the lock-free (single-writer, seqlock) mode.
+        ///
+        /// Only one of Bookkeeping or LockFreeBookkeeping is constructed in a
+        /// given segment, which is how clients tell the modes apart.
+        ///
+        /// The producer never waits on a reader: each slot carries a version
+        /// number that is odd while being written, and readers copy the slot
+        /// out, then check that neither the version nor the sequence number
+        /// changed underneath them.
+        class LockFreeBookkeeping : boost::noncopyable {
+          public:
+            typedef IPCRingBuffer::sequence_type sequence_type;
+            typedef uint16_t raw_index_type;
+
+            struct Slot {
+                SeqlockSlotHeader header;
+                ipc_offset_ptr<IPCRingBuffer::value_type> buf;
+            };
+
+            template <typename ManagedMemory>
+            static LockFreeBookkeeping *find(ManagedMemory &shm) {
+                auto self = shm.template find<LockFreeBookkeeping>(
+                    bip::unique_instance);
+                return self.first;
+            }
+
+            template <typename ManagedMemory>
+            static LockFreeBookkeeping *
+            construct(ManagedMemory &shm, IPCRingBuffer::Options const &opts) {
+                return shm.template construct<LockFreeBookkeeping>(
+                    bip::unique_instance)(shm, opts);
+            }
+
+            template <typename ManagedMemory>
+            static void destroy(ManagedMemory &shm) {
+                auto self = find(shm);
+                if (nullptr == self) {
+                    return;
+                }
+                self->freeBufs(shm);
+                shm.template destroy<LockFreeBookkeeping>(
+                    bip::unique_instance);
+            }
+
+            template <typename ManagedMemory>
+            LockFreeBookkeeping(ManagedMemory &shm,
+                                IPCRingBuffer::Options const &opts)
+                : m_capacity(opts.getEntries()),
+                  m_slots(shm.template construct<Slot>(
+                      bip::unique_instance)[m_capacity]()),
+                  m_published(0), m_nextSequenceNumber(0),
+                  m_bufLen(opts.getEntrySize()) {
+                for (raw_index_type i = 0; i < m_capacity; ++i) {
+                    try {
+                        m_slots[i].buf =
+                            static_cast<IPCRingBuffer::value_type *>(
+                                shm.allocate_aligned(opts.getEntrySize(),
+                                                     opts.getAlignment()));
+                    } catch (std::bad_alloc &) {
+                        OSVR_DEV_VERBOSE("Couldn't allocate buffer #"
+                                         << i
+                                         << ", truncating the ring buffer");
+                        m_capacity = i;
+                        break;
+                    }
+                }
+            }
+
+            template <typename ManagedMemory>
+            void freeBufs(ManagedMemory &shm) {
+                for (raw_index_type i = 0; i < m_capacity; ++i) {
+                    if (nullptr != m_slots[i].buf) {
+                        shm.deallocate(m_slots[i].buf.get());
+                    }
+                    m_slots[i].buf = nullptr;
+                }
+                shm.template destroy<Slot>(bip::unique_instance);
+            }
+
+            /// @brief Get number of elements.
+            raw_index_type getCapacity() const { return m_capacity; }
+
+            /// @brief Get capacity of elements.
+            uint32_t getBufferLength() const { return m_bufLen; }
+
+            /// @brief Producer side: claims the next slot without waiting on
+            /// any reader. Must only be called from a single producer thread.
+            IPCPutResultPtr produceElement() {
+                auto sequenceNumber = m_nextSequenceNumber;
+                m_nextSequenceNumber++;
+                auto &slot = getSlot(sequenceNumber);
+                /// shared memory nullptr filled in by outer class
+                IPCPutResultPtr ret(new IPCPutResult{
+                    slot.buf.get(), sequenceNumber, ipc::exclusive_lock_type(),
+                    ipc::exclusive_lock_type(), nullptr,
+                    SeqlockWriteGuard(slot.header, m_published,
+                                      sequenceNumber, m_bufLen)});
+                return ret;
+            }
+
+            /// @brief Consumer side: copies out the entry with the given
+            /// sequence number, if it is (still) available and was not torn
+            /// by a concurrent write. Returns an empty pointer otherwise.
+            ///
+            /// Only the length the producer recorded for the entry is
+            /// allocated and copied, not the whole slot.
+            IPCGetResultPtr consumeElement(sequence_type num) {
+                IPCGetResultPtr ret;
+                auto &slot = getSlot(num);
+                auto ticket = seqlockBeginRead(slot.header);
+                if (!ticket.stable || ticket.version == 0 ||
+                    ticket.seq != num) {
+                    /// Being written, never written, or already overwritten.
+                    return ret;
+                }
+                /// A length read mid-write is caught by the validation below,
+                /// but must not take us past the slot in the meantime.
+                auto length = std::min(ticket.length, m_bufLen);
+                auto copy = util::makeAlignedImageBuffer(length);
+                std::memcpy(copy.get(), slot.buf.get(), length);
+                if (!seqlockValidateRead(slot.header, ticket)) {
+                    /// Torn: the producer lapped us during the copy.
+                    return ret;
+                }
+                auto buf = copy.get();
+                /// The nullptr will be filled in by the main object.
+                ret.reset(new IPCGetResult{buf, ipc::sharable_lock_type(), num,
+                                           nullptr, std::move(copy)});
+                return ret;
+            }
+
+            /// @brief Consumer side: copies out the most recently published
+            /// entry, retrying a bounded number of times if it gets lapped.
+            IPCGetResultPtr consumeLatest() {
+                static const int MAX_ATTEMPTS = 3;
+                IPCGetResultPtr ret;
+                for (int i = 0; i < MAX_ATTEMPTS && !ret; ++i) {
+                    auto published =
+                        m_published.load(std::memory_order_acquire);
+                    ret = consumeElement(published - 1);
+                }
+                return ret;
+            }
+
+          private:
+            Slot &getSlot(sequence_type num) {
+                return *(m_slots + (num % m_capacity));
+            }
+            raw_index_type m_capacity;
+            ipc_offset_ptr<Slot> m_slots;
+            /// @brief One past the most recently published sequence number.
+            shared_atomic_uint32 m_published;
+            /// @brief Only touched by the producer.
+            sequence_type m_nextSequenceNumber;
+            uint32_t m_bufLen;
+        };
     } // namespace detail
 
 } // namespace common
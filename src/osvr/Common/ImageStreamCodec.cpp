@@ -0,0 +1,341 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ImageStreamCodec.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cstring>
+
+namespace osvr {
+namespace common {
+    namespace imagestream {
+        namespace {
+            inline std::size_t
+            getBytesPerPixel(OSVR_ImagingMetadata const &metadata) {
+                return std::size_t(metadata.channels) * metadata.depth;
+            }
+            inline std::size_t
+            getBufferSize(OSVR_ImagingMetadata const &metadata) {
+                return std::size_t(metadata.height) * metadata.width *
+                       getBytesPerPixel(metadata);
+            }
+            inline bool sameLayout(OSVR_ImagingMetadata const &a,
+                                   OSVR_ImagingMetadata const &b) {
+                return a.height == b.height && a.width == b.width &&
+                       a.channels == b.channels && a.depth == b.depth &&
+                       a.type == b.type;
+            }
+
+            /// @brief Isolated zeros aren't worth breaking a literal run for.
+            static const std::size_t MIN_ZERO_RUN = 3;
+
+            inline std::size_t getVarintSize(std::size_t val) {
+                std::size_t ret = 1;
+                while (val >= 0x80) {
+                    val >>= 7;
+                    ++ret;
+                }
+                return ret;
+            }
+
+            /// @brief The largest payload the encoder can produce for a frame
+            /// with this metadata.
+            inline std::size_t
+            getMaxPayloadSize(OSVR_ImagingMetadata const &metadata,
+                              Encoding encoding) {
+                auto bytes = getBufferSize(metadata);
+                if (encoding == Encoding::Raw) {
+                    return bytes;
+                }
+                /// Every group but the last ends in at least MIN_ZERO_RUN
+                /// zeros, and has two counts no larger than the frame.
+                auto groups = bytes / MIN_ZERO_RUN + 1;
+                return bytes + groups * 2 * getVarintSize(bytes);
+            }
+
+            inline void appendVarint(std::size_t val, ByteVector &out) {
+                while (val >= 0x80) {
+                    out.push_back(static_cast<uint8_t>(val | 0x80));
+                    val >>= 7;
+                }
+                out.push_back(static_cast<uint8_t>(val));
+            }
+
+            inline bool readVarint(uint8_t const *&data, uint8_t const *end,
+                                   std::size_t &val) {
+                val = 0;
+                unsigned shift = 0;
+                while (data != end && shift < sizeof(std::size_t) * 8) {
+                    uint8_t b = *data++;
+                    val |= std::size_t(b & 0x7f) << shift;
+                    if (!(b & 0x80)) {
+                        return true;
+                    }
+                    shift += 7;
+                }
+                return false;
+            }
+        } // namespace
+
+        OSVR_ImagingMetadata extractRegion(OSVR_ImagingMetadata const &metadata,
+                                           OSVR_ImageBufferElement const *data,
+                                           StreamSettings const &settings,
+                                           ByteVector &out) {
+            auto x0 = std::min(settings.roiX, metadata.width);
+            auto y0 = std::min(settings.roiY, metadata.height);
+            auto roiWidth = settings.roiWidth == 0 ? metadata.width - x0
+                                                   : settings.roiWidth;
+            auto roiHeight = settings.roiHeight == 0 ? metadata.height - y0
+                                                     : settings.roiHeight;
+            roiWidth = std::min(roiWidth, metadata.width - x0);
+            roiHeight = std::min(roiHeight, metadata.height - y0);
+            uint32_t step = std::max<uint32_t>(settings.downscale, 1);
+
+            OSVR_ImagingMetadata ret = metadata;
+            ret.width = (roiWidth + step - 1) / step;
+            ret.height = (roiHeight + step - 1) / step;
+            out.resize(getBufferSize(ret));
+
+            auto pixelBytes = getBytesPerPixel(metadata);
+            auto inStride = metadata.width * pixelBytes;
+            if (step == 1 && roiWidth == metadata.width) {
+                /// Whole rows: single copy.
+                if (!out.empty()) {
+                    std::memcpy(out.data(), data + y0 * inStride, out.size());
+                }
+                return ret;
+            }
+            auto outRow = out.data();
+            auto outStride = ret.width * pixelBytes;
+            for (uint32_t y = 0; y < ret.height; ++y) {
+                auto inRow = data + (y0 + y * step) * inStride + x0 * pixelBytes;
+                if (step == 1) {
+                    std::memcpy(outRow, inRow, outStride);
+                } else {
+                    auto outPixel = outRow;
+                    for (uint32_t x = 0; x < ret.width; ++x) {
+                        std::memcpy(outPixel, inRow + x * step * pixelBytes,
+                                    pixelBytes);
+                        outPixel += pixelBytes;
+                    }
+                }
+                outRow += outStride;
+            }
+            return ret;
+        }
+
+        void encodeZeroRuns(uint8_t const *data, std::size_t len,
+                            ByteVector &out) {
+            auto end = data + len;
+            auto literalBegin = data;
+            auto it = data;
+            while (it != end) {
+                if (*it != 0) {
+                    ++it;
+                    continue;
+                }
+                auto zeroBegin = it;
+                while (it != end && *it == 0) {
+                    ++it;
+                }
+                std::size_t zeros = it - zeroBegin;
+                if (zeros < MIN_ZERO_RUN && it != end) {
+                    continue;
+                }
+                appendVarint(zeroBegin - literalBegin, out);
+                out.insert(out.end(), literalBegin, zeroBegin);
+                appendVarint(zeros, out);
+                literalBegin = it;
+            }
+            if (literalBegin != end) {
+                appendVarint(end - literalBegin, out);
+                out.insert(out.end(), literalBegin, end);
+                appendVarint(0, out);
+            }
+        }
+
+        bool decodeZeroRuns(uint8_t const *data, std::size_t len, uint8_t *out,
+                            std::size_t outLen) {
+            auto end = data + len;
+            std::size_t written = 0;
+            while (data != end) {
+                std::size_t literals;
+                std::size_t zeros;
+                if (!readVarint(data, end, literals) ||
+                    literals > std::size_t(end - data) ||
+                    literals > outLen - written) {
+                    return false;
+                }
+                std::memcpy(out + written, data, literals);
+                data += literals;
+                written += literals;
+                if (!readVarint(data, end, zeros) ||
+                    zeros > outLen - written) {
+                    return false;
+                }
+                std::memset(out + written, 0, zeros);
+                written += zeros;
+            }
+            return written == outLen;
+        }
+
+        const frame_id_type Encoder::KEYFRAME_INTERVAL;
+
+        Encoder::Encoder() {}
+
+        Encoder::EncodedFrame const &
+        Encoder::encode(OSVR_ImagingMetadata const &metadata,
+                        OSVR_ImageBufferElement const *data,
+                        StreamSettings const &settings) {
+            auto regionMetadata =
+                extractRegion(metadata, data, settings, m_region);
+            /// Delta frames only pay off if the zeros get compressed.
+            bool useDelta = settings.delta && settings.compress;
+            bool keyframe = !useDelta || !m_havePrev || m_keyframeRequested ||
+                            m_framesSinceKey >= KEYFRAME_INTERVAL ||
+                            !sameLayout(regionMetadata, m_prevMetadata);
+
+            m_frame.metadata = regionMetadata;
+            m_frame.frameId = m_nextFrameId++;
+            if (m_frame.frameId == NO_BASE_FRAME) {
+                m_frame.frameId = m_nextFrameId++;
+            }
+            m_frame.payload.clear();
+            if (keyframe) {
+                m_frame.baseFrameId = NO_BASE_FRAME;
+                if (settings.compress) {
+                    m_frame.encoding = Encoding::ZeroRuns;
+                    encodeZeroRuns(m_region.data(), m_region.size(),
+                                   m_frame.payload);
+                } else {
+                    m_frame.encoding = Encoding::Raw;
+                    m_frame.payload = m_region;
+                }
+                m_framesSinceKey = 0;
+                m_keyframeRequested = false;
+            } else {
+                m_frame.baseFrameId = m_prevFrameId;
+                m_frame.encoding = Encoding::DeltaZeroRuns;
+                m_delta.resize(m_region.size());
+                for (std::size_t i = 0, e = m_region.size(); i < e; ++i) {
+                    m_delta[i] = static_cast<uint8_t>(m_region[i] - m_prev[i]);
+                }
+                encodeZeroRuns(m_delta.data(), m_delta.size(),
+                               m_frame.payload);
+                ++m_framesSinceKey;
+            }
+            m_prev.swap(m_region);
+            m_prevMetadata = regionMetadata;
+            m_prevFrameId = m_frame.frameId;
+            m_havePrev = true;
+            return m_frame;
+        }
+
+        Decoder::Decoder() {}
+
+        Decoder::Result Decoder::addChunk(ChunkHeader const &header,
+                                          uint8_t const *data,
+                                          std::size_t len) {
+            if (header.offset == 0) {
+                /// Start of a new frame, abandoning any partial one.
+                m_assembling = false;
+                if (header.totalBytes >
+                    getMaxPayloadSize(header.metadata, header.encoding)) {
+                    /// More than any frame this size could take: don't
+                    /// allocate what the wire asks for.
+                    return Result::NeedKeyframe;
+                }
+                m_assembling = true;
+                m_assemblingId = header.frameId;
+                m_received = 0;
+                m_payload.resize(header.totalBytes);
+            }
+            if (!m_assembling || header.frameId != m_assemblingId ||
+                header.offset != m_received ||
+                header.totalBytes != m_payload.size() ||
+                len > m_payload.size() - m_received) {
+                /// Lost or out-of-order chunk.
+                m_assembling = false;
+                return Result::NeedKeyframe;
+            }
+            if (len > 0) {
+                std::memcpy(m_payload.data() + m_received, data, len);
+            }
+            m_received += static_cast<uint32_t>(len);
+            if (m_received < m_payload.size()) {
+                return Result::Incomplete;
+            }
+            m_assembling = false;
+            return m_finishFrame(header);
+        }
+
+        Decoder::Result Decoder::m_finishFrame(ChunkHeader const &header) {
+            auto bytes = getBufferSize(header.metadata);
+            switch (header.encoding) {
+            case Encoding::Raw:
+                if (m_payload.size() != bytes) {
+                    return Result::NeedKeyframe;
+                }
+                m_frame.assign(m_payload.begin(), m_payload.end());
+                break;
+            case Encoding::ZeroRuns:
+                m_frame.resize(bytes);
+                if (!decodeZeroRuns(m_payload.data(), m_payload.size(),
+                                    m_frame.data(), bytes)) {
+                    m_haveFrame = false;
+                    return Result::NeedKeyframe;
+                }
+                break;
+            case Encoding::DeltaZeroRuns: {
+                if (!m_haveFrame || m_frameId != header.baseFrameId ||
+                    !sameLayout(m_frameMetadata, header.metadata)) {
+                    return Result::NeedKeyframe;
+                }
+                m_delta.resize(bytes);
+                if (!decodeZeroRuns(m_payload.data(), m_payload.size(),
+                                    m_delta.data(), bytes)) {
+                    m_haveFrame = false;
+                    return Result::NeedKeyframe;
+                }
+                for (std::size_t i = 0; i < bytes; ++i) {
+                    m_frame[i] = static_cast<uint8_t>(m_frame[i] + m_delta[i]);
+                }
+                break;
+            }
+            default:
+                return Result::NeedKeyframe;
+            }
+            m_frameMetadata = header.metadata;
+            m_frameId = header.frameId;
+            m_haveFrame = true;
+            return Result::Complete;
+        }
+    } // namespace imagestream
+} // namespace common
+} // namespace osvr
@@ -35,14 +35,34 @@
 // - none
 
 // Standard includes
+#include <algorithm>
+#include <random>
 #include <sstream>
 #include <utility>
 
 namespace osvr {
 namespace common {
+#ifdef OSVR_COMMON_LOCK_FREE_SHM_IMAGING
+    static const bool SHM_IMAGING_LOCK_FREE = true;
+#else
+    static const bool SHM_IMAGING_LOCK_FREE = false;
+#endif
+    /// @brief How long a network image stream lasts without its client
+    /// renewing the request.
+    static const double STREAM_LEASE_SECONDS = 5.;
+    /// @brief How often clients renew their network image stream requests.
+    static const double STREAM_RENEW_SECONDS = 1.5;
+
     static inline uint32_t getBufferSize(OSVR_ImagingMetadata const &meta) {
         return meta.height * meta.width * meta.depth * meta.channels;
     }
+    static inline bool sameSettings(imagestream::StreamSettings const &a,
+                                    imagestream::StreamSettings const &b) {
+        return a.downscale == b.downscale && a.roiX == b.roiX &&
+               a.roiY == b.roiY && a.roiWidth == b.roiWidth &&
+               a.roiHeight == b.roiHeight && a.compress == b.compress &&
+               a.delta == b.delta;
+    }
     namespace messages {
         namespace {
             template <typename T>
@@ -193,6 +213,108 @@ namespace common {
         const char *ImagePlacedInSharedMemory::identifier() {
             return "com.osvr.imaging.imageplacedinsharedmemory";
         }
+
+        class ImageChunk::MessageSerialization {
+          public:
+            typedef imagestream::Decoder::ChunkHeader Header;
+            MessageSerialization(Header const &header, OSVR_ChannelCount sensor,
+                                 uint32_t streamId, uint8_t const *data,
+                                 uint32_t len)
+                : m_header(header), m_sensor(sensor), m_streamId(streamId),
+                  m_data(data), m_len(len) {}
+
+            MessageSerialization() : m_data(nullptr), m_len(0) {}
+
+            template <typename T>
+            void allocateBuffer(T &, std::true_type const &) {
+                m_buf.resize(m_len);
+                m_data = m_buf.data();
+            }
+
+            template <typename T>
+            void allocateBuffer(T &, std::false_type const &) {
+                // Does nothing if we're serializing.
+            }
+
+            template <typename T> void processMessage(T &p) {
+                process(m_header.metadata, p);
+                p(m_header.encoding,
+                  serialization::EnumAsIntegerTag<imagestream::Encoding,
+                                                  uint8_t>());
+                p(m_header.frameId);
+                p(m_header.baseFrameId);
+                p(m_header.totalBytes);
+                p(m_header.offset);
+                p(m_sensor);
+                p(m_streamId);
+                p(m_len);
+                allocateBuffer(p, p.isDeserialize());
+                p(const_cast<uint8_t *>(m_data),
+                  serialization::AlignedDataBufferTag(m_len));
+            }
+
+            Header const &getHeader() const { return m_header; }
+            OSVR_ChannelCount getSensor() const { return m_sensor; }
+            uint32_t getStreamId() const { return m_streamId; }
+            uint8_t const *getData() const { return m_data; }
+            uint32_t getLength() const { return m_len; }
+
+          private:
+            Header m_header;
+            OSVR_ChannelCount m_sensor;
+            uint32_t m_streamId;
+            uint8_t const *m_data;
+            uint32_t m_len;
+            imagestream::ByteVector m_buf;
+        };
+
+        const char *ImageChunk::identifier() {
+            return "com.osvr.imaging.imagechunk";
+        }
+
+        namespace {
+            struct StreamRequestMessage {
+                OSVR_ChannelCount sensor;
+                /// @brief Chosen by the client, to tell its stream apart from
+                /// those of other clients.
+                uint32_t streamId;
+                imagestream::StreamSettings settings;
+                bool keyframeOnly;
+            };
+            template <typename T>
+            void process(StreamRequestMessage &msg, T &p) {
+                p(msg.sensor);
+                p(msg.streamId);
+                p(msg.settings.downscale);
+                p(msg.settings.roiX);
+                p(msg.settings.roiY);
+                p(msg.settings.roiWidth);
+                p(msg.settings.roiHeight);
+                p(msg.settings.compress);
+                p(msg.settings.delta);
+                p(msg.keyframeOnly);
+            }
+        } // namespace
+
+        class ImageStreamRequest::MessageSerialization {
+          public:
+            MessageSerialization() {}
+            explicit MessageSerialization(StreamRequestMessage const &msg)
+                : m_msgData(msg) {}
+
+            template <typename T> void processMessage(T &p) {
+                process(m_msgData, p);
+            }
+
+            StreamRequestMessage const &getMessage() { return m_msgData; }
+
+          private:
+            StreamRequestMessage m_msgData;
+        };
+
+        const char *ImageStreamRequest::identifier() {
+            return "com.osvr.imaging.imagestreamrequest";
+        }
     } // namespace messages
 
     shared_ptr<ImagingComponent>
@@ -201,7 +323,7 @@ namespace common {
         return ret;
     }
     ImagingComponent::ImagingComponent(OSVR_ChannelCount numChan)
-        : m_numSensor(numChan) {}
+        : m_numSensor(numChan), m_streamId(std::random_device()()) {}
 
     void ImagingComponent::sendImageData(OSVR_ImagingMetadata metadata,
                                          OSVR_ImageBufferElement *imageData,
@@ -233,7 +355,7 @@ namespace common {
         auto imageBufferCopy = util::makeAlignedImageBuffer(imageBufferSize);
         memcpy(imageBufferCopy.get(), imageData, imageBufferSize);
 
-        Buffer<> buf;
+        auto &buf = m_getMessageBuffer();
         messages::ImagePlacedInProcessMemory::MessageSerialization
             serialization(messages::InProcessMemoryMessage{
                 metadata, sensor,
@@ -247,12 +369,75 @@ namespace common {
     }
 #endif
 
-    bool ImagingComponent::m_sendImageDataViaSharedMemory(
-        OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
-        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
+    OSVR_ImageBufferElement *
+    ImagingComponent::acquireImageBuffer(OSVR_ImagingMetadata const &metadata,
+                                         OSVR_ChannelCount sensor) {
+        if (m_pendingFrames.size() <= sensor) {
+            m_pendingFrames.resize(sensor + 1);
+        }
+        auto &pending = m_pendingFrames[sensor];
+        /// Abandon anything previously acquired.
+        pending.shmEntry.reset();
+        pending.buffer.reset();
+        pending.metadata = metadata;
 
-        m_growShmVecIfRequired(sensor);
         uint32_t imageBufferSize = getBufferSize(metadata);
+#ifndef OSVR_COMMON_IN_PROCESS_IMAGING
+        /// Outside of lock-free mode, an entry being written holds the ring's
+        /// lock, which we can't keep while the device fills the buffer.
+        if (m_ensureShm(sensor, imageBufferSize) &&
+            m_shmBuf[sensor]->isLockFree()) {
+            pending.shmEntry.reset(new IPCRingBuffer::BufferWriteProxy(
+                m_shmBuf[sensor]->put()));
+            return pending.shmEntry->get();
+        }
+#endif
+        /// No shared memory we can write in place (by choice or by failure):
+        /// fall back to a buffer of our own.
+        pending.buffer = util::makeAlignedImageBuffer(imageBufferSize);
+        return pending.buffer.get();
+    }
+
+    bool ImagingComponent::commitImageBuffer(OSVR_ChannelCount sensor,
+                                             OSVR_TimeValue const &timestamp) {
+        if (m_pendingFrames.size() <= sensor) {
+            return false;
+        }
+        auto &pending = m_pendingFrames[sensor];
+        if (pending.buffer) {
+            /// Not using shared memory, so send the usual way.
+            sendImageData(pending.metadata, pending.buffer.get(), sensor,
+                          timestamp);
+            pending.buffer.reset();
+            return true;
+        }
+        if (!pending.shmEntry) {
+            return false;
+        }
+
+        /// We still own the entry, so we can read it for the network copy.
+        m_sendImageDataOnTheWire(pending.metadata, pending.shmEntry->get(),
+                                 sensor, timestamp);
+        auto seq = pending.shmEntry->getSequenceNumber();
+        /// Release the entry before telling anyone about it.
+        pending.shmEntry.reset();
+        m_sendSharedMemoryMessage(pending.metadata, seq, sensor, timestamp);
+        m_checkFirst(pending.metadata);
+        return true;
+    }
+
+    void ImagingComponent::releaseImageBuffer(OSVR_ChannelCount sensor) {
+        if (m_pendingFrames.size() <= sensor) {
+            return;
+        }
+        auto &pending = m_pendingFrames[sensor];
+        pending.shmEntry.reset();
+        pending.buffer.reset();
+    }
+
+    bool ImagingComponent::m_ensureShm(OSVR_ChannelCount sensor,
+                                       uint32_t imageBufferSize) {
+        m_growShmVecIfRequired(sensor);
         if (!m_shmBuf[sensor] ||
             m_shmBuf[sensor]->getEntrySize() != imageBufferSize) {
             // create or replace the shared memory ring buffer.
@@ -265,52 +450,277 @@ namespace common {
             m_shmBuf[sensor] = IPCRingBuffer::create(
                 IPCRingBuffer::Options(
                     makeName(sensor, m_getParent().getDeviceName()))
-                    .setEntrySize(imageBufferSize));
+                    .setEntrySize(imageBufferSize)
+                    .setLockFree(SHM_IMAGING_LOCK_FREE));
         }
         if (!m_shmBuf[sensor]) {
             OSVR_DEV_VERBOSE(
                 "Some issue creating shared memory for imaging, skipping out.");
             return false;
         }
-        auto &shm = *(m_shmBuf[sensor]);
-        auto seq = shm.put(imageData, imageBufferSize);
+        return true;
+    }
 
-        Buffer<> buf;
+    void ImagingComponent::m_sendSharedMemoryMessage(
+        OSVR_ImagingMetadata const &metadata, IPCRingBuffer::sequence_type seq,
+        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
+        auto &shm = *(m_shmBuf[sensor]);
+        auto &buf = m_getMessageBuffer();
         messages::ImagePlacedInSharedMemory::MessageSerialization serialization(
             messages::SharedMemoryMessage{metadata, seq, sensor,
-                                          IPCRingBuffer::getABILevel(),
+                                          shm.getInstanceABILevel(),
                                           shm.getBackend(), shm.getName()});
         serialize(buf, serialization);
         m_getParent().packMessage(
             buf, imagePlacedInSharedMemory.getMessageType(), timestamp);
+    }
+
+    bool ImagingComponent::m_sendImageDataViaSharedMemory(
+        OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
+        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
 
+        uint32_t imageBufferSize = getBufferSize(metadata);
+        if (!m_ensureShm(sensor, imageBufferSize)) {
+            return false;
+        }
+        auto seq = m_shmBuf[sensor]->put(imageData, imageBufferSize);
+        m_sendSharedMemoryMessage(metadata, seq, sensor, timestamp);
         return true;
     }
 
     bool ImagingComponent::m_sendImageDataOnTheWire(
         OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
         OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
+        /// Clients that asked for the stream ignore ImageRegion once it
+        /// arrives, but others (including older clients) still need it.
+        auto streamed =
+            m_sendImageStream(metadata, imageData, sensor, timestamp);
         /// @todo currently only handle 8bit data over network
         if (metadata.depth != 1) {
-            return false;
+            return streamed;
         }
-        Buffer<> buf;
         messages::ImageRegion::MessageSerialization msg(metadata, imageData,
                                                         sensor);
-        serialize(buf, msg);
-        if (buf.size() > vrpn_CONNECTION_TCP_BUFLEN) {
+        /// Check the size before copying the image into the buffer.
+        auto bytes = getBufferSpaceRequired(msg);
+        if (bytes > vrpn_CONNECTION_TCP_BUFLEN) {
 #if 0
             OSVR_DEV_VERBOSE("Skipping imaging message: size is "
-                             << buf.size() << " vs the maximum of "
+                             << bytes << " vs the maximum of "
                              << vrpn_CONNECTION_TCP_BUFLEN);
 #endif
-            return false;
+            return streamed;
         }
+        auto &buf = m_getMessageBuffer();
+        serialize(buf, msg);
         m_getParent().packMessage(buf, imageRegion.getMessageType(), timestamp);
         m_getParent().sendPending();
         return true;
     }
 
+    bool ImagingComponent::m_sendImageStream(
+        OSVR_ImagingMetadata const &metadata,
+        OSVR_ImageBufferElement const *imageData, OSVR_ChannelCount sensor,
+        OSVR_TimeValue const &timestamp) {
+        if (m_streamSenders.size() <= sensor) {
+            return false;
+        }
+        auto &streams = m_streamSenders[sensor];
+        /// Drop the streams of clients that stopped renewing their requests.
+        auto now = util::time::getNow();
+        streams.erase(std::remove_if(streams.begin(), streams.end(),
+                                     [&](StreamSendState const &stream) {
+                                         return util::time::duration(
+                                                    now, stream.lastRequest) >
+                                                STREAM_LEASE_SECONDS;
+                                     }),
+                      streams.end());
+        if (streams.empty()) {
+            return false;
+        }
+        for (auto &stream : streams) {
+            auto const &frame =
+                stream.encoder.encode(metadata, imageData, stream.settings);
+            m_sendImageStreamFrame(frame, sensor, stream.streamId, timestamp);
+        }
+        /// VRPN sends its outgoing buffer by itself whenever the next chunk
+        /// wouldn't fit, so flushing once per frame is enough.
+        m_getParent().sendPending();
+        return true;
+    }
+
+    void ImagingComponent::m_sendImageStreamFrame(
+        imagestream::Encoder::EncodedFrame const &frame,
+        OSVR_ChannelCount sensor, uint32_t streamId,
+        OSVR_TimeValue const &timestamp) {
+        /// Leave generous room for our header and VRPN's.
+        static const uint32_t MAX_CHUNK_BYTES =
+            vrpn_CONNECTION_TCP_BUFLEN - 256;
+
+        messages::ImageChunk::MessageSerialization::Header header;
+        header.metadata = frame.metadata;
+        header.encoding = frame.encoding;
+        header.frameId = frame.frameId;
+        header.baseFrameId = frame.baseFrameId;
+        header.totalBytes = static_cast<uint32_t>(frame.payload.size());
+        header.offset = 0;
+        do {
+            auto len = std::min(MAX_CHUNK_BYTES,
+                                header.totalBytes - header.offset);
+            auto &buf = m_getMessageBuffer();
+            messages::ImageChunk::MessageSerialization msg(
+                header, sensor, streamId, frame.payload.data() + header.offset,
+                len);
+            serialize(buf, msg);
+            m_getParent().packMessage(buf, imageChunk.getMessageType(),
+                                      timestamp);
+            header.offset += len;
+        } while (header.offset < header.totalBytes);
+    }
+
+    void ImagingComponent::requestImageStream(
+        OSVR_ChannelCount sensor, imagestream::StreamSettings const &settings) {
+        if (m_streamReceivers.size() <= sensor) {
+            m_streamReceivers.resize(sensor + 1);
+        }
+        auto &stream = m_streamReceivers[sensor];
+        stream.requested = true;
+        stream.settings = settings;
+        m_sendImageStreamRequest(sensor, settings, false);
+    }
+
+    void ImagingComponent::m_update() {
+        /// Client side: renew our stream requests before the server lets
+        /// them lapse.
+        auto now = util::time::getNow();
+        for (OSVR_ChannelCount sensor = 0; sensor < m_streamReceivers.size();
+             ++sensor) {
+            auto &stream = m_streamReceivers[sensor];
+            if (!stream.requested || stream.viaSharedMemory) {
+                continue;
+            }
+            if (util::time::duration(now, stream.lastRequestSent) >
+                STREAM_RENEW_SECONDS) {
+                m_sendImageStreamRequest(sensor, stream.settings, false);
+            }
+        }
+    }
+
+    void ImagingComponent::m_sendImageStreamRequest(
+        OSVR_ChannelCount sensor, imagestream::StreamSettings const &settings,
+        bool keyframeOnly) {
+        auto &buf = m_getMessageBuffer();
+        messages::ImageStreamRequest::MessageSerialization msg(
+            messages::StreamRequestMessage{sensor, m_streamId, settings,
+                                           keyframeOnly});
+        serialize(buf, msg);
+        m_getParent().packMessage(buf, imageStreamRequest.getMessageType());
+        if (!keyframeOnly && sensor < m_streamReceivers.size()) {
+            m_streamReceivers[sensor].lastRequestSent = util::time::getNow();
+        }
+    }
+
+    int VRPN_CALLBACK
+    ImagingComponent::m_handleImageStreamRequest(void *userdata,
+                                                 vrpn_HANDLERPARAM p) {
+        auto self = static_cast<ImagingComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+
+        messages::ImageStreamRequest::MessageSerialization msgSerialize;
+        deserialize(bufReader, msgSerialize);
+        auto &msg = msgSerialize.getMessage();
+        if (self->m_streamSenders.size() <= msg.sensor) {
+            self->m_streamSenders.resize(msg.sensor + 1);
+        }
+        auto &streams = self->m_streamSenders[msg.sensor];
+        auto it = std::find_if(streams.begin(), streams.end(),
+                               [&](StreamSendState const &stream) {
+                                   return stream.streamId == msg.streamId;
+                               });
+        if (it == streams.end()) {
+            if (msg.keyframeOnly) {
+                /// For a stream we've already dropped: the client will
+                /// renew it in full soon enough.
+                return 0;
+            }
+            OSVR_DEV_VERBOSE("Enabling network image stream for sensor "
+                             << msg.sensor << ", downscale "
+                             << int(msg.settings.downscale));
+            streams.emplace_back();
+            it = streams.end() - 1;
+            it->streamId = msg.streamId;
+            it->settings = msg.settings;
+        } else if (msg.keyframeOnly) {
+            it->encoder.requestKeyframe();
+            return 0;
+        } else if (!sameSettings(it->settings, msg.settings)) {
+            it->settings = msg.settings;
+            it->encoder.requestKeyframe();
+        }
+        /// A renewal with unchanged settings just extends the lease, without
+        /// forcing a key frame.
+        it->lastRequest = util::time::getNow();
+        return 0;
+    }
+
+    int VRPN_CALLBACK
+    ImagingComponent::m_handleImageChunk(void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<ImagingComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+
+        messages::ImageChunk::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        if (msg.getStreamId() != self->m_streamId) {
+            /// Another client's stream.
+            return 0;
+        }
+        auto sensor = msg.getSensor();
+        if (self->m_streamReceivers.size() <= sensor) {
+            self->m_streamReceivers.resize(sensor + 1);
+        }
+        auto &stream = self->m_streamReceivers[sensor];
+        if (stream.viaSharedMemory) {
+            /// Another client asked for the stream: we already get these
+            /// frames more cheaply.
+            return 0;
+        }
+        stream.receivingStream = true;
+        auto result = stream.decoder.addChunk(msg.getHeader(), msg.getData(),
+                                              msg.getLength());
+        switch (result) {
+        case imagestream::Decoder::Result::Incomplete:
+            break;
+        case imagestream::Decoder::Result::NeedKeyframe:
+            /// Ask once per broken frame, not once per chunk.
+            if (!stream.keyframeRequested ||
+                stream.keyframeRequestedAt != msg.getHeader().frameId) {
+                stream.keyframeRequested = true;
+                stream.keyframeRequestedAt = msg.getHeader().frameId;
+                self->m_sendImageStreamRequest(
+                    sensor, imagestream::StreamSettings(), true);
+            }
+            break;
+        case imagestream::Decoder::Result::Complete: {
+            stream.keyframeRequested = false;
+            auto const &frame = stream.decoder.getFrame();
+            auto copy = util::makeAlignedImageBuffer(frame.size());
+            std::copy(frame.begin(), frame.end(), copy.get());
+            ImageData data;
+            data.sensor = sensor;
+            data.metadata = stream.decoder.getMetadata();
+            data.buffer.reset(copy.release(), &util::alignedFree);
+            auto timestamp = util::time::fromStructTimeval(p.msg_time);
+
+            self->m_checkFirst(data.metadata);
+            for (auto const &cb : self->m_cb) {
+                cb(data, timestamp);
+            }
+            break;
+        }
+        }
+        return 0;
+    }
+
     int VRPN_CALLBACK
     ImagingComponent::m_handleImageRegion(void *userdata, vrpn_HANDLERPARAM p) {
         auto self = static_cast<ImagingComponent *>(userdata);
@@ -319,6 +729,11 @@ namespace common {
         messages::ImageRegion::MessageSerialization msg;
         deserialize(bufReader, msg);
         auto data = msg.getData();
+        if (data.sensor < self->m_streamReceivers.size() &&
+            self->m_streamReceivers[data.sensor].receivingStream) {
+            /// We get these frames from our stream instead.
+            return 0;
+        }
         auto timestamp = util::time::fromStructTimeval(p.msg_time);
 
         self->m_checkFirst(data.metadata);
@@ -363,7 +778,7 @@ namespace common {
         auto &msg = msgSerialize.getMessage();
         auto timestamp = util::time::fromStructTimeval(p.msg_time);
 
-        if (IPCRingBuffer::getABILevel() != msg.abiLevel) {
+        if (!IPCRingBuffer::isABILevelSupported(msg.abiLevel)) {
             /// Can't interoperate with this server over shared memory
             OSVR_DEV_VERBOSE("Can't handle SHM ABI level " << msg.abiLevel);
             return 0;
@@ -380,17 +795,26 @@ namespace common {
             self->m_shmBuf[msg.sensor] = IPCRingBuffer::find(
                 IPCRingBuffer::Options(msg.shmName, msg.backend));
         }
+        if (self->m_streamReceivers.size() <= msg.sensor) {
+            self->m_streamReceivers.resize(msg.sensor + 1);
+        }
+        auto &stream = self->m_streamReceivers[msg.sensor];
         if (!self->m_shmBuf[msg.sensor]) {
             /// Can't find the shared memory referred to - possibly not a local
             /// client
-            OSVR_DEV_VERBOSE("Can't find desired IPC ring buffer "
-                             << msg.shmName);
+            if (!stream.requested && !stream.viaSharedMemory) {
+                OSVR_DEV_VERBOSE("Can't find desired IPC ring buffer "
+                                 << msg.shmName
+                                 << ", requesting network image stream");
+                self->requestImageStream(msg.sensor);
+            }
             return 0;
         }
 
         auto &shm = self->m_shmBuf[msg.sensor];
         auto getResult = shm->get(msg.seqNum);
         if (getResult) {
+            stream.viaSharedMemory = true;
             auto bufptr = getResult.getBufferSmartPointer();
             self->m_checkFirst(msg.metadata);
             auto data = ImageData{msg.sensor, msg.metadata, bufptr};
@@ -411,6 +835,9 @@ namespace common {
                 &ImagingComponent::m_handleImagePlacedInSharedMemory, this,
                 imagePlacedInSharedMemory.getMessageType());
 
+            m_registerHandler(&ImagingComponent::m_handleImageChunk, this,
+                              imageChunk.getMessageType());
+
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
             m_registerHandler(
                 &ImagingComponent::m_handleImagePlacedInProcessMemory, this,
@@ -422,6 +849,10 @@ namespace common {
     void ImagingComponent::m_parentSet() {
         m_getParent().registerMessageType(imageRegion);
         m_getParent().registerMessageType(imagePlacedInSharedMemory);
+        m_getParent().registerMessageType(imageChunk);
+        m_getParent().registerMessageType(imageStreamRequest);
+        m_registerHandler(&ImagingComponent::m_handleImageStreamRequest, this,
+                          imageStreamRequest.getMessageType());
 #ifdef OSVR_COMMON_IN_PROCESS_IMAGING
         m_getParent().registerMessageType(imagePlacedInProcessMemory);
 #endif
@@ -78,7 +78,7 @@ namespace common {
                                           OSVR_ChannelCount sensor,
                                           OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        auto &buf = m_getMessageBuffer();
         messages::LocationRecord::MessageSerialization msg(location, sensor);
         serialize(buf, msg);
 
@@ -106,7 +106,7 @@ namespace common {
         OSVR_NaviVelocityState naviVelocityState, OSVR_ChannelCount sensor,
         OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        auto &buf = m_getMessageBuffer();
 
         messages::NaviVelocityRecord::MessageSerialization msg(
             naviVelocityState, sensor);
@@ -120,7 +120,7 @@ namespace common {
         OSVR_NaviPositionState naviPositionState, OSVR_ChannelCount sensor,
         OSVR_TimeValue const &timestamp) {
 
-        Buffer<> buf;
+        auto &buf = m_getMessageBuffer();
 
         messages::NaviPositionRecord::MessageSerialization msg(
             naviPositionState, sensor);
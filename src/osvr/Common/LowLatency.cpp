@@ -24,14 +24,89 @@
 
 // Internal Includes
 #include <osvr/Common/LowLatency.h>
+#include <osvr/Util/Log.h>
+#include <osvr/Util/Logger.h>
+#include <osvr/Util/PlatformConfig.h>
 
 #ifdef _WIN32
 #define NO_MINMAX
 #include <windows.h>
 #endif
 
+#ifdef OSVR_LINUX
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <unistd.h>
+#endif
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+
 namespace osvr {
 namespace common {
+    static util::log::Logger &getLowLatencyLogger() {
+        static util::log::LoggerPtr logger =
+            util::log::make_logger("LowLatency");
+        return *logger;
+    }
+
+    static const char *getSchedulerName(ThreadLatencyOptions::Scheduler s) {
+        switch (s) {
+        case ThreadLatencyOptions::Scheduler::Fifo:
+            return "SCHED_FIFO";
+        case ThreadLatencyOptions::Scheduler::RoundRobin:
+            return "SCHED_RR";
+        default:
+            break;
+        }
+        return "default scheduler";
+    }
+
+    static std::string describeCpus(std::vector<int> const &cpus) {
+        std::ostringstream os;
+        os << "CPU affinity {";
+        bool first = true;
+        for (auto cpu : cpus) {
+            os << (first ? "" : ", ") << cpu;
+            first = false;
+        }
+        os << "}";
+        return os.str();
+    }
+
+#ifndef OSVR_LINUX
+    static void reportUnsupported(LowLatencyOptions const &opts,
+                                  LowLatencyResult &result) {
+        if (opts.thread.scheduler != ThreadLatencyOptions::Scheduler::Default) {
+            result.failed.push_back(
+                std::string(getSchedulerName(opts.thread.scheduler)) +
+                ": not supported on this platform");
+        }
+        if (!opts.thread.cpus.empty()) {
+            result.failed.push_back(describeCpus(opts.thread.cpus) +
+                                    ": not supported on this platform");
+        }
+        if (opts.thread.minimizeTimerSlack) {
+            result.failed.push_back(
+                "minimal timer slack: not supported on this platform");
+        }
+        if (opts.lockMemory) {
+            result.failed.push_back(
+                "memory locking: not supported on this platform");
+        }
+    }
+#endif
 
 #ifdef _WIN32
 #define OSVR_HAVE_LOWLATENCY_CODE
@@ -39,34 +114,316 @@ namespace common {
     static const UINT TIMER_PERIOD = 1;
     struct LowLatency::Impl {
         bool beginSucceeded = false;
+        LowLatencyResult result;
     };
 
-/// @todo Unclear from docs whether a failed call to timeEndPeriod must also be
-/// matched
-/// https://msdn.microsoft.com/en-us/library/windows/desktop/dd757624(v=vs.85).aspx
-#if 0
-    LowLatency::LowLatency() : m_impl(new Impl) {
-        auto result = timeBeginPeriod(TIMER_PERIOD);
-        if (TIMERR_NOERROR == result) {
+    /// @todo Unclear from docs whether a failed call to timeEndPeriod must
+    /// also be matched
+    /// https://msdn.microsoft.com/en-us/library/windows/desktop/dd757624(v=vs.85).aspx
+    LowLatency::LowLatency(LowLatencyOptions const &opts) : m_impl(new Impl) {
+        if (TIMERR_NOERROR == timeBeginPeriod(TIMER_PERIOD)) {
             m_impl->beginSucceeded = true;
+            m_impl->result.applied.push_back("1ms timer period");
+        } else {
+            m_impl->result.failed.push_back("1ms timer period");
         }
+        reportUnsupported(opts, m_impl->result);
     }
-#endif
-
-    LowLatency::LowLatency() { timeBeginPeriod(TIMER_PERIOD); }
     LowLatency::~LowLatency() {
         /// Don't really care about the success of this call - nothing we can
         /// do.
         timeEndPeriod(TIMER_PERIOD);
     }
-#endif
+
+    LowLatencyResult
+    applyThreadLatencyOptions(ThreadLatencyOptions const &opts) {
+        LowLatencyOptions processOpts;
+        processOpts.thread = opts;
+        LowLatencyResult result;
+        reportUnsupported(processOpts, result);
+        return result;
+    }
+#endif // _WIN32
+
+#ifdef OSVR_LINUX
+#define OSVR_HAVE_LOWLATENCY_CODE
+    /// @brief Stack we touch when prefaulting, regardless of the requested
+    /// amount: the default thread stack is larger, but we don't know how much
+    /// is left of it.
+    static const std::size_t STACK_PREFAULT_BYTES = 64 * 1024;
+
+    /// @brief Timer slack, in nanoseconds, requested when minimizing it: 0 is
+    /// interpreted by the kernel as "reset to default" so 1 is the minimum.
+    static const unsigned long MINIMAL_TIMER_SLACK = 1;
+
+    static std::string describeError(int err) {
+        return std::strerror(err);
+    }
+
+    namespace {
+        /// @brief The state of a thread before we changed it, so we can put
+        /// it back.
+        struct SavedThreadState {
+            /// The thread we changed.
+            pthread_t thread;
+            bool schedChanged = false;
+            int policy = SCHED_OTHER;
+            sched_param param;
+            bool affinityChanged = false;
+            cpu_set_t affinity;
+            bool slackChanged = false;
+            unsigned long slack = 0;
+        };
+    } // namespace
+
+    /// @brief Applies the options to the calling thread, optionally recording
+    /// the previous state.
+    static void applyToThisThread(ThreadLatencyOptions const &opts,
+                                  LowLatencyResult &result,
+                                  SavedThreadState *saved) {
+        auto self = pthread_self();
+        if (saved) {
+            saved->thread = self;
+        }
+        if (opts.scheduler != ThreadLatencyOptions::Scheduler::Default) {
+            auto name = std::string(getSchedulerName(opts.scheduler));
+            int policy = opts.scheduler == ThreadLatencyOptions::Scheduler::Fifo
+                             ? SCHED_FIFO
+                             : SCHED_RR;
+            int oldPolicy;
+            sched_param oldParam;
+            int err = pthread_getschedparam(self, &oldPolicy, &oldParam);
+            if (0 == err) {
+                sched_param param = {};
+                param.sched_priority =
+                    std::min(std::max(opts.priority,
+                                      sched_get_priority_min(policy)),
+                             sched_get_priority_max(policy));
+                err = pthread_setschedparam(self, policy, &param);
+                name += " priority " + std::to_string(param.sched_priority);
+            }
+            if (0 == err) {
+                result.applied.push_back(name);
+                if (saved) {
+                    saved->schedChanged = true;
+                    saved->policy = oldPolicy;
+                    saved->param = oldParam;
+                }
+            } else {
+                result.failed.push_back(name + ": " + describeError(err));
+            }
+        }
+
+        if (!opts.cpus.empty()) {
+            auto name = describeCpus(opts.cpus);
+            cpu_set_t oldAffinity;
+            CPU_ZERO(&oldAffinity);
+            cpu_set_t affinity;
+            CPU_ZERO(&affinity);
+            bool valid = true;
+            for (auto cpu : opts.cpus) {
+                if (cpu < 0 || cpu >= CPU_SETSIZE) {
+                    valid = false;
+                    break;
+                }
+                CPU_SET(cpu, &affinity);
+            }
+            int err = valid ? pthread_getaffinity_np(self, sizeof(oldAffinity),
+                                                     &oldAffinity)
+                            : EINVAL;
+            if (0 == err) {
+                err = pthread_setaffinity_np(self, sizeof(affinity), &affinity);
+            }
+            if (0 == err) {
+                result.applied.push_back(name);
+                if (saved) {
+                    saved->affinityChanged = true;
+                    saved->affinity = oldAffinity;
+                }
+            } else {
+                result.failed.push_back(name + ": " + describeError(err));
+            }
+        }
+
+        if (opts.minimizeTimerSlack) {
+            auto name = std::string("minimal timer slack");
+            auto oldSlack = prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+            if (oldSlack >= 0 &&
+                0 == prctl(PR_SET_TIMERSLACK, MINIMAL_TIMER_SLACK, 0, 0, 0)) {
+                result.applied.push_back(name);
+                if (saved) {
+                    saved->slackChanged = true;
+                    saved->slack = static_cast<unsigned long>(oldSlack);
+                }
+            } else {
+                result.failed.push_back(name + ": " + describeError(errno));
+            }
+        }
+    }
+
+    /// @brief Puts back the state of the thread it was saved from, which
+    /// must still be running.
+    ///
+    /// Timer slack can only be set for the calling thread, so it's only
+    /// restored if that's the thread it was saved from.
+    static void restoreThread(SavedThreadState const &saved) {
+        /// Best effort: nothing useful to do if these fail.
+        if (saved.schedChanged) {
+            pthread_setschedparam(saved.thread, saved.policy, &saved.param);
+        }
+        if (saved.affinityChanged) {
+            pthread_setaffinity_np(saved.thread, sizeof(saved.affinity),
+                                   &saved.affinity);
+        }
+        if (saved.slackChanged && pthread_equal(saved.thread, pthread_self())) {
+            prctl(PR_SET_TIMERSLACK, saved.slack, 0, 0, 0);
+        }
+    }
+
+    /// @brief Touches a chunk of stack so its pages are resident (and, with
+    /// mlockall, stay so).
+    static void __attribute__((noinline)) prefaultStack() {
+        volatile unsigned char buf[STACK_PREFAULT_BYTES];
+        auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        for (std::size_t i = 0; i < STACK_PREFAULT_BYTES; i += pageSize) {
+            buf[i] = 0;
+        }
+        (void)buf;
+    }
+
+    /// @brief Touches the given number of bytes of heap, after telling malloc
+    /// never to give memory back to the system or to satisfy requests with
+    /// fresh mmap()s, so later allocations are served from these
+    /// already-resident pages.
+    ///
+    /// The malloc tuning is left in place for the life of the process.
+    static bool prefaultHeap(std::size_t bytes) {
+        if (!mallopt(M_TRIM_THRESHOLD, -1) || !mallopt(M_MMAP_MAX, 0)) {
+            return false;
+        }
+        auto buf = static_cast<char *>(std::malloc(bytes));
+        if (!buf) {
+            return false;
+        }
+        auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        for (std::size_t i = 0; i < bytes; i += pageSize) {
+            /// volatile write so the touch can't be optimized out.
+            *static_cast<char volatile *>(buf + i) = 0;
+        }
+        std::free(buf);
+        return true;
+    }
+
+    struct LowLatency::Impl {
+        SavedThreadState savedThread;
+        bool lockedMemory = false;
+        LowLatencyResult result;
+    };
+
+    LowLatency::LowLatency(LowLatencyOptions const &opts) : m_impl(new Impl) {
+        auto &result = m_impl->result;
+        applyToThisThread(opts.thread, result, &m_impl->savedThread);
+        if (opts.lockMemory) {
+            if (0 == mlockall(MCL_CURRENT | MCL_FUTURE)) {
+                m_impl->lockedMemory = true;
+                result.applied.push_back("memory locking");
+            } else {
+                result.failed.push_back("memory locking: " +
+                                        describeError(errno));
+            }
+        }
+        if (opts.lockMemory && opts.prefaultBytes > 0) {
+            /// The malloc tuning and the heap pages touched stay with the
+            /// process, so there's no point repeating this every time we
+            /// enter low-latency mode.
+            static std::mutex prefaultMutex;
+            static bool prefaulted = false;
+            std::lock_guard<std::mutex> lock(prefaultMutex);
+            if (!prefaulted) {
+                prefaulted = true;
+                auto name = "prefaulting " +
+                            std::to_string(opts.prefaultBytes) + " bytes";
+                prefaultStack();
+                if (prefaultHeap(opts.prefaultBytes)) {
+                    result.applied.push_back(name);
+                } else {
+                    result.failed.push_back(name);
+                }
+            }
+        }
+    }
+
+    LowLatency::~LowLatency() {
+        if (m_impl->lockedMemory) {
+            munlockall();
+        }
+        restoreThread(m_impl->savedThread);
+    }
+
+    LowLatencyResult
+    applyThreadLatencyOptions(ThreadLatencyOptions const &opts) {
+        LowLatencyResult result;
+        applyToThisThread(opts, result, nullptr);
+        return result;
+    }
+#endif // OSVR_LINUX
 
 #ifndef OSVR_HAVE_LOWLATENCY_CODE
     // Fallback no-op implementations
-    struct LowLatency::Impl {};
-    LowLatency::LowLatency() {}
+    struct LowLatency::Impl {
+        LowLatencyResult result;
+    };
+    LowLatency::LowLatency(LowLatencyOptions const &opts) : m_impl(new Impl) {
+        reportUnsupported(opts, m_impl->result);
+    }
     LowLatency::~LowLatency() {}
+    LowLatencyResult
+    applyThreadLatencyOptions(ThreadLatencyOptions const &opts) {
+        LowLatencyOptions processOpts;
+        processOpts.thread = opts;
+        LowLatencyResult result;
+        reportUnsupported(processOpts, result);
+        return result;
+    }
 #endif
 
+    LowLatency::LowLatency() : LowLatency(LowLatencyOptions{}) {}
+
+    LowLatencyResult const &LowLatency::getResult() const {
+        return m_impl->result;
+    }
+
+    static std::mutex &getDeviceThreadOptionsMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static ThreadLatencyOptions &getDeviceThreadOptions() {
+        static ThreadLatencyOptions opts;
+        return opts;
+    }
+
+    void setDeviceThreadLatencyOptions(ThreadLatencyOptions const &opts) {
+        std::lock_guard<std::mutex> lock(getDeviceThreadOptionsMutex());
+        getDeviceThreadOptions() = opts;
+    }
+
+    void applyDeviceThreadLatencyOptions() {
+        ThreadLatencyOptions opts;
+        {
+            std::lock_guard<std::mutex> lock(getDeviceThreadOptionsMutex());
+            opts = getDeviceThreadOptions();
+        }
+        auto result = applyThreadLatencyOptions(opts);
+        for (auto const &applied : result.applied) {
+            getLowLatencyLogger().debug() << "Device thread: applied "
+                                          << applied;
+        }
+        for (auto const &failed : result.failed) {
+            getLowLatencyLogger().warn() << "Device thread: could not apply "
+                                         << failed;
+        }
+    }
+
 } // namespace common
 } // namespace osvr
@@ -26,6 +26,8 @@
 #include <osvr/Common/PathTreeOwner.h>
 #include <osvr/Common/PathTreeObserver.h>
 #include <osvr/Common/PathTreeSerialization.h>
+#include <osvr/Common/PathElementTypes.h>
+#include <osvr/Common/PathNode.h>
 
 // Library/third-party includes
 // - none
@@ -72,21 +74,99 @@ namespace common {
     }
 
     void PathTreeOwner::replaceTree(Json::Value const &nodes) {
-        for_each_cleanup_pointers(
-            m_observers, [&](PathTreeObserver const &observer) {
-                observer.notifyEvent(PathTreeEvents::AboutToUpdate, m_tree);
-            });
+        m_wantFullTree = false;
+        m_requestedFullTree = false;
+        if (m_skipNextReplacement) {
+            m_skipNextReplacement = false;
+            return;
+        }
+        if (m_valid && !m_patched && nodes == m_lastNodes) {
+            /// Same tree as we already have.
+            if (m_pendingGeneration) {
+                m_generation = m_pendingGeneration;
+                m_pendingGeneration.reset();
+            }
+            return;
+        }
+        m_notify(PathTreeEvents::AboutToUpdate);
 
         m_tree.reset();
 
         common::jsonToPathTree(m_tree, nodes);
 
         m_valid = true;
+        m_lastNodes = nodes;
+        m_patched = false;
+        m_generation = m_pendingGeneration;
+        m_pendingGeneration.reset();
 
-        for_each_cleanup_pointers(
-            m_observers, [&](PathTreeObserver const &observer) {
-                observer.notifyEvent(PathTreeEvents::AfterUpdate, m_tree);
-            });
+        m_notify(PathTreeEvents::AfterUpdate);
+    }
+
+    void PathTreeOwner::confirmTree() {
+        m_wantFullTree = false;
+        m_requestedFullTree = false;
+        if (m_skipNextReplacement) {
+            m_skipNextReplacement = false;
+            return;
+        }
+        m_generation = m_pendingGeneration;
+        m_pendingGeneration.reset();
+    }
+
+    bool PathTreeOwner::applyTreeDelta(Json::Value const &delta) {
+        auto generation = delta["generation"].asUInt();
+        auto base = delta["base"].asUInt();
+        if (!m_valid || !m_generation || *m_generation != base) {
+            /// Can't patch: wait for the full tree, which follows right away
+            /// if this just announces its generation, and otherwise must be
+            /// asked for.
+            m_pendingGeneration = generation;
+            m_skipNextReplacement = false;
+            if (base != generation && !m_requestedFullTree) {
+                m_wantFullTree = true;
+            }
+            return false;
+        }
+        m_skipNextReplacement = true;
+        if (delta["set"].empty() && delta["remove"].empty()) {
+            /// Nothing to patch, we're just up to date already.
+            m_generation = generation;
+            m_pendingGeneration.reset();
+            return true;
+        }
+        m_notify(PathTreeEvents::AboutToPatch);
+
+        common::jsonToPathTree(m_tree, delta["set"]);
+        for (auto const &path : delta["remove"]) {
+            /// Nodes aren't removed from the tree: a null node is what a full
+            /// replacement would have left there (if anything).
+            m_tree.getNodeByPath(path.asString()).value() =
+                elements::NullElement();
+        }
+
+        m_generation = generation;
+        m_pendingGeneration.reset();
+        m_patched = true;
+
+        m_notify(PathTreeEvents::AfterPatch);
+        return true;
+    }
+
+    bool PathTreeOwner::takeFullTreeRequest() {
+        if (!m_wantFullTree) {
+            return false;
+        }
+        m_wantFullTree = false;
+        m_requestedFullTree = true;
+        return true;
+    }
+
+    void PathTreeOwner::m_notify(PathTreeEvents e) {
+        for_each_cleanup_pointers(m_observers,
+                                  [&](PathTreeObserver const &observer) {
+                                      observer.notifyEvent(e, m_tree);
+                                  });
     }
 } // namespace common
 } // namespace osvr
@@ -93,6 +93,28 @@ namespace common {
         const char *ReplacementTreeFromServer::identifier() {
             return "com.osvr.system.ReplacementTreeFromServer";
         }
+
+        class TreeDeltaFromServer::MessageSerialization {
+          public:
+            MessageSerialization(Json::Value const &msg = Json::objectValue)
+                : m_msg(msg) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_msg, serialization::JsonOnlyMessageTag());
+            }
+
+            Json::Value const &getValue() const { return m_msg; }
+
+          private:
+            Json::Value m_msg;
+        };
+        const char *TreeDeltaFromServer::identifier() {
+            return "com.osvr.system.TreeDeltaFromServer";
+        }
+
+        const char *TreeRequestToServer::identifier() {
+            return "com.osvr.system.TreeRequestToServer";
+        }
     } // namespace messages
 
     const char *SystemComponent::deviceName() {
@@ -107,7 +129,7 @@ namespace common {
     SystemComponent::SystemComponent() {}
 
     void SystemComponent::sendRoutes(std::string const &routes) {
-        Buffer<> buf;
+        auto &buf = m_getMessageBuffer();
         messages::RoutesFromServer::MessageSerialization msg(routes);
         serialize(buf, msg);
         m_getParent().packMessage(buf, routesOut.getMessageType());
@@ -119,7 +141,7 @@ namespace common {
     }
 
     void SystemComponent::sendClientRouteUpdate(std::string const &route) {
-        Buffer<> buf;
+        auto &buf = m_getMessageBuffer();
         messages::ClientRouteToServer::MessageSerialization msg(route);
         serialize(buf, msg);
         m_getParent().packMessage(buf, routeIn.getMessageType());
@@ -132,7 +154,12 @@ namespace common {
 
     void SystemComponent::sendReplacementTree(PathTree &tree) {
         auto config = pathTreeToJson(tree);
-        Buffer<> buf;
+        m_sendDelta(config, false);
+
+        /// Announce the generation of the full tree.
+        m_sendDelta(config, true);
+
+        auto &buf = m_getMessageBuffer();
         messages::ReplacementTreeFromServer::MessageSerialization msg(config);
         serialize(buf, msg);
         m_getParent().packMessage(buf, treeOut.getMessageType());
@@ -140,6 +167,45 @@ namespace common {
         m_getParent().sendPending(); // forcing this since it will cause
                                      // shuffling of remotes on the client.
     }
+
+    void SystemComponent::m_sendDelta(Json::Value const &config,
+                                      bool always) {
+        /// Diff against what we sent last time.
+        Json::Value delta(Json::objectValue);
+        auto &set = delta["set"] = Json::Value(Json::arrayValue);
+        auto &remove = delta["remove"] = Json::Value(Json::arrayValue);
+
+        std::map<std::string, Json::Value> nodes;
+        for (auto const &node : config) {
+            auto path = node["path"].asString();
+            auto it = m_sentNodes.find(path);
+            if (it == end(m_sentNodes) || !(it->second == node)) {
+                set.append(node);
+            }
+            nodes.emplace(std::move(path), node);
+        }
+        for (auto const &sent : m_sentNodes) {
+            if (nodes.find(sent.first) == end(nodes)) {
+                remove.append(sent.first);
+            }
+        }
+        auto changed = !set.empty() || !remove.empty();
+        if (!changed && !always) {
+            return;
+        }
+        m_sentNodes.swap(nodes);
+
+        delta["base"] = m_treeGeneration;
+        if (changed) {
+            ++m_treeGeneration;
+        }
+        delta["generation"] = m_treeGeneration;
+
+        auto &buf = m_getMessageBuffer();
+        messages::TreeDeltaFromServer::MessageSerialization msg(delta);
+        serialize(buf, msg);
+        m_getParent().packMessage(buf, treeDeltaOut.getMessageType());
+    }
     void SystemComponent::registerReplaceTreeHandler(JsonHandler cb) {
         if (m_replaceTreeHandlers.empty()) {
             m_registerHandler(&SystemComponent::m_handleReplaceTree, this,
@@ -148,11 +214,32 @@ namespace common {
         m_replaceTreeHandlers.push_back(cb);
     }
 
+    void SystemComponent::registerTreeDeltaHandler(JsonHandler cb) {
+        if (m_treeDeltaHandlers.empty()) {
+            m_registerHandler(&SystemComponent::m_handleTreeDelta, this,
+                              treeDeltaOut.getMessageType());
+        }
+        m_treeDeltaHandlers.push_back(cb);
+    }
+
+    void SystemComponent::sendTreeRequest() {
+        Buffer<> buf;
+        m_getParent().packMessage(buf, treeRequestIn.getMessageType());
+        m_getParent().sendPending();
+    }
+
+    void SystemComponent::registerTreeRequestHandler(
+        vrpn_MESSAGEHANDLER handler, void *userdata) {
+        m_registerHandler(handler, userdata, treeRequestIn.getMessageType());
+    }
+
     void SystemComponent::m_parentSet() {
         m_getParent().registerMessageType(routesOut);
         m_getParent().registerMessageType(appStartup);
         m_getParent().registerMessageType(routeIn);
         m_getParent().registerMessageType(treeOut);
+        m_getParent().registerMessageType(treeDeltaOut);
+        m_getParent().registerMessageType(treeRequestIn);
     }
 
     int SystemComponent::m_handleReplaceTree(void *userdata,
@@ -169,5 +256,21 @@ namespace common {
         }
         return 0;
     }
+
+    int SystemComponent::m_handleTreeDelta(void *userdata,
+                                           vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeDeltaFromServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+        if (!msg.getValue().isObject()) {
+            return 0;
+        }
+        for (auto const &cb : self->m_treeDeltaHandlers) {
+            cb(msg.getValue(), timestamp);
+        }
+        return 0;
+    }
 } // namespace common
 } // namespace osvr
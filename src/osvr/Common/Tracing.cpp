@@ -32,8 +32,25 @@
 #include <ETWProviders/etwprof.h>
 #endif
 
+#if OSVR_COMMON_TRACING_RING_BUFFER
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 // Standard includes
-// - none
+#if OSVR_COMMON_TRACING_RING_BUFFER
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#endif
 
 namespace osvr {
 namespace common {
@@ -57,6 +74,258 @@ namespace common {
         }
 
         void WorkerTracePolicy::mark(const char *text) { ETWWorkerMark(text); }
+
+        bool writeTraceFile(std::string const &) { return false; }
+#endif
+
+#if OSVR_COMMON_TRACING_RING_BUFFER
+        namespace {
+            /// @brief Number of events each thread keeps: older ones are
+            /// overwritten.
+            static const std::size_t EVENTS_PER_THREAD = 16384;
+            /// @brief Longest event name kept, including terminator: longer
+            /// ones (only possible from the concatenated marks) are
+            /// truncated.
+            static const std::size_t MAX_NAME_LENGTH = 64;
+
+            /// @brief Name of the environment variable specifying where to
+            /// write the trace at exit.
+            static const char TRACE_FILE_ENV[] = "OSVR_TRACE_FILE";
+
+            enum class EventType : char { Complete = 'X', Instant = 'i' };
+            enum class Category { Main, Worker };
+
+            inline std::int64_t nowInNanoseconds() {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now()
+                               .time_since_epoch())
+                    .count();
+            }
+
+            struct TraceEvent {
+                /// @brief Odd while being written, even when complete: a
+                /// per-slot seqlock so a flush never reads a torn event.
+                std::atomic<std::uint32_t> sequence;
+                EventType type;
+                Category category;
+                std::int64_t start;
+                std::int64_t duration;
+                char name[MAX_NAME_LENGTH];
+            };
+
+            /// @brief Copy of a TraceEvent taken when flushing.
+            struct EventSnapshot {
+                EventType type;
+                Category category;
+                std::int64_t start;
+                std::int64_t duration;
+                char name[MAX_NAME_LENGTH];
+            };
+
+            /// @brief Ring of events written only by its owning thread.
+            /// Recording is wait-free: the only synchronization with the
+            /// flushing thread is the per-slot sequence and the head index.
+            class ThreadEventRing {
+              public:
+                explicit ThreadEventRing(long tid) : m_tid(tid) {
+                    for (auto &ev : m_events) {
+                        ev.sequence.store(0, std::memory_order_relaxed);
+                    }
+                }
+
+                long getThreadId() const { return m_tid; }
+
+                void record(EventType type, Category category,
+                            const char *text, std::int64_t start,
+                            std::int64_t duration) {
+                    auto head = m_head.load(std::memory_order_relaxed);
+                    auto &ev = m_events[head % EVENTS_PER_THREAD];
+                    auto seq = ev.sequence.load(std::memory_order_relaxed);
+                    ev.sequence.store(seq + 1, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_release);
+                    ev.type = type;
+                    ev.category = category;
+                    ev.start = start;
+                    ev.duration = duration;
+                    std::strncpy(ev.name, text, MAX_NAME_LENGTH - 1);
+                    ev.name[MAX_NAME_LENGTH - 1] = '\0';
+                    ev.sequence.store(seq + 2, std::memory_order_release);
+                    m_head.store(head + 1, std::memory_order_release);
+                }
+
+                /// @brief Appends consistent copies of the events currently
+                /// in the ring, oldest first.
+                void snapshot(std::vector<EventSnapshot> &out) const {
+                    auto head = m_head.load(std::memory_order_acquire);
+                    auto begin =
+                        head > EVENTS_PER_THREAD ? head - EVENTS_PER_THREAD : 0;
+                    for (auto i = begin; i < head; ++i) {
+                        auto const &ev = m_events[i % EVENTS_PER_THREAD];
+                        auto seq = ev.sequence.load(std::memory_order_acquire);
+                        if (seq & 1) {
+                            /// Being overwritten right now.
+                            continue;
+                        }
+                        EventSnapshot copy;
+                        copy.type = ev.type;
+                        copy.category = ev.category;
+                        copy.start = ev.start;
+                        copy.duration = ev.duration;
+                        std::memcpy(copy.name, ev.name, MAX_NAME_LENGTH);
+                        std::atomic_thread_fence(std::memory_order_acquire);
+                        if (ev.sequence.load(std::memory_order_relaxed) !=
+                            seq) {
+                            /// Overwritten while we copied it.
+                            continue;
+                        }
+                        copy.name[MAX_NAME_LENGTH - 1] = '\0';
+                        out.push_back(copy);
+                    }
+                }
+
+              private:
+                long m_tid;
+                std::atomic<std::uint64_t> m_head{0};
+                std::array<TraceEvent, EVENTS_PER_THREAD> m_events;
+            };
+            using ThreadEventRingPtr = std::shared_ptr<ThreadEventRing>;
+
+            static void writeJsonString(std::ostream &os, const char *str) {
+                os << '"';
+                for (; *str; ++str) {
+                    auto c = *str;
+                    if (c == '"' || c == '\\') {
+                        os << '\\' << c;
+                    } else if (static_cast<unsigned char>(c) < 0x20) {
+                        char buf[8];
+                        std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                        os << buf;
+                    } else {
+                        os << c;
+                    }
+                }
+                os << '"';
+            }
+
+            /// @brief Owns the rings of all threads that have traced, even
+            /// after those threads exit, and writes them out at exit if
+            /// requested.
+            class TraceRegistry {
+              public:
+                ~TraceRegistry() {
+                    auto filename = std::getenv(TRACE_FILE_ENV);
+                    if (filename && *filename) {
+                        write(filename);
+                    }
+                }
+
+                ThreadEventRingPtr makeRing() {
+                    auto ring = std::make_shared<ThreadEventRing>(
+                        static_cast<long>(::syscall(SYS_gettid)));
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_rings.push_back(ring);
+                    return ring;
+                }
+
+                bool write(std::string const &filename) {
+                    std::vector<ThreadEventRingPtr> rings;
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        rings = m_rings;
+                    }
+                    std::ofstream os(filename);
+                    if (!os) {
+                        return false;
+                    }
+                    auto pid = static_cast<long>(::getpid());
+                    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+                    bool first = true;
+                    std::vector<EventSnapshot> events;
+                    for (auto const &ring : rings) {
+                        events.clear();
+                        ring->snapshot(events);
+                        for (auto const &ev : events) {
+                            os << (first ? "\n" : ",\n");
+                            first = false;
+                            os << "{\"name\":";
+                            writeJsonString(os, ev.name);
+                            os << ",\"cat\":\""
+                               << (ev.category == Category::Main ? "main"
+                                                                 : "worker")
+                               << "\",\"ph\":\"" << static_cast<char>(ev.type)
+                               << "\",\"ts\":" << ev.start / 1000 << '.'
+                               << ev.start / 100 % 10;
+                            if (ev.type == EventType::Complete) {
+                                os << ",\"dur\":" << ev.duration / 1000 << '.'
+                                   << ev.duration / 100 % 10;
+                            } else {
+                                os << ",\"s\":\"t\"";
+                            }
+                            os << ",\"pid\":" << pid
+                               << ",\"tid\":" << ring->getThreadId() << "}";
+                        }
+                    }
+                    os << "\n]}\n";
+                    return bool(os);
+                }
+
+              private:
+                std::mutex m_mutex;
+                std::vector<ThreadEventRingPtr> m_rings;
+            };
+
+            static TraceRegistry &getRegistry() {
+                static TraceRegistry registry;
+                return registry;
+            }
+
+            static ThreadEventRing &getThreadRing() {
+                /// The registry shares ownership, so events from threads that
+                /// have already exited still get written.
+                static thread_local ThreadEventRingPtr ring =
+                    getRegistry().makeRing();
+                return *ring;
+            }
+
+            inline void recordComplete(Category category, const char *text,
+                                       TraceBeginStamp stamp) {
+                getThreadRing().record(EventType::Complete, category, text,
+                                       stamp, nowInNanoseconds() - stamp);
+            }
+
+            inline void recordInstant(Category category, const char *text) {
+                getThreadRing().record(EventType::Instant, category, text,
+                                       nowInNanoseconds(), 0);
+            }
+        } // namespace
+
+        /// Regions are recorded as a single "complete" event when they end:
+        /// the stamp is just the start time.
+        TraceBeginStamp MainTracePolicy::begin(const char *) {
+            return nowInNanoseconds();
+        }
+        void MainTracePolicy::end(const char *text, TraceBeginStamp stamp) {
+            recordComplete(Category::Main, text, stamp);
+        }
+
+        void MainTracePolicy::mark(const char *text) {
+            recordInstant(Category::Main, text);
+        }
+
+        TraceBeginStamp WorkerTracePolicy::begin(const char *) {
+            return nowInNanoseconds();
+        }
+        void WorkerTracePolicy::end(const char *text, TraceBeginStamp stamp) {
+            recordComplete(Category::Worker, text, stamp);
+        }
+
+        void WorkerTracePolicy::mark(const char *text) {
+            recordInstant(Category::Worker, text);
+        }
+
+        bool writeTraceFile(std::string const &filename) {
+            return getRegistry().write(filename);
+        }
 #endif
     } // namespace tracing
 } // namespace common
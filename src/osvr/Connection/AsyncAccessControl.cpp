@@ -80,6 +80,11 @@ namespace connection {
             m_sharedRts = true;
             m_sharedDone = false;
             m_calledRequest = true;
+            if (m_control.m_requestNotifier) {
+                /// Now that the RTS is visible, make sure the main thread
+                /// comes around to see it.
+                m_control.m_requestNotifier();
+            }
             /// Take the main thread "free to go" status lock.
             {
                 m_lockDone.lock();
@@ -34,7 +34,7 @@
 #include <boost/optional/optional.hpp>
 
 // Standard includes
-// - none
+#include <functional>
 
 namespace osvr {
 namespace connection {
@@ -67,6 +67,13 @@ namespace connection {
         /// @returns true if there was a request to send.
         bool mainThreadDenyPermanently();
 
+        /// @brief Sets a function called by the async thread each time it
+        /// starts waiting for the main thread, to wake the main thread if
+        /// it's blocked. Set before the async thread starts.
+        void setRequestNotifier(std::function<void()> const &notifier) {
+            m_requestNotifier = notifier;
+        }
+
       private:
         /// @brief Messages/status that may be set by the main thread for read
         /// by
@@ -104,6 +111,8 @@ namespace connection {
 
         boost::optional<boost::thread::id> m_currentRequestThread;
 
+        std::function<void()> m_requestNotifier;
+
         /// @brief For the main thread sleep/wake awaiting completion of the
         /// async thread's work.
         boost::condition_variable m_condMainThread;
@@ -26,7 +26,9 @@
 
 // Internal Includes
 #include "AsyncDeviceToken.h"
+#include <osvr/Connection/Connection.h>
 #include <osvr/Connection/ConnectionDevice.h>
+#include <osvr/Common/LowLatency.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -40,8 +42,13 @@ namespace connection {
     using boost::unique_lock;
     using boost::mutex;
 
-    AsyncDeviceToken::AsyncDeviceToken(std::string const &name)
-        : OSVR_DeviceTokenObject(name) {}
+    AsyncDeviceToken::AsyncDeviceToken(std::string const &name,
+                                       bool queueReports)
+        : OSVR_DeviceTokenObject(name) {
+        if (queueReports) {
+            m_queue.reset(new AsyncReportQueue);
+        }
+    }
 
     AsyncDeviceToken::~AsyncDeviceToken() {
         OSVR_DEV_VERBOSE("AsyncDeviceToken\t"
@@ -77,6 +84,7 @@ namespace connection {
                 : m_cb(cb), m_run(&run) {}
             void operator()() {
                 OSVR_DEV_VERBOSE("WaitCallbackLoop starting");
+                common::applyDeviceThreadLatencyOptions();
                 ::util::LoopGuard guard(*m_run);
                 while (m_run->shouldContinue()) {
                     m_cb();
@@ -96,6 +104,9 @@ namespace connection {
     }
     void AsyncDeviceToken::m_ensureThreadStarted() {
         if ((!m_callbackThread) && m_cb) {
+            auto conn = m_getConnection().get();
+            m_accessControl.setRequestNotifier(
+                [conn] { conn->wakeProcessingThread(); });
             m_callbackThread.reset(
                 new boost::thread(WaitCallbackLoop(m_run, m_cb)));
             m_run.signalAndWaitForStart();
@@ -105,6 +116,13 @@ namespace connection {
     void AsyncDeviceToken::m_sendData(util::time::TimeValue const &timestamp,
                                       MessageType *type, const char *bytestream,
                                       size_t len) {
+        if (m_queue && m_queue->push(timestamp, type, bytestream, len)) {
+            OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
+                             "queued report");
+            m_getConnection()->wakeProcessingThread();
+            return;
+        }
+        /// Not queueing, or the report didn't fit: wait for the main thread.
         OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
                          "about to create RTS object");
         RequestToSend rts(m_accessControl);
@@ -118,28 +136,66 @@ namespace connection {
 
         OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
                          "Have CTS!");
+        /// The main thread is blocked until we're done, so we can stand in
+        /// as the queue's consumer, keeping earlier reports ahead of this one.
+        m_drainQueue();
         m_getConnectionDevice()->sendData(timestamp, type, bytestream, len);
         OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
                          "done!");
     }
 
+    bool AsyncDeviceToken::m_queueSend(QueuedSendFunction f, void *target,
+                                       util::time::TimeValue const &timestamp,
+                                       const char *payload, size_t len) {
+        if (m_queue && m_queue->pushCall(f, target, timestamp, payload, len)) {
+            OSVR_DEV_VERBOSE("AsyncDeviceToken::m_queueSend\t"
+                             "queued report");
+            m_getConnection()->wakeProcessingThread();
+            return true;
+        }
+        return false;
+    }
+
     class AsyncSendGuard : public util::GuardInterface {
       public:
-        AsyncSendGuard(AsyncAccessControl &control) : m_rts(control) {}
-        virtual bool lock() { return m_rts.request(); }
+        AsyncSendGuard(AsyncAccessControl &control,
+                       std::function<void()> const &onGranted)
+            : m_rts(control), m_onGranted(onGranted) {}
+        virtual bool lock() {
+            bool ret = m_rts.request();
+            if (ret) {
+                m_onGranted();
+            }
+            return ret;
+        }
         virtual ~AsyncSendGuard() {}
 
       private:
         RequestToSend m_rts;
+        std::function<void()> m_onGranted;
     };
 
     util::GuardPtr AsyncDeviceToken::m_getSendGuard() {
-        util::GuardPtr ret(new AsyncSendGuard(m_accessControl));
+        util::GuardPtr ret(
+            new AsyncSendGuard(m_accessControl, [&] { m_drainQueue(); }));
         return ret;
     }
 
+    void AsyncDeviceToken::m_drainQueue() {
+        if (!m_queue) {
+            return;
+        }
+        auto dev = m_getConnectionDevice();
+        m_queue->drain([&](util::time::TimeValue const &timestamp,
+                           MessageType *type, const char *bytestream,
+                           size_t len) {
+            dev->sendData(timestamp, type, bytestream, len);
+        });
+    }
+
     void AsyncDeviceToken::m_connectionInteract() {
         m_ensureThreadStarted();
+        m_drainQueue();
         OSVR_DEV_VERBOSE("AsyncDeviceToken::m_connectionInteract\t"
                          "Going to send a CTS if waiting");
         bool handled = m_accessControl.mainThreadCTS();
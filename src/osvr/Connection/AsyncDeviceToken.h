@@ -29,6 +29,7 @@
 #include <osvr/Connection/DeviceToken.h>
 #include <osvr/Util/CallbackWrapper.h>
 #include "AsyncAccessControl.h"
+#include "AsyncReportQueue.h"
 
 // Library/third-party includes
 #include <boost/thread.hpp>
@@ -41,7 +42,14 @@ namespace osvr {
 namespace connection {
     class AsyncDeviceToken : public OSVR_DeviceTokenObject {
       public:
-        AsyncDeviceToken(std::string const &name);
+        /// @brief Constructor
+        /// @param name Device name
+        /// @param queueReports If true, reports sent with sendData() are
+        /// placed in a lock-free queue that the main thread drains, instead
+        /// of blocking the device thread until the main thread grants
+        /// permission to send. So are interface reports sent with
+        /// queueSend(); send guards still use the blocking handshake.
+        AsyncDeviceToken(std::string const &name, bool queueReports = false);
         virtual ~AsyncDeviceToken();
 
         void signalShutdown();
@@ -58,6 +66,9 @@ namespace connection {
                         MessageType *type, const char *bytestream,
                         size_t len) override;
         util::GuardPtr m_getSendGuard() override;
+        bool m_queueSend(QueuedSendFunction f, void *target,
+                         util::time::TimeValue const &timestamp,
+                         const char *payload, size_t len) override;
 
         /// Called from the main thread - services requests to send from
         /// the async thread.
@@ -66,11 +77,18 @@ namespace connection {
         void m_stopThreads() override;
 
         void m_ensureThreadStarted();
+
+        /// @brief Called from the main thread - sends any queued reports.
+        void m_drainQueue();
+
         DeviceUpdateCallback m_cb;
         unique_ptr<boost::thread> m_callbackThread;
 
         AsyncAccessControl m_accessControl;
 
+        /// @brief Report queue, if in queued mode.
+        unique_ptr<AsyncReportQueue> m_queue;
+
         ::util::RunLoopManagerBoost m_run;
     };
 } // namespace connection
@@ -0,0 +1,144 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "AsyncReportQueue.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+
+namespace osvr {
+namespace connection {
+    /// The algorithm is Dmitry Vyukov's bounded queue: each slot carries a
+    /// sequence number saying whether it is ready for the producer holding
+    /// a given position (seq == pos) or for the consumer (seq == pos + 1).
+    struct AsyncReportQueue::Slot {
+        std::atomic<std::size_t> seq;
+        util::time::TimeValue timestamp;
+        /// @brief Non-null for a queued call rather than a report.
+        QueuedSendFunction call;
+        void *target;
+        MessageType *type;
+        std::size_t len;
+        char data[MAX_PAYLOAD];
+    };
+
+    const std::size_t AsyncReportQueue::MAX_PAYLOAD;
+    const std::size_t AsyncReportQueue::DEFAULT_CAPACITY;
+
+    static inline std::size_t roundUpToPowerOfTwo(std::size_t n) {
+        std::size_t ret = 2;
+        while (ret < n) {
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    AsyncReportQueue::AsyncReportQueue(std::size_t capacity)
+        : m_slots(new Slot[roundUpToPowerOfTwo(capacity)]),
+          m_mask(roundUpToPowerOfTwo(capacity) - 1), m_enqueuePos(0),
+          m_dequeuePos(0) {
+        for (std::size_t i = 0; i <= m_mask; ++i) {
+            m_slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    AsyncReportQueue::~AsyncReportQueue() {}
+
+    bool AsyncReportQueue::push(util::time::TimeValue const &timestamp,
+                                MessageType *type, const char *bytestream,
+                                std::size_t len) {
+        return m_push(nullptr, nullptr, timestamp, type, bytestream, len);
+    }
+
+    bool AsyncReportQueue::pushCall(QueuedSendFunction f, void *target,
+                                    util::time::TimeValue const &timestamp,
+                                    const char *payload, std::size_t len) {
+        return m_push(f, target, timestamp, nullptr, payload, len);
+    }
+
+    bool AsyncReportQueue::m_push(QueuedSendFunction f, void *target,
+                                  util::time::TimeValue const &timestamp,
+                                  MessageType *type, const char *bytestream,
+                                  std::size_t len) {
+        if (len > MAX_PAYLOAD) {
+            return false;
+        }
+        Slot *slot;
+        auto pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            slot = &m_slots[pos & m_mask];
+            auto seq = slot->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                /// Slot still holds a report from a lap ago: full.
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        slot->timestamp = timestamp;
+        slot->call = f;
+        slot->target = target;
+        slot->type = type;
+        slot->len = len;
+        if (len > 0) {
+            std::memcpy(slot->data, bytestream, len);
+        }
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t AsyncReportQueue::drain(ReportHandler const &handler) {
+        std::size_t n = 0;
+        for (; n <= m_mask; ++n) {
+            auto &slot = m_slots[m_dequeuePos & m_mask];
+            auto seq = slot.seq.load(std::memory_order_acquire);
+            if (seq != m_dequeuePos + 1) {
+                /// Empty, or the next producer hasn't finished writing yet.
+                break;
+            }
+            if (slot.call) {
+                slot.call(slot.target, slot.timestamp, slot.data, slot.len);
+            } else {
+                handler(slot.timestamp, slot.type, slot.data, slot.len);
+            }
+            slot.seq.store(m_dequeuePos + m_mask + 1,
+                           std::memory_order_release);
+            ++m_dequeuePos;
+        }
+        return n;
+    }
+
+} // namespace connection
+} // namespace osvr
@@ -0,0 +1,117 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AsyncReportQueue_h_GUID_8E3B5D27_4A1C_4F96_B0D2_7C9A61E4F358
+#define INCLUDED_AsyncReportQueue_h_GUID_8E3B5D27_4A1C_4F96_B0D2_7C9A61E4F358
+
+// Internal Includes
+#include <osvr/Connection/DeviceToken.h>
+#include <osvr/Connection/MessageTypePtr.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace osvr {
+namespace connection {
+    /// @brief Bounded, lock-free, multiple-producer single-consumer queue of
+    /// serialized reports, letting async device threads hand reports to the
+    /// main thread without waiting for it.
+    ///
+    /// A slot holds either a report for a MessageType, or a call to make in
+    /// place of sending one (see pushCall()). Each slot stores its payload
+    /// inline, so pushing and draining never allocate. Reports too large for
+    /// a slot, or pushed while the queue is full, are rejected: the caller is
+    /// expected to fall back to a blocking path.
+    class AsyncReportQueue : boost::noncopyable {
+      public:
+        /// @brief Largest payload (in bytes) that fits in a slot.
+        static const std::size_t MAX_PAYLOAD = MAX_QUEUED_SEND_PAYLOAD;
+
+        /// @brief Default number of slots.
+        static const std::size_t DEFAULT_CAPACITY = 256;
+
+        /// @brief Function called for each drained report.
+        typedef std::function<void(util::time::TimeValue const &,
+                                   MessageType *, const char *, std::size_t)>
+            ReportHandler;
+
+        /// @brief Constructor
+        /// @param capacity Number of slots: rounded up to a power of two.
+        explicit AsyncReportQueue(std::size_t capacity = DEFAULT_CAPACITY);
+        ~AsyncReportQueue();
+
+        /// @brief Try to enqueue a report. Safe to call from any number of
+        /// threads concurrently.
+        ///
+        /// @returns false if the report is too large or the queue is full.
+        bool push(util::time::TimeValue const &timestamp, MessageType *type,
+                  const char *bytestream, std::size_t len);
+
+        /// @brief Try to enqueue a call of f(target, timestamp, payload,
+        /// len), made by the consumer when draining, instead of passing a
+        /// report to the drain handler. Same rules as push().
+        bool pushCall(QueuedSendFunction f, void *target,
+                      util::time::TimeValue const &timestamp,
+                      const char *payload, std::size_t len);
+
+        /// @brief Pass queued reports, oldest first, to the handler (making
+        /// queued calls in turn). Only to be called from a single (consumer)
+        /// thread at a time.
+        ///
+        /// Stops after one queue's worth of reports, so busy producers can't
+        /// keep the consumer here forever.
+        ///
+        /// @returns the number of reports drained.
+        std::size_t drain(ReportHandler const &handler);
+
+        /// @brief Number of slots.
+        std::size_t capacity() const { return m_mask + 1; }
+
+      private:
+        bool m_push(QueuedSendFunction f, void *target,
+                    util::time::TimeValue const &timestamp, MessageType *type,
+                    const char *bytestream, std::size_t len);
+        struct Slot;
+        std::unique_ptr<Slot[]> m_slots;
+        std::size_t const m_mask;
+        /// @brief Producers' position.
+        std::atomic<std::size_t> m_enqueuePos;
+        /// @brief Keeps the producers' and consumer's positions off the same
+        /// cache line.
+        char m_padding[64];
+        /// @brief Consumer's position, only touched by the consumer.
+        std::size_t m_dequeuePos;
+    };
+
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_AsyncReportQueue_h_GUID_8E3B5D27_4A1C_4F96_B0D2_7C9A61E4F358
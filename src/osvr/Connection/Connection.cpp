@@ -162,6 +162,16 @@ namespace connection {
         }
     }
 
+    void Connection::setWakeupHandler(std::function<void()> handler) {
+        m_wakeupHandler = handler;
+    }
+
+    void Connection::wakeProcessingThread() {
+        if (m_wakeupHandler) {
+            m_wakeupHandler();
+        }
+    }
+
     Connection::Connection()
         : m_log(util::log::make_logger(util::log::OSVR_SERVER_LOG)) {}
 
@@ -78,6 +78,10 @@ void OSVR_DeviceInitObject::returnAnalogInterface(
     *m_analogIface = &iface;
 }
 
+void OSVR_DeviceInitObject::setAnalogDeltaEncoding(double quantum) {
+    m_analogDeltaQuantum = quantum > 0 ? quantum : 0.;
+}
+
 void OSVR_DeviceInitObject::setButtons(
     OSVR_ChannelCount num, osvr::connection::ButtonServerInterface **iface) {
     if (setOptional(num, iface, m_buttons)) {
@@ -54,6 +54,13 @@ OSVR_DeviceTokenObject::createAsyncDevice(DeviceInitObject &init) {
     return ret;
 }
 
+DeviceTokenPtr
+OSVR_DeviceTokenObject::createQueuedAsyncDevice(DeviceInitObject &init) {
+    DeviceTokenPtr ret(new AsyncDeviceToken(init.getQualifiedName(), true));
+    ret->m_sharedInit(init);
+    return ret;
+}
+
 DeviceTokenPtr
 OSVR_DeviceTokenObject::createSyncDevice(DeviceInitObject &init) {
     DeviceTokenPtr ret(new SyncDeviceToken(init.getQualifiedName()));
@@ -92,6 +99,20 @@ void OSVR_DeviceTokenObject::sendData(
 
 GuardPtr OSVR_DeviceTokenObject::getSendGuard() { return m_getSendGuard(); }
 
+bool OSVR_DeviceTokenObject::queueSend(
+    osvr::connection::QueuedSendFunction f, void *target,
+    osvr::util::time::TimeValue const &timestamp, const char *payload,
+    size_t len) {
+    return m_queueSend(f, target, timestamp, payload, len);
+}
+
+bool OSVR_DeviceTokenObject::m_queueSend(osvr::connection::QueuedSendFunction,
+                                         void *,
+                                         osvr::util::time::TimeValue const &,
+                                         const char *, size_t) {
+    return false;
+}
+
 void OSVR_DeviceTokenObject::setUpdateCallback(
     osvr::connection::DeviceUpdateCallback const &cb) {
     m_setUpdateCallback(cb);
@@ -27,13 +27,18 @@
 
 // Internal Includes
 #include "DeviceConstructionData.h"
+#include <osvr/Common/AnalogDeltaMessage.h>
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
 #include <osvr/Connection/AnalogServerInterface.h>
 
 // Library/third-party includes
 #include <vrpn_Analog.h>
+#include <vrpn_Connection.h>
 
 // Standard includes
 #include <cmath>
+#include <vector>
 
 namespace osvr {
 namespace connection {
@@ -48,12 +53,31 @@ namespace connection {
             memset(Base::channel, 0, sizeof(Base::channel));
             memset(Base::last, 0, sizeof(Base::last));
 
+            auto quantum = init.obj.getAnalogDeltaEncoding();
+            if (quantum) {
+                m_deltaEncoding = true;
+                m_quantum = *quantum;
+                m_delta_m_id = d_connection->register_message_type(
+                    common::messages::AnalogDelta::identifier());
+                // New clients need every channel, not just the changes.
+                register_autodeleted_handler(
+                    d_connection->register_message_type(vrpn_got_connection),
+                    &VrpnAnalogServer::handleGotConnection, this,
+                    vrpn_ANY_SENDER);
+                m_deltaEntries.reserve(m_getNumChannels());
+            }
+
             // Report interface out.
             init.obj.returnAnalogInterface(*this);
         }
 
         static const vrpn_uint32 CLASS_OF_SERVICE = vrpn_CONNECTION_LOW_LATENCY;
 
+        /// @brief With delta encoding, interval between messages carrying
+        /// every channel, so a client that missed a message (the class of
+        /// service is not reliable) catches up.
+        static double fullReportInterval() { return 1.0; }
+
         virtual bool setValue(value_type val, OSVR_ChannelCount chan,
                               util::time::TimeValue const &tv) {
             if (chan >= m_getNumChannels()) {
@@ -82,10 +106,75 @@ namespace connection {
             Base::num_channel = chans;
         }
         void m_reportChanges(util::time::TimeValue const &tv) {
+            if (m_deltaEncoding) {
+                m_sendDelta(tv);
+                return;
+            }
             struct timeval t;
             util::time::toStructTimeval(t, tv);
             Base::report_changes(CLASS_OF_SERVICE, t);
         }
+
+        static int VRPN_CALLBACK handleGotConnection(void *userdata,
+                                                     vrpn_HANDLERPARAM) {
+            static_cast<VrpnAnalogServer *>(userdata)->m_needFull = true;
+            return 0;
+        }
+
+        bool m_changed(OSVR_ChannelCount chan) const {
+            if (m_quantum > 0) {
+                return common::messages::AnalogDelta::quantize(
+                           Base::channel[chan], m_quantum) !=
+                       common::messages::AnalogDelta::quantize(Base::last[chan],
+                                                               m_quantum);
+            }
+            return Base::channel[chan] != Base::last[chan];
+        }
+
+        /// @brief Sends the channels changed since the last message (using
+        /// Base::last for the values last sent), or all of them if due.
+        void m_sendDelta(util::time::TimeValue const &tv) {
+            auto full = m_needFull ||
+                        util::time::duration(tv, m_lastFull) >=
+                            fullReportInterval();
+            m_deltaEntries.clear();
+            auto numChannels = m_getNumChannels();
+            for (OSVR_ChannelCount i = 0; i < numChannels; ++i) {
+                if (full || m_changed(i)) {
+                    m_deltaEntries.push_back(
+                        common::messages::AnalogDeltaEntry{
+                            static_cast<uint16_t>(i), Base::channel[i]});
+                    Base::last[i] = Base::channel[i];
+                }
+            }
+            if (m_deltaEntries.empty()) {
+                return;
+            }
+            auto &buf = m_deltaBuffer;
+            buf.clear();
+            common::messages::AnalogDelta::MessageSerialization msg(
+                full, static_cast<uint16_t>(numChannels), m_quantum,
+                m_deltaEntries.data(), m_deltaEntries.size());
+            common::serialize(buf, msg);
+            util::time::toStructTimeval(Base::timestamp, tv);
+            d_connection->pack_message(static_cast<vrpn_uint32>(buf.size()),
+                                       Base::timestamp, m_delta_m_id,
+                                       Base::d_sender_id, buf.data(),
+                                       CLASS_OF_SERVICE);
+            if (full) {
+                m_needFull = false;
+                m_lastFull = tv;
+            }
+        }
+
+        bool m_deltaEncoding = false;
+        double m_quantum = 0;
+        bool m_needFull = true;
+        util::time::TimeValue m_lastFull = {};
+        vrpn_int32 m_delta_m_id = -1;
+        /// Reused for each message, so sending doesn't allocate.
+        std::vector<common::messages::AnalogDeltaEntry> m_deltaEntries;
+        common::Buffer<> m_deltaBuffer;
     };
 
 } // namespace connection
@@ -27,6 +27,9 @@
 
 // Internal Includes
 #include "DeviceConstructionData.h"
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/TrackerBatchMessage.h>
 #include <osvr/Connection/TrackerServerInterface.h>
 #include <osvr/Util/QuatlibInteropC.h>
 
@@ -52,6 +55,9 @@ namespace connection {
             m_resetVel();
             m_resetAccel();
 
+            m_batch_m_id = d_connection->register_message_type(
+                common::messages::TrackerBatch::identifier());
+
             // Report interface out.
             init.obj.returnTrackerInterface(*this);
         }
@@ -135,6 +141,21 @@ namespace connection {
             m_sendAccel(sensor, tv);
         }
 
+        void sendBatchReport(OSVR_TrackerBatchEntry const *entries,
+                             std::size_t count,
+                             util::time::TimeValue const &tv) override {
+            auto &buf = m_batchBuffer;
+            buf.clear();
+            common::messages::TrackerBatch::MessageSerialization msg(entries,
+                                                                     count);
+            common::serialize(buf, msg);
+            util::time::toStructTimeval(Base::timestamp, tv);
+            d_connection->pack_message(static_cast<vrpn_uint32>(buf.size()),
+                                       Base::timestamp, m_batch_m_id,
+                                       Base::d_sender_id, buf.data(),
+                                       CLASS_OF_SERVICE);
+        }
+
       private:
         void m_resetVec3(vrpn_float64 vec[3]) {
             vec[0] = 0;
@@ -197,6 +218,10 @@ namespace connection {
                                        Base::d_sender_id, msgbuf,
                                        CLASS_OF_SERVICE);
         }
+
+        vrpn_int32 m_batch_m_id;
+        /// Reused for each batch, so sending doesn't allocate.
+        common::Buffer<> m_batchBuffer;
     };
 
 } // namespace connection
@@ -10,6 +10,7 @@ set(OSVR_REPORT_TYPES
     AngularAcceleration
     Button
     Analog
+    AnalogArray
     Imaging
     Location2D
     Direction
@@ -99,6 +99,13 @@ namespace pluginhost {
         }
     }
 
+    void PluginSpecificRegistrationContextImpl::appendHardwareDetectCalls(
+        std::vector<std::function<void()> > &calls) {
+        for (auto const &f : m_hardwareDetectCallbacks) {
+            calls.push_back([this, f] { f(this); });
+        }
+    }
+
     void PluginSpecificRegistrationContextImpl::instantiateDriver(
         const std::string &driverName, const std::string &params) const {
         auto it = m_driverInstantiationCallbacks.find(driverName);
@@ -85,6 +85,11 @@ namespace pluginhost {
         /// if any.
         void triggerHardwareDetectCallbacks();
 
+        /// @brief Add a call of each hardware detect callback registered by
+        /// this plugin, if any, to the list.
+        void
+        appendHardwareDetectCalls(std::vector<std::function<void()> > &calls);
+
         /// @brief Call a driver instantiation callback for the given driver
         /// name.
         /// @throws std::runtime_error if there is no driver registered by that
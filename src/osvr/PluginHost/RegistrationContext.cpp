@@ -221,6 +221,15 @@ namespace pluginhost {
         }
     }
 
+    std::vector<RegistrationContext::HardwareDetectCall>
+    RegistrationContext::getHardwareDetectCalls() {
+        std::vector<HardwareDetectCall> ret;
+        for (auto &pluginPtr : m_regMap | boost::adaptors::map_values) {
+            pluginPtr->appendHardwareDetectCalls(ret);
+        }
+        return ret;
+    }
+
     void
     RegistrationContext::instantiateDriver(const std::string &pluginName,
                                            const std::string &driverName,
@@ -31,12 +31,13 @@
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include <osvr/Util/PointerWrapper.h>
 #include "HandleNullContext.h"
+#include "UseSendGuard.h"
 
 // Library/third-party includes
 // - none
 
 // Standard includes
-// - none
+#include <algorithm>
 
 struct OSVR_AnalogDeviceInterfaceObject
     : public osvr::connection::DeviceInterfaceBase {
@@ -56,6 +57,43 @@ osvrDeviceAnalogConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
     return OSVR_RETURN_SUCCESS;
 }
 
+OSVR_ReturnCode osvrDeviceAnalogConfigureDeltaEncoding(
+    OSVR_INOUT_PTR OSVR_DeviceInitOptions opts, OSVR_IN double quantum) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceAnalogConfigureDeltaEncoding",
+                                    opts);
+    opts->setAnalogDeltaEncoding(quantum);
+    return OSVR_RETURN_SUCCESS;
+}
+
+/// @brief An analog report as queued for the server main thread.
+struct QueuedAnalogValue {
+    OSVR_AnalogState val;
+    OSVR_ChannelCount chan;
+};
+
+static void sendAnalogValue(osvr::connection::AnalogServerInterface &analog,
+                            QueuedAnalogValue const &report,
+                            osvr::util::time::TimeValue const &timestamp) {
+    analog.setValue(report.val, report.chan, timestamp);
+}
+
+/// @brief Reports of more channels than this (sized to fit a slot of the
+/// report queue) are sent under the send guard even in queued mode.
+static const OSVR_ChannelCount MAX_QUEUED_ANALOG_CHANNELS = 24;
+
+struct QueuedAnalogValues {
+    OSVR_ChannelCount chans;
+    OSVR_AnalogState val[MAX_QUEUED_ANALOG_CHANNELS];
+};
+
+static void sendAnalogValues(osvr::connection::AnalogServerInterface &analog,
+                             QueuedAnalogValues const &report,
+                             osvr::util::time::TimeValue const &timestamp) {
+    auto val = report.val;
+    analog.setValues(const_cast<OSVR_AnalogState *>(val), report.chans,
+                     timestamp);
+}
+
 OSVR_ReturnCode
 osvrDeviceAnalogSetValue(OSVR_IN_PTR OSVR_DeviceToken dev,
                          OSVR_IN_PTR OSVR_AnalogDeviceInterface iface,
@@ -75,6 +113,11 @@ OSVR_ReturnCode osvrDeviceAnalogSetValueTimestamped(
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceAnalogSetValueTimestamped",
                                     timestamp);
 
+    /// In queued mode, a bad channel goes unreported, as with setValues.
+    if (iface->queueSend(*iface->analog, QueuedAnalogValue{val, chan},
+                         *timestamp, &sendAnalogValue)) {
+        return OSVR_RETURN_SUCCESS;
+    }
     auto guard = iface->getSendGuard();
     if (guard->lock()) {
         bool sendResult = iface->analog->setValue(val, chan, *timestamp);
@@ -103,6 +146,15 @@ OSVR_ReturnCode osvrDeviceAnalogSetValuesTimestamped(
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceAnalogSetValuesTimestamped",
                                     timestamp);
 
+    if (chans <= MAX_QUEUED_ANALOG_CHANNELS) {
+        QueuedAnalogValues report;
+        report.chans = chans;
+        std::copy(val, val + chans, report.val);
+        if (iface->queueSend(*iface->analog, report, *timestamp,
+                             &sendAnalogValues)) {
+            return OSVR_RETURN_SUCCESS;
+        }
+    }
     auto guard = iface->getSendGuard();
     if (guard->lock()) {
         iface->analog->setValues(val, chans, *timestamp);
@@ -30,13 +30,14 @@
 #include <osvr/Connection/DeviceInterfaceBase.h>
 #include <osvr/PluginHost/PluginSpecificRegistrationContext.h>
 #include "HandleNullContext.h"
+#include "UseSendGuard.h"
 #include <osvr/Util/PointerWrapper.h>
 
 // Library/third-party includes
 // - none
 
 // Standard includes
-// - none
+#include <algorithm>
 
 struct OSVR_ButtonDeviceInterfaceObject : public osvr::connection::DeviceInterfaceBase {
     osvr::util::PointerWrapper<osvr::connection::ButtonServerInterface> button;
@@ -55,6 +56,35 @@ osvrDeviceButtonConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
     return OSVR_RETURN_SUCCESS;
 }
 
+/// @brief A button report as queued for the server main thread.
+struct QueuedButtonValue {
+    OSVR_ButtonState val;
+    OSVR_ChannelCount chan;
+};
+
+static void sendButtonValue(osvr::connection::ButtonServerInterface &button,
+                            QueuedButtonValue const &report,
+                            osvr::util::time::TimeValue const &timestamp) {
+    button.setValue(report.val, report.chan, timestamp);
+}
+
+/// @brief Reports of more channels than this (sized to fit a slot of the
+/// report queue) are sent under the send guard even in queued mode.
+static const OSVR_ChannelCount MAX_QUEUED_BUTTON_CHANNELS = 128;
+
+struct QueuedButtonValues {
+    OSVR_ChannelCount chans;
+    OSVR_ButtonState val[MAX_QUEUED_BUTTON_CHANNELS];
+};
+
+static void sendButtonValues(osvr::connection::ButtonServerInterface &button,
+                             QueuedButtonValues const &report,
+                             osvr::util::time::TimeValue const &timestamp) {
+    auto val = report.val;
+    button.setValues(const_cast<OSVR_ButtonState *>(val), report.chans,
+                     timestamp);
+}
+
 OSVR_ReturnCode osvrDeviceButtonSetValue(OSVR_IN_PTR OSVR_DeviceToken dev,
                                          OSVR_IN_PTR OSVR_ButtonDeviceInterface
                                          iface,
@@ -74,6 +104,11 @@ OSVR_ReturnCode osvrDeviceButtonSetValueTimestamped(
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceButtonSetValueTimestamped",
                                     timestamp);
 
+    /// In queued mode, a bad channel goes unreported, as with setValues.
+    if (iface->queueSend(*iface->button, QueuedButtonValue{val, chan},
+                         *timestamp, &sendButtonValue)) {
+        return OSVR_RETURN_SUCCESS;
+    }
     auto guard = iface->getSendGuard();
     if (guard->lock()) {
         bool sendResult = iface->button->setValue(val, chan, *timestamp);
@@ -102,6 +137,15 @@ OSVR_ReturnCode osvrDeviceButtonSetValuesTimestamped(
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceButtonSetValuesTimestamped",
                                     timestamp);
 
+    if (chans <= MAX_QUEUED_BUTTON_CHANNELS) {
+        QueuedButtonValues report;
+        report.chans = chans;
+        std::copy(val, val + chans, report.val);
+        if (iface->queueSend(*iface->button, report, *timestamp,
+                             &sendButtonValues)) {
+            return OSVR_RETURN_SUCCESS;
+        }
+    }
     auto guard = iface->getSendGuard();
     if (guard->lock()) {
         iface->button->setValues(val, chans, *timestamp);
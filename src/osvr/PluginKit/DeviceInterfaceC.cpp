@@ -210,6 +210,17 @@ osvrDeviceAsyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext,
                                  OSVR_DeviceTokenObject::createAsyncDevice);
 }
 
+OSVR_ReturnCode
+osvrDeviceQueuedAsyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext,
+                                     OSVR_IN_STRZ const char *name,
+                                     OSVR_IN_PTR OSVR_DeviceInitOptions options,
+                                     OSVR_OUT_PTR OSVR_DeviceToken *device) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceQueuedAsyncInitWithOptions",
+                                    options);
+    return osvrDeviceGenericInit(
+        options, name, device, OSVR_DeviceTokenObject::createQueuedAsyncDevice);
+}
+
 OSVR_ReturnCode osvrDeviceMicrosleep(OSVR_IN uint64_t microseconds) {
     boost::this_thread::sleep(boost::posix_time::microseconds(microseconds));
     return OSVR_RETURN_SUCCESS;
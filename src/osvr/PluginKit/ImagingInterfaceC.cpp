@@ -112,3 +112,43 @@ osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken,
 
     return OSVR_RETURN_FAILURE;
 }
+
+OSVR_ReturnCode osvrDeviceImagingAcquireFrameBuffer(
+    OSVR_IN_PTR OSVR_DeviceToken,
+    OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ImagingMetadata metadata, OSVR_IN OSVR_ChannelCount sensor,
+    OSVR_OUT_PTR OSVR_ImageBufferElement **buffer) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingAcquireFrameBuffer",
+                                    iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingAcquireFrameBuffer",
+                                    buffer);
+    *buffer = nullptr;
+    /// Only held while acquiring: the device fills the buffer without it.
+    auto guard = iface->getSendGuard();
+    if (!guard->lock()) {
+        return OSVR_RETURN_FAILURE;
+    }
+    *buffer = iface->imaging->acquireImageBuffer(metadata, sensor);
+    if (nullptr == *buffer) {
+        return OSVR_RETURN_FAILURE;
+    }
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode
+osvrDeviceImagingCommitFrame(OSVR_IN_PTR OSVR_DeviceToken,
+                             OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                             OSVR_IN OSVR_ChannelCount sensor,
+                             OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingCommitFrame", iface);
+    auto guard = iface->getSendGuard();
+    if (!guard->lock()) {
+        /// Don't keep holding the buffer (possibly a ring buffer entry).
+        iface->imaging->releaseImageBuffer(sensor);
+        return OSVR_RETURN_FAILURE;
+    }
+    if (iface->imaging->commitImageBuffer(sensor, *timestamp)) {
+        return OSVR_RETURN_SUCCESS;
+    }
+    return OSVR_RETURN_FAILURE;
+}
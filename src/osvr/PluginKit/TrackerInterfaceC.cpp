@@ -57,6 +57,33 @@ osvrDeviceTrackerConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
     return OSVR_RETURN_SUCCESS;
 }
 
+/// @brief A tracker report as queued for the server main thread.
+template <typename StateType> struct QueuedTrackerReport {
+    StateType val;
+    OSVR_ChannelCount sensor;
+};
+
+template <typename StateType>
+static void sendPose(osvr::connection::TrackerServerInterface &tracker,
+                     QueuedTrackerReport<StateType> const &report,
+                     osvr::util::time::TimeValue const &timestamp) {
+    tracker.sendReport(report.val, report.sensor, timestamp);
+}
+
+template <typename StateType>
+static void sendVel(osvr::connection::TrackerServerInterface &tracker,
+                    QueuedTrackerReport<StateType> const &report,
+                    osvr::util::time::TimeValue const &timestamp) {
+    tracker.sendVelReport(report.val, report.sensor, timestamp);
+}
+
+template <typename StateType>
+static void sendAccel(osvr::connection::TrackerServerInterface &tracker,
+                      QueuedTrackerReport<StateType> const &report,
+                      osvr::util::time::TimeValue const &timestamp) {
+    tracker.sendAccelReport(report.val, report.sensor, timestamp);
+}
+
 template <typename StateType>
 static inline OSVR_ReturnCode
 osvrTrackerSend(const char method[], OSVR_DeviceToken,
@@ -64,8 +91,9 @@ osvrTrackerSend(const char method[], OSVR_DeviceToken,
                 OSVR_ChannelCount sensor, OSVR_TimeValue const *timestamp) {
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, iface);
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, timestamp);
-    return useSendGuardVoid(
-        iface, [&]() { iface->tracker->sendReport(*val, sensor, *timestamp); });
+    return queueOrUseSendGuard(iface, *iface->tracker,
+                               QueuedTrackerReport<StateType>{*val, sensor},
+                               *timestamp, &sendPose<StateType>);
 }
 
 template <typename StateType>
@@ -75,9 +103,9 @@ osvrTrackerSendVel(const char method[], OSVR_DeviceToken,
                    OSVR_ChannelCount sensor, OSVR_TimeValue const *timestamp) {
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, iface);
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, timestamp);
-    return useSendGuardVoid(iface, [&]() {
-        iface->tracker->sendVelReport(*val, sensor, *timestamp);
-    });
+    return queueOrUseSendGuard(iface, *iface->tracker,
+                               QueuedTrackerReport<StateType>{*val, sensor},
+                               *timestamp, &sendVel<StateType>);
 }
 
 template <typename StateType>
@@ -88,10 +116,9 @@ osvrTrackerSendAccel(const char method[], OSVR_DeviceToken,
                      OSVR_TimeValue const *timestamp) {
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, iface);
     OSVR_PLUGIN_HANDLE_NULL_CONTEXT(method, timestamp);
-
-    return useSendGuardVoid(iface, [&]() {
-        iface->tracker->sendAccelReport(*val, sensor, *timestamp);
-    });
+    return queueOrUseSendGuard(iface, *iface->tracker,
+                               QueuedTrackerReport<StateType>{*val, sensor},
+                               *timestamp, &sendAccel<StateType>);
 }
 
 OSVR_ReturnCode
@@ -217,3 +244,23 @@ OSVR_ReturnCode osvrDeviceTrackerSendAngularAccelerationTimestamped(
         "osvrDeviceTrackerSendAngularAccelerationTimestamped", dev, iface, val,
         sensor, timestamp);
 }
+
+OSVR_ReturnCode osvrDeviceTrackerSendBatchTimestamped(
+    OSVR_IN_PTR OSVR_DeviceToken,
+    OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN_READS(count) OSVR_TrackerBatchEntry const *entries,
+    OSVR_IN OSVR_ChannelCount count,
+    OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendBatchTimestamped",
+                                    iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendBatchTimestamped",
+                                    timestamp);
+    if (count == 0) {
+        return OSVR_RETURN_SUCCESS;
+    }
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendBatchTimestamped",
+                                    entries);
+    return useSendGuardVoid(iface, [&]() {
+        iface->tracker->sendBatchReport(entries, count, *timestamp);
+    });
+}
@@ -26,6 +26,7 @@
 #define INCLUDED_UseSendGuard_h_GUID_FEAB5647_E86B_4BA2_0A29_CB5665678CCB
 
 // Internal Includes
+#include <osvr/Util/TimeValue.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -62,4 +63,21 @@ inline OSVR_ReturnCode useSendGuardVoid(InterfaceType &iface, F &&func) {
         return OSVR_RETURN_SUCCESS;
     });
 }
+
+/// Sends an interface report: in queued async mode, handed to the server main
+/// thread without waiting, otherwise (or if it can't be queued) sent right
+/// here under the send guard. Either way, send(target, report, timestamp) does
+/// the sending.
+template <typename InterfaceType, typename Target, typename Report>
+inline OSVR_ReturnCode
+queueOrUseSendGuard(InterfaceType &iface, Target &target, Report const &report,
+                    OSVR_TimeValue const &timestamp,
+                    void (*send)(Target &, Report const &,
+                                 osvr::util::time::TimeValue const &)) {
+    if (iface->queueSend(target, report, timestamp, send)) {
+        return OSVR_RETURN_SUCCESS;
+    }
+    return useSendGuardVoid(iface,
+                            [&]() { send(target, report, timestamp); });
+}
 #endif // INCLUDED_UseSendGuard_h_GUID_FEAB5647_E86B_4BA2_0A29_CB5665678CCB
@@ -26,7 +26,9 @@
 #include <osvr/Server/ConfigureServer.h>
 #include <osvr/Server/Server.h>
 #include <osvr/Connection/Connection.h>
+#include <osvr/Common/LowLatencyJSON.h>
 #include <osvr/PluginHost/SearchPath.h>
+#include <osvr/Util/Log.h>
 #include <osvr/Util/Verbosity.h>
 #include "JSONResolvePossibleRef.h"
 
@@ -121,6 +123,9 @@ namespace server {
     static const char LOCAL_KEY[] = "local";
     static const char PORT_KEY[] = "port"; // not the triwizard cup.
     static const char SLEEP_KEY[] = "sleep";
+    static const char EVENT_DRIVEN_KEY[] = "eventDriven";
+    static const char LOW_LATENCY_KEY[] = "lowLatency";
+    static const char ASYNC_LOGGING_KEY[] = "asyncLogging";
 
     ServerPtr ConfigureServer::constructServer() {
         Json::Value const &root(m_data->root);
@@ -132,6 +137,8 @@ namespace server {
 #else
         int sleepTime = 1000; // microseconds
 #endif
+        bool eventDriven = false;
+        common::LowLatencyOptions lowLatency;
 
         /// Extract data from the JSON structure.
         if (root.isMember(SERVER_KEY)) {
@@ -163,6 +170,24 @@ namespace server {
                 // Convert to microseconds for internal use.
                 sleepTime = static_cast<int>(jsonSleepTime.asDouble() * 1000.0);
             }
+
+            Json::Value jsonEventDriven = jsonServer[EVENT_DRIVEN_KEY];
+            if (jsonEventDriven.isBool()) {
+                eventDriven = jsonEventDriven.asBool();
+            }
+
+            Json::Value const &jsonAsyncLogging = jsonServer[ASYNC_LOGGING_KEY];
+            if (jsonAsyncLogging.isBool()) {
+                util::log::setAsyncLogging(jsonAsyncLogging.asBool());
+            }
+
+            Json::Value const &jsonLowLatency = jsonServer[LOW_LATENCY_KEY];
+            if (jsonLowLatency.isObject()) {
+                common::ThreadLatencyOptions deviceThreads;
+                lowLatency = common::parseLowLatencyOptions(jsonLowLatency,
+                                                            deviceThreads);
+                common::setDeviceThreadLatencyOptions(deviceThreads);
+            }
         }
 
         /// Construct a server, or a connection then a server, based on the
@@ -182,8 +207,11 @@ namespace server {
         if (sleepTime > 0.0) {
             m_server->setSleepTime(sleepTime);
         }
+        m_server->setEventDriven(eventDriven);
+        m_server->setLowLatencyOptions(lowLatency);
 
         m_server->setHardwareDetectOnConnection();
+        m_server->setHardwareDetectOnHotplug();
 
         return m_server;
     }
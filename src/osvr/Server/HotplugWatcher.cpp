@@ -0,0 +1,159 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "HotplugWatcher.h"
+
+// Library/third-party includes
+#ifdef OSVR_HOTPLUG_WATCHER_INOTIFY
+#include <dirent.h>
+#include <limits.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// Standard includes
+#include <cstring>
+#include <string>
+
+namespace osvr {
+namespace server {
+#ifdef OSVR_HOTPLUG_WATCHER_INOTIFY
+    namespace {
+        /// @brief How long device nodes must stay unchanged before we report
+        /// a hotplug.
+        static const std::chrono::milliseconds SETTLE_TIME(250);
+
+        static const char DEV_DIR[] = "/dev";
+        static const char USB_BUS_DIR[] = "/dev/bus/usb";
+
+        /// @brief Node name prefixes in /dev that hardware detection cares
+        /// about. Only the USB serial ttys: virtual consoles and built-in
+        /// serial ports don't come and go, but have their attributes changed
+        /// (by logins, for instance).
+        static const char *const DEV_PREFIXES[] = {"hidraw", "ttyACM",
+                                                   "ttyUSB", "video"};
+
+        static const uint32_t WATCH_EVENTS = IN_CREATE | IN_ATTRIB | IN_MOVED_TO;
+
+        inline bool isInterestingDevNode(const char *name) {
+            for (auto prefix : DEV_PREFIXES) {
+                if (0 == std::strncmp(name, prefix, std::strlen(prefix))) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    } // namespace
+
+    HotplugWatcher::HotplugWatcher() : HotplugWatcher(DEV_DIR, USB_BUS_DIR) {}
+
+    HotplugWatcher::HotplugWatcher(std::string const &devDir,
+                                   std::string const &usbBusDir)
+        : m_fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)),
+          m_buf(sizeof(inotify_event) + NAME_MAX + 1) {
+        if (m_fd < 0) {
+            return;
+        }
+        m_devWatch = inotify_add_watch(m_fd, devDir.c_str(), WATCH_EVENTS);
+        if (m_devWatch < 0) {
+            close(m_fd);
+            m_fd = -1;
+            return;
+        }
+        /// USB buses don't come and go, so watching the ones present now is
+        /// enough.
+        if (DIR *dir = opendir(usbBusDir.c_str())) {
+            while (dirent *entry = readdir(dir)) {
+                if (entry->d_name[0] == '.') {
+                    continue;
+                }
+                auto path = usbBusDir + "/" + entry->d_name;
+                inotify_add_watch(m_fd, path.c_str(), WATCH_EVENTS);
+            }
+            closedir(dir);
+        }
+    }
+
+    HotplugWatcher::~HotplugWatcher() {
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+    }
+
+    bool HotplugWatcher::isWatching() const { return m_fd >= 0; }
+
+    bool HotplugWatcher::checkForHotplug() {
+        if (m_fd < 0) {
+            return false;
+        }
+        m_drainEvents();
+        if (m_pending &&
+            std::chrono::steady_clock::now() - m_lastEvent >= SETTLE_TIME) {
+            m_pending = false;
+            return true;
+        }
+        return false;
+    }
+
+    void HotplugWatcher::m_drainEvents() {
+        ssize_t len;
+        while ((len = read(m_fd, m_buf.data(), m_buf.size())) > 0) {
+            const char *cur = m_buf.data();
+            const char *end = cur + len;
+            while (cur < end) {
+                inotify_event ev;
+                std::memcpy(&ev, cur, sizeof(ev));
+                const char *name = cur + sizeof(inotify_event);
+                cur += sizeof(inotify_event) + ev.len;
+                if (ev.mask & IN_Q_OVERFLOW) {
+                    /// Lost events: assume the worst.
+                } else if (ev.wd == m_devWatch &&
+                           (ev.len == 0 || !isInterestingDevNode(name))) {
+                    continue;
+                }
+                m_pending = true;
+                m_lastEvent = std::chrono::steady_clock::now();
+            }
+        }
+    }
+
+#else // !OSVR_HOTPLUG_WATCHER_INOTIFY
+
+    HotplugWatcher::HotplugWatcher() {}
+
+    HotplugWatcher::HotplugWatcher(std::string const &,
+                                   std::string const &) {}
+
+    HotplugWatcher::~HotplugWatcher() {}
+
+    bool HotplugWatcher::isWatching() const { return false; }
+
+    bool HotplugWatcher::checkForHotplug() { return false; }
+
+#endif // OSVR_HOTPLUG_WATCHER_INOTIFY
+
+} // namespace server
+} // namespace osvr
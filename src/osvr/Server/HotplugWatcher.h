@@ -0,0 +1,94 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_HotplugWatcher_h_GUID_8E3F6A20_B71C_4D95_A2E4_05C9D81F3B67
+#define INCLUDED_HotplugWatcher_h_GUID_8E3F6A20_B71C_4D95_A2E4_05C9D81F3B67
+
+// Internal Includes
+#include <osvr/Util/PlatformConfig.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <chrono>
+#include <string>
+#include <vector>
+
+#if defined(OSVR_LINUX) && !defined(OSVR_ANDROID)
+#define OSVR_HOTPLUG_WATCHER_INOTIFY
+#endif
+
+namespace osvr {
+namespace server {
+
+    /// @brief Notices devices being plugged in, so hardware detection can run
+    /// only when there might be something new to detect.
+    ///
+    /// On Linux, this uses inotify on /dev (for hidraw, USB serial and video
+    /// nodes) and on the /dev/bus/usb bus directories (for devices accessed
+    /// through libusb). Elsewhere, isWatching() is false and checkForHotplug()
+    /// never reports anything.
+    class HotplugWatcher : boost::noncopyable {
+      public:
+        /// @brief Watches /dev and /dev/bus/usb.
+        HotplugWatcher();
+
+        /// @brief Watches the given directories in place of /dev and
+        /// /dev/bus/usb: for testing.
+        HotplugWatcher(std::string const &devDir,
+                       std::string const &usbBusDir);
+
+        ~HotplugWatcher();
+
+        /// @brief Whether hotplug events are actually being watched.
+        bool isWatching() const;
+
+        /// @brief Non-blocking check, to be called periodically from one
+        /// thread.
+        ///
+        /// @return true once after devices have been added and the device
+        /// nodes have stopped changing (since udev creates a node, then
+        /// adjusts its permissions, and one device often has several nodes).
+        bool checkForHotplug();
+
+      private:
+#ifdef OSVR_HOTPLUG_WATCHER_INOTIFY
+        void m_drainEvents();
+        int m_fd = -1;
+        /// @brief Watch descriptor for /dev itself, whose events are
+        /// filtered by node name: all other watches are on USB bus
+        /// directories.
+        int m_devWatch = -1;
+        bool m_pending = false;
+        std::chrono::steady_clock::time_point m_lastEvent;
+        std::vector<char> m_buf;
+#endif
+    };
+
+} // namespace server
+} // namespace osvr
+
+#endif // INCLUDED_HotplugWatcher_h_GUID_8E3F6A20_B71C_4D95_A2E4_05C9D81F3B67
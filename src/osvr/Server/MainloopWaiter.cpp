@@ -0,0 +1,197 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MainloopWaiter.h"
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+#ifdef OSVR_MAINLOOP_WAITER_EPOLL
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+// Standard includes
+#include <cerrno>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace osvr {
+namespace server {
+#ifdef OSVR_MAINLOOP_WAITER_EPOLL
+    namespace {
+        /// @brief Maximum number of events fetched per epoll_wait: we don't
+        /// dispatch on them, so a handful is plenty.
+        static const int MAX_EVENTS = 8;
+
+        /// @brief Gets the local port of a socket, or -1 if it isn't an
+        /// IP socket.
+        inline int getLocalPort(int fd) {
+            sockaddr_storage addr;
+            socklen_t len = sizeof(addr);
+            if (0 != getsockname(fd, reinterpret_cast<sockaddr *>(&addr),
+                                 &len)) {
+                return -1;
+            }
+            switch (addr.ss_family) {
+            case AF_INET:
+                return ntohs(reinterpret_cast<sockaddr_in *>(&addr)->sin_port);
+            case AF_INET6:
+                return ntohs(
+                    reinterpret_cast<sockaddr_in6 *>(&addr)->sin6_port);
+            default:
+                return -1;
+            }
+        }
+    } // namespace
+
+    MainloopWaiter::MainloopWaiter()
+        : m_epoll(epoll_create1(EPOLL_CLOEXEC)),
+          m_event(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+          m_timer(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)) {
+        if (m_epoll < 0 || m_event < 0 || m_timer < 0) {
+            m_close();
+            throw std::runtime_error(
+                "Could not create the server mainloop wait handles");
+        }
+        m_add(m_event);
+        m_add(m_timer);
+    }
+
+    MainloopWaiter::~MainloopWaiter() { m_close(); }
+
+    bool MainloopWaiter::canWatchSockets() { return true; }
+
+    void MainloopWaiter::wake() {
+        uint64_t one = 1;
+        /// Can only fail if the counter would overflow, in which case a wake
+        /// is already pending anyway.
+        auto ret = ::write(m_event, &one, sizeof(one));
+        (void)ret;
+    }
+
+    void MainloopWaiter::wait(int microseconds) {
+        int timeoutMs = 0;
+        if (microseconds > 0) {
+            itimerspec spec = {};
+            spec.it_value.tv_sec = microseconds / 1000000;
+            spec.it_value.tv_nsec = (microseconds % 1000000) * 1000;
+            timerfd_settime(m_timer, 0, &spec, nullptr);
+            timeoutMs = -1;
+        }
+        epoll_event events[MAX_EVENTS];
+        int n;
+        do {
+            n = epoll_wait(m_epoll, events, MAX_EVENTS, timeoutMs);
+        } while (n < 0 && errno == EINTR);
+
+        /// Reset the level-triggered wake and timer handles: sockets are
+        /// drained by the connection itself.
+        uint64_t count;
+        auto ret = ::read(m_event, &count, sizeof(count));
+        ret = ::read(m_timer, &count, sizeof(count));
+        (void)ret;
+        if (microseconds > 0) {
+            itimerspec disarm = {};
+            timerfd_settime(m_timer, 0, &disarm, nullptr);
+        }
+    }
+
+    void MainloopWaiter::watchLocalSockets(int port) {
+        DIR *dir = opendir("/proc/self/fd");
+        if (!dir) {
+            return;
+        }
+        while (dirent *entry = readdir(dir)) {
+            char *end = nullptr;
+            long fd = std::strtol(entry->d_name, &end, 10);
+            if (end == entry->d_name || *end != '\0' || fd == dirfd(dir)) {
+                continue;
+            }
+            struct stat info;
+            if (0 != fstat(int(fd), &info) || !S_ISSOCK(info.st_mode)) {
+                continue;
+            }
+            if (getLocalPort(int(fd)) == port) {
+                m_add(int(fd));
+            }
+        }
+        closedir(dir);
+    }
+
+    void MainloopWaiter::m_close() {
+        for (int *fd : {&m_timer, &m_event, &m_epoll}) {
+            if (*fd >= 0) {
+                close(*fd);
+                *fd = -1;
+            }
+        }
+    }
+
+    void MainloopWaiter::m_add(int fd) {
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        /// EEXIST just means we're already watching it.
+        epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+#else // !OSVR_MAINLOOP_WAITER_EPOLL
+
+    MainloopWaiter::MainloopWaiter() {}
+
+    MainloopWaiter::~MainloopWaiter() {}
+
+    bool MainloopWaiter::canWatchSockets() { return false; }
+
+    void MainloopWaiter::wake() {
+        {
+            boost::unique_lock<boost::mutex> lock(m_mutex);
+            m_woken = true;
+        }
+        m_cond.notify_one();
+    }
+
+    void MainloopWaiter::wait(int microseconds) {
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+        if (microseconds > 0) {
+            m_cond.wait_for(lock, boost::chrono::microseconds(microseconds),
+                            [&] { return m_woken; });
+        }
+        m_woken = false;
+    }
+
+    void MainloopWaiter::watchLocalSockets(int) {}
+
+#endif // OSVR_MAINLOOP_WAITER_EPOLL
+
+} // namespace server
+} // namespace osvr
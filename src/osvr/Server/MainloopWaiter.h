@@ -0,0 +1,98 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MainloopWaiter_h_GUID_2D7A4C61_93E8_4F0B_A1C5_6B8E0F3D7C24
+#define INCLUDED_MainloopWaiter_h_GUID_2D7A4C61_93E8_4F0B_A1C5_6B8E0F3D7C24
+
+// Internal Includes
+#include <osvr/Util/PlatformConfig.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+
+// Standard includes
+// - none
+
+#if defined(OSVR_LINUX) && !defined(OSVR_ANDROID)
+#define OSVR_MAINLOOP_WAITER_EPOLL
+#endif
+
+namespace osvr {
+namespace server {
+
+    /// @brief Lets the server thread block between loop iterations until
+    /// there is something for it to do (or a timeout elapses), instead of
+    /// unconditionally sleeping.
+    ///
+    /// On Linux, this blocks in epoll on an eventfd (for wake()), a timerfd
+    /// (for microsecond-resolution timeouts), and any sockets added with
+    /// watchLocalSockets(). Elsewhere, it waits on a condition variable, so
+    /// only wake() and the timeout end a wait.
+    class MainloopWaiter : boost::noncopyable {
+      public:
+        MainloopWaiter();
+        ~MainloopWaiter();
+
+        /// @brief Returns true if socket readiness can end a wait on this
+        /// platform.
+        static bool canWatchSockets();
+
+        /// @brief Ends the current (or next) call to wait() early. Safe to
+        /// call from any thread.
+        void wake();
+
+        /// @brief Blocks until wake() is called, a watched socket is
+        /// readable, or the given number of microseconds elapse.
+        ///
+        /// Only to be called from the server thread.
+        void wait(int microseconds);
+
+        /// @brief Watches any sockets of this process bound to the given
+        /// local port (listening sockets as well as accepted connections).
+        /// Call again when connections are accepted: sockets are removed
+        /// automatically when closed.
+        ///
+        /// No-op when canWatchSockets() is false.
+        void watchLocalSockets(int port);
+
+      private:
+#ifdef OSVR_MAINLOOP_WAITER_EPOLL
+        void m_add(int fd);
+        void m_close();
+        int m_epoll = -1;
+        int m_event = -1;
+        int m_timer = -1;
+#else
+        boost::mutex m_mutex;
+        boost::condition_variable m_cond;
+        bool m_woken = false;
+#endif
+    };
+
+} // namespace server
+} // namespace osvr
+
+#endif // INCLUDED_MainloopWaiter_h_GUID_2D7A4C61_93E8_4F0B_A1C5_6B8E0F3D7C24
@@ -92,6 +92,10 @@ namespace server {
         m_impl->setHardwareDetectOnConnection();
     }
 
+    void Server::setHardwareDetectOnHotplug() {
+        m_impl->setHardwareDetectOnHotplug();
+    }
+
     void Server::instantiateDriver(std::string const &plugin,
                                    std::string const &driver,
                                    std::string const &params) {
@@ -132,6 +136,17 @@ namespace server {
     void Server::setSleepTime(int microseconds) {
         m_impl->setSleepTime(microseconds);
     }
+
+    void Server::setEventDriven(bool eventDriven) {
+        m_impl->setEventDriven(eventDriven);
+    }
+
+    void
+    Server::setLowLatencyOptions(common::LowLatencyOptions const &opts) {
+        m_impl->setLowLatencyOptions(opts);
+    }
+
+    void Server::wakeMainloop() { m_impl->wakeMainloop(); }
 #if 0
     int Server::getSleepTime() const { return m_impl->getSleepTime(); }
 #endif
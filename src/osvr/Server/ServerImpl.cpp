@@ -51,11 +51,17 @@
 #include <vrpn_ConnectionPtr.h>
 
 // Standard includes
+#include <chrono>
 #include <functional>
 #include <stdexcept>
 
 namespace osvr {
 namespace server {
+    /// @brief Minimum time between hardware detections triggered by client
+    /// connections: each client connection sends a ping, and detection can
+    /// stall the mainloop for a noticeable time.
+    static const std::chrono::seconds CONNECTION_DETECT_INTERVAL(2);
+
     static vrpn_ConnectionPtr
     getVRPNConnection(connection::ConnectionPtr const &conn) {
         vrpn_ConnectionPtr ret;
@@ -94,6 +100,8 @@ namespace server {
             m_systemDevice->addComponent(common::SystemComponent::create());
         m_systemComponent->registerClientRouteUpdateHandler(
             &ServerImpl::m_handleUpdatedRoute, this);
+        m_systemComponent->registerTreeRequestHandler(
+            &ServerImpl::m_handleTreeRequest, this);
 
         // Things to do when we get a new incoming connection
         // No longer doing hardware detect unconditionally here - see
@@ -118,6 +126,12 @@ namespace server {
         vrpnConn->register_handler(
             vrpnConn->register_message_type(vrpn_dropped_last_connection),
             &ServerImpl::m_enterIdle, this);
+        vrpnConn->register_handler(
+            vrpnConn->register_message_type(vrpn_got_connection),
+            &ServerImpl::m_gotConnection, this);
+
+        // Let device threads interrupt our wait when they have data.
+        m_conn->setWakeupHandler([&] { wakeMainloop(); });
     }
 
     ServerImpl::~ServerImpl() {
@@ -140,6 +154,7 @@ namespace server {
         m_thread = boost::thread([&] {
             bool keepRunning = true;
             m_mainThreadId = m_thread.get_id();
+            m_inOwnThread = true;
             ::util::LoopGuard guard(m_run);
             do {
                 keepRunning = this->m_loop();
@@ -180,8 +195,25 @@ namespace server {
     void ServerImpl::loadAutoPlugins() { m_ctx->loadPlugins(); }
 
     void ServerImpl::setHardwareDetectOnConnection() {
+        if (m_hotplug.isWatching()) {
+            /// Hotplug tells us when there's something new to detect, so
+            /// client connections needn't make the mainloop look.
+            setHardwareDetectOnHotplug();
+            return;
+        }
         m_commonComponent->registerPingHandler(
-            [&] { triggerHardwareDetect(); });
+            [&] { m_connectionDetectPending = true; });
+    }
+
+    void ServerImpl::setHardwareDetectOnHotplug() {
+        if (!m_hotplug.isWatching()) {
+            m_log->info() << "Device hotplug can't be watched on this "
+                             "platform.";
+            return;
+        }
+        m_log->info() << "Hardware detection will run when devices are "
+                         "plugged in.";
+        m_callControlled([&] { m_detectOnHotplug = true; });
     }
 
     void ServerImpl::instantiateDriver(std::string const &plugin,
@@ -217,19 +249,83 @@ namespace server {
         for (auto &f : m_mainloopMethods) {
             f();
         }
-        if (m_triggeredDetect) {
+        if (m_detectOnHotplug && m_hotplug.checkForHotplug()) {
+            m_log->info() << "Device hotplug detected.";
+            m_triggeredDetect = true;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (m_connectionDetectPending &&
+            now - m_lastDetect >= CONNECTION_DETECT_INTERVAL) {
+            m_triggeredDetect = true;
+        }
+        if (m_triggeredDetect && !m_detecting) {
             m_log->info() << "Performing hardware auto-detection.";
             common::tracing::markHardwareDetect();
-            m_ctx->triggerHardwareDetect();
+            m_startHardwareDetect();
             m_triggeredDetect = false;
+            /// Whatever asked for this detection, it also covers connections
+            /// so far.
+            m_connectionDetectPending = false;
+            m_lastDetect = now;
         }
-        if (m_treeDirty) {
-            m_log->debug() << "Path tree updated or connection detected";
+        if (m_fullTreeWanted || m_treeDirty) {
+            if (m_fullTreeWanted) {
+                m_log->debug() << "Connection detected or full path tree "
+                                  "requested";
+            } else {
+                m_log->debug() << "Path tree updated";
+            }
+            /// Always the full tree, for clients that don't handle deltas:
+            /// those that do get the delta first and skip the rest.
             m_sendTree();
+            m_fullTreeWanted.reset();
             m_treeDirty.reset();
         }
     }
 
+    void ServerImpl::m_startHardwareDetect() {
+        auto calls = m_ctx->getHardwareDetectCalls();
+        if (!m_inOwnThread) {
+            for (auto const &call : calls) {
+                call();
+            }
+            return;
+        }
+        /// Any previous detection is done with its calls, so this is quick.
+        if (m_detectThread.joinable()) {
+            m_detectThread.join();
+        }
+        m_detecting = true;
+        m_detectThread = boost::thread([this, calls] {
+            /// The callbacks create devices on the connection, which isn't
+            /// thread-safe, so each runs as if in the server thread: but the
+            /// mainloop gets to run between them.
+            for (auto const &call : calls) {
+                {
+                    boost::unique_lock<boost::mutex> lock(m_mainThreadMutex);
+                    if (m_stopDetecting) {
+                        break;
+                    }
+                    call();
+                }
+                wakeMainloop();
+            }
+            boost::unique_lock<boost::mutex> lock(m_mainThreadMutex);
+            m_detecting = false;
+        });
+    }
+
+    void ServerImpl::m_stopHardwareDetect() {
+        if (!m_detectThread.joinable()) {
+            return;
+        }
+        {
+            boost::unique_lock<boost::mutex> lock(m_mainThreadMutex);
+            m_stopDetecting = true;
+        }
+        m_detectThread.join();
+    }
+
     bool ServerImpl::m_loop() {
         bool shouldContinue;
         {
@@ -240,12 +336,34 @@ namespace server {
             shouldContinue = m_run.shouldContinue();
         }
 
-        if (m_currentSleepTime > 0) {
-            osvr::util::time::microsleep(m_currentSleepTime);
+        if (shouldContinue) {
+            m_waitForWork();
         }
         return shouldContinue;
     }
 
+    void ServerImpl::m_waitForWork() {
+        if (!m_eventDriven) {
+            if (m_currentSleepTime > 0) {
+                osvr::util::time::microsleep(m_currentSleepTime);
+            }
+            return;
+        }
+        if (m_socketsChanged) {
+            m_waiter.watchLocalSockets(m_port == util::UseDefaultPort
+                                           ? vrpn_DEFAULT_LISTEN_PORT_NO
+                                           : m_port);
+            m_socketsChanged = false;
+        }
+        /// Synchronous devices still need polling, so this is only an upper
+        /// bound on how long we block.
+        int maxWait = m_currentSleepTime;
+        if (maxWait <= 0) {
+            maxWait = IDLE_SLEEP_TIME;
+        }
+        m_waiter.wait(maxWait);
+    }
+
     bool ServerImpl::addRoute(std::string const &routingDirective) {
         bool wasNew;
         m_callControlled([&] { wasNew = m_addRoute(routingDirective); });
@@ -315,6 +433,11 @@ namespace server {
     }
 
     void ServerImpl::m_orderedDestruction() {
+        /// Its calls need the context and connection.
+        m_stopHardwareDetect();
+        /// Leave low-latency mode here, in the server thread, since it
+        /// restores that thread's original settings.
+        m_lowLatency.reset();
         m_ctx.reset();
         m_systemComponent = nullptr; // non-owning pointer
         m_systemDevice.reset();
@@ -332,6 +455,17 @@ namespace server {
         return 0;
     }
 
+    int ServerImpl::m_handleTreeRequest(void *userdata, vrpn_HANDLERPARAM) {
+        auto self = static_cast<ServerImpl *>(userdata);
+        BOOST_ASSERT_MSG(
+            self->m_inServerThread(),
+            "This callback should never happen outside the server thread!");
+
+        self->m_log->debug() << "A client requested the full path tree.";
+        self->m_fullTreeWanted.set();
+        return 0;
+    }
+
     bool ServerImpl::m_addRoute(std::string const &routingDirective) {
         bool change =
             common::addAliasFromRoute(m_tree.getRoot(), routingDirective);
@@ -359,7 +493,7 @@ namespace server {
         return change;
     }
     void ServerImpl::m_queueTreeSend() {
-        m_callControlled([&] { m_treeDirty += true; });
+        m_callControlled([&] { m_fullTreeWanted.set(); });
     }
     void ServerImpl::m_sendTree() {
 
@@ -371,6 +505,26 @@ namespace server {
     void ServerImpl::setSleepTime(int microseconds) {
         m_sleepTime = microseconds;
     }
+
+    void ServerImpl::setEventDriven(bool eventDriven) {
+        m_eventDriven = eventDriven;
+        if (m_eventDriven && !MainloopWaiter::canWatchSockets()) {
+            m_log->info() << "Event-driven server loop can't watch client "
+                             "sockets on this platform: client messages will "
+                             "only be handled once per sleep interval.";
+        }
+    }
+
+    void
+    ServerImpl::setLowLatencyOptions(common::LowLatencyOptions const &opts) {
+        m_lowLatencyOptions = opts;
+    }
+
+    void ServerImpl::wakeMainloop() {
+        if (m_eventDriven) {
+            m_waiter.wake();
+        }
+    }
 #if 0
     int ServerImpl::getSleepTime() const { return m_sleepTime; }
 #endif
@@ -397,8 +551,19 @@ namespace server {
                 "Got first client connection, exiting idle mode.");
             self->m_currentSleepTime = self->m_sleepTime;
         }
-        /// Create the low-latency behavior object.
-        self->m_lowLatency.reset(new common::LowLatency);
+        /// Create the low-latency behavior object, destroying any old one
+        /// first so it restores the thread state before we save it again.
+        self->m_lowLatency.reset();
+        self->m_lowLatency.reset(
+            new common::LowLatency(self->m_lowLatencyOptions));
+        auto const &result = self->m_lowLatency->getResult();
+        for (auto const &applied : result.applied) {
+            self->m_log->debug() << "Low-latency mode: applied " << applied;
+        }
+        for (auto const &failed : result.failed) {
+            self->m_log->warn() << "Low-latency mode: could not apply "
+                                << failed;
+        }
         return 0;
     }
 
@@ -418,5 +583,11 @@ namespace server {
         return 0;
     }
 
+    int ServerImpl::m_gotConnection(void *userdata, vrpn_HANDLERPARAM) {
+        auto self = static_cast<ServerImpl *>(userdata);
+        self->m_socketsChanged = true;
+        return 0;
+    }
+
 } // namespace server
 } // namespace osvr
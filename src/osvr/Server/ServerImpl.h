@@ -26,6 +26,8 @@
 #define INCLUDED_ServerImpl_h_GUID_BA15589C_D1AD_4BBE_4F93_8AC87043A982
 
 // Internal Includes
+#include "HotplugWatcher.h"
+#include "MainloopWaiter.h"
 #include <osvr/Common/CommonComponent_fwd.h>
 #include <osvr/Common/CreateDevice.h>
 #include <osvr/Common/LowLatency.h>
@@ -51,6 +53,7 @@
 #include <vrpn_Connection.h>
 
 // Standard includes
+#include <chrono>
 #include <string>
 
 namespace osvr {
@@ -93,6 +96,9 @@ namespace server {
         /// @copydoc Server::setHardwareDetectOnConnection()
         void setHardwareDetectOnConnection();
 
+        /// @copydoc Server::setHardwareDetectOnHotplug()
+        void setHardwareDetectOnHotplug();
+
         /// @copydoc Server::triggerHardwareDetect()
         void triggerHardwareDetect();
 
@@ -121,6 +127,15 @@ namespace server {
 
         /// @copydoc Server::setSleepTime()
         void setSleepTime(int microseconds);
+
+        /// @copydoc Server::setEventDriven()
+        void setEventDriven(bool eventDriven);
+
+        /// @copydoc Server::setLowLatencyOptions()
+        void setLowLatencyOptions(common::LowLatencyOptions const &opts);
+
+        /// @copydoc Server::wakeMainloop()
+        void wakeMainloop();
 #if 0
         /// @copydoc Server::getSleepTime()
         int getSleepTime() const;
@@ -141,6 +156,19 @@ namespace server {
         /// @brief The actual guts of the update
         void m_update();
 
+        /// @brief Blocks (or sleeps) between loop iterations.
+        void m_waitForWork();
+
+        /// @brief Runs the hardware detect callbacks: on m_detectThread, one
+        /// at a time holding m_mainThreadMutex so the mainloop keeps running
+        /// in between, if the server has its own thread; otherwise, right
+        /// here.
+        void m_startHardwareDetect();
+
+        /// @brief Waits for m_detectThread, skipping its remaining calls.
+        /// Call without holding m_mainThreadMutex.
+        void m_stopHardwareDetect();
+
         /// @brief Internal function to call a callable if the thread isn't
         /// running, or to queue up the callable if it is running.
         template <typename Callable> void m_callControlled(Callable f);
@@ -152,12 +180,17 @@ namespace server {
         /// order.
         void m_orderedDestruction();
 
-        /// @brief Queues up a tree transmission for next time around
+        /// @brief Queues up a full tree transmission for next time around
         void m_queueTreeSend();
 
-        /// @brief sends full path tree contents
+        /// @brief sends full path tree contents, preceded by the changes
+        /// since the tree was last sent
         void m_sendTree();
 
+        /// @brief handles a client's request for the full path tree
+        static int VRPN_CALLBACK m_handleTreeRequest(void *userdata,
+                                                     vrpn_HANDLERPARAM);
+
         /// @brief handles updated route message from client
         static int VRPN_CALLBACK m_handleUpdatedRoute(void *userdata,
                                                       vrpn_HANDLERPARAM p);
@@ -189,6 +222,9 @@ namespace server {
         static int VRPN_CALLBACK m_exitIdle(void *userdata, vrpn_HANDLERPARAM);
         /// @brief Callback on dropping last connection, to enter idle state.
         static int VRPN_CALLBACK m_enterIdle(void *userdata, vrpn_HANDLERPARAM);
+        /// @brief Callback on any new connection, to watch its socket.
+        static int VRPN_CALLBACK m_gotConnection(void *userdata,
+                                                 vrpn_HANDLERPARAM);
 
         /// @brief Connection ownership.
         connection::ConnectionPtr m_conn;
@@ -212,9 +248,42 @@ namespace server {
         /// detection.
         bool m_triggeredDetect = false;
 
+        /// @brief a flag to indicate that a client connection asked for a
+        /// hardware detection, which we run once enough time has passed since
+        /// the last one.
+        bool m_connectionDetectPending = false;
+
+        /// @brief When hardware detection last ran.
+        std::chrono::steady_clock::time_point m_lastDetect;
+
+        /// @brief Whether device hotplug triggers hardware detection.
+        bool m_detectOnHotplug = false;
+
+        /// @brief Makes the hardware detect calls when the server has its own
+        /// thread.
+        boost::thread m_detectThread;
+
+        /// @name Protected by m_mainThreadMutex when the server has its own
+        /// thread
+        /// @{
+        /// @brief Whether m_detectThread is still making its calls.
+        bool m_detecting = false;
+        /// @brief Tells m_detectThread to skip its remaining calls.
+        bool m_stopDetecting = false;
+        /// @}
+
+        /// @brief Whether m_update() runs in the server's own thread (holding
+        /// m_mainThreadMutex). Only touched in that thread.
+        bool m_inOwnThread = false;
+
+        /// @brief Watches for device hotplug, where supported.
+        HotplugWatcher m_hotplug;
+
         /// @brief Path tree
         common::PathTree m_tree;
         util::Flag m_treeDirty;
+        /// @brief Set when the full tree should be sent, not just changes.
+        util::Flag m_fullTreeWanted;
 
         /// @brief Mutex held by anything executing in the main thread.
         mutable boost::mutex m_mainThreadMutex;
@@ -248,6 +317,17 @@ namespace server {
         /// right now. 0 = no sleeping.
         int m_currentSleepTime = IDLE_SLEEP_TIME;
 
+        /// @brief Whether the loop blocks in m_waiter (woken by device
+        /// threads, queued calls, and on Linux, client sockets) rather than
+        /// sleeping a fixed time. Set only before starting the server.
+        bool m_eventDriven = false;
+
+        /// @brief Set when the set of sockets to watch may have changed.
+        bool m_socketsChanged = true;
+
+        /// @brief Blocking/wakeup mechanism for event-driven mode.
+        MainloopWaiter m_waiter;
+
         /// The host/interface we're listening on, if any.
         std::string m_host;
 
@@ -257,6 +337,9 @@ namespace server {
         /// The logger.
         util::log::LoggerPtr m_log;
 
+        /// Settings for m_lowLatency. Set only before starting the server.
+        common::LowLatencyOptions m_lowLatencyOptions;
+
         /// Latency reduction RAII object
         unique_ptr<common::LowLatency> m_lowLatency;
     };
@@ -285,9 +368,13 @@ namespace server {
     inline void ServerImpl::m_callControlled(Callable f) {
         boost::unique_lock<boost::mutex> lock(m_runControl);
         if (m_running && boost::this_thread::get_id() != m_thread.get_id()) {
-            boost::unique_lock<boost::mutex> innerLock(m_mainThreadMutex);
-            TemporaryThreadIDChanger changer(m_mainThreadId);
-            f();
+            {
+                boost::unique_lock<boost::mutex> innerLock(m_mainThreadMutex);
+                TemporaryThreadIDChanger changer(m_mainThreadId);
+                f();
+            }
+            /// Let the server thread act on whatever we just changed.
+            wakeMainloop();
         } else {
             f();
         }
@@ -68,6 +68,10 @@ namespace util {
         void dropAll() { LogRegistry::instance().dropAll(); }
 
         void flush() { LogRegistry::instance().flush(); }
+
+        void setAsyncLogging(bool enable) {
+            LogRegistry::instance().setAsync(enable);
+        }
 #else
         /*
          * This implementation avoids using a singleton.  The downside is that
@@ -101,6 +105,10 @@ namespace util {
             // no-op in the absence of a logger registry.
         }
 
+        void setAsyncLogging(bool) {
+            // no-op in the absence of a logger registry: no file sink.
+        }
+
         bool tryInitializingLoggingWithBaseName(std::string const &) {
             // no singleton, no file sink.
             return false;
@@ -32,7 +32,8 @@
 // - none
 
 // Standard includes
-// - none
+#include <chrono>
+#include <cstddef>
 
 namespace osvr {
 namespace util {
@@ -41,6 +42,13 @@ namespace util {
         static const auto DEFAULT_LEVEL = LogLevel::trace;
         static const auto DEFAULT_CONSOLE_LEVEL = LogLevel::info;
         static const auto DEFAULT_FLUSH_LEVEL = LogLevel::info;
+        /// Messages that can be waiting for each console or log file writer
+        /// thread: must be a power of 2.
+        static const std::size_t DEFAULT_ASYNC_QUEUE_SIZE = 1024;
+        /// Longest a flush waits for a writer thread to catch up, before
+        /// writing the rest of the queue itself.
+        static const auto DEFAULT_ASYNC_SYNC_TIMEOUT =
+            std::chrono::milliseconds(500);
 
         static const auto ANDROID_LOG_TAG = "OSVR";
     } // end namespace log
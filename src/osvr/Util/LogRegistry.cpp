@@ -45,6 +45,7 @@
 #include <spdlog/spdlog.h>
 
 // Standard includes
+#include <algorithm>
 #include <iostream>
 #include <utility>
 
@@ -92,8 +93,8 @@ namespace util {
                     spd_logger = spdlog::details::registry::instance().create(
                         logger_name, begin(sinks_), end(sinks_));
                     spd_logger->set_pattern(DEFAULT_PATTERN);
-                    /// @todo should this level be different than other levels?
-                    spd_logger->set_level(convertToLevelEnum(minLevel_));
+                    spd_logger->set_level(
+                        convertToLevelEnum(getEffectiveLevel()));
                     spd_logger->flush_on(
                         convertToLevelEnum(DEFAULT_FLUSH_LEVEL));
                 } catch (const std::exception &e) {
@@ -128,6 +129,17 @@ namespace util {
                     // fail silently
                 }
             }
+            // Wait for the background writers to catch up.
+            for (auto const &sink : {console_sink_, file_sink_}) {
+                if (!sink) {
+                    continue;
+                }
+                try {
+                    sink->sync();
+                } catch (...) {
+                    // fail silently
+                }
+            }
         }
 
         void LogRegistry::setPattern(const std::string &pattern) {
@@ -151,6 +163,15 @@ namespace util {
             setConsoleLevelImpl(severity);
         }
 
+        void LogRegistry::setAsync(bool async) {
+            if (console_sink_) {
+                console_sink_->set_async(async);
+            }
+            if (file_sink_) {
+                file_sink_->set_async(async);
+            }
+        }
+
         LogRegistry::LogRegistry(std::string const &logFileBaseName)
             : minLevel_(std::min(DEFAULT_LEVEL, DEFAULT_CONSOLE_LEVEL)),
               consoleLevel_(std::max(DEFAULT_LEVEL, DEFAULT_CONSOLE_LEVEL)),
@@ -169,9 +190,13 @@ namespace util {
             sinks_.push_back(android_sink);
             auto &main_sink = android_sink;
 #else
-            // Console sink
-            console_filter_ =
-                getDefaultFilteredSink(convertToLevelEnum(consoleLevel_));
+            // Console sink, written from a background thread, and filtered
+            // before the hand-off so filtered messages never take up room in
+            // its queue.
+            console_sink_ = std::make_shared<async_sink>(
+                getDefaultUnfilteredSink(), DEFAULT_ASYNC_QUEUE_SIZE);
+            console_filter_ = std::make_shared<filter_sink>(
+                console_sink_, convertToLevelEnum(consoleLevel_));
             sinks_.push_back(console_filter_);
             auto &main_sink = console_filter_;
 #endif
@@ -180,6 +205,7 @@ namespace util {
             generalPurposeLog_ = consoleOnlyLog_.get();
 
             createFileSink();
+            applyEffectiveLevel();
 
             auto binLoc = getBinaryLocation();
             if (!binLoc.empty()) {
@@ -193,8 +219,8 @@ namespace util {
         }
 
         void LogRegistry::setLevelImpl(LogLevel severity) {
-            spdlog::set_level(convertToLevelEnum(severity));
             minLevel_ = severity;
+            applyEffectiveLevel();
         }
 
         void LogRegistry::setConsoleLevelImpl(LogLevel severity) {
@@ -202,6 +228,20 @@ namespace util {
             if (console_filter_) {
                 console_filter_->set_level(convertToLevelEnum(severity));
             }
+            applyEffectiveLevel();
+        }
+
+        LogLevel LogRegistry::getEffectiveLevel() const {
+            if (!console_filter_ || file_sink_) {
+                // There's a sink that takes everything at our min level.
+                return minLevel_;
+            }
+            // Just the console, which drops anything below its own level.
+            return std::max(minLevel_, consoleLevel_);
+        }
+
+        void LogRegistry::applyEffectiveLevel() {
+            spdlog::set_level(convertToLevelEnum(getEffectiveLevel()));
         }
 
         static inline bool shouldLogToFile() {
@@ -225,8 +265,6 @@ namespace util {
             // File sink - rotates daily
             std::string logDir;
             try {
-                size_t q_size = 64; // queue size must be power of 2
-                spdlog::set_async_mode(q_size);
                 namespace fs = boost::filesystem;
                 auto base_name = fs::path(getLoggingDirectory(true));
                 if (!base_name.empty()) {
@@ -236,7 +274,11 @@ namespace util {
                         std::make_shared<spdlog::sinks::daily_file_sink_mt>(
                             base_name.string().c_str(), LOG_FILE_EXTENSION, 0,
                             0);
-                    sinks_.push_back(daily_file_sink);
+                    // Written from a background thread, so logging never
+                    // waits on the disk.
+                    file_sink_ = std::make_shared<async_sink>(
+                        std::move(daily_file_sink), DEFAULT_ASYNC_QUEUE_SIZE);
+                    sinks_.push_back(file_sink_);
                 }
             } catch (const std::exception &e) {
                 if (consoleOnlyLog_) {
@@ -45,13 +45,23 @@
 #include <spdlog/sinks/wincolor_sink.h>
 #endif
 #include <spdlog/common.h>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/details/mpmc_bounded_q.h>
 #include <spdlog/sinks/base_sink.h>
 #include <spdlog/sinks/android_sink.h>
 #include <spdlog/spdlog.h>
 
 // Standard includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
 #include <utility> // for std::move
 
 namespace osvr {
@@ -128,6 +138,246 @@ namespace util {
             spdlog::level::level_enum level_;
         };
 
+        /// A decorator around another (slow, e.g. file) sink that hands the
+        /// formatted messages off to a background thread to write, so the
+        /// thread logging never waits on the disk.
+        ///
+        /// Messages go through a bounded lock-free queue, sized once up front:
+        /// formatted text short enough to fit in a slot is copied in without
+        /// allocating. If the queue is full, the message is dropped (and
+        /// counted, with the count later written to the wrapped sink) rather
+        /// than blocking the caller.
+        ///
+        /// When asynchronous mode is turned off, messages go straight through
+        /// to the wrapped sink.
+        ///
+        /// Waiting on the background thread is always bounded, since it may
+        /// be gone without having finished: at process exit on Windows, for
+        /// instance, other threads are terminated before static objects
+        /// (like the log registry) are destroyed. So the queue and wrapped
+        /// sink are shared with the background thread, which keeps them alive
+        /// if it has to be left behind.
+        class async_sink : public ::spdlog::sinks::sink {
+          public:
+            using clock = std::chrono::steady_clock;
+            using duration = clock::duration;
+
+            /// @param queue_size Number of messages that can be waiting to be
+            /// written: must be a power of 2.
+            /// @param sync_timeout Longest sync() waits for the background
+            /// thread, before writing what's left of the queue itself.
+            async_sink(spdlog::sink_ptr &&wrapped_sink, std::size_t queue_size,
+                       duration sync_timeout = DEFAULT_ASYNC_SYNC_TIMEOUT)
+                : state_(std::make_shared<state>(std::move(wrapped_sink),
+                                                 queue_size)),
+                  sync_timeout_(sync_timeout) {
+                auto s = state_;
+                worker_ = std::thread([s] { workerMain(*s); });
+            }
+
+            virtual ~async_sink() {
+                state_->stop = true;
+                if (waitUntil(clock::now() + sync_timeout_,
+                              [&] { return !state_->worker_running; })) {
+                    worker_.join();
+                } else {
+                    // Stuck or terminated: we can't wait on it, but it owns
+                    // its share of the state, and will write what's left if
+                    // it ever gets going again.
+                    worker_.detach();
+                }
+                // Anything logged after the worker finished draining.
+                std::unique_lock<std::timed_mutex> lock(state_->drain_mutex,
+                                                        std::try_to_lock);
+                if (lock) {
+                    state_->drain();
+                    state_->sink->flush();
+                }
+            }
+
+            /// Enable or disable asynchronous mode: disabling it waits for
+            /// queued messages to be written first.
+            void set_async(bool async) {
+                async_ = async;
+                if (!async) {
+                    sync();
+                }
+            }
+
+            void log(const spdlog::details::log_msg &msg) override {
+                if (!async_) {
+                    state_->sink->log(msg);
+                    return;
+                }
+                queued_msg entry;
+                entry.set(msg);
+                ++state_->pending;
+                if (!state_->queue.enqueue(std::move(entry))) {
+                    --state_->pending;
+                    ++state_->dropped;
+                }
+            }
+
+            /// Only requests a flush, which the worker thread performs once
+            /// it has written what is already queued.
+            void flush() override {
+                if (!async_) {
+                    state_->sink->flush();
+                    return;
+                }
+                state_->flush_requested = true;
+            }
+
+            /// Blocks until everything queued so far has been written and the
+            /// wrapped sink flushed. If the background thread isn't running,
+            /// or doesn't catch up in time, the rest of the queue is written
+            /// by the calling thread - unless the background thread is in the
+            /// middle of writing, in which case it's left to finish, so
+            /// messages are never written out of order.
+            void sync() {
+                auto deadline = clock::now() + sync_timeout_;
+                waitUntil(deadline, [&] {
+                    return state_->pending == 0 || !state_->worker_running;
+                });
+                std::unique_lock<std::timed_mutex> lock(state_->drain_mutex,
+                                                        std::defer_lock);
+                if (!lock.try_lock_until(deadline)) {
+                    state_->flush_requested = true;
+                    return;
+                }
+                state_->drain();
+                state_->sink->flush();
+            }
+
+          private:
+            static const std::size_t INLINE_TEXT_SIZE = 256;
+
+            /// Queue slot: a copy of the pieces of a log_msg that a sink needs
+            /// once it has been formatted.
+            struct queued_msg {
+                void set(const spdlog::details::log_msg &msg) {
+                    level = msg.level;
+                    time = msg.time;
+                    size = msg.formatted.size();
+                    if (size <= text.size()) {
+                        std::copy(msg.formatted.data(),
+                                  msg.formatted.data() + size, text.begin());
+                    } else {
+                        long_text.assign(msg.formatted.data(), size);
+                    }
+                }
+
+                void get(spdlog::details::log_msg &msg) const {
+                    msg.level = level;
+                    msg.time = time;
+                    if (size <= text.size()) {
+                        msg.formatted << fmt::StringRef(text.data(), size);
+                    } else {
+                        msg.formatted << long_text;
+                    }
+                }
+
+                spdlog::level::level_enum level = spdlog::level::off;
+                spdlog::log_clock::time_point time;
+                std::size_t size = 0;
+                std::array<char, INLINE_TEXT_SIZE> text;
+                /// Only used for messages longer than the inline buffer.
+                std::string long_text;
+            };
+
+            /// Everything the background thread touches.
+            struct state {
+                state(spdlog::sink_ptr &&wrapped_sink, std::size_t queue_size)
+                    : sink(std::move(wrapped_sink)), queue(queue_size) {}
+
+                /// Writes everything in the queue, and performs any requested
+                /// flush. Call with drain_mutex held.
+                /// @return true if anything was written.
+                bool drain() {
+                    bool wrote = false;
+                    queued_msg entry;
+                    while (queue.dequeue(entry)) {
+                        spdlog::details::log_msg msg;
+                        entry.get(msg);
+                        try {
+                            sink->log(msg);
+                        } catch (...) {
+                            // nowhere to report it.
+                        }
+                        --pending;
+                        wrote = true;
+                    }
+                    writeDroppedCount();
+                    if (flush_requested.exchange(false)) {
+                        sink->flush();
+                    }
+                    return wrote;
+                }
+
+                void writeDroppedCount() {
+                    auto count = dropped.exchange(0);
+                    if (count == 0) {
+                        return;
+                    }
+                    spdlog::details::log_msg msg;
+                    msg.level = spdlog::level::warn;
+                    msg.time = spdlog::details::os::now();
+                    msg.formatted << "[OSVR] Log queue full: dropped "
+                                  << count << " messages\n";
+                    sink->log(msg);
+                }
+
+                spdlog::sink_ptr sink;
+                spdlog::details::mpmc_bounded_queue<queued_msg> queue;
+                /// Held by whichever thread is writing from the queue, so
+                /// messages go out in order.
+                std::timed_mutex drain_mutex;
+                std::atomic<bool> stop{false};
+                std::atomic<bool> flush_requested{false};
+                std::atomic<std::size_t> pending{0};
+                std::atomic<std::size_t> dropped{0};
+                /// Cleared by the worker as the last thing it does.
+                std::atomic<bool> worker_running{true};
+            };
+
+            static void workerMain(state &s) {
+                while (!s.stop) {
+                    bool wrote;
+                    {
+                        std::lock_guard<std::timed_mutex> lock(s.drain_mutex);
+                        wrote = s.drain();
+                    }
+                    if (!wrote) {
+                        std::this_thread::sleep_for(
+                            std::chrono::milliseconds(10));
+                    }
+                }
+                {
+                    std::lock_guard<std::timed_mutex> lock(s.drain_mutex);
+                    s.drain();
+                }
+                s.worker_running = false;
+            }
+
+            /// Polls the condition until it holds or the deadline passes.
+            /// @return whether the condition held.
+            template <typename F>
+            static bool waitUntil(clock::time_point deadline, F &&condition) {
+                while (!condition()) {
+                    if (clock::now() >= deadline) {
+                        return false;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                return true;
+            }
+
+            std::shared_ptr<state> state_;
+            std::atomic<bool> async_{true};
+            duration sync_timeout_;
+            std::thread worker_;
+        };
+
         static inline spdlog::sink_ptr getUnfilteredConsoleSink() {
             // Console sink
             auto console_out = spdlog::sinks::stderr_sink_mt::instance();
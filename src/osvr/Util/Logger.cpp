@@ -150,6 +150,10 @@ namespace util {
             logger_->flush_on(convertToLevelEnum(level));
         }
 
+        bool Logger::shouldLog(LogLevel level) const {
+            return convertToLevelEnum(level) >= logger_->level();
+        }
+
         Logger::StreamProxy Logger::trace(const char *msg) {
             return { *this, LogLevel::trace, msg };
         }
@@ -0,0 +1,273 @@
+/** @file
+    @brief Test Implementation: the analog dispatcher's handling of
+    delta-encoded analog messages, received on a loopback connection.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Client/AnalogDispatcher.h"
+#include <osvr/Connection/Connection.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <vrpn_Connection.h>
+
+// Standard includes
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using osvr::client::AnalogDispatcher;
+using osvr::common::messages::AnalogDelta;
+using osvr::common::messages::AnalogDeltaEntry;
+using boost::optional;
+
+namespace {
+static const char DEVICE[] = "TestAnalogDelta";
+
+/// Keeps everything the dispatcher delivers to it.
+struct RecordingHandler {
+    void deliver(OSVR_TimeValue const &timestamp, int32_t sensor,
+                 double value) {
+        times.push_back(timestamp);
+        reports.emplace_back(sensor, value);
+    }
+
+    void deliverArray(OSVR_TimeValue const &timestamp, double const *values,
+                      int count) {
+        times.push_back(timestamp);
+        arrays.emplace_back(values, values + count);
+    }
+
+    void clear() {
+        times.clear();
+        reports.clear();
+        arrays.clear();
+    }
+
+    std::vector<OSVR_TimeValue> times;
+    std::vector<std::pair<int, double> > reports;
+    std::vector<std::vector<double> > arrays;
+};
+
+typedef AnalogDispatcher<RecordingHandler> Dispatcher;
+typedef std::vector<std::pair<int, double> > Reports;
+typedef std::vector<std::vector<double> > Arrays;
+
+/// A dispatcher for DEVICE, and a way to send it delta messages, on one
+/// loopback connection.
+class AnalogDeltaTest : public ::testing::Test {
+  protected:
+    AnalogDeltaTest() {
+        auto conn = osvr::connection::Connection::createLoopbackConnection();
+        m_conn = std::get<1>(conn);
+        m_vrpnConn = vrpn_ConnectionPtr(
+            static_cast<vrpn_Connection *>(std::get<0>(conn)));
+        m_sender = m_vrpnConn->register_sender(DEVICE);
+        m_type = m_vrpnConn->register_message_type(AnalogDelta::identifier());
+        dispatcher.reset(new Dispatcher(m_vrpnConn, DEVICE));
+    }
+
+    ~AnalogDeltaTest() {
+        for (auto &sub : m_subscribed) {
+            dispatcher->unsubscribe(*sub.first, sub.second);
+        }
+        dispatcher.reset();
+    }
+
+    void subscribe(RecordingHandler &handler, optional<int> sensor) {
+        dispatcher->subscribe(handler, sensor);
+        m_subscribed.emplace_back(&handler, sensor);
+    }
+
+    void sendDelta(bool full, uint16_t numChannels,
+                   std::vector<AnalogDeltaEntry> const &entries,
+                   double quantum = 0) {
+        auto buf = serializeDelta(full, numChannels, entries, quantum);
+        send(buf.data(), buf.size());
+    }
+
+    static osvr::common::Buffer<>
+    serializeDelta(bool full, uint16_t numChannels,
+                   std::vector<AnalogDeltaEntry> const &entries,
+                   double quantum = 0) {
+        osvr::common::Buffer<> buf;
+        AnalogDelta::MessageSerialization msg(full, numChannels, quantum,
+                                              entries.data(), entries.size());
+        osvr::common::serialize(buf, msg);
+        return buf;
+    }
+
+    void send(const char *data, std::size_t size) {
+        struct timeval now;
+        vrpn_gettimeofday(&now, nullptr);
+        lastSent.seconds = now.tv_sec;
+        lastSent.microseconds = now.tv_usec;
+        m_vrpnConn->pack_message(static_cast<vrpn_uint32>(size), now, m_type,
+                                 m_sender, data, vrpn_CONNECTION_LOW_LATENCY);
+        m_vrpnConn->mainloop();
+    }
+
+    /// A message with every channel: channel i has value base + i.
+    void sendFull(uint16_t numChannels, double base) {
+        std::vector<AnalogDeltaEntry> entries;
+        for (uint16_t i = 0; i < numChannels; ++i) {
+            entries.push_back(AnalogDeltaEntry{i, base + i});
+        }
+        sendDelta(true, numChannels, entries);
+    }
+
+    std::unique_ptr<Dispatcher> dispatcher;
+    OSVR_TimeValue lastSent = {};
+
+  private:
+    osvr::connection::ConnectionPtr m_conn;
+    vrpn_ConnectionPtr m_vrpnConn;
+    vrpn_int32 m_sender;
+    vrpn_int32 m_type;
+    std::vector<std::pair<RecordingHandler *, optional<int> > > m_subscribed;
+};
+} // namespace
+
+TEST_F(AnalogDeltaTest, DeltaBeforeFullHoldsBackAllChannelArrays) {
+    RecordingHandler all;
+    RecordingHandler one;
+    subscribe(all, optional<int>());
+    subscribe(one, 1);
+
+    sendDelta(false, 3, {AnalogDeltaEntry{1, 0.5}});
+    /// Channel 1 is known, so goes to both: but not the whole state, with
+    /// channels 0 and 2 still unknown.
+    ASSERT_EQ((Reports{{1, 0.5}}), all.reports);
+    ASSERT_TRUE(all.arrays.empty());
+    ASSERT_EQ((Reports{{1, 0.5}}), one.reports);
+    ASSERT_EQ(1u, one.arrays.size());
+    ASSERT_EQ(0.5, one.arrays[0][1]);
+    all.clear();
+    one.clear();
+
+    sendFull(3, 10.);
+    ASSERT_EQ((Reports{{0, 10.}, {1, 11.}, {2, 12.}}), all.reports);
+    ASSERT_EQ((Arrays{{10., 11., 12.}}), all.arrays);
+    ASSERT_EQ(lastSent.seconds, all.times.back().seconds);
+    ASSERT_EQ(lastSent.microseconds, all.times.back().microseconds);
+    all.clear();
+
+    /// From now on, deltas fill in the rest from what we already know.
+    sendDelta(false, 3, {AnalogDeltaEntry{2, 7.}});
+    ASSERT_EQ((Reports{{2, 7.}}), all.reports);
+    ASSERT_EQ((Arrays{{10., 11., 7.}}), all.arrays);
+}
+
+TEST_F(AnalogDeltaTest, DeltasCanCompleteTheState) {
+    RecordingHandler all;
+    subscribe(all, optional<int>());
+
+    sendDelta(false, 2, {AnalogDeltaEntry{0, 1.}});
+    ASSERT_TRUE(all.arrays.empty());
+    /// Hearing channel 0 again doesn't count twice.
+    sendDelta(false, 2, {AnalogDeltaEntry{0, 2.}});
+    ASSERT_TRUE(all.arrays.empty());
+    sendDelta(false, 2, {AnalogDeltaEntry{1, 3.}});
+    ASSERT_EQ((Arrays{{2., 3.}}), all.arrays);
+}
+
+TEST_F(AnalogDeltaTest, ChannelCountChangeForgetsState) {
+    RecordingHandler all;
+    subscribe(all, optional<int>());
+    sendFull(3, 10.);
+    ASSERT_EQ(1u, all.arrays.size());
+    all.clear();
+
+    /// New layout: the three channels we knew may not mean the same now.
+    sendDelta(false, 4, {AnalogDeltaEntry{0, 1.}});
+    ASSERT_EQ((Reports{{0, 1.}}), all.reports);
+    ASSERT_TRUE(all.arrays.empty());
+    all.clear();
+
+    sendFull(4, 20.);
+    ASSERT_EQ((Arrays{{20., 21., 22., 23.}}), all.arrays);
+    all.clear();
+
+    /// Fewer channels works the same way.
+    sendDelta(false, 2, {AnalogDeltaEntry{1, 5.}});
+    ASSERT_EQ((Reports{{1, 5.}}), all.reports);
+    ASSERT_TRUE(all.arrays.empty());
+}
+
+TEST_F(AnalogDeltaTest, IgnoresChannelsPastCount) {
+    RecordingHandler all;
+    RecordingHandler beyond;
+    subscribe(all, optional<int>());
+    subscribe(beyond, 5);
+    sendDelta(false, 2, {AnalogDeltaEntry{0, 1.}, AnalogDeltaEntry{5, 9.},
+                         AnalogDeltaEntry{1, 2.}});
+    ASSERT_EQ((Reports{{0, 1.}, {1, 2.}}), all.reports);
+    ASSERT_EQ((Arrays{{1., 2.}}), all.arrays);
+    ASSERT_TRUE(beyond.reports.empty());
+    ASSERT_TRUE(beyond.arrays.empty());
+}
+
+TEST_F(AnalogDeltaTest, PerSensorArraysOnlyForChangedChannels) {
+    RecordingHandler zero;
+    RecordingHandler two;
+    subscribe(zero, 0);
+    subscribe(two, 2);
+
+    /// Per-sensor handlers don't wait for the whole state.
+    sendDelta(false, 3, {AnalogDeltaEntry{2, 3.}});
+    ASSERT_TRUE(zero.reports.empty());
+    ASSERT_TRUE(zero.arrays.empty());
+    ASSERT_EQ((Reports{{2, 3.}}), two.reports);
+    ASSERT_EQ(1u, two.arrays.size());
+    ASSERT_EQ(3u, two.arrays[0].size());
+    ASSERT_EQ(3., two.arrays[0][2]);
+    two.clear();
+
+    /// One array for each changed channel, to its handlers only.
+    sendDelta(false, 3, {AnalogDeltaEntry{0, 0.75}, AnalogDeltaEntry{1, 1.}},
+              0.25);
+    ASSERT_EQ((Reports{{0, 0.75}}), zero.reports);
+    ASSERT_EQ((Arrays{{0.75, 1., 3.}}), zero.arrays);
+    ASSERT_TRUE(two.reports.empty());
+    ASSERT_TRUE(two.arrays.empty());
+}
+
+TEST_F(AnalogDeltaTest, IgnoresTruncatedMessage) {
+    RecordingHandler all;
+    subscribe(all, optional<int>());
+    sendFull(2, 1.);
+    all.clear();
+
+    /// The last entry's value is cut short.
+    auto buf = serializeDelta(false, 2, {AnalogDeltaEntry{0, 5.},
+                                         AnalogDeltaEntry{1, 6.}});
+    send(buf.data(), buf.size() - 4);
+    ASSERT_TRUE(all.reports.empty());
+    ASSERT_TRUE(all.arrays.empty());
+
+    /// And the state is as it was.
+    sendDelta(false, 2, {AnalogDeltaEntry{1, 7.}});
+    ASSERT_EQ((Arrays{{1., 7.}}), all.arrays);
+}
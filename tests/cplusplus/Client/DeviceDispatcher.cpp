@@ -0,0 +1,203 @@
+/** @file
+    @brief Test Implementation: the per-sensor subscriber table and the
+    per-device dispatcher registry shared by the client remote handlers.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Client/DeviceDispatcher.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <functional>
+#include <string>
+#include <vector>
+
+using osvr::client::SensorSubscriberTable;
+using osvr::client::DeviceDispatcherRegistry;
+using boost::optional;
+
+namespace {
+struct Subscriber {
+    explicit Subscriber(int id_) : id(id_) {}
+    int id;
+    /// Called from within a delivery, if set.
+    std::function<void()> onCall;
+};
+
+typedef SensorSubscriberTable<Subscriber> Table;
+
+/// Ids of the subscribers a call delivers to, in order.
+template <typename Deliver> std::vector<int> delivered(Deliver &&deliver) {
+    std::vector<int> ret;
+    deliver([&](Subscriber &sub) {
+        ret.push_back(sub.id);
+        if (sub.onCall) {
+            sub.onCall();
+        }
+    });
+    return ret;
+}
+
+std::vector<int> forSensor(Table &table, int sensor) {
+    return delivered([&](std::function<void(Subscriber &)> const &f) {
+        table.forSensor(sensor, f);
+    });
+}
+
+std::vector<int> forEach(Table &table) {
+    return delivered([&](std::function<void(Subscriber &)> const &f) {
+        table.forEach(f);
+    });
+}
+
+std::vector<int> subscribedSensors(Table &table, int count) {
+    std::vector<int> ret;
+    table.forEachSubscribedSensor(count,
+                                  [&](int sensor) { ret.push_back(sensor); });
+    return ret;
+}
+
+struct Dispatcher {
+    Dispatcher(vrpn_ConnectionPtr const &, const char *device_)
+        : device(device_) {}
+    std::string device;
+};
+} // namespace
+
+TEST(SensorSubscriberTable, FansOutBySensor) {
+    Table table;
+    Subscriber sensor0(0), sensor2(2), all(-1), negative(-2);
+    ASSERT_TRUE(table.empty());
+    ASSERT_EQ(nullptr, table.driver());
+    table.add(sensor2, 2);
+    table.add(all, optional<int>());
+    table.add(sensor0, 0);
+    table.add(negative, -3);
+    ASSERT_FALSE(table.empty());
+    ASSERT_EQ(&sensor2, table.driver());
+
+    ASSERT_EQ(std::vector<int>({0, -1}), forSensor(table, 0));
+    ASSERT_EQ(std::vector<int>({-1}), forSensor(table, 1));
+    ASSERT_EQ(std::vector<int>({2, -1}), forSensor(table, 2));
+    ASSERT_EQ(std::vector<int>({-1}), forSensor(table, 7));
+    ASSERT_EQ(std::vector<int>({-1}), forSensor(table, -3));
+    ASSERT_EQ(std::vector<int>({2, -1, 0, -2}), forEach(table));
+
+    /// A subscriber to all sensors makes every sensor interesting.
+    ASSERT_EQ(std::vector<int>({0, 1, 2, 3}), subscribedSensors(table, 4));
+    table.remove(all, optional<int>());
+    ASSERT_EQ(std::vector<int>({0, 2}), subscribedSensors(table, 4));
+    ASSERT_EQ(std::vector<int>({0}), subscribedSensors(table, 2));
+
+    table.remove(sensor2, 2);
+    ASSERT_EQ(&sensor0, table.driver());
+    table.remove(sensor0, 0);
+    table.remove(negative, -3);
+    ASSERT_TRUE(table.empty());
+    ASSERT_EQ(nullptr, table.driver());
+    ASSERT_TRUE(forEach(table).empty());
+}
+
+TEST(SensorSubscriberTable, RemovalDuringDelivery) {
+    Table table;
+    Subscriber a(1), b(2), c(3), all(4);
+    table.add(a, 0);
+    table.add(b, 0);
+    table.add(c, 0);
+    table.add(all, optional<int>());
+
+    /// The first subscriber unsubscribes itself and a later one, as freeing
+    /// interfaces from a callback would.
+    a.onCall = [&] {
+        table.remove(a, 0);
+        table.remove(c, 0);
+        table.remove(all, optional<int>());
+    };
+    ASSERT_EQ(std::vector<int>({1, 2}), forSensor(table, 0));
+    ASSERT_EQ(&b, table.driver());
+    ASSERT_FALSE(table.empty());
+
+    a.onCall = nullptr;
+    ASSERT_EQ(std::vector<int>({2}), forSensor(table, 0));
+    ASSERT_EQ(std::vector<int>({2}), forEach(table));
+
+    /// Removing everyone mid-delivery.
+    b.onCall = [&] { table.remove(b, 0); };
+    ASSERT_EQ(std::vector<int>({2}), forSensor(table, 0));
+    ASSERT_TRUE(table.empty());
+    ASSERT_EQ(nullptr, table.driver());
+    ASSERT_TRUE(forEach(table).empty());
+}
+
+TEST(SensorSubscriberTable, AdditionDuringDelivery) {
+    Table table;
+    Subscriber a(1), added(2), addedAll(3), addedHigh(4);
+    table.add(a, 0);
+
+    /// Enough additions to reallocate every list, including the per-sensor
+    /// index itself.
+    bool first = true;
+    a.onCall = [&] {
+        if (first) {
+            first = false;
+            table.add(added, 0);
+            table.add(addedAll, optional<int>());
+            table.add(addedHigh, 50);
+        }
+    };
+    ASSERT_EQ(std::vector<int>({1}), forSensor(table, 0));
+    ASSERT_EQ(std::vector<int>({1, 2, 3}), forSensor(table, 0));
+    ASSERT_EQ(std::vector<int>({4, 3}), forSensor(table, 50));
+    ASSERT_EQ(std::vector<int>({1, 2, 3, 4}), forEach(table));
+}
+
+TEST(DeviceDispatcherRegistry, SharesAndForgetsDispatchers) {
+    DeviceDispatcherRegistry<Dispatcher> registry;
+    vrpn_ConnectionPtr conn;
+    auto first = registry.get(conn, "com_osvr_Example/Device");
+    ASSERT_EQ("com_osvr_Example/Device", first->device);
+    ASSERT_EQ(first, registry.get(conn, "com_osvr_Example/Device"));
+
+    /// Copies share their dispatchers.
+    auto copy = registry;
+    ASSERT_EQ(first, copy.get(conn, "com_osvr_Example/Device"));
+
+    auto other = copy.get(conn, "com_osvr_Example/Other");
+    ASSERT_NE(first, other);
+    ASSERT_EQ(2u, registry.size());
+
+    /// Once no handler holds on to a dispatcher, its entry goes away, and a
+    /// later request gets a new one.
+    other.reset();
+    auto again = registry.get(conn, "com_osvr_Example/Device");
+    ASSERT_EQ(first, again);
+    ASSERT_EQ(1u, registry.size());
+
+    first.reset();
+    again.reset();
+    auto fresh = registry.get(conn, "com_osvr_Example/Other");
+    ASSERT_EQ("com_osvr_Example/Other", fresh->device);
+    ASSERT_EQ(1u, registry.size());
+}
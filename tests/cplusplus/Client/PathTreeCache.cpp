@@ -0,0 +1,165 @@
+/** @file
+    @brief Test Implementation: the on-disk path tree cache.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Client/PathTreeCache.cpp"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+#include <json/reader.h>
+#include <json/value.h>
+#include <json/writer.h>
+
+// Standard includes
+#include <fstream>
+#include <string>
+
+using osvr::client::PathTreeCache;
+namespace fs = boost::filesystem;
+
+namespace {
+Json::Value makeNodes(std::string const &path) {
+    Json::Value node(Json::objectValue);
+    node["path"] = path;
+    node["type"] = "DeviceElement";
+    Json::Value nodes(Json::arrayValue);
+    nodes.append(node);
+    return nodes;
+}
+
+Json::Value readJson(std::string const &filename) {
+    std::ifstream file{filename};
+    Json::Value root;
+    Json::Reader().parse(file, root);
+    return root;
+}
+
+void writeJson(std::string const &filename, Json::Value const &root) {
+    std::ofstream file{filename};
+    file << Json::FastWriter().write(root);
+}
+
+class PathTreeCacheTest : public ::testing::Test {
+  protected:
+    PathTreeCacheTest()
+        : dir(fs::temp_directory_path() /
+              fs::unique_path("osvr-pathtreecache-%%%%-%%%%")) {}
+    ~PathTreeCacheTest() {
+        boost::system::error_code ec;
+        fs::remove_all(dir, ec);
+    }
+
+    std::size_t countFiles() const {
+        std::size_t ret = 0;
+        for (fs::directory_iterator it(dir), end; it != end; ++it) {
+            ++ret;
+        }
+        return ret;
+    }
+
+    fs::path dir;
+};
+} // namespace
+
+TEST(PathTreeCacheHash, Stable) {
+    auto nodes = makeNodes("/me/head");
+    ASSERT_EQ(PathTreeCache::hash(nodes), PathTreeCache::hash(nodes));
+    ASSERT_EQ(PathTreeCache::hash(nodes),
+              PathTreeCache::hash(makeNodes("/me/head")));
+    ASSERT_NE(PathTreeCache::hash(nodes),
+              PathTreeCache::hash(makeNodes("/me/hands")));
+    /// The same across runs and builds: 64-bit FNV-1a of the compact
+    /// serialization.
+    ASSERT_EQ(0xdcd1cd1a2138b85dULL,
+              PathTreeCache::hash(Json::Value(Json::arrayValue)));
+}
+
+TEST_F(PathTreeCacheTest, SanitizesHost) {
+    PathTreeCache cache{"192.168.0.1:3883", dir.string()};
+    ASSERT_EQ((dir / "pathtree-192_168_0_1_3883.json").string(),
+              cache.getFilename());
+    PathTreeCache escaping{"../host/", dir.string()};
+    ASSERT_EQ((dir / "pathtree-___host_.json").string(),
+              escaping.getFilename());
+}
+
+TEST_F(PathTreeCacheTest, NoDirectory) {
+    PathTreeCache cache{"localhost", ""};
+    ASSERT_TRUE(cache.getFilename().empty());
+    ASSERT_FALSE(cache.load());
+    ASSERT_FALSE(cache.matchOrStore(makeNodes("/me/head")));
+    ASSERT_TRUE(cache.matchOrStore(makeNodes("/me/head")));
+}
+
+TEST_F(PathTreeCacheTest, RoundTrip) {
+    auto nodes = makeNodes("/me/head");
+    {
+        PathTreeCache cache{"localhost", dir.string()};
+        ASSERT_FALSE(cache.load());
+        ASSERT_FALSE(cache.matchOrStore(nodes));
+        ASSERT_TRUE(cache.matchOrStore(nodes));
+    }
+    /// Only the cache file: no temporary left behind.
+    ASSERT_EQ(1u, countFiles());
+
+    PathTreeCache cache{"localhost", dir.string()};
+    auto loaded = cache.load();
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(nodes, *loaded);
+    ASSERT_TRUE(cache.getHash());
+    ASSERT_EQ(PathTreeCache::hash(nodes), *cache.getHash());
+    ASSERT_TRUE(cache.matchOrStore(nodes));
+
+    /// A different tree replaces it.
+    auto otherNodes = makeNodes("/me/hands");
+    ASSERT_FALSE(cache.matchOrStore(otherNodes));
+    ASSERT_EQ(1u, countFiles());
+    PathTreeCache reloaded{"localhost", dir.string()};
+    loaded = reloaded.load();
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(otherNodes, *loaded);
+}
+
+TEST_F(PathTreeCacheTest, RejectsTamperedFile) {
+    PathTreeCache cache{"localhost", dir.string()};
+    ASSERT_FALSE(cache.matchOrStore(makeNodes("/me/head")));
+
+    auto root = readJson(cache.getFilename());
+    root["nodes"][0]["path"] = "/me/hands";
+    writeJson(cache.getFilename(), root);
+    PathTreeCache tampered{"localhost", dir.string()};
+    ASSERT_FALSE(tampered.load());
+    ASSERT_FALSE(tampered.getHash());
+}
+
+TEST_F(PathTreeCacheTest, RejectsOtherServer) {
+    PathTreeCache cache{"localhost", dir.string()};
+    ASSERT_FALSE(cache.matchOrStore(makeNodes("/me/head")));
+
+    /// A file for one host, copied to the name for another.
+    PathTreeCache other{"otherhost", dir.string()};
+    fs::copy_file(cache.getFilename(), other.getFilename());
+    ASSERT_FALSE(other.load());
+}
@@ -0,0 +1,111 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ChangeOfBasis.h>
+#include <osvr/Common/CompiledTransform.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+using osvr::common::ChangeOfBasis;
+using osvr::common::CompiledTransform;
+using osvr::common::Transform;
+
+namespace {
+Transform makeRouteTransform() {
+    Transform ret;
+    Eigen::Isometry3d post(Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitY()));
+    post.translation() = Eigen::Vector3d(0.1, 1.5, -0.2);
+    ret.concatPost(post.matrix());
+    Eigen::Isometry3d pre(Eigen::AngleAxisd(-1.1, Eigen::Vector3d::UnitX()));
+    pre.translation() = Eigen::Vector3d(0, 0.05, 0.1);
+    ret.concatPre(pre.matrix());
+    return ret;
+}
+
+Transform makeMirrorTransform() {
+    ChangeOfBasis cb;
+    cb.setNewX(-Eigen::Vector3d::UnitX());
+    cb.setNewY(Eigen::Vector3d::UnitY());
+    cb.setNewZ(Eigen::Vector3d::UnitZ());
+    return cb.get();
+}
+
+Eigen::Quaterniond getTestRotation() {
+    return Eigen::Quaterniond(
+        Eigen::AngleAxisd(0.7, Eigen::Vector3d(1, 2, 3).normalized()));
+}
+
+/// @brief Checks that the compiled form matches the original on a pose and
+/// both kinds of derivative.
+void checkMatches(Transform xform) {
+    CompiledTransform compiled(xform);
+    Eigen::Vector3d pos(0.3, -0.4, 2);
+    Eigen::Quaterniond rot = getTestRotation();
+
+    Eigen::Isometry3d pose(rot);
+    pose.translation() = pos;
+    Eigen::Matrix4d expected = xform.transform(pose.matrix());
+    compiled.transformPose(rot, pos);
+    ASSERT_TRUE(pos.isApprox(expected.topRightCorner<3, 1>()));
+    ASSERT_NEAR(0, rot.angularDistance(Eigen::Quaterniond(
+                       Eigen::Matrix3d(expected.topLeftCorner<3, 3>()))),
+                1e-9);
+
+    Eigen::Vector3d vel(1, 2, 3);
+    ASSERT_TRUE(compiled.transformDerivative(vel).isApprox(
+        xform.transformDerivative(vel)));
+
+    auto incRot = getTestRotation();
+    ASSERT_NEAR(0, compiled.transformDerivative(incRot).angularDistance(
+                       xform.transformDerivative(incRot)),
+                1e-9);
+}
+} // namespace
+
+TEST(CompiledTransform, Identity) {
+    CompiledTransform compiled;
+    ASSERT_TRUE(compiled.isRigid());
+    checkMatches(Transform());
+}
+
+TEST(CompiledTransform, RigidRouteAndRoom) {
+    auto xform = makeRouteTransform();
+    Transform room;
+    room.concatPost(Eigen::Isometry3d(Eigen::Translation3d(0, 0, 5)).matrix());
+    xform.transform(room);
+    ASSERT_TRUE(CompiledTransform(xform).isRigid());
+    checkMatches(xform);
+}
+
+TEST(CompiledTransform, Reflection) {
+    auto xform = makeRouteTransform();
+    xform.transform(makeMirrorTransform());
+    ASSERT_FALSE(CompiledTransform(xform).isRigid());
+    checkMatches(xform);
+}
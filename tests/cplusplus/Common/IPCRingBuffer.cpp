@@ -0,0 +1,138 @@
+/** @file
+    @brief Test Implementation: the lock-free single-writer mode of
+    IPCRingBuffer, with a writer thread racing a reader.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/IPCRingBuffer.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using osvr::common::IPCRingBuffer;
+
+namespace {
+static const uint32_t ENTRY_SIZE = 4096;
+static const uint32_t WRITES = 20000;
+
+IPCRingBuffer::Options makeOptions(const char *name) {
+    return IPCRingBuffer::Options(name)
+        .setEntrySize(ENTRY_SIZE)
+        .setEntries(4)
+        .setLockFree(true);
+}
+
+/// Every entry the writer puts is filled with a single byte value, so an
+/// entry mixing two values was torn.
+bool isUniform(IPCRingBuffer::BufferReadProxy const &entry) {
+    auto p = entry.get();
+    for (uint32_t i = 1; i < ENTRY_SIZE; ++i) {
+        if (p[i] != p[0]) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST(IPCRingBufferLockFree, ClientDetectsMode) {
+    auto server = IPCRingBuffer::create(makeOptions("osvr-test-rb-mode"));
+    ASSERT_TRUE(server);
+    auto client =
+        IPCRingBuffer::find(IPCRingBuffer::Options("osvr-test-rb-mode"));
+    ASSERT_TRUE(client);
+    ASSERT_TRUE(client->isLockFree());
+    ASSERT_EQ(IPCRingBuffer::getLockFreeABILevel(),
+              client->getInstanceABILevel());
+    ASSERT_FALSE(client->getLatest());
+}
+
+TEST(IPCRingBufferLockFree, RejectsEntriesBeingWrittenOrOverwritten) {
+    auto server = IPCRingBuffer::create(makeOptions("osvr-test-rb-reject"));
+    ASSERT_TRUE(server);
+    auto client =
+        IPCRingBuffer::find(IPCRingBuffer::Options("osvr-test-rb-reject"));
+    ASSERT_TRUE(client);
+    std::vector<uint8_t> buf(ENTRY_SIZE, 1);
+    ASSERT_EQ(0u, server->put(buf.data(), buf.size()));
+    ASSERT_TRUE(client->get(0));
+    {
+        /// A put in progress: the slot must not be readable until it's done.
+        auto proxy = server->put();
+        ASSERT_FALSE(client->get(proxy.getSequenceNumber()));
+    }
+    ASSERT_TRUE(client->get(1));
+
+    /// Lap the ring: entry 0 is gone, not silently replaced.
+    for (int i = 0; i < 4; ++i) {
+        server->put(buf.data(), buf.size());
+    }
+    ASSERT_FALSE(client->get(0));
+    ASSERT_TRUE(client->get(5));
+}
+
+TEST(IPCRingBufferLockFree, ConcurrentReaderNeverSeesTornEntry) {
+    auto server = IPCRingBuffer::create(makeOptions("osvr-test-rb-torn"));
+    ASSERT_TRUE(server);
+    auto client =
+        IPCRingBuffer::find(IPCRingBuffer::Options("osvr-test-rb-torn"));
+    ASSERT_TRUE(client);
+
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        std::vector<uint8_t> buf(ENTRY_SIZE);
+        for (uint32_t n = 0; n < WRITES; ++n) {
+            std::memset(buf.data(), n & 0xff, buf.size());
+            server->put(buf.data(), buf.size());
+        }
+        done = true;
+    });
+
+    std::size_t accepted = 0;
+    std::size_t torn = 0;
+    while (!done) {
+        auto entry = client->getLatest();
+        if (!entry) {
+            continue;
+        }
+        ++accepted;
+        if (!isUniform(entry)) {
+            ++torn;
+        }
+    }
+    /// Join before asserting, so a failure is reported rather than
+    /// terminating with a joinable thread.
+    writer.join();
+
+    EXPECT_EQ(0u, torn) << "out of " << accepted << " entries read";
+    auto last = client->get(WRITES - 1);
+    ASSERT_TRUE(last);
+    EXPECT_EQ((WRITES - 1) & 0xff, last.get()[0]);
+    EXPECT_TRUE(isUniform(last));
+}
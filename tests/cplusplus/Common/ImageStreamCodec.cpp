@@ -0,0 +1,208 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ImageStreamCodec.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <algorithm>
+#include <vector>
+
+using namespace osvr::common::imagestream;
+
+namespace {
+OSVR_ImagingMetadata makeMetadata(uint32_t width, uint32_t height) {
+    OSVR_ImagingMetadata ret;
+    ret.height = height;
+    ret.width = width;
+    ret.channels = 1;
+    ret.depth = 1;
+    ret.type = OSVR_IVT_UNSIGNED_INT;
+    return ret;
+}
+
+ByteVector makeImage(uint32_t width, uint32_t height, uint8_t frame) {
+    ByteVector ret(width * height, 0);
+    /// Mostly-black image with a moving bright square.
+    for (uint32_t y = 0; y < 8; ++y) {
+        for (uint32_t x = 0; x < 8; ++x) {
+            ret[(y + frame % (height - 8)) * width + x + frame % (width - 8)] =
+                200;
+        }
+    }
+    return ret;
+}
+
+Decoder::ChunkHeader makeHeader(Encoder::EncodedFrame const &frame,
+                                uint32_t offset) {
+    Decoder::ChunkHeader ret;
+    ret.metadata = frame.metadata;
+    ret.encoding = frame.encoding;
+    ret.frameId = frame.frameId;
+    ret.baseFrameId = frame.baseFrameId;
+    ret.totalBytes = static_cast<uint32_t>(frame.payload.size());
+    ret.offset = offset;
+    return ret;
+}
+} // namespace
+
+TEST(ImageStreamCodec, ZeroRunsRoundTrip) {
+    ByteVector input = {1, 0, 0, 0, 0, 2, 0, 3, 0, 0, 0, 0, 0, 0};
+    ByteVector encoded;
+    encodeZeroRuns(input.data(), input.size(), encoded);
+    ASSERT_LT(encoded.size(), input.size());
+    ByteVector output(input.size());
+    ASSERT_TRUE(decodeZeroRuns(encoded.data(), encoded.size(), output.data(),
+                               output.size()));
+    ASSERT_EQ(input, output);
+    ASSERT_FALSE(decodeZeroRuns(encoded.data(), encoded.size(), output.data(),
+                                output.size() - 1));
+}
+
+TEST(ImageStreamCodec, RegionAndDownscale) {
+    auto metadata = makeMetadata(16, 8);
+    ByteVector image(16 * 8);
+    for (std::size_t i = 0; i < image.size(); ++i) {
+        image[i] = static_cast<uint8_t>(i);
+    }
+    StreamSettings settings;
+    settings.roiX = 4;
+    settings.roiY = 2;
+    settings.roiWidth = 8;
+    settings.roiHeight = 4;
+    settings.downscale = 2;
+    ByteVector out;
+    auto outMetadata = extractRegion(metadata, image.data(), settings, out);
+    ASSERT_EQ(4u, outMetadata.width);
+    ASSERT_EQ(2u, outMetadata.height);
+    ASSERT_EQ(8u, out.size());
+    ASSERT_EQ(2 * 16 + 4, out[0]);
+    ASSERT_EQ(2 * 16 + 6, out[1]);
+    ASSERT_EQ(4 * 16 + 4, out[4]);
+}
+
+TEST(ImageStreamCodec, StreamRoundTrip) {
+    static const uint32_t CHUNK = 100;
+    auto metadata = makeMetadata(96, 96);
+    Encoder encoder;
+    Decoder decoder;
+    StreamSettings settings;
+    for (uint8_t i = 0; i < 40; ++i) {
+        auto image = makeImage(96, 96, i);
+        auto const &frame = encoder.encode(metadata, image.data(), settings);
+        if (i == 0 || i == Encoder::KEYFRAME_INTERVAL + 1) {
+            ASSERT_EQ(NO_BASE_FRAME, frame.baseFrameId);
+        } else {
+            ASSERT_EQ(Encoding::DeltaZeroRuns, frame.encoding);
+            ASSERT_LT(frame.payload.size(), image.size() / 4);
+        }
+        auto result = Decoder::Result::Incomplete;
+        uint32_t offset = 0;
+        do {
+            auto len = std::min<uint32_t>(
+                CHUNK, static_cast<uint32_t>(frame.payload.size()) - offset);
+            result = decoder.addChunk(makeHeader(frame, offset),
+                                      frame.payload.data() + offset, len);
+            offset += len;
+        } while (offset < frame.payload.size());
+        ASSERT_EQ(Decoder::Result::Complete, result);
+        ASSERT_EQ(image, decoder.getFrame());
+    }
+}
+
+TEST(ImageStreamCodec, LostChunkNeedsKeyframe) {
+    auto metadata = makeMetadata(96, 96);
+    Encoder encoder;
+    Decoder decoder;
+    StreamSettings settings;
+    settings.compress = false;
+    auto image = makeImage(96, 96, 0);
+    auto const &frame = encoder.encode(metadata, image.data(), settings);
+    ASSERT_EQ(Encoding::Raw, frame.encoding);
+    ASSERT_EQ(Decoder::Result::Incomplete,
+              decoder.addChunk(makeHeader(frame, 0), frame.payload.data(), 10));
+    /// Skip a chunk.
+    ASSERT_EQ(Decoder::Result::NeedKeyframe,
+              decoder.addChunk(makeHeader(frame, 20),
+                               frame.payload.data() + 20, 10));
+
+    /// A delta frame without its base can't be decoded either.
+    Encoder deltaEncoder;
+    Decoder deltaDecoder;
+    StreamSettings deltaSettings;
+    deltaEncoder.encode(metadata, image.data(), deltaSettings);
+    auto next = makeImage(96, 96, 1);
+    auto const &delta =
+        deltaEncoder.encode(metadata, next.data(), deltaSettings);
+    ASSERT_EQ(Encoding::DeltaZeroRuns, delta.encoding);
+    ASSERT_EQ(Decoder::Result::NeedKeyframe,
+              deltaDecoder.addChunk(
+                  makeHeader(delta, 0), delta.payload.data(),
+                  static_cast<uint32_t>(delta.payload.size())));
+    deltaEncoder.requestKeyframe();
+    auto const &key = deltaEncoder.encode(metadata, next.data(), deltaSettings);
+    ASSERT_EQ(NO_BASE_FRAME, key.baseFrameId);
+    ASSERT_EQ(Decoder::Result::Complete,
+              deltaDecoder.addChunk(makeHeader(key, 0), key.payload.data(),
+                                    key.payload.size()));
+    ASSERT_EQ(next, deltaDecoder.getFrame());
+}
+
+TEST(ImageStreamCodec, RejectsOversizedFrame) {
+    auto metadata = makeMetadata(96, 96);
+    Encoder encoder;
+    Decoder decoder;
+    StreamSettings settings;
+    settings.compress = false;
+    auto image = makeImage(96, 96, 0);
+    auto const &frame = encoder.encode(metadata, image.data(), settings);
+    /// A raw frame can't be bigger than its pixels.
+    auto header = makeHeader(frame, 0);
+    header.totalBytes = static_cast<uint32_t>(image.size() + 1);
+    ASSERT_EQ(Decoder::Result::NeedKeyframe,
+              decoder.addChunk(header, frame.payload.data(), 10));
+    /// Nor a compressed one anywhere near this big.
+    header.encoding = Encoding::ZeroRuns;
+    header.totalBytes = 0xffffffff;
+    ASSERT_EQ(Decoder::Result::NeedKeyframe,
+              decoder.addChunk(header, frame.payload.data(), 10));
+
+    /// The worst case for zero runs still fits.
+    Encoder compressingEncoder;
+    ByteVector worst(image.size(), 0);
+    for (std::size_t i = 3; i < worst.size(); i += 4) {
+        worst[i] = 1;
+    }
+    auto const &compressed =
+        compressingEncoder.encode(metadata, worst.data(), StreamSettings());
+    ASSERT_EQ(Encoding::ZeroRuns, compressed.encoding);
+    ASSERT_EQ(Decoder::Result::Complete,
+              decoder.addChunk(makeHeader(compressed, 0),
+                               compressed.payload.data(),
+                               compressed.payload.size()));
+    ASSERT_EQ(worst, decoder.getFrame());
+}
@@ -0,0 +1,184 @@
+/** @file
+    @brief Test Implementation: writing imaging frames in place with
+    ImagingComponent::acquireImageBuffer() and commitImageBuffer(), sent to a
+    client device on a loopback connection.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/BaseDevice.h>
+#include <osvr/Common/CreateDevice.h>
+#include <osvr/Common/ImagingComponent.h>
+#include <osvr/Connection/Connection.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <vrpn_Connection.h>
+#include <vrpn_ConnectionPtr.h>
+
+// Standard includes
+#include <string>
+#include <tuple>
+#include <vector>
+
+using osvr::common::ImagingComponent;
+using osvr::common::ImageData;
+
+namespace {
+OSVR_ImagingMetadata makeMetadata() {
+    OSVR_ImagingMetadata ret;
+    ret.height = 4;
+    ret.width = 8;
+    ret.channels = 1;
+    ret.depth = 1;
+    ret.type = OSVR_IVT_UNSIGNED_INT;
+    return ret;
+}
+
+static const std::size_t FRAME_BYTES = 4 * 8;
+
+/// A server device with an imaging component, and a client device of the
+/// same name, on one loopback connection.
+class ImagingLoopback {
+  public:
+    explicit ImagingLoopback(std::string const &name) {
+        auto conn = osvr::connection::Connection::createLoopbackConnection();
+        m_conn = std::get<1>(conn);
+        vrpn_ConnectionPtr vrpnConn(
+            static_cast<vrpn_Connection *>(std::get<0>(conn)));
+        m_server = osvr::common::createServerDevice(name, vrpnConn);
+        server = m_server->addComponent(ImagingComponent::create(1));
+        m_client = osvr::common::createClientDevice(name, vrpnConn);
+        client = m_client->addComponent(ImagingComponent::create(1));
+        client->registerImageHandler(
+            [&](ImageData const &data, osvr::util::time::TimeValue const &) {
+                frames.emplace_back(data.buffer.get(),
+                                    data.buffer.get() + FRAME_BYTES);
+            });
+    }
+
+    /// Runs both devices until the client has received a frame.
+    bool waitForFrame() {
+        for (int i = 0; i < 100 && frames.empty(); ++i) {
+            m_server->update();
+            m_client->update();
+        }
+        return !frames.empty();
+    }
+
+    ImagingComponent *server;
+    ImagingComponent *client;
+    std::vector<std::vector<OSVR_ImageBufferElement> > frames;
+
+  private:
+    osvr::connection::ConnectionPtr m_conn;
+    osvr::common::BaseDevicePtr m_server;
+    osvr::common::BaseDevicePtr m_client;
+};
+
+void fill(OSVR_ImageBufferElement *buf) {
+    for (std::size_t i = 0; i < FRAME_BYTES; ++i) {
+        buf[i] = static_cast<OSVR_ImageBufferElement>(i * 3);
+    }
+}
+
+void checkFrames(ImagingLoopback const &loopback) {
+    ASSERT_FALSE(loopback.frames.empty());
+    for (auto const &frame : loopback.frames) {
+        for (std::size_t i = 0; i < FRAME_BYTES; ++i) {
+            ASSERT_EQ(static_cast<OSVR_ImageBufferElement>(i * 3), frame[i]);
+        }
+    }
+}
+
+osvr::util::time::TimeValue now() { return osvr::util::time::getNow(); }
+} // namespace
+
+TEST(ImagingAcquireCommit, CommitSendsFrame) {
+    ImagingLoopback loopback{"TestImagingAcquire"};
+    auto buf = loopback.server->acquireImageBuffer(makeMetadata(), 0);
+    ASSERT_NE(nullptr, buf);
+    fill(buf);
+    ASSERT_TRUE(loopback.server->commitImageBuffer(0, now()));
+    ASSERT_TRUE(loopback.waitForFrame());
+    checkFrames(loopback);
+}
+
+TEST(ImagingAcquireCommit, CommitWithoutAcquireFails) {
+    ImagingLoopback loopback{"TestImagingNoAcquire"};
+    ASSERT_FALSE(loopback.server->commitImageBuffer(0, now()));
+
+    /// Each buffer can only be committed once.
+    auto buf = loopback.server->acquireImageBuffer(makeMetadata(), 0);
+    ASSERT_NE(nullptr, buf);
+    fill(buf);
+    ASSERT_TRUE(loopback.server->commitImageBuffer(0, now()));
+    ASSERT_FALSE(loopback.server->commitImageBuffer(0, now()));
+}
+
+TEST(ImagingAcquireCommit, ReleasedBufferIsNotSent) {
+    ImagingLoopback loopback{"TestImagingRelease"};
+    auto buf = loopback.server->acquireImageBuffer(makeMetadata(), 0);
+    ASSERT_NE(nullptr, buf);
+    loopback.server->releaseImageBuffer(0);
+    ASSERT_FALSE(loopback.server->commitImageBuffer(0, now()));
+    ASSERT_FALSE(loopback.waitForFrame());
+
+    /// Releasing a sensor with nothing acquired is harmless.
+    loopback.server->releaseImageBuffer(0);
+    loopback.server->releaseImageBuffer(5);
+
+    /// And the ring buffer entry, if any, was given back.
+    buf = loopback.server->acquireImageBuffer(makeMetadata(), 0);
+    ASSERT_NE(nullptr, buf);
+    fill(buf);
+    ASSERT_TRUE(loopback.server->commitImageBuffer(0, now()));
+    ASSERT_TRUE(loopback.waitForFrame());
+    checkFrames(loopback);
+}
+
+TEST(ImagingAcquireCommit, ReacquireAbandonsFirstBuffer) {
+    ImagingLoopback loopback{"TestImagingReacquire"};
+    auto first = loopback.server->acquireImageBuffer(makeMetadata(), 0);
+    ASSERT_NE(nullptr, first);
+    auto buf = loopback.server->acquireImageBuffer(makeMetadata(), 0);
+    ASSERT_NE(nullptr, buf);
+    fill(buf);
+    ASSERT_TRUE(loopback.server->commitImageBuffer(0, now()));
+    ASSERT_TRUE(loopback.waitForFrame());
+    checkFrames(loopback);
+}
+
+#ifndef _WIN32
+TEST(ImagingAcquireCommit, FallsBackToPrivateBufferWithoutSharedMemory) {
+    /// Too long a name for a POSIX shared memory object, so the ring buffer
+    /// can't be created: the frame is written to a private buffer, then sent
+    /// over the connection.
+    ImagingLoopback loopback{"TestImagingNoShm" + std::string(300, 'x')};
+    auto buf = loopback.server->acquireImageBuffer(makeMetadata(), 0);
+    ASSERT_NE(nullptr, buf);
+    fill(buf);
+    ASSERT_TRUE(loopback.server->commitImageBuffer(0, now()));
+    ASSERT_TRUE(loopback.waitForFrame());
+    checkFrames(loopback);
+}
+#endif
@@ -0,0 +1,114 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/InterfaceState.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <thread>
+
+using osvr::common::InterfaceState;
+using osvr::util::time::TimeValue;
+
+namespace {
+/// @brief Makes a pose report with every field, and the timestamp, derived
+/// from the same value, so a torn read is detectable.
+OSVR_PoseReport makePose(double v) {
+    OSVR_PoseReport ret;
+    ret.sensor = 0;
+    ret.pose.translation.data[0] = v;
+    ret.pose.translation.data[1] = v;
+    ret.pose.translation.data[2] = v;
+    ret.pose.rotation.data[0] = v;
+    ret.pose.rotation.data[1] = v;
+    ret.pose.rotation.data[2] = v;
+    ret.pose.rotation.data[3] = v;
+    return ret;
+}
+} // namespace
+
+TEST(InterfaceState, GetStateWithoutState) {
+    InterfaceState state;
+    TimeValue timestamp;
+    OSVR_PoseState pose;
+    ASSERT_FALSE(state.getState<OSVR_PoseReport>(timestamp, pose));
+}
+
+TEST(InterfaceState, HasStateOnceSet) {
+    InterfaceState state;
+    ASSERT_FALSE(state.hasAnyState());
+    ASSERT_FALSE(state.hasState<OSVR_PoseReport>());
+    TimeValue timestamp = {};
+    state.setStateFromReport(timestamp, makePose(1));
+    ASSERT_TRUE(state.hasAnyState());
+    ASSERT_TRUE(state.hasState<OSVR_PoseReport>());
+    ASSERT_FALSE(state.hasState<OSVR_ButtonReport>());
+}
+
+TEST(InterfaceState, ConcurrentReadsNeverTear) {
+    InterfaceState state;
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (int i = 0; i < 200000; ++i) {
+            TimeValue timestamp;
+            timestamp.seconds = i;
+            timestamp.microseconds = 0;
+            state.setStateFromReport(timestamp, makePose(i));
+        }
+        done = true;
+    });
+
+    std::size_t reads = 0;
+    std::size_t torn = 0;
+    std::size_t missing = 0;
+    while (!done) {
+        TimeValue timestamp;
+        OSVR_PoseState pose;
+        if (!state.getState<OSVR_PoseReport>(timestamp, pose)) {
+            continue;
+        }
+        ++reads;
+        if (!state.hasState<OSVR_PoseReport>()) {
+            ++missing;
+        }
+        auto v = static_cast<double>(timestamp.seconds);
+        if (v != pose.translation.data[0] || v != pose.translation.data[1] ||
+            v != pose.translation.data[2] || v != pose.rotation.data[0] ||
+            v != pose.rotation.data[1] || v != pose.rotation.data[2] ||
+            v != pose.rotation.data[3]) {
+            ++torn;
+        }
+    }
+    /// Join before asserting, so a failure is reported rather than
+    /// terminating with a joinable thread.
+    writer.join();
+
+    EXPECT_EQ(0u, torn) << "out of " << reads << " reads";
+    EXPECT_EQ(0u, missing);
+    EXPECT_GT(reads, 0u);
+}
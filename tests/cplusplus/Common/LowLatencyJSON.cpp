@@ -0,0 +1,117 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/LowLatencyJSON.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/reader.h>
+
+// Standard includes
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using osvr::common::LowLatencyOptions;
+using osvr::common::ThreadLatencyOptions;
+using osvr::common::parseLowLatencyOptions;
+using osvr::common::parseThreadLatencyOptions;
+using Scheduler = ThreadLatencyOptions::Scheduler;
+
+namespace {
+Json::Value parse(std::string const &json) {
+    Json::Value ret;
+    Json::Reader reader;
+    if (!reader.parse(json, ret)) {
+        throw std::runtime_error("Bad test JSON: " + json);
+    }
+    return ret;
+}
+} // namespace
+
+TEST(LowLatencyJSON, EmptyGivesDefaults) {
+    ThreadLatencyOptions devices;
+    devices.priority = 42;
+    auto opts = parseLowLatencyOptions(parse("{}"), devices);
+    ASSERT_EQ(Scheduler::Default, opts.thread.scheduler);
+    ASSERT_TRUE(opts.thread.cpus.empty());
+    ASSERT_FALSE(opts.thread.minimizeTimerSlack);
+    ASSERT_FALSE(opts.lockMemory);
+    ASSERT_EQ(0u, opts.prefaultBytes);
+    ASSERT_EQ(Scheduler::Default, devices.scheduler);
+    ASSERT_EQ(ThreadLatencyOptions().priority, devices.priority);
+}
+
+TEST(LowLatencyJSON, FullConfig) {
+    ThreadLatencyOptions devices;
+    auto opts = parseLowLatencyOptions(
+        parse(R"({
+            "serverThread": {"scheduler": "fifo", "priority": 50,
+                             "cpus": [2, 3], "minimizeTimerSlack": true},
+            "deviceThreads": {"scheduler": "rr", "priority": 40,
+                              "cpus": [1]},
+            "lockMemory": true,
+            "prefaultBytes": 1048576
+        })"),
+        devices);
+    ASSERT_EQ(Scheduler::Fifo, opts.thread.scheduler);
+    ASSERT_EQ(50, opts.thread.priority);
+    ASSERT_EQ((std::vector<int>{2, 3}), opts.thread.cpus);
+    ASSERT_TRUE(opts.thread.minimizeTimerSlack);
+    ASSERT_TRUE(opts.lockMemory);
+    ASSERT_EQ(1048576u, opts.prefaultBytes);
+
+    ASSERT_EQ(Scheduler::RoundRobin, devices.scheduler);
+    ASSERT_EQ(40, devices.priority);
+    ASSERT_EQ((std::vector<int>{1}), devices.cpus);
+    ASSERT_FALSE(devices.minimizeTimerSlack);
+}
+
+TEST(LowLatencyJSON, MistypedValuesIgnored) {
+    auto opts = parseThreadLatencyOptions(
+        parse(R"({"priority": "high", "cpus": [0, "one", 2],
+                  "minimizeTimerSlack": 1})"));
+    ASSERT_EQ(ThreadLatencyOptions().priority, opts.priority);
+    ASSERT_EQ((std::vector<int>{0, 2}), opts.cpus);
+    ASSERT_FALSE(opts.minimizeTimerSlack);
+
+    ThreadLatencyOptions devices;
+    auto lowLatency = parseLowLatencyOptions(
+        parse(R"({"lockMemory": "yes", "prefaultBytes": -1})"), devices);
+    ASSERT_FALSE(lowLatency.lockMemory);
+    ASSERT_EQ(0u, lowLatency.prefaultBytes);
+}
+
+TEST(LowLatencyJSON, SchedulerNames) {
+    ASSERT_EQ(Scheduler::Default,
+              parseThreadLatencyOptions(parse(R"({"scheduler": "default"})"))
+                  .scheduler);
+    ASSERT_EQ(
+        Scheduler::RoundRobin,
+        parseThreadLatencyOptions(parse(R"({"scheduler": "rr"})")).scheduler);
+    ASSERT_THROW(parseThreadLatencyOptions(parse(R"({"scheduler": "FIFO"})")),
+                 std::invalid_argument);
+}
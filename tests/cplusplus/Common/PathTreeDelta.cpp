@@ -0,0 +1,197 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DummyTree.h"
+#include <osvr/Common/PathTreeOwner.h>
+#include <osvr/Common/PathTreeObserver.h>
+#include <osvr/Common/PathTreeSerialization.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/variant/get.hpp>
+
+// Standard includes
+#include <string>
+
+namespace common = osvr::common;
+using osvr::common::PathTree;
+using osvr::common::PathTreeEvents;
+
+namespace {
+Json::Value getNode(Json::Value const &nodes, std::string const &path) {
+    for (auto const &node : nodes) {
+        if (node["path"].asString() == path) {
+            return node;
+        }
+    }
+    return Json::Value();
+}
+
+Json::Value makeDelta(Json::UInt base, Json::UInt generation) {
+    Json::Value ret(Json::objectValue);
+    ret["base"] = base;
+    ret["generation"] = generation;
+    ret["set"] = Json::Value(Json::arrayValue);
+    ret["remove"] = Json::Value(Json::arrayValue);
+    return ret;
+}
+
+std::string getAliasSource(PathTree &tree) {
+    auto const &elt = tree.getNodeByPath(dummy::getAlias()).value();
+    return boost::get<common::elements::AliasElement>(elt).getSource();
+}
+} // namespace
+
+class PathTreeDelta : public ::testing::Test {
+  public:
+    PathTreeDelta() : observer(owner.makeObserver()) {
+        PathTree tree;
+        setupDummyTree(tree);
+        full = common::pathTreeToJson(tree);
+
+        PathTree changed;
+        setupDummyTree(changed);
+        changed.getNodeByPath(dummy::getAlias()).value() =
+            common::elements::AliasElement("/other");
+        changedFull = common::pathTreeToJson(changed);
+        changedAlias = getNode(changedFull, dummy::getAlias());
+
+        observer->setEventCallback(PathTreeEvents::AfterUpdate,
+                                   [&](PathTree &) { ++updates; });
+        observer->setEventCallback(PathTreeEvents::AfterPatch,
+                                   [&](PathTree &) { ++patches; });
+    }
+
+    /// @brief Simulate a server sending generation 1 to a new client.
+    void receiveInitialTree() {
+        ASSERT_FALSE(owner.applyTreeDelta(makeDelta(0, 1)));
+        owner.replaceTree(full);
+        ASSERT_EQ(1, updates);
+    }
+
+    common::PathTreeOwner owner;
+    common::PathTreeObserverPtr observer;
+    Json::Value full;
+    Json::Value changedFull;
+    Json::Value changedAlias;
+    int updates = 0;
+    int patches = 0;
+};
+
+TEST_F(PathTreeDelta, DeltaWithoutTreeIsIgnored) {
+    ASSERT_FALSE(owner.applyTreeDelta(makeDelta(0, 1)));
+    ASSERT_FALSE(bool(owner));
+    ASSERT_EQ(0, patches);
+}
+
+TEST_F(PathTreeDelta, DeltaSkipsFollowingFullTree) {
+    receiveInitialTree();
+    ASSERT_EQ(dummy::getFullSourcePath(), getAliasSource(owner.get()));
+
+    auto delta = makeDelta(1, 2);
+    delta["set"].append(changedAlias);
+    ASSERT_TRUE(owner.applyTreeDelta(delta));
+    ASSERT_EQ(1, patches);
+    ASSERT_EQ("/other", getAliasSource(owner.get()));
+
+    /// The matching full tree is redundant, so it must not trigger a rebuild
+    /// (we pass the stale tree to make sure it wasn't applied).
+    owner.replaceTree(full);
+    ASSERT_EQ(1, updates);
+    ASSERT_EQ("/other", getAliasSource(owner.get()));
+
+    /// But the next one without a delta is.
+    owner.replaceTree(full);
+    ASSERT_EQ(2, updates);
+    ASSERT_EQ(dummy::getFullSourcePath(), getAliasSource(owner.get()));
+}
+
+TEST_F(PathTreeDelta, MismatchedBaseFallsBackToFullTree) {
+    receiveInitialTree();
+
+    auto delta = makeDelta(5, 6);
+    delta["set"].append(changedAlias);
+    ASSERT_FALSE(owner.applyTreeDelta(delta));
+    ASSERT_EQ(0, patches);
+    ASSERT_EQ(dummy::getFullSourcePath(), getAliasSource(owner.get()));
+
+    owner.replaceTree(changedFull);
+    ASSERT_EQ(2, updates);
+    ASSERT_EQ("/other", getAliasSource(owner.get()));
+
+    /// We've adopted the full tree's generation.
+    ASSERT_TRUE(owner.applyTreeDelta(makeDelta(6, 7)));
+}
+
+TEST_F(PathTreeDelta, AnnouncedFullTreeSkippedWhenUpToDate) {
+    receiveInitialTree();
+
+    /// A full tree sent for another client, announced by an empty delta.
+    ASSERT_TRUE(owner.applyTreeDelta(makeDelta(1, 1)));
+    ASSERT_EQ(0, patches);
+    owner.replaceTree(changedFull);
+    ASSERT_EQ(1, updates);
+    ASSERT_EQ(dummy::getFullSourcePath(), getAliasSource(owner.get()));
+    ASSERT_FALSE(owner.takeFullTreeRequest());
+}
+
+TEST_F(PathTreeDelta, UnchangedFullTreeIgnored) {
+    receiveInitialTree();
+    owner.replaceTree(full);
+    ASSERT_EQ(1, updates);
+}
+
+TEST_F(PathTreeDelta, MissedDeltaRequestsFullTreeOnce) {
+    receiveInitialTree();
+    ASSERT_FALSE(owner.takeFullTreeRequest());
+
+    ASSERT_FALSE(owner.applyTreeDelta(makeDelta(5, 6)));
+    ASSERT_TRUE(owner.takeFullTreeRequest());
+    ASSERT_FALSE(owner.takeFullTreeRequest());
+
+    /// Already asked: more deltas don't ask again.
+    ASSERT_FALSE(owner.applyTreeDelta(makeDelta(6, 7)));
+    ASSERT_FALSE(owner.takeFullTreeRequest());
+
+    /// The requested tree, which is announced so needs no further request.
+    ASSERT_FALSE(owner.applyTreeDelta(makeDelta(7, 7)));
+    ASSERT_FALSE(owner.takeFullTreeRequest());
+    owner.replaceTree(changedFull);
+    ASSERT_EQ(2, updates);
+    ASSERT_TRUE(owner.applyTreeDelta(makeDelta(7, 8)));
+
+    /// Once we have a tree, we'd ask again.
+    ASSERT_FALSE(owner.applyTreeDelta(makeDelta(9, 10)));
+    ASSERT_TRUE(owner.takeFullTreeRequest());
+}
+
+TEST_F(PathTreeDelta, RemovedNodesBecomeNull) {
+    receiveInitialTree();
+    auto delta = makeDelta(1, 2);
+    delta["remove"].append(dummy::getAlias());
+    ASSERT_TRUE(owner.applyTreeDelta(delta));
+    ASSERT_TRUE(boost::get<common::elements::NullElement>(
+        &owner.get().getNodeByPath(dummy::getAlias()).value()));
+}
@@ -0,0 +1,164 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/InterfaceState.h>
+#include <osvr/Common/PosePrediction.h>
+#include <osvr/Util/Pose3C.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+using osvr::common::getPoseStateAtTime;
+using osvr::common::InterfaceState;
+using osvr::common::predictPose;
+using osvr::util::fromQuat;
+using osvr::util::toQuat;
+using osvr::util::vecMap;
+using osvr::util::time::TimeValue;
+
+namespace {
+static const double QUARTER_TURN = 1.5707963267948966;
+
+OSVR_VelocityState makeVelocity() {
+    OSVR_VelocityState ret;
+    vecMap(ret.linearVelocity) = Eigen::Vector3d(1, 0, 0);
+    ret.linearVelocityValid = true;
+    /// 90 degrees per second about +Z, expressed over a 0.02 s interval.
+    Eigen::AngleAxisd incRot(QUARTER_TURN * 0.02, Eigen::Vector3d::UnitZ());
+    toQuat(Eigen::Quaterniond(incRot), ret.angularVelocity.incrementalRotation);
+    ret.angularVelocity.dt = 0.02;
+    ret.angularVelocityValid = true;
+    return ret;
+}
+
+TimeValue makeTime(OSVR_TimeValue_Microseconds microseconds) {
+    TimeValue ret = {10, microseconds};
+    return ret;
+}
+
+/// @brief An interface state with an identity pose at 10 s, and a linear
+/// velocity of 1 m/s along X at the given time.
+void setPoseAndVelocity(InterfaceState &state, TimeValue const &velTime) {
+    OSVR_PoseReport pose;
+    pose.sensor = 0;
+    osvrPose3SetIdentity(&pose.pose);
+    state.setStateFromReport(makeTime(0), pose);
+
+    OSVR_VelocityReport vel;
+    vel.sensor = 0;
+    vel.state = OSVR_VelocityState{};
+    vecMap(vel.state.linearVelocity) = Eigen::Vector3d(1, 0, 0);
+    vel.state.linearVelocityValid = true;
+    state.setStateFromReport(velTime, vel);
+}
+
+double predictX(InterfaceState const &state, TimeValue const &target) {
+    TimeValue timestamp;
+    OSVR_PoseState pose;
+    EXPECT_TRUE(getPoseStateAtTime(state, target, timestamp, pose));
+    EXPECT_EQ(makeTime(0), timestamp);
+    return pose.translation.data[0];
+}
+} // namespace
+
+TEST(PosePrediction, ConstantVelocity) {
+    OSVR_PoseState pose;
+    osvrPose3SetIdentity(&pose);
+    predictPose(pose, makeVelocity(), nullptr, 0.1);
+    ASSERT_TRUE(
+        vecMap(pose.translation).isApprox(Eigen::Vector3d(0.1, 0, 0)));
+    Eigen::Quaterniond expected(
+        Eigen::AngleAxisd(QUARTER_TURN * 0.1, Eigen::Vector3d::UnitZ()));
+    ASSERT_TRUE(fromQuat(pose.rotation).isApprox(expected));
+}
+
+TEST(PosePrediction, InvalidComponentsIgnored) {
+    OSVR_PoseState pose;
+    osvrPose3SetIdentity(&pose);
+    auto vel = makeVelocity();
+    vel.linearVelocityValid = false;
+    vel.angularVelocityValid = false;
+    predictPose(pose, vel, nullptr, 0.1);
+    ASSERT_TRUE(vecMap(pose.translation).isZero());
+    ASSERT_TRUE(
+        fromQuat(pose.rotation).isApprox(Eigen::Quaterniond::Identity()));
+}
+
+TEST(PosePrediction, ConstantAcceleration) {
+    OSVR_PoseState pose;
+    osvrPose3SetIdentity(&pose);
+    OSVR_VelocityState vel = {};
+    OSVR_AccelerationState accel = {};
+    vecMap(accel.linearAcceleration) = Eigen::Vector3d(0, -10, 0);
+    accel.linearAccelerationValid = true;
+    predictPose(pose, vel, &accel, 0.1);
+    ASSERT_TRUE(
+        vecMap(pose.translation).isApprox(Eigen::Vector3d(0, -0.05, 0)));
+}
+
+TEST(PosePrediction, AtTimeWithoutPose) {
+    InterfaceState state;
+    TimeValue timestamp;
+    OSVR_PoseState pose;
+    ASSERT_FALSE(getPoseStateAtTime(state, makeTime(0), timestamp, pose));
+}
+
+TEST(PosePrediction, AtTimeExtrapolates) {
+    InterfaceState state;
+    setPoseAndVelocity(state, makeTime(0));
+    ASSERT_NEAR(0.05, predictX(state, makeTime(50000)), 1e-9);
+}
+
+TEST(PosePrediction, AtTimeBeforePoseIsUnmodified) {
+    InterfaceState state;
+    setPoseAndVelocity(state, makeTime(0));
+    TimeValue before = {9, 900000};
+    ASSERT_EQ(0, predictX(state, before));
+}
+
+TEST(PosePrediction, AtTimeClampsInterval) {
+    InterfaceState state;
+    setPoseAndVelocity(state, makeTime(50000));
+    /// 0.12 s past the pose, but only extrapolated over 0.1 s.
+    ASSERT_NEAR(osvr::common::MAX_POSE_PREDICTION_INTERVAL,
+                predictX(state, makeTime(120000)), 1e-9);
+}
+
+TEST(PosePrediction, AtTimeIgnoresVelocityOlderThanPose) {
+    InterfaceState state;
+    TimeValue velTime = {9, 990000};
+    setPoseAndVelocity(state, velTime);
+    ASSERT_EQ(0, predictX(state, makeTime(50000)));
+}
+
+TEST(PosePrediction, AtTimeIgnoresStaleVelocity) {
+    InterfaceState state;
+    setPoseAndVelocity(state, makeTime(0));
+    /// Velocity is 0.15 s older than the target time.
+    ASSERT_EQ(0, predictX(state, makeTime(150000)));
+}
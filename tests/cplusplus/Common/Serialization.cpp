@@ -24,9 +24,11 @@
 // limitations under the License.
 
 // Internal Includes
+#include <osvr/Common/AnalogDeltaMessage.h>
 #include <osvr/Common/Serialization.h>
 #include <osvr/Common/Buffer.h>
 #include <osvr/Common/BufferTraits.h>
+#include <osvr/Common/TrackerBatchMessage.h>
 #include <osvr/Util/StdInt.h>
 
 // Library/third-party includes
@@ -34,6 +36,7 @@
 
 // Standard includes
 #include <string>
+#include <vector>
 
 using osvr::common::Buffer;
 
@@ -359,3 +362,92 @@ TEST(Serialization, SelfDescriptive) {
         ASSERT_EQ(data.c, 3);
     }
 }
+
+TEST(TrackerBatchSerialization, RoundTrip) {
+    std::vector<OSVR_TrackerBatchEntry> entries(2);
+    entries[0] = OSVR_TrackerBatchEntry{};
+    entries[0].sensor = 3;
+    entries[0].poseValid = OSVR_TRUE;
+    entries[0].pose.translation.data[2] = -1.5;
+    entries[0].pose.rotation.data[0] = 1;
+    entries[1] = OSVR_TrackerBatchEntry{};
+    entries[1].sensor = 7;
+    entries[1].velocity.angularVelocityValid = OSVR_TRUE;
+    entries[1].velocity.angularVelocity.dt = 0.01;
+    entries[1].velocity.angularVelocity.incrementalRotation.data[0] = 1;
+
+    Buffer<> buf;
+    {
+        osvr::common::messages::TrackerBatch::MessageSerialization msg(
+            entries.data(), entries.size());
+        osvr::common::serialize(buf, msg);
+    }
+
+    std::vector<OSVR_TrackerBatchEntry> result;
+    {
+        osvr::common::messages::TrackerBatch::MessageSerialization msg(result);
+        auto reader = buf.startReading();
+        osvr::common::deserialize(reader, msg);
+        ASSERT_EQ(reader.bytesRemaining(), 0);
+    }
+    ASSERT_EQ(result.size(), 2);
+    ASSERT_EQ(result[0].sensor, 3);
+    ASSERT_EQ(result[0].poseValid, OSVR_TRUE);
+    ASSERT_EQ(result[0].pose.translation.data[2], -1.5);
+    ASSERT_EQ(result[0].pose.rotation.data[0], 1);
+    ASSERT_EQ(result[0].velocity.linearVelocityValid, OSVR_FALSE);
+    ASSERT_EQ(result[0].velocity.angularVelocityValid, OSVR_FALSE);
+    ASSERT_EQ(result[1].sensor, 7);
+    ASSERT_EQ(result[1].poseValid, OSVR_FALSE);
+    ASSERT_EQ(result[1].velocity.angularVelocityValid, OSVR_TRUE);
+    ASSERT_EQ(result[1].velocity.angularVelocity.dt, 0.01);
+    ASSERT_EQ(
+        result[1].velocity.angularVelocity.incrementalRotation.data[0], 1);
+    ASSERT_EQ(result[1].acceleration.linearAccelerationValid, OSVR_FALSE);
+}
+
+TEST(TrackerBatchSerialization, TruncatedThrows) {
+    OSVR_TrackerBatchEntry entry = {};
+    entry.poseValid = OSVR_TRUE;
+    Buffer<> buf;
+    osvr::common::messages::TrackerBatch::MessageSerialization msg(&entry, 1);
+    osvr::common::serialize(buf, msg);
+
+    std::vector<OSVR_TrackerBatchEntry> result;
+    osvr::common::messages::TrackerBatch::MessageSerialization in(result);
+    auto reader = osvr::common::readExternalBuffer(buf.data(), buf.size() - 1);
+    ASSERT_THROW(osvr::common::deserialize(reader, in), std::runtime_error);
+}
+
+TEST(AnalogDeltaSerialization, RoundTrip) {
+    using osvr::common::messages::AnalogDelta;
+    using osvr::common::messages::AnalogDeltaEntry;
+    std::vector<AnalogDeltaEntry> entries = {{2, 0.123456}, {40, -7.5}};
+    for (auto quantum : {0., 0.001}) {
+        Buffer<> buf;
+        {
+            AnalogDelta::MessageSerialization msg(false, 64, quantum,
+                                                  entries.data(),
+                                                  entries.size());
+            osvr::common::serialize(buf, msg);
+            ASSERT_EQ(osvr::common::getBufferSpaceRequired(msg), buf.size());
+        }
+
+        std::vector<AnalogDeltaEntry> result;
+        AnalogDelta::MessageSerialization msg(result);
+        auto reader = buf.startReading();
+        osvr::common::deserialize(reader, msg);
+        ASSERT_EQ(reader.bytesRemaining(), 0);
+        ASSERT_FALSE(msg.isFull());
+        ASSERT_EQ(msg.getNumChannels(), 64);
+        ASSERT_EQ(result.size(), 2);
+        ASSERT_EQ(result[0].channel, 2);
+        ASSERT_EQ(result[1].channel, 40);
+        if (quantum > 0) {
+            ASSERT_DOUBLE_EQ(result[0].value, 0.123);
+        } else {
+            ASSERT_EQ(result[0].value, 0.123456);
+        }
+        ASSERT_DOUBLE_EQ(result[1].value, -7.5);
+    }
+}
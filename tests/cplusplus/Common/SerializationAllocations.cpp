@@ -0,0 +1,156 @@
+/** @file
+    @brief Test Implementation: allocations made serializing messages, with
+    fresh and reused buffers.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/TrackerBatchMessage.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+std::size_t g_allocations = 0;
+
+/// Allocator that counts the allocations made through it.
+template <typename T> struct CountingAllocator : std::allocator<T> {
+    template <typename U> struct rebind { typedef CountingAllocator<U> other; };
+    CountingAllocator() {}
+    template <typename U>
+    CountingAllocator(CountingAllocator<U> const &other)
+        : std::allocator<T>(other) {}
+    T *allocate(std::size_t n) {
+        ++g_allocations;
+        return std::allocator<T>::allocate(n);
+    }
+};
+
+typedef osvr::common::Buffer<std::vector<char, CountingAllocator<char> > >
+    CountingBuffer;
+
+/// Message with a mix of fields needing alignment padding and a
+/// variable-length one, like the component messages.
+class MixedMessage {
+  public:
+    MixedMessage(std::string const &name) : m_name(name) {}
+    template <typename T> void processMessage(T &p) {
+        p(m_flag);
+        p(m_value);
+        p(m_name);
+        p(m_enabled);
+        p(m_kind, osvr::common::serialization::EnumAsIntegerTag<Kind,
+                                                                 uint16_t>());
+        p(m_count);
+    }
+
+  private:
+    enum Kind { KIND_A, KIND_B };
+    uint8_t m_flag = 1;
+    bool m_enabled = true;
+    Kind m_kind = KIND_B;
+    double m_value = 2.5;
+    std::string m_name;
+    uint32_t m_count = 42;
+};
+
+std::vector<OSVR_TrackerBatchEntry> makeBatch() {
+    std::vector<OSVR_TrackerBatchEntry> entries(3);
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        auto &entry = entries[i];
+        entry = OSVR_TrackerBatchEntry{};
+        entry.sensor = static_cast<OSVR_ChannelCount>(i);
+        entry.poseValid = OSVR_TRUE;
+        entry.pose.rotation.data[0] = 1.;
+        entry.velocity.linearVelocityValid = (i % 2) ? OSVR_TRUE : OSVR_FALSE;
+    }
+    return entries;
+}
+
+static const std::size_t ITERATIONS = 100;
+
+/// Serializes ITERATIONS copies of msg, with a fresh buffer each time or one
+/// reused buffer, returning allocations per message.
+template <typename MessageClass>
+double allocationsPerMessage(MessageClass &msg, bool reuse) {
+    CountingBuffer reused;
+    g_allocations = 0;
+    for (std::size_t i = 0; i < ITERATIONS; ++i) {
+        if (reuse) {
+            reused.clear();
+            osvr::common::serialize(reused, msg);
+        } else {
+            CountingBuffer buf;
+            osvr::common::serialize(buf, msg);
+        }
+    }
+    return static_cast<double>(g_allocations) / ITERATIONS;
+}
+} // namespace
+
+TEST(SerializationSpaceRequired, MatchesSerializedSize) {
+    MixedMessage mixed("com.osvr.example");
+    for (std::size_t existing = 0; existing < 8; ++existing) {
+        osvr::common::Buffer<> buf;
+        buf.appendPadding(existing);
+        auto required = osvr::common::getBufferSpaceRequired(mixed, existing);
+        osvr::common::serialize(buf, mixed);
+        ASSERT_EQ(existing + required, buf.size());
+    }
+
+    auto entries = makeBatch();
+    osvr::common::messages::TrackerBatch::MessageSerialization batch(
+        entries.data(), entries.size());
+    osvr::common::Buffer<> buf;
+    auto required = osvr::common::getBufferSpaceRequired(batch);
+    osvr::common::serialize(buf, batch);
+    ASSERT_EQ(required, buf.size());
+}
+
+TEST(SerializationAllocations, FreshBufferAllocatesOnce) {
+    MixedMessage mixed("com.osvr.example");
+    ASSERT_EQ(1., allocationsPerMessage(mixed, false));
+
+    auto entries = makeBatch();
+    osvr::common::messages::TrackerBatch::MessageSerialization batch(
+        entries.data(), entries.size());
+    ASSERT_EQ(1., allocationsPerMessage(batch, false));
+}
+
+TEST(SerializationAllocations, ReusedBufferDoesNotAllocate) {
+    MixedMessage mixed("com.osvr.example");
+    ASSERT_LT(allocationsPerMessage(mixed, true), 2. / ITERATIONS);
+
+    auto entries = makeBatch();
+    osvr::common::messages::TrackerBatch::MessageSerialization batch(
+        entries.data(), entries.size());
+    ASSERT_LT(allocationsPerMessage(batch, true), 2. / ITERATIONS);
+}
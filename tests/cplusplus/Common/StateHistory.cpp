@@ -0,0 +1,117 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/InterfaceState.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+using osvr::common::InterfaceState;
+using osvr::util::time::TimeValue;
+
+namespace {
+TimeValue makeTime(OSVR_TimeValue_Seconds sec,
+                   OSVR_TimeValue_Microseconds us) {
+    TimeValue ret;
+    ret.seconds = sec;
+    ret.microseconds = us;
+    return ret;
+}
+
+OSVR_AnalogReport makeAnalog(double v) {
+    OSVR_AnalogReport ret;
+    ret.sensor = 0;
+    ret.state = v;
+    return ret;
+}
+
+OSVR_PositionReport makePosition(double x) {
+    OSVR_PositionReport ret;
+    ret.sensor = 0;
+    ret.xyz.data[0] = x;
+    ret.xyz.data[1] = 0;
+    ret.xyz.data[2] = 0;
+    return ret;
+}
+} // namespace
+
+TEST(StateHistory, DisabledByDefault) {
+    InterfaceState state;
+    state.setStateFromReport(makeTime(1, 0), makeAnalog(1));
+    ASSERT_EQ(nullptr, state.getHistory<OSVR_AnalogReport>());
+}
+
+TEST(StateHistory, RingKeepsNewest) {
+    InterfaceState state;
+    state.setHistoryCapacity(4);
+    for (int i = 0; i < 10; ++i) {
+        state.setStateFromReport(makeTime(i, 0), makeAnalog(i));
+    }
+    /// Only the report types that arrived get a history.
+    ASSERT_EQ(nullptr, state.getHistory<OSVR_ButtonReport>());
+    auto history = state.getHistory<OSVR_AnalogReport>();
+    ASSERT_NE(nullptr, history);
+    ASSERT_EQ(4u, history->size());
+    for (std::size_t i = 0; i < history->size(); ++i) {
+        ASSERT_EQ(6. + i, (*history)[i].state);
+    }
+
+    ASSERT_EQ(7., history->getNearest(makeTime(7, 400000))->state);
+    ASSERT_EQ(8., history->getNearest(makeTime(7, 600000))->state);
+    ASSERT_EQ(6., history->getNearest(makeTime(0, 0))->state);
+    ASSERT_EQ(9., history->getNearest(makeTime(100, 0))->state);
+
+    state.setHistoryCapacity(0);
+    ASSERT_EQ(nullptr, state.getHistory<OSVR_AnalogReport>());
+}
+
+TEST(StateHistory, Interpolation) {
+    InterfaceState state;
+    state.setHistoryCapacity(8);
+    state.setStateFromReport(makeTime(1, 0), makePosition(0));
+    state.setStateFromReport(makeTime(2, 0), makePosition(10));
+    auto history = state.getHistory<OSVR_PositionReport>();
+    ASSERT_NE(nullptr, history);
+
+    using Entry = osvr::common::StateMapContents<OSVR_PositionReport>;
+    Entry const *before = nullptr;
+    Entry const *after = nullptr;
+    double alpha = 0;
+    ASSERT_TRUE(
+        history->getBracket(makeTime(1, 250000), before, after, alpha));
+    ASSERT_DOUBLE_EQ(0.25, alpha);
+    auto interp =
+        osvr::common::interpolateState(before->state, after->state, alpha);
+    ASSERT_DOUBLE_EQ(2.5, interp.data[0]);
+
+    ASSERT_TRUE(history->getBracket(makeTime(2, 0), before, after, alpha));
+    ASSERT_EQ(before, after);
+
+    ASSERT_FALSE(history->getBracket(makeTime(0, 0), before, after, alpha));
+    ASSERT_FALSE(history->getBracket(makeTime(3, 0), before, after, alpha));
+}
@@ -0,0 +1,135 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/Tracing.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/reader.h>
+#include <json/value.h>
+
+// Standard includes
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+
+namespace tracing = osvr::common::tracing;
+
+#ifdef OSVR_COMMON_TRACING_RING_BUFFER
+namespace {
+static const char TRACE_FILE[] = "osvr-test-trace.json";
+
+/// @brief Writes the trace so far and parses it back.
+Json::Value writeAndParseTrace() {
+    Json::Value ret;
+    EXPECT_TRUE(tracing::writeTraceFile(TRACE_FILE));
+    std::ifstream is(TRACE_FILE);
+    Json::Reader reader;
+    EXPECT_TRUE(reader.parse(is, ret)) << reader.getFormattedErrorMessages();
+    is.close();
+    std::remove(TRACE_FILE);
+    return ret;
+}
+
+/// @brief Returns the last event with the given name, or null if none.
+Json::Value findEvent(Json::Value const &trace, std::string const &name) {
+    Json::Value ret;
+    for (auto const &ev : trace["traceEvents"]) {
+        if (ev["name"].asString() == name) {
+            ret = ev;
+        }
+    }
+    return ret;
+}
+} // namespace
+
+TEST(TracingRingBuffer, WritesRecordedEvents) {
+    {
+        tracing::ServerUpdate region;
+        tracing::markPathTreeBroadcast();
+    }
+    std::thread worker([] {
+        tracing::WorkerTracePolicy::mark("worker \"quoted\"\\mark");
+    });
+    worker.join();
+
+    auto trace = writeAndParseTrace();
+    ASSERT_TRUE(trace["traceEvents"].isArray());
+
+    auto region = findEvent(trace, "ServerUpdate");
+    ASSERT_TRUE(region.isObject());
+    EXPECT_EQ("X", region["ph"].asString());
+    EXPECT_EQ("main", region["cat"].asString());
+    EXPECT_GE(region["dur"].asDouble(), 0.);
+
+    auto mark = findEvent(trace, "Path Tree Broadcast");
+    ASSERT_TRUE(mark.isObject());
+    EXPECT_EQ("i", mark["ph"].asString());
+    /// The mark was made inside the region.
+    EXPECT_GE(mark["ts"].asDouble(), region["ts"].asDouble());
+    EXPECT_LE(mark["ts"].asDouble(),
+              region["ts"].asDouble() + region["dur"].asDouble() + 0.1);
+    EXPECT_EQ(region["tid"].asInt64(), mark["tid"].asInt64());
+
+    /// Events from a thread that has since exited are still written.
+    auto workerMark = findEvent(trace, "worker \"quoted\"\\mark");
+    ASSERT_TRUE(workerMark.isObject());
+    EXPECT_EQ("worker", workerMark["cat"].asString());
+    EXPECT_NE(region["tid"].asInt64(), workerMark["tid"].asInt64());
+    EXPECT_EQ(region["pid"].asInt64(), workerMark["pid"].asInt64());
+}
+
+TEST(TracingRingBuffer, LongNamesTruncated) {
+    std::string name(200, 'a');
+    tracing::markGetState("/" + name);
+    auto trace = writeAndParseTrace();
+    std::string truncated;
+    for (auto const &ev : trace["traceEvents"]) {
+        auto evName = ev["name"].asString();
+        if (evName.compare(0, 10, "GetState /") == 0) {
+            truncated = evName;
+        }
+    }
+    ASSERT_FALSE(truncated.empty());
+    EXPECT_LT(truncated.size(), name.size());
+    EXPECT_EQ(std::string(truncated.size() - 10, 'a'), truncated.substr(10));
+}
+
+TEST(TracingRingBuffer, KeepsNewestEventsWhenFull) {
+    for (int i = 0; i < 20000; ++i) {
+        tracing::WorkerTracePolicy::mark(
+            ("overflow " + std::to_string(i)).c_str());
+    }
+    auto trace = writeAndParseTrace();
+    EXPECT_TRUE(findEvent(trace, "overflow 19999").isObject());
+    EXPECT_TRUE(findEvent(trace, "overflow 0").isNull());
+}
+#else
+TEST(Tracing, WriteTraceFileUnavailable) {
+    ASSERT_FALSE(tracing::writeTraceFile("osvr-test-trace.json"));
+}
+#endif
@@ -0,0 +1,164 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Connection/AsyncReportQueue.h"
+#include "../../../src/osvr/Connection/AsyncReportQueue.cpp"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <cstring>
+#include <vector>
+
+using namespace osvr::connection;
+using osvr::util::time::TimeValue;
+
+namespace {
+struct Report {
+    int producer;
+    int seq;
+};
+inline MessageType *fakeType(int i) {
+    return reinterpret_cast<MessageType *>(static_cast<std::size_t>(i + 1));
+}
+} // namespace
+
+TEST(AsyncReportQueue, fifo) {
+    AsyncReportQueue q(4);
+    ASSERT_EQ(4u, q.capacity());
+    TimeValue tv = {1, 2};
+    for (int i = 0; i < 4; ++i) {
+        Report r = {0, i};
+        ASSERT_TRUE(q.push(tv, fakeType(i), reinterpret_cast<char *>(&r),
+                           sizeof(r)));
+    }
+    Report r = {0, 4};
+    ASSERT_FALSE(
+        q.push(tv, fakeType(4), reinterpret_cast<char *>(&r), sizeof(r)))
+        << "Queue should be full";
+
+    int expected = 0;
+    auto n = q.drain([&](TimeValue const &t, MessageType *type,
+                         const char *data, std::size_t len) {
+        ASSERT_EQ(sizeof(Report), len);
+        ASSERT_EQ(1, t.seconds);
+        ASSERT_EQ(fakeType(expected), type);
+        Report got;
+        std::memcpy(&got, data, len);
+        ASSERT_EQ(expected, got.seq);
+        ++expected;
+    });
+    ASSERT_EQ(4u, n);
+    ASSERT_EQ(0u, q.drain([](TimeValue const &, MessageType *, const char *,
+                             std::size_t) { FAIL(); }));
+    ASSERT_TRUE(
+        q.push(tv, fakeType(4), reinterpret_cast<char *>(&r), sizeof(r)))
+        << "Should have room again after draining";
+}
+
+TEST(AsyncReportQueue, rejectsOversize) {
+    AsyncReportQueue q;
+    std::vector<char> big(AsyncReportQueue::MAX_PAYLOAD + 1);
+    TimeValue tv = {0, 0};
+    ASSERT_FALSE(q.push(tv, nullptr, big.data(), big.size()));
+    ASSERT_TRUE(q.push(tv, nullptr, big.data(), big.size() - 1));
+}
+
+namespace {
+void appendSeq(void *target, TimeValue const &, const char *payload,
+               std::size_t len) {
+    Report got;
+    std::memcpy(&got, payload, len);
+    static_cast<std::vector<int> *>(target)->push_back(got.seq);
+}
+} // namespace
+
+TEST(AsyncReportQueue, callsInterleavedWithReports) {
+    AsyncReportQueue q(4);
+    TimeValue tv = {0, 0};
+    std::vector<int> order;
+    for (int i = 0; i < 4; ++i) {
+        Report r = {0, i};
+        if (i % 2) {
+            ASSERT_TRUE(q.pushCall(&appendSeq, &order, tv,
+                                   reinterpret_cast<char *>(&r), sizeof(r)));
+        } else {
+            ASSERT_TRUE(q.push(tv, fakeType(i), reinterpret_cast<char *>(&r),
+                               sizeof(r)));
+        }
+    }
+    auto n = q.drain([&](TimeValue const &, MessageType *, const char *data,
+                         std::size_t len) {
+        Report got;
+        std::memcpy(&got, data, len);
+        order.push_back(got.seq);
+    });
+    ASSERT_EQ(4u, n);
+    ASSERT_EQ((std::vector<int>{0, 1, 2, 3}), order)
+        << "Calls and reports must be handled in the order queued";
+}
+
+TEST(AsyncReportQueue, multipleProducers) {
+    static const int PRODUCERS = 4;
+    static const int REPORTS = 20000;
+    AsyncReportQueue q(64);
+    std::vector<int> nextSeq(PRODUCERS, 0);
+    std::vector<boost::thread> threads;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        threads.emplace_back([&q, p] {
+            TimeValue tv = {0, 0};
+            for (int i = 0; i < REPORTS; ++i) {
+                Report r = {p, i};
+                while (!q.push(tv, fakeType(p),
+                               reinterpret_cast<char *>(&r), sizeof(r))) {
+                    boost::this_thread::yield();
+                }
+            }
+        });
+    }
+    int total = 0;
+    while (total < PRODUCERS * REPORTS) {
+        total += static_cast<int>(q.drain([&](TimeValue const &,
+                                              MessageType *type,
+                                              const char *data,
+                                              std::size_t len) {
+            Report got;
+            std::memcpy(&got, data, len);
+            ASSERT_EQ(fakeType(got.producer), type);
+            /// Each producer's reports must arrive in order, exactly once.
+            ASSERT_EQ(nextSeq[got.producer], got.seq);
+            ++nextSeq[got.producer];
+        }));
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    for (int p = 0; p < PRODUCERS; ++p) {
+        ASSERT_EQ(REPORTS, nextSeq[p]);
+    }
+}
@@ -0,0 +1,165 @@
+/** @file
+    @brief Test Implementation: HotplugWatcher, which tells the server when
+    devices may have been plugged in.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Server/HotplugWatcher.h"
+#include "../../../src/osvr/Server/HotplugWatcher.cpp"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+
+// Standard includes
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using osvr::server::HotplugWatcher;
+namespace fs = boost::filesystem;
+
+#ifdef OSVR_HOTPLUG_WATCHER_INOTIFY
+
+namespace {
+/// Comfortably longer than the watcher's settle time.
+static const std::chrono::milliseconds SETTLED(400);
+
+/// Stand-ins for /dev and /dev/bus/usb, with one bus directory.
+class HotplugWatcherTest : public ::testing::Test {
+  protected:
+    HotplugWatcherTest()
+        : dir(fs::temp_directory_path() /
+              fs::unique_path("osvr-hotplug-%%%%-%%%%")),
+          dev(dir / "dev"), usb(dir / "usb") {
+        fs::create_directories(dev);
+        fs::create_directories(usb / "001");
+    }
+    ~HotplugWatcherTest() {
+        boost::system::error_code ec;
+        fs::remove_all(dir, ec);
+    }
+
+    static void touch(fs::path const &file) {
+        std::ofstream{file.string()};
+    }
+
+    /// Checks for a while, as the server mainloop would, returning whether
+    /// any check reported a hotplug.
+    static bool checkFor(HotplugWatcher &watcher,
+                         std::chrono::milliseconds duration) {
+        auto end = std::chrono::steady_clock::now() + duration;
+        bool ret = false;
+        do {
+            ret = watcher.checkForHotplug() || ret;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        } while (std::chrono::steady_clock::now() < end);
+        return ret;
+    }
+
+    fs::path dir;
+    fs::path dev;
+    fs::path usb;
+};
+} // namespace
+
+TEST_F(HotplugWatcherTest, NothingHappening) {
+    HotplugWatcher watcher{dev.string(), usb.string()};
+    ASSERT_TRUE(watcher.isWatching());
+    ASSERT_FALSE(checkFor(watcher, SETTLED));
+}
+
+TEST_F(HotplugWatcherTest, ReportsInterestingNodeOnceSettled) {
+    HotplugWatcher watcher{dev.string(), usb.string()};
+    touch(dev / "hidraw0");
+    /// Not until the nodes stop changing.
+    ASSERT_FALSE(watcher.checkForHotplug());
+    std::this_thread::sleep_for(SETTLED);
+    ASSERT_TRUE(watcher.checkForHotplug());
+    /// And only once.
+    ASSERT_FALSE(checkFor(watcher, SETTLED));
+}
+
+TEST_F(HotplugWatcherTest, ReportsEachInterestingPrefix) {
+    HotplugWatcher watcher{dev.string(), usb.string()};
+    for (auto name : {"hidraw3", "ttyACM0", "ttyUSB1", "video2"}) {
+        touch(dev / name);
+        ASSERT_TRUE(checkFor(watcher, SETTLED)) << name;
+    }
+}
+
+TEST_F(HotplugWatcherTest, ChangesKeepItUnsettled) {
+    HotplugWatcher watcher{dev.string(), usb.string()};
+    touch(dev / "hidraw0");
+    /// udev creates a node, then adjusts its permissions.
+    for (int i = 0; i < 5; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        ASSERT_FALSE(watcher.checkForHotplug());
+        fs::permissions(dev / "hidraw0",
+                        (i % 2) ? fs::owner_read | fs::owner_write
+                                : fs::owner_read);
+    }
+    ASSERT_TRUE(checkFor(watcher, SETTLED));
+}
+
+TEST_F(HotplugWatcherTest, IgnoresOtherDevNodes) {
+    HotplugWatcher watcher{dev.string(), usb.string()};
+    touch(dev / "null");
+    touch(dev / "tty1");
+    touch(dev / "ttyS0");
+    fs::create_directories(dev / "input");
+    fs::permissions(dev / "tty1", fs::owner_read);
+    ASSERT_FALSE(checkFor(watcher, SETTLED));
+}
+
+TEST_F(HotplugWatcherTest, ReportsAnyNodeOnUsbBus) {
+    HotplugWatcher watcher{dev.string(), usb.string()};
+    touch(usb / "001" / "005");
+    ASSERT_TRUE(checkFor(watcher, SETTLED));
+}
+
+TEST_F(HotplugWatcherTest, UsbBusesAreOptional) {
+    HotplugWatcher watcher{dev.string(), (dir / "missing").string()};
+    ASSERT_TRUE(watcher.isWatching());
+    touch(dev / "ttyUSB0");
+    ASSERT_TRUE(checkFor(watcher, SETTLED));
+}
+
+TEST_F(HotplugWatcherTest, NotWatchingWithoutDevDirectory) {
+    HotplugWatcher watcher{(dir / "missing").string(), usb.string()};
+    ASSERT_FALSE(watcher.isWatching());
+    touch(usb / "001" / "005");
+    ASSERT_FALSE(checkFor(watcher, SETTLED));
+}
+
+#else // !OSVR_HOTPLUG_WATCHER_INOTIFY
+
+TEST(HotplugWatcher, NeverWatching) {
+    HotplugWatcher watcher;
+    ASSERT_FALSE(watcher.isWatching());
+    ASSERT_FALSE(watcher.checkForHotplug());
+}
+
+#endif // OSVR_HOTPLUG_WATCHER_INOTIFY
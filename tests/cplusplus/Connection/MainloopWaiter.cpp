@@ -0,0 +1,104 @@
+/** @file
+    @brief Test Implementation: MainloopWaiter, which the server thread blocks
+    in between loop iterations.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Server/MainloopWaiter.h"
+#include "../../../src/osvr/Server/MainloopWaiter.cpp"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <chrono>
+
+using osvr::server::MainloopWaiter;
+
+namespace {
+typedef std::chrono::steady_clock clock_type;
+
+/// Long enough that only a wake ends the wait in any reasonable test run.
+static const int LONG_WAIT_US = 10 * 1000 * 1000;
+
+/// Comfortably short of LONG_WAIT_US, even on a loaded machine.
+static const std::chrono::seconds WOKEN_WITHIN(5);
+
+clock_type::duration timeWait(MainloopWaiter &waiter, int microseconds) {
+    auto start = clock_type::now();
+    waiter.wait(microseconds);
+    return clock_type::now() - start;
+}
+} // namespace
+
+TEST(MainloopWaiter, WakeFromOtherThreadEndsWait) {
+    MainloopWaiter waiter;
+    boost::thread waker([&] {
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(20));
+        waiter.wake();
+    });
+    auto elapsed = timeWait(waiter, LONG_WAIT_US);
+    waker.join();
+    ASSERT_LT(elapsed, clock_type::duration(WOKEN_WITHIN));
+}
+
+TEST(MainloopWaiter, TimesOut) {
+    MainloopWaiter waiter;
+    auto elapsed = timeWait(waiter, 20000);
+    /// Allow for coarse timers, but it must have actually waited.
+    ASSERT_GE(elapsed, clock_type::duration(std::chrono::milliseconds(15)));
+    ASSERT_LT(elapsed, clock_type::duration(WOKEN_WITHIN));
+
+    /// And does so again: the timeout doesn't leave a wake pending.
+    elapsed = timeWait(waiter, 20000);
+    ASSERT_GE(elapsed, clock_type::duration(std::chrono::milliseconds(15)));
+}
+
+TEST(MainloopWaiter, WakeBeforeWaitIsNotLost) {
+    MainloopWaiter waiter;
+    waiter.wake();
+    ASSERT_LT(timeWait(waiter, LONG_WAIT_US),
+              clock_type::duration(WOKEN_WITHIN));
+
+    /// The wait consumed the wake, so the next one waits out its timeout.
+    ASSERT_GE(timeWait(waiter, 20000),
+              clock_type::duration(std::chrono::milliseconds(15)));
+}
+
+TEST(MainloopWaiter, SeveralWakesEndOneWait) {
+    MainloopWaiter waiter;
+    waiter.wake();
+    waiter.wake();
+    waiter.wake();
+    ASSERT_LT(timeWait(waiter, LONG_WAIT_US),
+              clock_type::duration(WOKEN_WITHIN));
+    ASSERT_GE(timeWait(waiter, 20000),
+              clock_type::duration(std::chrono::milliseconds(15)));
+}
+
+TEST(MainloopWaiter, ZeroTimeoutDoesNotBlock) {
+    MainloopWaiter waiter;
+    ASSERT_LT(timeWait(waiter, 0), clock_type::duration(WOKEN_WITHIN));
+}
@@ -0,0 +1,96 @@
+/** @file
+    @brief Test Implementation: LogRateLimiter
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Util/LogRateLimiter.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using osvr::util::log::LogRateLimiter;
+
+TEST(LogRateLimiter, FirstCallAllowed) {
+    LogRateLimiter limiter{std::chrono::hours(1)};
+    ASSERT_TRUE(limiter.allow());
+    ASSERT_EQ(0u, limiter.takeSuppressedCount());
+}
+
+TEST(LogRateLimiter, CountsSuppressedWithinInterval) {
+    LogRateLimiter limiter{std::chrono::hours(1)};
+    ASSERT_TRUE(limiter.allow());
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_FALSE(limiter.allow());
+    }
+    ASSERT_EQ(5u, limiter.takeSuppressedCount());
+    /// Taking the count resets it.
+    ASSERT_EQ(0u, limiter.takeSuppressedCount());
+    ASSERT_FALSE(limiter.allow());
+    ASSERT_EQ(1u, limiter.takeSuppressedCount());
+}
+
+TEST(LogRateLimiter, ZeroIntervalAllowsEverything) {
+    LogRateLimiter limiter{LogRateLimiter::clock::duration::zero()};
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(limiter.allow());
+    }
+    ASSERT_EQ(0u, limiter.takeSuppressedCount());
+}
+
+TEST(LogRateLimiter, AllowsAgainAfterInterval) {
+    LogRateLimiter limiter{std::chrono::milliseconds(20)};
+    ASSERT_TRUE(limiter.allow());
+    ASSERT_FALSE(limiter.allow());
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    ASSERT_TRUE(limiter.allow());
+    ASSERT_EQ(1u, limiter.takeSuppressedCount());
+}
+
+TEST(LogRateLimiter, OneAllowedAcrossThreads) {
+    static const int THREADS = 4;
+    static const int CALLS = 1000;
+    LogRateLimiter limiter{std::chrono::hours(1)};
+    std::atomic<int> allowed{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < CALLS; ++i) {
+                if (limiter.allow()) {
+                    ++allowed;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(1, allowed);
+    ASSERT_EQ(static_cast<std::size_t>(THREADS * CALLS - 1),
+              limiter.takeSuppressedCount());
+}
@@ -0,0 +1,231 @@
+/** @file
+    @brief Test Implementation: the asynchronous log sink, and skipping of
+    filtered-out messages by Logger::StreamProxy.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Util/LogSinks.h"
+#include <osvr/Util/LogLevel.h>
+#include <osvr/Util/Logger.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using osvr::util::log::async_sink;
+using osvr::util::log::LogLevel;
+using osvr::util::log::Logger;
+
+namespace {
+/// Keeps the text of every message written to it. Optionally holds up the
+/// first write until released, to keep a background writer busy.
+class recording_sink : public spdlog::sinks::sink {
+  public:
+    void log(const spdlog::details::log_msg &msg) override {
+        if (++writes_ == 1) {
+            while (holdFirst_) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        lines_.push_back(msg.formatted.str());
+    }
+
+    void flush() override {}
+
+    void holdFirstWrite() { holdFirst_ = true; }
+    void release() { holdFirst_ = false; }
+
+    /// Waits (briefly) until the first write has started.
+    bool waitForFirstWrite() {
+        for (int i = 0; i < 1000 && writes_ == 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return writes_ > 0;
+    }
+
+    /// Waits (briefly) until some number of writes have finished.
+    bool waitForLines(std::size_t count) {
+        for (int i = 0; i < 1000 && lines().size() < count; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return lines().size() >= count;
+    }
+
+    std::vector<std::string> lines() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lines_;
+    }
+
+  private:
+    std::atomic<int> writes_{0};
+    std::atomic<bool> holdFirst_{false};
+    std::mutex mutex_;
+    std::vector<std::string> lines_;
+};
+
+void logTo(spdlog::sinks::sink &sink, std::string const &text) {
+    spdlog::details::log_msg msg;
+    msg.level = spdlog::level::info;
+    msg.time = spdlog::details::os::now();
+    msg.formatted << text;
+    sink.log(msg);
+}
+
+/// Counts how many times it has been formatted.
+struct Counted {
+    int &formatted;
+};
+inline std::ostream &operator<<(std::ostream &os, Counted const &c) {
+    ++c.formatted;
+    return os << "counted";
+}
+
+void streamValue(std::ostream &os, int value) { os << value; }
+} // namespace
+
+TEST(AsyncSink, WritesInOrderBySync) {
+    auto recorder = std::make_shared<recording_sink>();
+    async_sink sink{spdlog::sink_ptr(recorder), 1024};
+    for (int i = 0; i < 100; ++i) {
+        logTo(sink, std::to_string(i));
+    }
+    sink.sync();
+    auto lines = recorder->lines();
+    ASSERT_EQ(100u, lines.size());
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(std::to_string(i), lines[i]);
+    }
+}
+
+TEST(AsyncSink, CountsDroppedMessages) {
+    auto recorder = std::make_shared<recording_sink>();
+    async_sink sink{spdlog::sink_ptr(recorder), 2};
+    recorder->holdFirstWrite();
+    logTo(sink, "0");
+    /// Once the writer is stuck on the first message, the queue can take
+    /// exactly two more.
+    ASSERT_TRUE(recorder->waitForFirstWrite());
+    for (int i = 1; i < 6; ++i) {
+        logTo(sink, std::to_string(i));
+    }
+    recorder->release();
+    sink.sync();
+    auto lines = recorder->lines();
+    ASSERT_EQ(4u, lines.size());
+    ASSERT_EQ("0", lines[0]);
+    ASSERT_EQ("1", lines[1]);
+    ASSERT_EQ("2", lines[2]);
+    ASSERT_NE(std::string::npos, lines[3].find("dropped 3 messages"));
+}
+
+TEST(AsyncSink, SyncDoesNotWaitForeverOnWriter) {
+    auto recorder = std::make_shared<recording_sink>();
+    async_sink sink{spdlog::sink_ptr(recorder), 16,
+                    std::chrono::milliseconds(20)};
+    recorder->holdFirstWrite();
+    logTo(sink, "stuck");
+    ASSERT_TRUE(recorder->waitForFirstWrite());
+    logTo(sink, "queued");
+    /// The writer can't get to "queued", so sync gives up on it: but leaves
+    /// it queued, rather than writing it ahead of "stuck".
+    sink.sync();
+    ASSERT_TRUE(recorder->lines().empty());
+    recorder->release();
+    sink.sync();
+    auto lines = recorder->lines();
+    ASSERT_EQ(2u, lines.size());
+    ASSERT_EQ("stuck", lines[0]);
+    ASSERT_EQ("queued", lines[1]);
+}
+
+TEST(AsyncSink, DestroyWhileWriterStuck) {
+    auto recorder = std::make_shared<recording_sink>();
+    {
+        async_sink sink{spdlog::sink_ptr(recorder), 16,
+                        std::chrono::milliseconds(20)};
+        recorder->holdFirstWrite();
+        logTo(sink, "stuck");
+        ASSERT_TRUE(recorder->waitForFirstWrite());
+        logTo(sink, "queued");
+    }
+    /// The sink is gone, but the writer it left behind still has what it
+    /// needs to finish, in order.
+    ASSERT_TRUE(recorder->lines().empty());
+    recorder->release();
+    ASSERT_TRUE(recorder->waitForLines(2));
+    auto lines = recorder->lines();
+    ASSERT_EQ(2u, lines.size());
+    ASSERT_EQ("stuck", lines[0]);
+    ASSERT_EQ("queued", lines[1]);
+}
+
+TEST(AsyncSink, SynchronousWhenDisabled) {
+    auto recorder = std::make_shared<recording_sink>();
+    async_sink sink{spdlog::sink_ptr(recorder), 16};
+    sink.set_async(false);
+    logTo(sink, "direct");
+    auto lines = recorder->lines();
+    ASSERT_EQ(1u, lines.size());
+    ASSERT_EQ("direct", lines[0]);
+}
+
+TEST(StreamProxy, SkipsFilteredMessages) {
+    auto recorder = std::make_shared<recording_sink>();
+    auto logger = Logger::makeWithSink("StreamProxyTest", recorder);
+    logger->setLogLevel(LogLevel::info);
+    ASSERT_FALSE(logger->shouldLog(LogLevel::debug));
+    ASSERT_TRUE(logger->shouldLog(LogLevel::info));
+
+    int formatted = 0;
+    logger->debug() << Counted{formatted};
+    ASSERT_EQ(0, formatted);
+    logger->debug("filtered") << 42 << std::endl;
+    ASSERT_TRUE(recorder->lines().empty());
+
+    logger->info() << Counted{formatted};
+    ASSERT_EQ(1, formatted);
+    auto lines = recorder->lines();
+    ASSERT_EQ(1u, lines.size());
+    ASSERT_NE(std::string::npos, lines[0].find("counted"));
+}
+
+TEST(StreamProxy, ResultIsAnOstream) {
+    auto recorder = std::make_shared<recording_sink>();
+    auto logger = Logger::makeWithSink("StreamProxyTest", recorder);
+    logger->setLogLevel(LogLevel::info);
+    streamValue(logger->info() << "value: ", 5);
+    streamValue(logger->debug() << "value: ", 6);
+    auto lines = recorder->lines();
+    ASSERT_EQ(1u, lines.size());
+    ASSERT_NE(std::string::npos, lines[0].find("value: 5"));
+}